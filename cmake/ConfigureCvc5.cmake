@@ -81,6 +81,7 @@ check_symbol_exists(sigaltstack "signal.h" HAVE_SIGALTSTACK)
 check_symbol_exists(strerror_r "string.h" HAVE_STRERROR_R)
 check_symbol_exists(strtok_r "string.h" HAVE_STRTOK_R)
 check_symbol_exists(setitimer "sys/time.h" HAVE_SETITIMER)
+check_symbol_exists(mmap "sys/mman.h" HAVE_MMAP)
 
 # on non-POSIX systems, time limit is implemented with threads
 if(NOT HAVE_SETITIMER)
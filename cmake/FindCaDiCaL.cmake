@@ -14,6 +14,8 @@
 # CaDiCaL_FOUND - system has CaDiCaL lib
 # CaDiCaL_INCLUDE_DIR - the CaDiCaL include directory
 # CaDiCaL_LIBRARIES - Libraries needed to use CaDiCaL
+# CaDiCaL_HAS_EXTERNAL_PROPAGATOR - CaDiCaL supports IPASIR-UP
+# CaDiCaL_HAS_EXTERNAL_PROPAGATOR_V2 - IPASIR-UP has the CaDiCaL 2.x signatures
 ##
 
 include(deps-helper)
@@ -36,6 +38,48 @@ if(CaDiCaL_INCLUDE_DIR AND CaDiCaL_LIBRARIES)
   endif()
 
   check_system_version("CaDiCaL")
+
+  # Check whether CaDiCaL provides the external propagator interface
+  # (IPASIR-UP) required to use it as the main CDCL(T) SAT solver. The
+  # signatures of the callbacks changed with CaDiCaL 2.0, which notifies
+  # assignments in batches and allows external clauses to be forgettable.
+  include(CheckCXXSourceCompiles)
+  set(CMAKE_REQUIRED_QUIET TRUE)
+  set(CMAKE_REQUIRED_INCLUDES ${CaDiCaL_INCLUDE_DIR})
+  check_cxx_source_compiles(
+    "#include <cadical.hpp>
+     #include <vector>
+     struct P : CaDiCaL::ExternalPropagator {
+       void notify_assignment(const std::vector<int>&) override {}
+       void notify_new_decision_level() override {}
+       void notify_backtrack(size_t) override {}
+       bool cb_check_found_model(const std::vector<int>&) override { return true; }
+       bool cb_has_external_clause(bool&) override { return false; }
+       int cb_add_external_clause_lit() override { return 0; }
+     };
+     int main() { P p; (void) p; return 0; }"
+     CaDiCaL_HAS_EXTERNAL_PROPAGATOR_V2
+  )
+  if(CaDiCaL_HAS_EXTERNAL_PROPAGATOR_V2)
+    set(CaDiCaL_HAS_EXTERNAL_PROPAGATOR TRUE)
+  else()
+    check_cxx_source_compiles(
+      "#include <cadical.hpp>
+       #include <vector>
+       struct P : CaDiCaL::ExternalPropagator {
+         void notify_assignment(int, bool) override {}
+         void notify_new_decision_level() override {}
+         void notify_backtrack(size_t) override {}
+         bool cb_check_found_model(const std::vector<int>&) override { return true; }
+         bool cb_has_external_clause() override { return false; }
+         int cb_add_external_clause_lit() override { return 0; }
+       };
+       int main() { P p; (void) p; return 0; }"
+       CaDiCaL_HAS_EXTERNAL_PROPAGATOR
+    )
+  endif()
+  unset(CMAKE_REQUIRED_QUIET)
+  unset(CMAKE_REQUIRED_INCLUDES)
 endif()
 
 if(NOT CaDiCaL_FOUND_SYSTEM)
@@ -102,6 +146,9 @@ if(NOT CaDiCaL_FOUND_SYSTEM)
 
   set(CaDiCaL_INCLUDE_DIR "${DEPS_BASE}/include/")
   set(CaDiCaL_LIBRARIES "${DEPS_BASE}/lib/libcadical.a")
+  # The bundled version predates the external propagator interface.
+  set(CaDiCaL_HAS_EXTERNAL_PROPAGATOR FALSE)
+  set(CaDiCaL_HAS_EXTERNAL_PROPAGATOR_V2 FALSE)
 endif()
 
 set(CaDiCaL_FOUND TRUE)
@@ -128,6 +175,8 @@ mark_as_advanced(CaDiCaL_FOUND)
 mark_as_advanced(CaDiCaL_FOUND_SYSTEM)
 mark_as_advanced(CaDiCaL_INCLUDE_DIR)
 mark_as_advanced(CaDiCaL_LIBRARIES)
+mark_as_advanced(CaDiCaL_HAS_EXTERNAL_PROPAGATOR)
+mark_as_advanced(CaDiCaL_HAS_EXTERNAL_PROPAGATOR_V2)
 
 if(CaDiCaL_FOUND_SYSTEM)
   message(STATUS "Found CaDiCaL ${CaDiCaL_VERSION}: ${CaDiCaL_LIBRARIES}")
@@ -44,6 +44,7 @@ The following flags enable optional features (disable with --no-<option name>).
   --coverage               support for gcov coverage testing
   --profiling              support for gprof profiling
   --unit-testing           support for unit testing
+  --benchmarks             build the micro benchmarks
   --python-bindings        build Python bindings based on new C++ API
   --java-bindings          build Java bindings based on new C++ API
   --all-bindings           build bindings for all supported languages
@@ -131,6 +132,7 @@ tracing=default
 tsan=default
 ubsan=default
 unit_testing=default
+benchmarks=default
 valgrind=default
 win64=default
 win64_native=default
@@ -258,6 +260,9 @@ do
     --unit-testing) unit_testing=ON;;
     --no-unit-testing) unit_testing=OFF;;
 
+    --benchmarks) benchmarks=ON;;
+    --no-benchmarks) benchmarks=OFF;;
+
     --python-bindings) python_bindings=ON;;
     --no-python-bindings) python_bindings=OFF;;
 
@@ -358,6 +363,8 @@ fi
   && cmake_opts="$cmake_opts -DENABLE_TRACING=$tracing"
 [ $unit_testing != default ] \
   && cmake_opts="$cmake_opts -DENABLE_UNIT_TESTING=$unit_testing"
+[ $benchmarks != default ] \
+  && cmake_opts="$cmake_opts -DENABLE_BENCHMARKS=$benchmarks"
 [ $docs != default ] \
   && cmake_opts="$cmake_opts -DBUILD_DOCS=$docs"
 [ $python_bindings != default ] \
@@ -52,6 +52,7 @@ class DType;
 class DTypeConstructor;
 class DTypeSelector;
 class NodeManager;
+class NodeManagerScope;
 class SolverEngine;
 class TypeNode;
 class Options;
@@ -64,6 +65,7 @@ class StatisticsRegistry;
 }  // namespace internal
 
 namespace parser {
+class BinaryParser;
 class Command;
 }
 
@@ -355,6 +357,7 @@ class Datatype;
  */
 class CVC5_EXPORT Sort
 {
+  friend class parser::BinaryParser;
   friend class parser::Command;
   friend class DatatypeConstructor;
   friend class DatatypeConstructorDecl;
@@ -1107,6 +1110,7 @@ namespace cvc5 {
  */
 class CVC5_EXPORT Term
 {
+  friend class parser::BinaryParser;
   friend class parser::Command;
   friend class Datatype;
   friend class DatatypeConstructor;
@@ -3200,6 +3204,86 @@ class CVC5_EXPORT Statistics
 std::ostream& operator<<(std::ostream& out,
                          const Statistics& stats) CVC5_EXPORT;
 
+/* -------------------------------------------------------------------------- */
+/* TermManager                                                                */
+/* -------------------------------------------------------------------------- */
+
+/**
+ * A term manager that can be shared by solvers running in different threads.
+ *
+ * By default, every thread has its own term manager, which is used by all
+ * solvers, sorts and terms created in that thread, and these cannot be used
+ * in any other thread. Instead, a thread may use a term manager of this class
+ * by creating a TermManager::Scope for it: while the scope is alive, all
+ * solvers, sorts and terms created by that thread belong to this term
+ * manager, and they may be used in any other thread that has a scope for the
+ * same term manager. For example, a large background theory may be built
+ * once, and then asserted to solvers running in parallel threads.
+ *
+ * A solver and all objects it created must be used and destroyed in threads
+ * that have a scope for the term manager that was current when the solver
+ * was created. A single solver may not be used by several threads at the same
+ * time. Sorts and terms of this term manager must not be mixed with those of
+ * a thread's own term manager.
+ *
+ * Creating terms is serialized via a lock. Terms created by a term manager of
+ * this class are only freed when the term manager is destroyed, which must
+ * happen after all solvers, sorts and terms of it have been destroyed.
+ *
+ * @warning This class is experimental and may change in future versions.
+ */
+class CVC5_EXPORT TermManager
+{
+ public:
+  /**
+   * Makes a term manager the term manager of the calling thread for the
+   * lifetime of this object. Scopes may be nested, and must be destroyed by
+   * the thread that created them.
+   */
+  class CVC5_EXPORT Scope
+  {
+   public:
+    /**
+     * Constructor.
+     * @param tm The term manager to use in the calling thread.
+     */
+    Scope(TermManager& tm);
+    /**
+     * Destructor, restores the term manager that was used before.
+     */
+    ~Scope();
+
+    /**
+     * Disallow copy/assignment.
+     */
+    Scope(const Scope&) = delete;
+    Scope& operator=(const Scope&) = delete;
+
+   private:
+    /** The internal scope */
+    std::unique_ptr<internal::NodeManagerScope> d_scope;
+  };
+
+  /**
+   * Constructor.
+   */
+  TermManager();
+  /**
+   * Destructor.
+   */
+  ~TermManager();
+
+  /**
+   * Disallow copy/assignment.
+   */
+  TermManager(const TermManager&) = delete;
+  TermManager& operator=(const TermManager&) = delete;
+
+ private:
+  /** The associated node manager */
+  internal::NodeManager* d_nm;
+};
+
 /* -------------------------------------------------------------------------- */
 /* Solver                                                                     */
 /* -------------------------------------------------------------------------- */
@@ -3217,8 +3301,10 @@ class CVC5_EXPORT Solver
   friend class DriverOptions;
   friend class Grammar;
   friend class Op;
+  friend class parser::BinaryParser;
   friend class parser::Command;
   friend class main::CommandExecutor;
+  friend class Portfolio;
   friend class Sort;
   friend class Term;
 
@@ -4133,6 +4219,52 @@ class CVC5_EXPORT Solver
    */
   std::vector<Term> getAssertions() const;
 
+  /**
+   * Write the given terms to an output stream in the binary format of cvc5.
+   *
+   * The binary format is a compact representation of terms that can be
+   * loaded much faster than their textual representation. Subterms that
+   * are shared between the given terms are written only once.
+   *
+   * @note Skolems, datatypes and values of theories other than arithmetic,
+   *       bit-vectors, floating-point arithmetic and strings are not
+   *       supported.
+   *
+   * @warning This method is experimental and may change in future versions.
+   *
+   * @param out The output stream.
+   * @param terms The terms to write.
+   */
+  void writeBinary(std::ostream& out, const std::vector<Term>& terms) const;
+
+  /**
+   * Read the terms written by writeBinary() from an input stream.
+   *
+   * The free constants and uninterpreted sorts of the terms are created
+   * fresh, i.e., they are distinct from all other constants and sorts.
+   * Constants and sorts that are shared between the terms written by a
+   * single call to writeBinary() are also shared between the returned terms.
+   *
+   * @warning This method is experimental and may change in future versions.
+   *
+   * @param in The input stream.
+   * @return The terms.
+   */
+  std::vector<Term> readBinary(std::istream& in) const;
+
+  /**
+   * Write the current problem to an output stream in the binary format of
+   * cvc5. The problem consists of the logic, the declarations of the free
+   * constants and uninterpreted sorts occurring in the assertions, the
+   * assertions and a check for satisfiability. The problem can be read with
+   * the input language `binary`, e.g., by `cvc5 --lang=binary`.
+   *
+   * @warning This method is experimental and may change in future versions.
+   *
+   * @param out The output stream.
+   */
+  void writeBinaryProblem(std::ostream& out) const;
+
   /**
    * Get info from the solver.
    *
@@ -5241,6 +5373,90 @@ class CVC5_EXPORT Solver
   std::unique_ptr<internal::Random> d_rng;
 };
 
+/* -------------------------------------------------------------------------- */
+/* Portfolio                                                                  */
+/* -------------------------------------------------------------------------- */
+
+/**
+ * A thread-based parallel portfolio of solvers.
+ *
+ * A portfolio runs one solver per configuration, each in its own thread, on
+ * the same problem, and returns the first definitive (sat or unsat) result.
+ * The solvers exchange short learned clauses and literals learned at decision
+ * level zero through a lock-free buffer, if they are over atoms that occur in
+ * the input of the receiving solver.
+ *
+ * Since terms cannot be shared between solvers, the problem is given as a
+ * setup function that is called on the solver of each configuration, in the
+ * thread of that solver. It must declare the symbols and assert the formulas
+ * of the problem, in the same way for every solver, but it must not check
+ * satisfiability.
+ *
+ * Sharing learned clauses requires that every configuration derives only
+ * clauses that are entailed by the assertions. Hence, preprocessing that only
+ * preserves satisfiability (e.g. symmetry breaking, sort inference) is
+ * disabled in the solvers of a portfolio, and enabling it explicitly in a
+ * configuration is an error. Solvers that add lemmas which are not entailed
+ * (e.g. with finite model finding) use the clauses of the other solvers, but
+ * do not share their own.
+ *
+ * @warning This class is experimental and may change in future versions.
+ */
+class CVC5_EXPORT Portfolio
+{
+ public:
+  /** A configuration, given as a list of option name and value pairs. */
+  using Configuration = std::vector<std::pair<std::string, std::string>>;
+  /** A function that sets up the problem to solve on a given solver. */
+  using SetupFunction = std::function<void(Solver&)>;
+  /**
+   * A function that is called on the solver that produced the result of the
+   * portfolio, before that solver is destroyed.
+   */
+  using ResultFunction = std::function<void(Solver&, const Result&)>;
+
+  /**
+   * Constructor.
+   * @param configs The configurations to run, one thread per configuration.
+   */
+  Portfolio(const std::vector<Configuration>& configs);
+
+  /**
+   * Destructor.
+   */
+  ~Portfolio();
+
+  /**
+   * Check satisfiability of the problem given by the setup function, using
+   * all configurations in parallel.
+   *
+   * Any exception raised by a solver is rethrown if no solver produced a
+   * result.
+   *
+   * @param setup The function that sets up the problem on each solver.
+   * @param onResult If non-null, this function is called on the solver that
+   *                 produced the result, in the thread of that solver. This
+   *                 can for example be used to query its model.
+   * @return The first sat or unsat result, or unknown if no configuration
+   *         produced a definitive result.
+   */
+  Result checkSat(const SetupFunction& setup,
+                  const ResultFunction& onResult = nullptr);
+
+  /**
+   * Get the index of the configuration that produced the result of the last
+   * call to checkSat().
+   * @return The index of the winning configuration.
+   */
+  size_t getWinner() const;
+
+ private:
+  /** The configurations */
+  std::vector<Configuration> d_configs;
+  /** The winning configuration of the last call to checkSat() */
+  size_t d_winner;
+};
+
 }  // namespace cvc5
 
 #endif
@@ -32,8 +32,12 @@
 
 #include <cvc5/cvc5.h>
 
+#include <algorithm>
+#include <atomic>
 #include <cstring>
+#include <exception>
 #include <sstream>
+#include <thread>
 
 #include "api/cpp/cvc5_checks.h"
 #include "base/check.h"
@@ -53,6 +57,7 @@
 #include "expr/node_algorithm.h"
 #include "expr/node_builder.h"
 #include "expr/node_manager.h"
+#include "expr/node_serializer.h"
 #include "expr/sequence.h"
 #include "expr/sygus_grammar.h"
 #include "expr/type_node.h"
@@ -62,9 +67,11 @@
 #include "options/option_exception.h"
 #include "options/options.h"
 #include "options/options_public.h"
+#include "options/parallel_options.h"
 #include "options/quantifiers_options.h"
 #include "options/smt_options.h"
 #include "proof/unsat_core.h"
+#include "prop/learned_exchange.h"
 #include "smt/env.h"
 #include "smt/model.h"
 #include "smt/smt_mode.h"
@@ -4912,6 +4919,27 @@ std::ostream& operator<<(std::ostream& out, const Statistics& stats)
   return out;
 }
 
+/* -------------------------------------------------------------------------- */
+/* TermManager                                                                */
+/* -------------------------------------------------------------------------- */
+
+TermManager::Scope::Scope(TermManager& tm)
+    : d_scope(new internal::NodeManagerScope(tm.d_nm))
+{
+}
+
+TermManager::Scope::~Scope() {}
+
+TermManager::TermManager() : d_nm(new internal::NodeManager(true)) {}
+
+TermManager::~TermManager()
+{
+  // the node manager may access the current node manager while it is
+  // destroyed
+  internal::NodeManagerScope scope(d_nm);
+  delete d_nm;
+}
+
 /* -------------------------------------------------------------------------- */
 /* Solver                                                                     */
 /* -------------------------------------------------------------------------- */
@@ -6671,6 +6699,92 @@ std::vector<Term> Solver::getAssertions(void) const
   CVC5_API_TRY_CATCH_END;
 }
 
+void Solver::writeBinary(std::ostream& out,
+                         const std::vector<Term>& terms) const
+{
+  CVC5_API_TRY_CATCH_BEGIN;
+  CVC5_API_SOLVER_CHECK_TERMS(terms);
+  //////// all checks before this line
+  internal::NodeSerializer ns(out);
+  for (const Term& t : terms)
+  {
+    ns.writeTerm(*t.d_node);
+  }
+  ns.finish();
+  ////////
+  CVC5_API_TRY_CATCH_END;
+}
+
+std::vector<Term> Solver::readBinary(std::istream& in) const
+{
+  CVC5_API_TRY_CATCH_BEGIN;
+  //////// all checks before this line
+  std::vector<internal::Node> nodes;
+  internal::NodeDeserializer nd(d_nm, in);
+  internal::NodeDeserializer::Record r;
+  while (nd.next(r))
+  {
+    if (r.d_kind == internal::BinaryRecord::TERM)
+    {
+      nodes.push_back(r.d_node);
+    }
+  }
+  return Term::nodeVectorToTerms(d_nm, nodes);
+  ////////
+  CVC5_API_TRY_CATCH_END;
+}
+
+void Solver::writeBinaryProblem(std::ostream& out) const
+{
+  CVC5_API_TRY_CATCH_BEGIN;
+  //////// all checks before this line
+  std::vector<internal::Node> assertions = d_slv->getAssertions();
+  // collect the free constants and the uninterpreted sorts, where the latter
+  // may also occur only in the types of bound variables
+  std::unordered_set<internal::Node> syms;
+  std::unordered_set<internal::TypeNode> types;
+  for (const internal::Node& a : assertions)
+  {
+    internal::expr::getSymbols(a, syms);
+    internal::expr::getTypes(a, types);
+  }
+  std::unordered_set<internal::TypeNode> ctypes;
+  for (const internal::Node& s : syms)
+  {
+    internal::expr::getComponentTypes(s.getType(), ctypes);
+  }
+  for (const internal::TypeNode& tn : types)
+  {
+    internal::expr::getComponentTypes(tn, ctypes);
+  }
+  internal::NodeSerializer ns(out);
+  ns.writeLogic(d_slv->getUserLogicInfo().getLogicString());
+  std::unordered_set<internal::TypeNode> sorts;
+  for (const internal::TypeNode& tn : ctypes)
+  {
+    internal::TypeNode sort = tn.isInstantiatedUninterpretedSort()
+                                  ? tn.getUninterpretedSortConstructor()
+                                  : tn;
+    if ((sort.isUninterpretedSort() || sort.isUninterpretedSortConstructor())
+        && sorts.insert(sort).second)
+    {
+      ns.writeDeclareSort(sort);
+    }
+  }
+  for (const internal::Node& s : syms)
+  {
+    ns.writeDeclareFun(s);
+  }
+  for (const internal::Node& a : assertions)
+  {
+    ns.writeAssert(a);
+  }
+  ns.writeCheckSat();
+  ns.finish();
+  ////////
+  CVC5_API_TRY_CATCH_END;
+}
+
 std::string Solver::getInfo(const std::string& flag) const
 {
   CVC5_API_TRY_CATCH_BEGIN;
@@ -7822,6 +7936,120 @@ std::string Solver::getVersion() const
   CVC5_API_TRY_CATCH_END;
 }
 
+/* -------------------------------------------------------------------------- */
+/* Portfolio                                                                  */
+/* -------------------------------------------------------------------------- */
+
+Portfolio::Portfolio(const std::vector<Configuration>& configs)
+    : d_configs(configs), d_winner(configs.size())
+{
+  CVC5_API_TRY_CATCH_BEGIN;
+  CVC5_API_CHECK(!configs.empty())
+      << "Expected at least one configuration for portfolio";
+  CVC5_API_TRY_CATCH_END;
+}
+
+Portfolio::~Portfolio() {}
+
+Result Portfolio::checkSat(const SetupFunction& setup,
+                           const ResultFunction& onResult)
+{
+  CVC5_API_TRY_CATCH_BEGIN;
+  CVC5_API_CHECK(setup != nullptr) << "Expected a setup function";
+  //////// all checks before this line
+  size_t nconfigs = d_configs.size();
+  // the exchange is shared by all solvers, hence it is sized by the largest
+  // capacity of any configuration
+  uint64_t capacity = 0;
+  for (const Configuration& config : d_configs)
+  {
+    internal::Options opts;
+    for (const std::pair<std::string, std::string>& opt : config)
+    {
+      if (opt.first == "learned-share-capacity")
+      {
+        internal::options::set(opts, opt.first, opt.second);
+      }
+    }
+    capacity = std::max(capacity, opts.parallel.learnedShareCapacity);
+  }
+  internal::prop::LearnedExchange exchange(capacity);
+  std::atomic<size_t> winner(nconfigs);
+  std::vector<Result> results(nconfigs);
+  std::vector<std::exception_ptr> errors(nconfigs);
+  std::vector<std::thread> workers;
+  for (size_t i = 0; i < nconfigs; i++)
+  {
+    workers.emplace_back([&, i]() {
+      try
+      {
+        // the solver, and hence the node manager it uses, is local to this
+        // thread
+        Solver slv;
+        slv.d_slv->setLearnedExchange(&exchange);
+        for (const std::pair<std::string, std::string>& opt : d_configs[i])
+        {
+          slv.setOption(opt.first, opt.second);
+        }
+        setup(slv);
+        if (exchange.isStopRequested())
+        {
+          return;
+        }
+        results[i] = slv.checkSat();
+        if (results[i].isSat() || results[i].isUnsat())
+        {
+          size_t none = nconfigs;
+          if (winner.compare_exchange_strong(none, i))
+          {
+            exchange.requestStop();
+            if (onResult != nullptr)
+            {
+              onResult(slv, results[i]);
+            }
+          }
+        }
+      }
+      catch (...)
+      {
+        errors[i] = std::current_exception();
+      }
+    });
+  }
+  for (std::thread& w : workers)
+  {
+    w.join();
+  }
+  d_winner = winner.load();
+  if (d_winner == nconfigs)
+  {
+    for (const std::exception_ptr& e : errors)
+    {
+      if (e != nullptr)
+      {
+        std::rethrow_exception(e);
+      }
+    }
+    // no definitive result, report the result of the first configuration
+    d_winner = 0;
+  }
+  return results[d_winner];
+  ////////
+  CVC5_API_TRY_CATCH_END;
+}
+
+size_t Portfolio::getWinner() const
+{
+  CVC5_API_TRY_CATCH_BEGIN;
+  CVC5_API_CHECK(d_winner < d_configs.size())
+      << "Cannot get winner unless immediately preceded by a call to "
+         "checkSat()";
+  //////// all checks before this line
+  return d_winner;
+  ////////
+  CVC5_API_TRY_CATCH_END;
+}
+
 }  // namespace cvc5
 
 namespace std {
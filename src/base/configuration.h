@@ -103,6 +103,8 @@ public:
 
   static bool isBuiltWithKissat();
 
+  static bool isBuiltWithCadicalPropagator();
+
   static bool isBuiltWithEditline();
 
   static bool isBuiltWithPoly();
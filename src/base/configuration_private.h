@@ -90,6 +90,12 @@ namespace cvc5::internal {
 #  define IS_CRYPTOMINISAT_BUILD false
 #endif /* CVC5_USE_CRYPTOMINISAT */
 
+#ifdef CVC5_USE_CADICAL_PROPAGATOR
+#define IS_CADICAL_PROPAGATOR_BUILD true
+#else /* CVC5_USE_CADICAL_PROPAGATOR */
+#define IS_CADICAL_PROPAGATOR_BUILD false
+#endif /* CVC5_USE_CADICAL_PROPAGATOR */
+
 #if CVC5_USE_KISSAT
 #define IS_KISSAT_BUILD true
 #else /* CVC5_USE_KISSAT */
@@ -31,5 +31,6 @@ const int Cvc5ostream::s_indentIosIndex = std::ios_base::xalloc();
 
 WarningC WarningChannel(&std::cerr);
 TraceC TraceChannel(&std::cout);
+thread_local bool TraceC::s_suppressed = false;
 
 }  // namespace cvc5::internal
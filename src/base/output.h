@@ -263,13 +263,24 @@ public:
   {
     // This is faster than using std::set::find() or sorting the vector and
     // using std::lower_bound.
-    return !d_tags.empty() && std::find(d_tags.begin(), d_tags.end(), tag) != d_tags.end();
+    return !d_tags.empty() && !s_suppressed
+           && std::find(d_tags.begin(), d_tags.end(), tag) != d_tags.end();
   }
 
+  /**
+   * Suppress the trace output of the calling thread if s is true, or enable
+   * it again otherwise. Worker threads suppress their trace output, since it
+   * would interleave with the output of the other threads.
+   */
+  void setSuppressed(bool s) { s_suppressed = s; }
+
   std::ostream& setStream(std::ostream* os) { d_os = os; return *d_os; }
   std::ostream& getStream() const { return *d_os; }
   std::ostream* getStreamPointer() const { return d_os; }
 
+ private:
+  /** Whether the trace output of the calling thread is suppressed */
+  static thread_local bool s_suppressed CVC5_EXPORT;
 }; /* class TraceC */
 
 /** The warning output singleton */
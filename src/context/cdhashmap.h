@@ -19,8 +19,8 @@
  *
  * See also:
  *  CDInsertHashMap : An "insert-once" CD hash map.
- *  CDTrailHashMap : A lightweight CD hash map with poor iteration
- *    characteristics and some quirks in usage.
+ *  CDTrailHashMap : A CD hash map that is a single context object, using
+ *    an open-addressing table and a trail of edits.
  *
  * Internal documentation:
  *
@@ -17,8 +17,8 @@
  * It is significantly lighter in memory usage than CDHashMap.
  *
  * See also:
- *  CDTrailHashMap : A lightweight CD hash map with poor iteration
- *    characteristics and some quirks in usage.
+ *  CDTrailHashMap : A CD hash map that is a single context object, using
+ *    an open-addressing table and a trail of edits.
  *  CDHashMap : A fully featured CD hash map. (The closest to <ext/hash_map>)
  *
  * Notes:
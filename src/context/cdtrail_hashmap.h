@@ -0,0 +1,296 @@
+/******************************************************************************
+ * Top contributors (to current version):
+ *   agent
+ *
+ * This file is part of the cvc5 project.
+ *
+ * Copyright (c) 2009-2023 by the authors listed in the file AUTHORS
+ * in the top-level source directory and their institutional affiliations.
+ * All rights reserved.  See the file COPYING in the top-level source
+ * directory for licensing information.
+ * ****************************************************************************
+ *
+ * Context-dependent hash map built using an open-addressing table and a
+ * trail of edits.
+ *
+ * See also:
+ *  CDHashMap : A fully featured CD hash map, where each element is a
+ *    separate context object.
+ *  CDInsertHashMap : An "insert-once" CD hash map.
+ */
+
+#include "cvc5_private.h"
+
+#ifndef CVC5__CONTEXT__CDTRAIL_HASHMAP_H
+#define CVC5__CONTEXT__CDTRAIL_HASHMAP_H
+
+#include <cstdint>
+#include <functional>
+#include <utility>
+#include <vector>
+
+#include "base/check.h"
+#include "context/context.h"
+
+namespace cvc5::context {
+
+/**
+ * A context-dependent hash map with the same semantics as CDHashMap, which
+ * is a single context object instead of one context object per element.
+ *
+ * The elements are stored in a vector in insertion order, and an
+ * open-addressing table with linear probing maps keys to their position in
+ * that vector. Since elements are removed on backtracking in the reverse
+ * order of their insertion, removing an element pops the back of the vector.
+ * Changes of the data of elements inserted at a lower context level are
+ * recorded on a single trail, at most once per element and context level.
+ * Saving the map for a context level only records the size of the vector and
+ * of the trail, and restoring it replays the trail and pops the elements
+ * inserted since.
+ *
+ * Requires that Key and Data are copyable, and that operator== is defined for
+ * Key. As for CDHashMap, the data of an element is changed via insert, and
+ * elements are only removed on backtracking.
+ */
+template <class Key, class Data, class HashFcn = std::hash<Key>>
+class CDTrailHashMap : public ContextObj
+{
+ public:
+  using value_type = std::pair<Key, Data>;
+  using const_iterator = typename std::vector<value_type>::const_iterator;
+  using iterator = const_iterator;
+
+  CDTrailHashMap(Context* context)
+      : ContextObj(context),
+        d_slots(size_t(1) << s_initialLogCapacity, 0),
+        d_savedSize(0),
+        d_savedTrailSize(0),
+        d_shift(64 - s_initialLogCapacity)
+  {
+  }
+
+  ~CDTrailHashMap() { destroy(); }
+
+  /** The number of elements in the current context */
+  size_t size() const { return d_elements.size(); }
+
+  /** Is the map empty in the current context? */
+  bool empty() const { return d_elements.empty(); }
+
+  /** Returns 1 if k is mapped in the current context, 0 otherwise */
+  size_t count(const Key& k) const { return contains(k) ? 1 : 0; }
+
+  /** Returns true if k is mapped in the current context */
+  bool contains(const Key& k) const { return findIndex(k) != s_none; }
+
+  /**
+   * Maps k to d, where k may already be mapped. Returns true if k was not
+   * mapped before.
+   */
+  bool insert(const Key& k, const Data& d)
+  {
+    makeCurrent();
+    uint32_t level = getLevel();
+    uint32_t i = findIndex(k);
+    if (i != s_none)
+    {
+      if (d_levels[i] < level)
+      {
+        // first change of an element of a lower context level
+        d_trail.push_back(TrailElement{i, d_levels[i], d_elements[i].second});
+        d_levels[i] = level;
+      }
+      d_elements[i].second = d;
+      return false;
+    }
+    // keep the load factor at most 1/2
+    if (2 * (d_elements.size() + 1) > d_slots.size())
+    {
+      grow();
+    }
+    d_elements.emplace_back(k, d);
+    d_levels.push_back(level);
+    insertSlot(static_cast<uint32_t>(d_elements.size() - 1));
+    return true;
+  }
+
+  /**
+   * Returns the data mapped by k, which must be mapped in the current
+   * context.
+   */
+  const Data& operator[](const Key& k) const
+  {
+    uint32_t i = findIndex(k);
+    Assert(i != s_none);
+    return d_elements[i].second;
+  }
+
+  /** Returns an iterator to the element of k, or end() if k is not mapped */
+  const_iterator find(const Key& k) const
+  {
+    uint32_t i = findIndex(k);
+    return i == s_none ? d_elements.end() : d_elements.begin() + i;
+  }
+
+  /** Iterates over the elements in the order of their insertion */
+  const_iterator begin() const { return d_elements.begin(); }
+
+  const_iterator end() const { return d_elements.end(); }
+
+ private:
+  /** The initial capacity of the table is 2^s_initialLogCapacity */
+  static constexpr uint32_t s_initialLogCapacity = 4;
+  /** The index of no element */
+  static constexpr uint32_t s_none = UINT32_MAX;
+
+  /** A change of the data of an element */
+  struct TrailElement
+  {
+    /** The index of the element */
+    uint32_t d_index;
+    /** The previous level of the element */
+    uint32_t d_level;
+    /** The previous data of the element */
+    Data d_data;
+  };
+
+  /**
+   * Private copy constructor used only by save(). Only the sizes of the
+   * elements and of the trail are needed in restore, hence the vectors are
+   * not copied.
+   */
+  CDTrailHashMap(const CDTrailHashMap& m)
+      : ContextObj(m),
+        d_savedSize(m.d_elements.size()),
+        d_savedTrailSize(m.d_trail.size()),
+        d_shift(0)
+  {
+  }
+  CDTrailHashMap& operator=(const CDTrailHashMap&) = delete;
+
+  ContextObj* save(ContextMemoryManager* pCMM) override
+  {
+    return new (pCMM) CDTrailHashMap(*this);
+  }
+
+  /**
+   * Restore the map to the sizes stored in data, by first undoing the changes
+   * of the data of elements on the trail and then removing the elements
+   * inserted since.
+   */
+  void restore(ContextObj* data) override
+  {
+    CDTrailHashMap* saved = static_cast<CDTrailHashMap*>(data);
+    while (d_trail.size() > saved->d_savedTrailSize)
+    {
+      TrailElement& te = d_trail.back();
+      d_elements[te.d_index].second = te.d_data;
+      d_levels[te.d_index] = te.d_level;
+      d_trail.pop_back();
+    }
+    while (d_elements.size() > saved->d_savedSize)
+    {
+      eraseSlot(static_cast<uint32_t>(d_elements.size() - 1));
+      d_elements.pop_back();
+      d_levels.pop_back();
+    }
+  }
+
+  /** The home slot of k, using Fibonacci hashing */
+  size_t slot(const Key& k) const
+  {
+    return static_cast<size_t>(
+        (static_cast<uint64_t>(d_hash(k)) * UINT64_C(0x9e3779b97f4a7c15))
+        >> d_shift);
+  }
+
+  /** The index of the element of k, or s_none if k is not mapped */
+  uint32_t findIndex(const Key& k) const
+  {
+    size_t mask = d_slots.size() - 1;
+    for (size_t s = slot(k);; s = (s + 1) & mask)
+    {
+      uint32_t e = d_slots[s];
+      if (e == 0)
+      {
+        return s_none;
+      }
+      if (d_elements[e - 1].first == k)
+      {
+        return e - 1;
+      }
+    }
+  }
+
+  /** Insert the element with index i in the first free slot of its cluster */
+  void insertSlot(uint32_t i)
+  {
+    size_t mask = d_slots.size() - 1;
+    size_t s = slot(d_elements[i].first);
+    while (d_slots[s] != 0)
+    {
+      s = (s + 1) & mask;
+    }
+    d_slots[s] = i + 1;
+  }
+
+  /**
+   * Erase the slot of the element with index i, shifting back the following
+   * elements of its cluster, so that the table has no tombstones.
+   */
+  void eraseSlot(uint32_t i)
+  {
+    size_t mask = d_slots.size() - 1;
+    size_t s = slot(d_elements[i].first);
+    while (d_slots[s] != i + 1)
+    {
+      Assert(d_slots[s] != 0);
+      s = (s + 1) & mask;
+    }
+    for (size_t j = (s + 1) & mask; d_slots[j] != 0; j = (j + 1) & mask)
+    {
+      size_t home = slot(d_elements[d_slots[j] - 1].first);
+      if (((j - home) & mask) >= ((j - s) & mask))
+      {
+        d_slots[s] = d_slots[j];
+        s = j;
+      }
+    }
+    d_slots[s] = 0;
+  }
+
+  /** Double the capacity of the table and rehash all elements */
+  void grow()
+  {
+    d_slots.assign(d_slots.size() * 2, 0);
+    d_shift--;
+    for (uint32_t i = 0, nelems = d_elements.size(); i < nelems; i++)
+    {
+      insertSlot(i);
+    }
+  }
+
+  /** The elements in the order of their insertion */
+  std::vector<value_type> d_elements;
+  /** The context level at which the data of each element was last saved */
+  std::vector<uint32_t> d_levels;
+  /** The previous data of elements, for restoring them on backtracking */
+  std::vector<TrailElement> d_trail;
+  /**
+   * The table, which stores 1 + the index of an element, or 0 for an empty
+   * slot. Its size is a power of two.
+   */
+  std::vector<uint32_t> d_slots;
+  /** The number of elements, only used by saved copies of this map */
+  size_t d_savedSize;
+  /** The size of the trail, only used by saved copies of this map */
+  size_t d_savedTrailSize;
+  /** 64 minus the logarithm of the capacity of the table */
+  uint32_t d_shift;
+  /** The hash function */
+  HashFcn d_hash;
+}; /* class CDTrailHashMap<> */
+
+}  // namespace cvc5::context
+
+#endif /* CVC5__CONTEXT__CDTRAIL_HASHMAP_H */
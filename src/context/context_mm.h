@@ -148,6 +148,15 @@ class CVC5_EXPORT ContextMemoryManager
    */
   void pop();
 
+  /**
+   * Get the number of bytes of the chunks of all regions, not including the
+   * free chunks.
+   */
+  size_t getMemoryUsage() const
+  {
+    return d_chunkList.size() * chunkSizeBytes;
+  }
+
 }; /* class ContextMemoryManager */
 
 #else /* CVC5_DEBUG_CONTEXT_MEMORY_MANAGER */
@@ -195,6 +204,9 @@ class ContextMemoryManager
     d_allocations.pop_back();
   }
 
+  /** The memory usage is not tracked by this implementation */
+  size_t getMemoryUsage() const { return 0; }
+
  private:
   std::vector<std::vector<char*>> d_allocations;
 }; /* ContextMemoryManager */
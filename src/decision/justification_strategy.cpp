@@ -37,11 +37,13 @@ JustificationStrategy::JustificationStrategy(Env& env,
           context(), context()),  // skolem assertions are SAT-context dependent
       d_jcache(context(), ss, cs),
       d_stack(context()),
+      d_watches(ss, cs, &d_jcache),
       d_lastDecisionLit(context()),
       d_currStatusDec(false),
       d_useRlvOrder(options().decision.jhRlvOrder),
       d_decisionStopOnly(options().decision.decisionMode
                          == options::DecisionMode::STOPONLY),
+      d_useWatches(options().decision.jhWatch),
       d_jhSkMode(options().decision.jhSkolemMode),
       d_jhSkRlvMode(options().decision.jhSkolemRlvMode),
       d_stats(statisticsRegistry())
@@ -58,6 +60,8 @@ void JustificationStrategy::presolve()
   d_skolemAssertions.presolve();
   // clear the stack
   d_stack.clear();
+  // the literals of the previous call are not relevant anymore
+  d_watches.clear();
 }
 
 SatLiteral JustificationStrategy::getNextInternal(bool& stopSearch)
@@ -141,6 +145,12 @@ SatLiteral JustificationStrategy::getNextInternal(bool& stopSearch)
         }
         d_assertions.notifyStatus(d_currUnderStatus, ds);
       }
+      if (d_useWatches)
+      {
+        // remember the literals that justified the assertion
+        d_stats.d_numWatchEvaluated +=
+            d_watches.watch(d_stack.getCurrentAssertion());
+      }
       // we did not find a next node for current, refresh current assertion
       d_stack.clear();
       refreshCurrentAssertion();
@@ -578,6 +588,18 @@ bool JustificationStrategy::refreshCurrentAssertionFromList(bool useSkolemList)
     // we never add theory literals to our assertions lists
     Assert(!isTheoryLiteral(curr));
     currValue = d_jcache.lookupValue(curr);
+    if (currValue == SAT_VALUE_UNKNOWN && d_useWatches
+        && d_watches.isWatchedTrue(curr))
+    {
+      // the literals that justified curr before backtracking are still true,
+      // hence it is justified without traversing it
+      Trace("jh-process") << "...justified by watched literals" << std::endl;
+      ++(d_stats.d_numWatchedJustified);
+      bool pol = curr.getKind() != NOT;
+      d_jcache.setValue(pol ? curr : curr[0],
+                        pol ? SAT_VALUE_TRUE : SAT_VALUE_FALSE);
+      currValue = SAT_VALUE_TRUE;
+    }
     if (currValue == SAT_VALUE_UNKNOWN)
     {
       // if not already justified, we reset the stack and push to it
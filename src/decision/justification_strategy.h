@@ -26,6 +26,7 @@
 #include "decision/justify_info.h"
 #include "decision/justify_stack.h"
 #include "decision/justify_stats.h"
+#include "decision/justify_watches.h"
 #include "expr/node.h"
 #include "options/decision_options.h"
 #include "prop/cnf_stream.h"
@@ -113,6 +114,13 @@ namespace decision {
  * then (ite A (= k 1) (= k 2)) would not be added as a relevant skolem
  * definition, and Q alone would have sufficed to show the input formula
  * was satisfied.
+ *
+ * The index of the next assertion to satisfy and the justification cache
+ * are SAT-context dependent, hence after backtracking, the assertions after
+ * the restored index are traversed again. If option jhWatch is set, we
+ * remember the literals that justified each assertion (see JustifyWatches),
+ * and after backtracking, only traverse the assertions for which one of these
+ * literals is no longer true.
  */
 class JustificationStrategy : public DecisionEngine
 {
@@ -219,6 +227,8 @@ class JustificationStrategy : public DecisionEngine
   JustifyCache d_jcache;
   /** A justify stack */
   JustifyStack d_stack;
+  /** The watched literals of justified assertions */
+  JustifyWatches d_watches;
   /** The last decision literal */
   context::CDO<TNode> d_lastDecisionLit;
   //------------------------------------ activity
@@ -231,6 +241,8 @@ class JustificationStrategy : public DecisionEngine
   bool d_useRlvOrder;
   /** using stop only */
   bool d_decisionStopOnly;
+  /** using watched literals of justified assertions */
+  bool d_useWatches;
   /** skolem mode */
   options::JutificationSkolemMode d_jhSkMode;
   /** skolem relevancy mode */
@@ -25,7 +25,10 @@ JustifyStatistics::JustifyStatistics(StatisticsRegistry& sr)
       d_numStatusBacktrack(sr.registerInt("JustifyStrategy::StatusBacktrack")),
       d_maxStackSize(sr.registerInt("JustifyStrategy::MaxStackSize")),
       d_maxAssertionsSize(sr.registerInt("JustifyStrategy::MaxAssertionsSize")),
-      d_maxSkolemDefsSize(sr.registerInt("JustifyStrategy::MaxSkolemDefsSize"))
+      d_maxSkolemDefsSize(sr.registerInt("JustifyStrategy::MaxSkolemDefsSize")),
+      d_numWatchedJustified(
+          sr.registerInt("JustifyStrategy::WatchedJustified")),
+      d_numWatchEvaluated(sr.registerInt("JustifyStrategy::WatchEvaluated"))
 {
 }
 
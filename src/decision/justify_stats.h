@@ -40,6 +40,16 @@ class JustifyStatistics
   IntStat d_maxAssertionsSize;
   /** Maximum skolem definition size we considered */
   IntStat d_maxSkolemDefsSize;
+  /**
+   * Number of times we skipped an assertion since its watched literals were
+   * still true
+   */
+  IntStat d_numWatchedJustified;
+  /**
+   * Number of subformulas evaluated when computing watched literals, since
+   * they were not justified in the justification cache
+   */
+  IntStat d_numWatchEvaluated;
 };
 
 }
@@ -0,0 +1,320 @@
+/******************************************************************************
+ * Top contributors (to current version):
+ *   agent
+ *
+ * This file is part of the cvc5 project.
+ *
+ * Copyright (c) 2009-2023 by the authors listed in the file AUTHORS
+ * in the top-level source directory and their institutional affiliations.
+ * All rights reserved.  See the file COPYING in the top-level source
+ * directory for licensing information.
+ * ****************************************************************************
+ *
+ * Watched literals of justified assertions
+ */
+
+#include "decision/justify_watches.h"
+
+#include <unordered_set>
+
+#include "expr/node_algorithm.h"
+
+using namespace cvc5::internal::kind;
+using namespace cvc5::internal::prop;
+
+namespace cvc5::internal {
+namespace decision {
+
+JustifyWatches::JustifyWatches(prop::CDCLTSatSolver* ss,
+                               prop::CnfStream* cs,
+                               JustifyCache* jc)
+    : d_satSolver(ss), d_cnfStream(cs), d_jcache(jc)
+{
+}
+
+size_t JustifyWatches::watch(TNode n)
+{
+  // the values of the subformulas looked up so far
+  std::unordered_map<TNode, SatValue> values;
+  size_t nevals = 0;
+  if (getValue(n, values, nevals) != SAT_VALUE_TRUE)
+  {
+    Trace("jh-watch") << "...no watches for " << n << std::endl;
+    d_watches.erase(n);
+    return nevals;
+  }
+  // Collect the theory literals that suffice to make n true. Each subformula
+  // visited here has a value, which is forced by the children we visit. We
+  // only look up the values of the children we need to find these.
+  std::vector<SatLiteral>& lits = d_watches[n];
+  lits.clear();
+  std::unordered_set<TNode> visited;
+  std::vector<TNode> visit{n};
+  TNode cur;
+  do
+  {
+    cur = visit.back();
+    visit.pop_back();
+    if (!visited.insert(cur).second)
+    {
+      continue;
+    }
+    Kind k = cur.getKind();
+    if (k == NOT)
+    {
+      visit.push_back(cur[0]);
+      continue;
+    }
+    SatValue val = getValue(cur, values, nevals);
+    Assert(val != SAT_VALUE_UNKNOWN);
+    if (expr::isTheoryAtom(cur))
+    {
+      SatLiteral lit = d_cnfStream->getLiteral(cur);
+      lits.push_back(val == SAT_VALUE_TRUE ? lit : ~lit);
+    }
+    else if ((k == AND && val == SAT_VALUE_FALSE)
+             || (k == OR && val == SAT_VALUE_TRUE))
+    {
+      // a single child that forces the value, where we prefer a child whose
+      // value is known without evaluating it, e.g. the child that justified
+      // cur
+      TNode forcing;
+      for (const Node& c : cur)
+      {
+        if (lookupValue(c, values) == val)
+        {
+          forcing = c;
+          break;
+        }
+      }
+      for (size_t i = 0, nchild = cur.getNumChildren();
+           forcing.isNull() && i < nchild;
+           i++)
+      {
+        if (getValue(cur[i], values, nevals) == val)
+        {
+          forcing = cur[i];
+        }
+      }
+      if (!forcing.isNull())
+      {
+        visit.push_back(forcing);
+      }
+    }
+    else if (k == IMPLIES && val == SAT_VALUE_TRUE)
+    {
+      // either the antecedent is false or the conclusion is true
+      if (getValue(cur[0], values, nevals) == SAT_VALUE_FALSE)
+      {
+        visit.push_back(cur[0]);
+      }
+      else
+      {
+        visit.push_back(cur[1]);
+      }
+    }
+    else if (k == ITE)
+    {
+      SatValue cv = getValue(cur[0], values, nevals);
+      if (cv == SAT_VALUE_UNKNOWN)
+      {
+        // both branches have the same value
+        visit.push_back(cur[1]);
+        visit.push_back(cur[2]);
+      }
+      else
+      {
+        visit.push_back(cur[0]);
+        visit.push_back(cv == SAT_VALUE_TRUE ? cur[1] : cur[2]);
+      }
+    }
+    else
+    {
+      // all children are required
+      visit.insert(visit.end(), cur.begin(), cur.end());
+    }
+  } while (!visit.empty());
+  Trace("jh-watch") << "...watch " << lits.size() << " literals for " << n
+                    << ", evaluated " << nevals << " subformulas" << std::endl;
+  return nevals;
+}
+
+bool JustifyWatches::isWatchedTrue(TNode n) const
+{
+  std::unordered_map<Node, std::vector<SatLiteral>>::const_iterator it =
+      d_watches.find(n);
+  if (it == d_watches.end())
+  {
+    return false;
+  }
+  for (const SatLiteral& lit : it->second)
+  {
+    if (d_satSolver->value(lit) != SAT_VALUE_TRUE)
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+void JustifyWatches::clear() { d_watches.clear(); }
+
+SatValue JustifyWatches::lookupValue(
+    TNode n, const std::unordered_map<TNode, SatValue>& values)
+{
+  bool pol = n.getKind() != NOT;
+  TNode atom = pol ? n : n[0];
+  std::unordered_map<TNode, SatValue>::const_iterator it = values.find(atom);
+  SatValue val;
+  if (it != values.end())
+  {
+    val = it->second;
+  }
+  else if (expr::isTheoryAtom(atom))
+  {
+    val = getAtomValue(atom);
+  }
+  else
+  {
+    val = d_jcache->lookupValue(atom);
+  }
+  return pol ? val : invertValue(val);
+}
+
+SatValue JustifyWatches::getValue(TNode n,
+                                  std::unordered_map<TNode, SatValue>& values,
+                                  size_t& nevals)
+{
+  bool pol = n.getKind() != NOT;
+  TNode atom = pol ? n : n[0];
+  std::unordered_map<TNode, SatValue>::iterator it = values.find(atom);
+  SatValue val =
+      it != values.end() ? it->second : evaluate(atom, values, nevals);
+  return pol ? val : invertValue(val);
+}
+
+SatValue JustifyWatches::evaluate(TNode n,
+                                  std::unordered_map<TNode, SatValue>& values,
+                                  size_t& nevals)
+{
+  std::unordered_map<TNode, SatValue>::iterator it;
+  std::vector<TNode> visit;
+  TNode cur;
+  visit.push_back(n.getKind() == NOT ? n[0] : n);
+  do
+  {
+    cur = visit.back();
+    it = values.find(cur);
+    if (it != values.end() && it->second != SAT_VALUE_UNKNOWN)
+    {
+      visit.pop_back();
+      continue;
+    }
+    if (expr::isTheoryAtom(cur))
+    {
+      visit.pop_back();
+      values[cur] = getAtomValue(cur);
+      continue;
+    }
+    if (it == values.end())
+    {
+      // subformulas justified by the justification strategy have a value in
+      // its cache, which we use instead of traversing them
+      SatValue jval = d_jcache->lookupValue(cur);
+      if (jval != SAT_VALUE_UNKNOWN)
+      {
+        visit.pop_back();
+        values[cur] = jval;
+        continue;
+      }
+      // mark as visited with an unknown value, and visit the children first
+      values[cur] = SAT_VALUE_UNKNOWN;
+      for (const Node& c : cur)
+      {
+        visit.push_back(c.getKind() == NOT ? c[0] : c);
+      }
+      continue;
+    }
+    visit.pop_back();
+    // the values of the children, where negations are taken into account
+    std::vector<SatValue> cvals;
+    for (const Node& c : cur)
+    {
+      bool cpol = c.getKind() != NOT;
+      SatValue cv = values[cpol ? c : c[0]];
+      cvals.push_back(cpol ? cv : invertValue(cv));
+    }
+    SatValue val = SAT_VALUE_UNKNOWN;
+    switch (cur.getKind())
+    {
+      case AND:
+      case OR:
+      {
+        // the value that forces the value of cur
+        SatValue forcing =
+            cur.getKind() == AND ? SAT_VALUE_FALSE : SAT_VALUE_TRUE;
+        bool allKnown = true;
+        for (SatValue cv : cvals)
+        {
+          if (cv == forcing)
+          {
+            val = forcing;
+            break;
+          }
+          allKnown = allKnown && cv != SAT_VALUE_UNKNOWN;
+        }
+        if (val == SAT_VALUE_UNKNOWN && allKnown)
+        {
+          val = invertValue(forcing);
+        }
+      }
+      break;
+      case IMPLIES:
+        if (cvals[0] == SAT_VALUE_FALSE || cvals[1] == SAT_VALUE_TRUE)
+        {
+          val = SAT_VALUE_TRUE;
+        }
+        else if (cvals[0] == SAT_VALUE_TRUE && cvals[1] == SAT_VALUE_FALSE)
+        {
+          val = SAT_VALUE_FALSE;
+        }
+        break;
+      case ITE:
+        if (cvals[0] != SAT_VALUE_UNKNOWN)
+        {
+          val = cvals[0] == SAT_VALUE_TRUE ? cvals[1] : cvals[2];
+        }
+        else if (cvals[1] == cvals[2])
+        {
+          val = cvals[1];
+        }
+        break;
+      case XOR:
+      case EQUAL:
+        if (cvals[0] != SAT_VALUE_UNKNOWN && cvals[1] != SAT_VALUE_UNKNOWN)
+        {
+          val = ((cvals[0] == cvals[1]) == (cur.getKind() == EQUAL))
+                    ? SAT_VALUE_TRUE
+                    : SAT_VALUE_FALSE;
+        }
+        break;
+      default: Unreachable() << "Unexpected kind " << cur.getKind();
+    }
+    values[cur] = val;
+    nevals++;
+  } while (!visit.empty());
+  SatValue val = values[n.getKind() == NOT ? n[0] : n];
+  return n.getKind() == NOT ? invertValue(val) : val;
+}
+
+SatValue JustifyWatches::getAtomValue(TNode n) const
+{
+  if (!d_cnfStream->hasLiteral(n))
+  {
+    return SAT_VALUE_UNKNOWN;
+  }
+  return d_satSolver->value(d_cnfStream->getLiteral(n));
+}
+
+}  // namespace decision
+}  // namespace cvc5::internal
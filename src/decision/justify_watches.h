@@ -0,0 +1,121 @@
+/******************************************************************************
+ * Top contributors (to current version):
+ *   agent
+ *
+ * This file is part of the cvc5 project.
+ *
+ * Copyright (c) 2009-2023 by the authors listed in the file AUTHORS
+ * in the top-level source directory and their institutional affiliations.
+ * All rights reserved.  See the file COPYING in the top-level source
+ * directory for licensing information.
+ * ****************************************************************************
+ *
+ * Watched literals of justified assertions
+ */
+
+#include "cvc5_private.h"
+
+#ifndef CVC5__DECISION__JUSTIFY_WATCHES_H
+#define CVC5__DECISION__JUSTIFY_WATCHES_H
+
+#include <unordered_map>
+#include <vector>
+
+#include "decision/justify_cache.h"
+#include "expr/node.h"
+#include "prop/cnf_stream.h"
+#include "prop/sat_solver.h"
+#include "prop/sat_solver_types.h"
+
+namespace cvc5::internal {
+namespace decision {
+
+/**
+ * Remembers, for formulas that were justified, a set of literals whose
+ * values suffice to make the formula true. We call these the watched literals
+ * of the formula.
+ *
+ * The justification of a formula is SAT-context dependent (see JustifyCache),
+ * hence after backtracking, the justification heuristic would traverse the
+ * formula again. However, backtracking often does not unassign the literals
+ * that the formula depends on, e.g. the single true child of a disjunction.
+ * This class is context-independent, and allows to check whether the
+ * watched literals of a formula are still true, in which case it need not be
+ * traversed again.
+ *
+ * For example, if (or (and A B) C) is justified by C, its watched literals
+ * are { C }. If we backtrack to a level where C is still true, the formula
+ * is still justified, regardless of whether A and B are assigned.
+ */
+class JustifyWatches
+{
+ public:
+  JustifyWatches(prop::CDCLTSatSolver* ss,
+                 prop::CnfStream* cs,
+                 JustifyCache* jc);
+  /**
+   * Compute and store the watched literals for n, which should evaluate to
+   * true in the current assignment of the theory literals of n. If n does not
+   * evaluate to true, its watched literals are removed.
+   *
+   * The watched literals are collected by following the children that force
+   * the value of each subformula. The values of the subformulas are taken
+   * from the justification cache, which has the values of those that were
+   * justified when justifying n. Only the subformulas without a value in the
+   * cache are evaluated.
+   *
+   * @return the number of subformulas that were evaluated.
+   */
+  size_t watch(TNode n);
+  /** Are all watched literals of n true in the current assignment? */
+  bool isWatchedTrue(TNode n) const;
+  /** Remove all watched literals */
+  void clear();
+
+ private:
+  /**
+   * Get the value of n, which may be negated, if it is known without
+   * evaluating n, i.e. if it is in values, n is a theory literal or n has a
+   * value in the justification cache. Returns UNKNOWN otherwise.
+   */
+  prop::SatValue lookupValue(
+      TNode n, const std::unordered_map<TNode, prop::SatValue>& values);
+  /**
+   * Get the value of n, which may be negated, where values caches the values
+   * of the non-negated subformulas looked up so far. Evaluates n if its value
+   * is not cached, incrementing nevals for each evaluated subformula.
+   */
+  prop::SatValue getValue(TNode n,
+                          std::unordered_map<TNode, prop::SatValue>& values,
+                          size_t& nevals);
+  /**
+   * Evaluate n based on the current assignment of its theory literals,
+   * storing the values of the subformulas of n in values. Subformulas with a
+   * value in the justification cache are not traversed. Increments nevals
+   * for each subformula whose value is computed from its children.
+   */
+  prop::SatValue evaluate(TNode n,
+                          std::unordered_map<TNode, prop::SatValue>& values,
+                          size_t& nevals);
+  /**
+   * Get the value of theory atom n in the current assignment, or UNKNOWN if
+   * n does not have a literal.
+   */
+  prop::SatValue getAtomValue(TNode n) const;
+  /** Pointer to the SAT solver */
+  prop::CDCLTSatSolver* d_satSolver;
+  /** Pointer to the CNF stream */
+  prop::CnfStream* d_cnfStream;
+  /** Pointer to the justification cache */
+  JustifyCache* d_jcache;
+  /**
+   * Maps formulas to the literals that are true in the assignment in which
+   * they were justified.
+   */
+  std::unordered_map<Node, std::vector<prop::SatLiteral>> d_watches;
+};
+
+}  // namespace decision
+}  // namespace cvc5::internal
+
+#endif /* CVC5__DECISION__JUSTIFY_WATCHES_H */
@@ -536,12 +536,14 @@ void AttributeManager::reconstructTable(AttrHash<T>& table){
 template <class AttrKind>
 inline typename AttrKind::value_type
 NodeManager::getAttribute(expr::NodeValue* nv, const AttrKind&) const {
+  SharedLock lock(this);
   return d_attrManager->getAttribute(nv, AttrKind());
 }
 
 template <class AttrKind>
 inline bool NodeManager::hasAttribute(expr::NodeValue* nv,
                                       const AttrKind&) const {
+  SharedLock lock(this);
   return d_attrManager->hasAttribute(nv, AttrKind());
 }
 
@@ -549,6 +551,7 @@ template <class AttrKind>
 inline bool
 NodeManager::getAttribute(expr::NodeValue* nv, const AttrKind&,
                           typename AttrKind::value_type& ret) const {
+  SharedLock lock(this);
   return d_attrManager->getAttribute(nv, AttrKind(), ret);
 }
 
@@ -556,18 +559,21 @@ template <class AttrKind>
 inline void
 NodeManager::setAttribute(expr::NodeValue* nv, const AttrKind&,
                           const typename AttrKind::value_type& value) {
+  SharedLock lock(this);
   d_attrManager->setAttribute(nv, AttrKind(), value);
 }
 
 template <class AttrKind>
 inline typename AttrKind::value_type
 NodeManager::getAttribute(TNode n, const AttrKind&) const {
+  SharedLock lock(this);
   return d_attrManager->getAttribute(n.d_nv, AttrKind());
 }
 
 template <class AttrKind>
 inline bool
 NodeManager::hasAttribute(TNode n, const AttrKind&) const {
+  SharedLock lock(this);
   return d_attrManager->hasAttribute(n.d_nv, AttrKind());
 }
 
@@ -575,6 +581,7 @@ template <class AttrKind>
 inline bool
 NodeManager::getAttribute(TNode n, const AttrKind&,
                           typename AttrKind::value_type& ret) const {
+  SharedLock lock(this);
   return d_attrManager->getAttribute(n.d_nv, AttrKind(), ret);
 }
 
@@ -582,18 +589,21 @@ template <class AttrKind>
 inline void
 NodeManager::setAttribute(TNode n, const AttrKind&,
                           const typename AttrKind::value_type& value) {
+  SharedLock lock(this);
   d_attrManager->setAttribute(n.d_nv, AttrKind(), value);
 }
 
 template <class AttrKind>
 inline typename AttrKind::value_type
 NodeManager::getAttribute(TypeNode n, const AttrKind&) const {
+  SharedLock lock(this);
   return d_attrManager->getAttribute(n.d_nv, AttrKind());
 }
 
 template <class AttrKind>
 inline bool
 NodeManager::hasAttribute(TypeNode n, const AttrKind&) const {
+  SharedLock lock(this);
   return d_attrManager->hasAttribute(n.d_nv, AttrKind());
 }
 
@@ -601,6 +611,7 @@ template <class AttrKind>
 inline bool
 NodeManager::getAttribute(TypeNode n, const AttrKind&,
                           typename AttrKind::value_type& ret) const {
+  SharedLock lock(this);
   return d_attrManager->getAttribute(n.d_nv, AttrKind(), ret);
 }
 
@@ -608,6 +619,7 @@ template <class AttrKind>
 inline void
 NodeManager::setAttribute(TypeNode n, const AttrKind&,
                           const typename AttrKind::value_type& value) {
+  SharedLock lock(this);
   d_attrManager->setAttribute(n.d_nv, AttrKind(), value);
 }
 
@@ -57,6 +57,7 @@ class BoundVarManager
   template <class T>
   Node mkBoundVar(Node n, TypeNode tn)
   {
+    NodeManager::SharedLock lock(NodeManager::currentNM());
     T attr;
     if (n.hasAttribute(attr))
     {
@@ -18,6 +18,7 @@
 
 #include "expr/dtype_cons.h"
 #include "expr/node_algorithm.h"
+#include "expr/node_manager.h"
 #include "expr/skolem_manager.h"
 #include "expr/type_matcher.h"
 #include "util/rational.h"
@@ -360,6 +361,7 @@ void DType::setRecord()
 
 Cardinality DType::getCardinality(TypeNode t) const
 {
+  NodeManager::SharedLock lock(NodeManager::currentNM());
   Trace("datatypes-init") << "DType::getCardinality " << std::endl;
   Assert(isResolved());
   Assert(t.isDatatype() && t.getDType().getTypeNode() == d_self);
@@ -370,6 +372,7 @@ Cardinality DType::getCardinality(TypeNode t) const
 
 Cardinality DType::getCardinality() const
 {
+  NodeManager::SharedLock lock(NodeManager::currentNM());
   Assert(!isParametric());
   return getCardinality(d_self);
 }
@@ -398,6 +401,7 @@ Cardinality DType::computeCardinality(TypeNode t,
 
 bool DType::isRecursiveSingleton(TypeNode t) const
 {
+  NodeManager::SharedLock lock(NodeManager::currentNM());
   Trace("datatypes-init") << "DType::isRecursiveSingleton " << std::endl;
   Assert(isResolved());
   Assert(t.isDatatype() && t.getDType().getTypeNode() == d_self);
@@ -445,6 +449,7 @@ bool DType::isRecursiveSingleton() const
 
 unsigned DType::getNumRecursiveSingletonArgTypes(TypeNode t) const
 {
+  NodeManager::SharedLock lock(NodeManager::currentNM());
   Assert(d_cardRecSingleton.find(t) != d_cardRecSingleton.end());
   Assert(isRecursiveSingleton(t));
   return d_cardUAssume[t].size();
@@ -458,6 +463,7 @@ unsigned DType::getNumRecursiveSingletonArgTypes() const
 
 TypeNode DType::getRecursiveSingletonArgType(TypeNode t, size_t i) const
 {
+  NodeManager::SharedLock lock(NodeManager::currentNM());
   Assert(d_cardRecSingleton.find(t) != d_cardRecSingleton.end());
   Assert(isRecursiveSingleton(t));
   return d_cardUAssume[t][i];
@@ -541,6 +547,7 @@ bool DType::computeCardinalityRecSingleton(
 
 CardinalityClass DType::getCardinalityClass(TypeNode t) const
 {
+  NodeManager::SharedLock lock(NodeManager::currentNM());
   Trace("datatypes-init") << "DType::isFinite " << std::endl;
   Assert(isResolved());
   Assert(t.isDatatype() && t.getDType().getTypeNode() == d_self);
@@ -581,6 +588,7 @@ bool DType::isFinite(bool fmfEnabled) const
 
 bool DType::isWellFounded() const
 {
+  NodeManager::SharedLock lock(NodeManager::currentNM());
   Assert(isResolved());
   if (d_wellFounded != 0)
   {
@@ -649,6 +657,7 @@ Node DType::mkGroundValue(TypeNode t) const
 
 Node DType::mkGroundTermInternal(TypeNode t, bool isValue) const
 {
+  NodeManager::SharedLock lock(NodeManager::currentNM());
   Trace("datatypes-init") << "DType::mkGroundTerm of type " << t
                           << ", isValue = " << isValue << std::endl;
   // is this already in the cache ?
@@ -751,6 +760,7 @@ void DType::getAlienSubfieldTypes(std::unordered_set<TypeNode>& types,
 
 bool DType::hasNestedRecursion() const
 {
+  NodeManager::SharedLock lock(NodeManager::currentNM());
   if (d_nestedRecursion != 0)
   {
     return d_nestedRecursion == 1;
@@ -893,6 +903,7 @@ const DTypeConstructor& DType::operator[](size_t index) const
 
 Node DType::getSharedSelector(TypeNode dtt, TypeNode t, size_t index) const
 {
+  NodeManager::SharedLock lock(NodeManager::currentNM());
   Assert(isResolved());
   std::map<TypeNode, std::map<TypeNode, std::map<unsigned, Node> > >::iterator
       itd = d_sharedSel.find(dtt);
@@ -591,6 +591,12 @@ class DType
   /** whether all terms are allowed as solutions */
   bool d_sygusAllowAll;
 
+  /*
+   * The caches below are filled on demand by const methods. Since datatypes
+   * may be used by solvers in different threads if their node manager is
+   * shared, these methods access the caches while holding a
+   * NodeManager::SharedLock.
+   */
   /** the cardinality of this datatype
    * "mutable" because computing the cardinality can be expensive,
    * and so it's computed just once, on demand---this is the cache
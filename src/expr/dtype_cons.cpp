@@ -212,6 +212,7 @@ bool DTypeConstructor::hasFiniteExternalArgType(TypeNode t) const
 std::pair<CardinalityClass, bool> DTypeConstructor::computeCardinalityInfo(
     TypeNode t) const
 {
+  NodeManager::SharedLock lock(NodeManager::currentNM());
   std::map<TypeNode, std::pair<CardinalityClass, bool> >::iterator it =
       d_cardInfo.find(t);
   if (it != d_cardInfo.end())
@@ -276,6 +277,7 @@ Node DTypeConstructor::getSelector(size_t index) const
 Node DTypeConstructor::getSharedSelector(TypeNode domainType,
                                          size_t index) const
 {
+  NodeManager::SharedLock lock(NodeManager::currentNM());
   Assert(isResolved());
   Assert(index < getNumArgs());
   computeSharedSelectors(domainType);
@@ -285,6 +287,7 @@ Node DTypeConstructor::getSharedSelector(TypeNode domainType,
 
 int DTypeConstructor::getSelectorIndexInternal(Node sel) const
 {
+  NodeManager::SharedLock lock(NodeManager::currentNM());
   Assert(isResolved());
   Assert(sel.getType().isDatatypeSelector());
   // might be a builtin selector
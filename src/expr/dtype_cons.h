@@ -325,6 +325,10 @@ class DTypeConstructor
   Node d_sygusOp;
   /** weight */
   unsigned d_weight;
+  /*
+   * The caches below are filled on demand by const methods, which hold a
+   * NodeManager::SharedLock (see DType).
+   */
   /** shared selectors for each type
    *
    * This stores the shared (constructor-agnotic)
@@ -217,7 +217,7 @@ class NodeTemplate {
   inline void assertTNodeNotExpired() const
   {
     if(!ref_count) {
-      Assert(d_nv->d_rc > 0) << "TNode pointing to an expired NodeValue";
+      Assert(d_nv->getRefCount() > 0) << "TNode pointing to an expired NodeValue";
     }
   }
 
@@ -1030,7 +1030,7 @@ NodeTemplate<ref_count>::NodeTemplate(const expr::NodeValue* ev) :
   if(ref_count) {
     d_nv->inc();
   } else {
-    Assert(d_nv->d_rc > 0 || d_nv == &expr::NodeValue::null())
+    Assert(d_nv->getRefCount() > 0 || d_nv == &expr::NodeValue::null())
         << "TNode constructed from NodeValue with rc == 0";
   }
 }
@@ -1044,11 +1044,11 @@ NodeTemplate<ref_count>::NodeTemplate(const NodeTemplate<!ref_count>& e) {
   Assert(e.d_nv != NULL) << "Expecting a non-NULL expression value!";
   d_nv = e.d_nv;
   if(ref_count) {
-    Assert(d_nv->d_rc > 0) << "Node constructed from TNode with rc == 0";
+    Assert(d_nv->getRefCount() > 0) << "Node constructed from TNode with rc == 0";
     d_nv->inc();
   } else {
     // shouldn't ever fail
-    Assert(d_nv->d_rc > 0) << "TNode constructed from Node with rc == 0";
+    Assert(d_nv->getRefCount() > 0) << "TNode constructed from Node with rc == 0";
   }
 }
 
@@ -1058,10 +1058,10 @@ NodeTemplate<ref_count>::NodeTemplate(const NodeTemplate& e) {
   d_nv = e.d_nv;
   if(ref_count) {
     // shouldn't ever fail
-    Assert(d_nv->d_rc > 0) << "Node constructed from Node with rc == 0";
+    Assert(d_nv->getRefCount() > 0) << "Node constructed from Node with rc == 0";
     d_nv->inc();
   } else {
-    Assert(d_nv->d_rc > 0) << "TNode constructed from TNode with rc == 0";
+    Assert(d_nv->getRefCount() > 0) << "TNode constructed from TNode with rc == 0";
   }
 }
 
@@ -1070,7 +1070,7 @@ NodeTemplate<ref_count>::~NodeTemplate() {
   Assert(d_nv != NULL) << "Expecting a non-NULL expression value!";
   if(ref_count) {
     // shouldn't ever fail
-    Assert(d_nv->d_rc > 0) << "Node reference count would be negative";
+    Assert(d_nv->getRefCount() > 0) << "Node reference count would be negative";
     d_nv->dec();
   }
 }
@@ -1081,7 +1081,7 @@ void NodeTemplate<ref_count>::assignNodeValue(expr::NodeValue* ev) {
   if(ref_count) {
     d_nv->inc();
   } else {
-    Assert(d_nv->d_rc > 0) << "TNode assigned to NodeValue with rc == 0";
+    Assert(d_nv->getRefCount() > 0) << "TNode assigned to NodeValue with rc == 0";
   }
 }
 
@@ -1093,16 +1093,16 @@ operator=(const NodeTemplate& e) {
   if(__builtin_expect( ( d_nv != e.d_nv ), true )) {
     if(ref_count) {
       // shouldn't ever fail
-      Assert(d_nv->d_rc > 0) << "Node reference count would be negative";
+      Assert(d_nv->getRefCount() > 0) << "Node reference count would be negative";
       d_nv->dec();
     }
     d_nv = e.d_nv;
     if(ref_count) {
       // shouldn't ever fail
-      Assert(d_nv->d_rc > 0) << "Node assigned from Node with rc == 0";
+      Assert(d_nv->getRefCount() > 0) << "Node assigned from Node with rc == 0";
       d_nv->inc();
     } else {
-      Assert(d_nv->d_rc > 0) << "TNode assigned from TNode with rc == 0";
+      Assert(d_nv->getRefCount() > 0) << "TNode assigned from TNode with rc == 0";
     }
   }
   return *this;
@@ -1116,16 +1116,16 @@ operator=(const NodeTemplate<!ref_count>& e) {
   if(__builtin_expect( ( d_nv != e.d_nv ), true )) {
     if(ref_count) {
       // shouldn't ever fail
-      Assert(d_nv->d_rc > 0) << "Node reference count would be negative";
+      Assert(d_nv->getRefCount() > 0) << "Node reference count would be negative";
       d_nv->dec();
     }
     d_nv = e.d_nv;
     if(ref_count) {
-      Assert(d_nv->d_rc > 0) << "Node assigned from TNode with rc == 0";
+      Assert(d_nv->getRefCount() > 0) << "Node assigned from TNode with rc == 0";
       d_nv->inc();
     } else {
       // shouldn't ever happen
-      Assert(d_nv->d_rc > 0) << "TNode assigned from Node with rc == 0";
+      Assert(d_nv->getRefCount() > 0) << "TNode assigned from Node with rc == 0";
     }
   }
   return *this;
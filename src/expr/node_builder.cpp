@@ -358,18 +358,30 @@ void NodeBuilder::decrRefCounts()
   d_inlineNv.d_nchildren = 0;
 }
 
-TypeNode NodeBuilder::constructTypeNode() { return TypeNode(constructNV()); }
+TypeNode NodeBuilder::constructTypeNode()
+{
+  NodeManager::SharedLock lock(d_nm);
+  return TypeNode(constructNV());
+}
 
 Node NodeBuilder::constructNode()
 {
-  Node n(constructNV());
+  Node n;
+  {
+    NodeManager::SharedLock lock(d_nm);
+    n = Node(constructNV());
+  }
   maybeCheckType(n);
   return n;
 }
 
 Node* NodeBuilder::constructNodePtr()
 {
-  std::unique_ptr<Node> np(new Node(constructNV()));
+  std::unique_ptr<Node> np;
+  {
+    NodeManager::SharedLock lock(d_nm);
+    np.reset(new Node(constructNV()));
+  }
   maybeCheckType(*np.get());
   return np.release();
 }
@@ -405,18 +417,14 @@ expr::NodeValue* NodeBuilder::constructNV()
            "no children permitted";
 
     // we have to copy the inline NodeValue out
-    expr::NodeValue* nv =
-        (expr::NodeValue*)std::malloc(sizeof(expr::NodeValue));
-    if (nv == nullptr)
-    {
-      throw std::bad_alloc();
-    }
+    expr::NodeValue* nv = d_nm->allocateNodeValue(0);
     // there are no children, so we don't have to worry about
     // reference counts in this case.
     nv->d_nchildren = 0;
     nv->d_kind = d_nv->d_kind;
     nv->d_id = d_nm->d_nextId++;
     nv->d_rc = 0;
+    d_nm->notifyNewNodeValue(nv);
     setUsed();
     if (TraceIsOn("gc"))
     {
@@ -488,13 +496,8 @@ expr::NodeValue* NodeBuilder::constructNV()
        * reference count. */
 
       // create the canonical expression value for this node
-      expr::NodeValue* nv = (expr::NodeValue*)std::malloc(
-          sizeof(expr::NodeValue)
-          + (sizeof(expr::NodeValue*) * d_inlineNv.d_nchildren));
-      if (nv == nullptr)
-      {
-        throw std::bad_alloc();
-      }
+      expr::NodeValue* nv =
+          d_nm->allocateNodeValue(d_inlineNv.d_nchildren);
       nv->d_nchildren = d_inlineNv.d_nchildren;
       nv->d_kind = d_inlineNv.d_kind;
       nv->d_id = d_nm->d_nextId++;
@@ -509,6 +512,7 @@ expr::NodeValue* NodeBuilder::constructNV()
 
       // poolNv = nv;
       d_nm->poolInsert(nv);
+      d_nm->notifyNewNodeValue(nv);
       if (TraceIsOn("gc"))
       {
         Trace("gc") << "creating node value " << nv << " [" << nv->d_id
@@ -553,10 +557,32 @@ expr::NodeValue* NodeBuilder::constructNV()
        * d_nv is repointed to d_inlineNv so that destruction of the
        * NodeBuilder doesn't cause any problems, and the (old) value
        * it had is placed into the NodeManager's pool and returned in
-       * a Node wrapper. */
+       * a Node wrapper.  If the NodeManager allocates node values with
+       * this number of children in its arena, d_nv is instead copied
+       * into the arena and freed. */
 
-      crop();
-      expr::NodeValue* nv = d_nv;
+      expr::NodeValue* nv;
+      if (expr::NodeValueArena::isArenaAllocated(d_nv->d_nchildren))
+      {
+        nv = d_nm->allocateNodeValue(d_nv->d_nchildren);
+        nv->d_nchildren = d_nv->d_nchildren;
+        nv->d_kind = d_nv->d_kind;
+        nv->d_rc = 0;
+        std::copy(d_nv->d_children,
+                  d_nv->d_children + d_nv->d_nchildren,
+                  nv->d_children);
+        // the reference counts of the children are taken over by nv
+        free(d_nv);
+      }
+      else
+      {
+        crop();
+        nv = d_nv;
+        // nv is freed by the node manager, which accounts for its memory
+        d_nm->d_mallocNodeValueBytes +=
+            sizeof(expr::NodeValue)
+            + sizeof(expr::NodeValue*) * nv->d_nchildren;
+      }
       nv->d_id = d_nm->d_nextId++;
       d_nv = &d_inlineNv;
       d_nvMaxChildren = default_nchild_thresh;
@@ -564,6 +590,7 @@ expr::NodeValue* NodeBuilder::constructNV()
 
       // poolNv = nv;
       d_nm->poolInsert(nv);
+      d_nm->notifyNewNodeValue(nv);
       Trace("gc") << "creating node value " << nv << " [" << nv->d_id
                   << "]: " << *nv << "\n";
       return nv;
@@ -359,7 +359,12 @@ class NodeBuilder {
    */
   void crop();
 
-  /** Construct the node value out of the node builder */
+  /**
+   * Construct the node value out of the node builder. Must be called while
+   * holding a NodeManager::SharedLock, which serializes hash-consing and must
+   * be held until the node value is referenced, since otherwise a zombie that
+   * is found in the pool may be reclaimed by another thread.
+   */
   expr::NodeValue* constructNV();
 
 #ifdef CVC5_DEBUG
@@ -106,9 +106,13 @@ struct LambdaBoundVarListTag
 typedef expr::Attribute<attr::LambdaBoundVarListTag, Node>
     LambdaBoundVarListAttr;
 
-NodeManager::NodeManager()
-    : d_skManager(new SkolemManager),
+thread_local NodeManager* NodeManager::s_current = nullptr;
+
+NodeManager::NodeManager(bool shared)
+    : d_shared(shared),
+      d_skManager(new SkolemManager),
       d_bvManager(new BoundVarManager),
+      d_mallocNodeValueBytes(0),
       d_nextId(0),
       d_attrManager(new expr::attr::AttributeManager()),
       d_nodeUnderDeletion(nullptr),
@@ -129,6 +133,10 @@ NodeManager::NodeManager()
 
 NodeManager* NodeManager::currentNM()
 {
+  if (s_current != nullptr)
+  {
+    return s_current;
+  }
   thread_local static NodeManager nm;
   return &nm;
 }
@@ -275,13 +283,12 @@ NodeManager::~NodeManager()
   if (TraceIsOn("gc:leaks"))
   {
     Trace("gc:leaks") << "still in pool:" << endl;
-    for (NodeValuePool::const_iterator i = d_nodeValuePool.begin(),
-                                       iend = d_nodeValuePool.end();
-         i != iend;
-         ++i)
+    std::vector<NodeValue*> nvs;
+    d_nodeValuePool.getNodeValues(nvs);
+    for (NodeValue* nv : nvs)
     {
-      Trace("gc:leaks") << "  " << *i << " id=" << (*i)->d_id
-                        << " rc=" << (*i)->d_rc << " " << **i << endl;
+      Trace("gc:leaks") << "  " << nv << " id=" << nv->d_id
+                        << " rc=" << nv->d_rc << " " << *nv << endl;
     }
     Trace("gc:leaks") << ":end:" << endl;
   }
@@ -317,6 +324,7 @@ const DType& NodeManager::getDTypeFor(Node n) const
 
 const DType& NodeManager::getDTypeForIndex(size_t index) const
 {
+  SharedLock lock(this);
   // if this assertion fails, it is likely due to not managing datatypes
   // properly w.r.t. multiple NodeManagers.
   Assert(index < d_dtypes.size());
@@ -325,7 +333,9 @@ const DType& NodeManager::getDTypeForIndex(size_t index) const
 
 void NodeManager::reclaimZombies()
 {
-  // FIXME multithreading
+  // If this node manager is shared, this is called while holding its lock,
+  // which is also required for resurrecting zombies (see
+  // NodeValue::incShared()).
   Assert(!d_attrManager->inGarbageCollection());
 
   Trace("gc") << "reclaiming " << d_zombies.size() << " zombie(s)!\n";
@@ -350,6 +360,10 @@ void NodeManager::reclaimZombies()
   // concurrently process d_zombies in the loop below, such addition
   // may be invisible to us (B is leaked) or even invalidate our
   // iterator, causing a crash.  So we need to copy the set away.
+  //
+  // The zombies are processed in bulk: we drop the ones that were
+  // resurrected, and remove duplicates by sorting them by identifier,
+  // which also makes the order of deletion deterministic.
 
   vector<NodeValue*> zombies;
   zombies.reserve(d_zombies.size());
@@ -358,23 +372,15 @@ void NodeManager::reclaimZombies()
                  back_inserter(zombies),
                  NodeValueReferenceCountNonZero());
   d_zombies.clear();
+  std::sort(zombies.begin(), zombies.end(), [](NodeValue* a, NodeValue* b) {
+    return a->d_id < b->d_id;
+  });
+  zombies.erase(std::unique(zombies.begin(), zombies.end()), zombies.end());
 
-#ifdef _LIBCPP_VERSION
-  NodeValue* last = NULL;
-#endif
   for (vector<NodeValue*>::iterator i = zombies.begin(); i != zombies.end();
        ++i)
   {
     NodeValue* nv = *i;
-#ifdef _LIBCPP_VERSION
-    // Work around an apparent bug in libc++'s hash_set<> which can
-    // (very occasionally) have an element repeated.
-    if (nv == last)
-    {
-      continue;
-    }
-    last = nv;
-#endif
 
     // collect ONLY IF still zero
     if (nv->d_rc == 0)
@@ -426,11 +432,56 @@ void NodeManager::reclaimZombies()
         // type for a constant payload.)
         kind::metakind::deleteNodeValueConstant(nv);
       }
-      free(nv);
+      deallocateNodeValue(nv);
     }
   }
 } /* NodeManager::reclaimZombies() */
 
+NodeValue* NodeManager::allocateNodeValue(uint32_t nchildren)
+{
+  if (expr::NodeValueArena::isArenaAllocated(nchildren))
+  {
+    return d_nodeValueArena.allocate(nchildren);
+  }
+  size_t size = sizeof(NodeValue) + sizeof(NodeValue*) * nchildren;
+  NodeValue* nv = static_cast<NodeValue*>(std::malloc(size));
+  if (nv == nullptr)
+  {
+    throw std::bad_alloc();
+  }
+  d_mallocNodeValueBytes += size;
+  return nv;
+}
+
+void NodeManager::deallocateNodeValue(NodeValue* nv)
+{
+  // constants are allocated by malloc, with their payload in place of the
+  // children
+  if (nv->getMetaKind() != kind::metakind::CONSTANT
+      && expr::NodeValueArena::isArenaAllocated(nv->d_nchildren))
+  {
+    d_nodeValueArena.deallocate(nv, nv->d_nchildren);
+    return;
+  }
+  if (nv->getMetaKind() == kind::metakind::CONSTANT)
+  {
+    d_mallocNodeValueBytes -= sizeof(NodeValue);
+  }
+  else
+  {
+    d_mallocNodeValueBytes -=
+        sizeof(NodeValue) + sizeof(NodeValue*) * nv->d_nchildren;
+  }
+  free(nv);
+}
+
+size_t NodeManager::getMemoryUsage() const
+{
+  SharedLock lock(this);
+  return d_nodeValueArena.getNumSlabs() * expr::NodeValueArena::SLAB_SIZE
+         + d_mallocNodeValueBytes;
+}
+
 std::vector<NodeValue*> NodeManager::TopologicalSort(
     const std::vector<NodeValue*>& roots)
 {
@@ -638,6 +689,7 @@ std::vector<TypeNode> NodeManager::mkMutualDatatypeTypesInternal(
     const std::vector<DType>& datatypes,
     const std::set<TypeNode>& unresolvedTypes)
 {
+  SharedLock lock(this);
   std::map<std::string, TypeNode> nameResolutions;
   std::vector<TypeNode> dtts;
 
@@ -926,11 +978,13 @@ TypeNode NodeManager::mkFunctionType(const std::vector<TypeNode>& argTypes,
 
 TypeNode NodeManager::mkTupleType(const std::vector<TypeNode>& types)
 {
+  SharedLock lock(this);
   return d_tt_cache.getTupleType(this, types);
 }
 
 TypeNode NodeManager::mkRecordType(const Record& rec)
 {
+  SharedLock lock(this);
   return d_rt_cache.getRecordType(this, rec);
 }
 
@@ -988,6 +1042,7 @@ TypeNode NodeManager::mkUnresolvedDatatypeSort(const std::string& name,
 
 Node NodeManager::mkOracle(Oracle& o)
 {
+  SharedLock lock(this);
   Node n = NodeBuilder(this, kind::ORACLE);
   n.setAttribute(TypeAttr(), builtinOperatorType());
   n.setAttribute(TypeCheckedAttr(), true);
@@ -1000,6 +1055,7 @@ Node NodeManager::mkOracle(Oracle& o)
 const Oracle& NodeManager::getOracleFor(const Node& n) const
 {
   Assert(n.getKind() == kind::ORACLE);
+  SharedLock lock(this);
   size_t index = n.getAttribute(OracleIndexAttr());
   Assert(index < d_oracles.size());
   return *d_oracles[index];
@@ -1024,6 +1080,7 @@ Node NodeManager::mkBoundVar(const std::string& name, const TypeNode& type)
 Node NodeManager::getBoundVarListForFunctionType(TypeNode tn)
 {
   Assert(tn.isFunction());
+  SharedLock lock(this);
   Node bvl = tn.getAttribute(LambdaBoundVarListAttr());
   if (bvl.isNull())
   {
@@ -1166,6 +1223,7 @@ Node NodeManager::mkRawSymbol(const std::string& name, const TypeNode& type)
 
 Node NodeManager::mkNullaryOperator(const TypeNode& type, Kind k)
 {
+  SharedLock lock(this);
   std::map<TypeNode, Node>::iterator it = d_unique_vars[k].find(type);
   if (it == d_unique_vars[k].end())
   {
@@ -1211,6 +1269,7 @@ TNode NodeManager::operatorOf(Kind k)
 template <class NodeClass, class T>
 NodeClass NodeManager::mkConstInternal(Kind k, const T& val)
 {
+  SharedLock lock(this);
   NVStorage<1> nvStorage;
   expr::NodeValue& nvStack = reinterpret_cast<expr::NodeValue&>(nvStorage);
 
@@ -1244,6 +1303,7 @@ NodeClass NodeManager::mkConstInternal(Kind k, const T& val)
   {
     throw std::bad_alloc();
   }
+  d_mallocNodeValueBytes += sizeof(expr::NodeValue);
 
   nv->d_nchildren = 0;
   nv->d_kind = k;
@@ -1253,6 +1313,7 @@ NodeClass NodeManager::mkConstInternal(Kind k, const T& val)
   new (&nv->d_children) T(val);
 
   poolInsert(nv);
+  notifyNewNodeValue(nv);
   if (TraceIsOn("gc"))
   {
     Trace("gc") << "creating node value " << nv << " [" << nv->d_id << "]: ";
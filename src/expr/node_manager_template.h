@@ -22,6 +22,7 @@
 #ifndef CVC5__NODE_MANAGER_H
 #define CVC5__NODE_MANAGER_H
 
+#include <mutex>
 #include <string>
 #include <unordered_set>
 #include <vector>
@@ -30,11 +31,14 @@
 #include "expr/kind.h"
 #include "expr/node_builder.h"
 #include "expr/node_value.h"
+#include "expr/node_value_arena.h"
+#include "expr/node_value_table.h"
 #include "util/floatingpoint_size.h"
 
 namespace cvc5 {
 
 class Solver;
+class TermManager;
 
 namespace internal {
 
@@ -62,19 +66,64 @@ class TypeChecker;
 /**
  * The node manager.
  *
- * This class should not be used simulatenously in multiple threads. It is a
- * singleton that is accessible via NodeManager::currentNM().
+ * Every thread has its own node manager, which is accessible via
+ * NodeManager::currentNM() and should not be used simultaneously in multiple
+ * threads. A thread may instead use a shared node manager (see
+ * NodeManagerScope), which is owned by a cvc5::TermManager.
+ *
+ * A shared node manager may be used by several threads at the same time. It
+ * serializes hash-consing, attribute accesses and the other tables it owns
+ * via a lock. The node values created by a shared node manager have atomic
+ * reference counts, where a node value becomes a zombie, is resurrected and
+ * is reclaimed only while holding the lock (see NodeValue::incShared()).
  */
 class NodeManager
 {
   friend class cvc5::Solver;
+  friend class cvc5::TermManager;
   friend class expr::NodeValue;
   friend class expr::TypeChecker;
   friend class SkolemManager;
+  friend class NodeManagerScope;
+  friend class NodeDeserializer;
 
   friend class NodeBuilder;
 
  public:
+  /**
+   * Locks the given node manager for the lifetime of this object if it is
+   * shared, and does nothing otherwise. This is used to protect accesses to
+   * the state of a node manager, e.g. caches stored in attributes, that
+   * consist of several steps that must happen atomically.
+   *
+   * Since every attribute access takes this lock, it costs a single branch
+   * for a node manager that is not shared.
+   */
+  class SharedLock
+  {
+   public:
+    SharedLock(const NodeManager* nm)
+        : d_mutex(nm->d_shared ? &nm->d_mutex : nullptr)
+    {
+      if (d_mutex != nullptr)
+      {
+        d_mutex->lock();
+      }
+    }
+    ~SharedLock()
+    {
+      if (d_mutex != nullptr)
+      {
+        d_mutex->unlock();
+      }
+    }
+    SharedLock(const SharedLock&) = delete;
+    SharedLock& operator=(const SharedLock&) = delete;
+
+   private:
+    /** The mutex we hold, or nullptr if the node manager is not shared */
+    std::recursive_mutex* d_mutex;
+  };
 
   /**
    * Return true if given kind is n-ary. The test is based on n-ary kinds
@@ -83,9 +132,25 @@ class NodeManager
    */
   static bool isNAryKind(Kind k);
 
-  /** The node manager in the current public-facing cvc5 library context */
+  /**
+   * The node manager in the current public-facing cvc5 library context. This
+   * is the shared node manager of the innermost NodeManagerScope of the
+   * calling thread if there is one, and the node manager of the calling
+   * thread otherwise.
+   */
   static NodeManager* currentNM();
 
+  /** Is this node manager shared between threads? */
+  bool isShared() const { return d_shared; }
+
+  /**
+   * Get the number of bytes allocated for the node values of this node
+   * manager, which is the size of its arena plus the size of the node values
+   * allocated by malloc. This does not include the payloads of constants,
+   * e.g. the digits of rationals, nor the memory of attributes.
+   */
+  size_t getMemoryUsage() const;
+
   /** Get a Kind from an operator expression */
   static Kind operatorToKind(TNode n);
 
@@ -766,10 +831,6 @@ class NodeManager
       const std::vector<DType>& datatypes,
       const std::set<TypeNode>& unresolvedTypes);
 
-  typedef std::unordered_set<expr::NodeValue*,
-                             expr::NodeValuePoolHashFunction,
-                             expr::NodeValuePoolEq>
-      NodeValuePool;
   typedef std::unordered_set<expr::NodeValue*,
                              expr::NodeValueIDHashFunction,
                              expr::NodeValueIDEquality>
@@ -778,9 +839,15 @@ class NodeManager
   /** Predicate for use with STL algorithms */
   struct NodeValueReferenceCountNonZero
   {
-    bool operator()(expr::NodeValue* nv) { return nv->d_rc > 0; }
+    bool operator()(expr::NodeValue* nv) { return nv->getRefCount() > 0; }
   };
 
+  /**
+   * The number of zombies at which they are reclaimed, if it is safe to
+   * reclaim zombies.
+   */
+  static constexpr size_t s_zombieThreshold = 5000;
+
   /**
    * This template gives a mechanism to stack-allocate a NodeValue
    * with enough space for N children (where N is a compile-time
@@ -834,9 +901,9 @@ class NodeManager
   /**
    * Instead of creating an instance using the constructor,
    * `NodeManager::currentNM()` should be used to retrieve an instance of
-   * `NodeManager`.
+   * `NodeManager`. Shared node managers are created by cvc5::TermManager.
    */
-  explicit NodeManager();
+  explicit NodeManager(bool shared = false);
   ~NodeManager();
   // undefined private copy constructor (disallow copy)
   NodeManager(const NodeManager&) = delete;
@@ -884,12 +951,35 @@ class NodeManager
    */
   void poolRemove(expr::NodeValue* nv);
 
+  /**
+   * Allocate the memory of a (non-constant) node value with nchildren
+   * children. Node values with few children are allocated in the arena of
+   * this node manager, the others by malloc.
+   */
+  expr::NodeValue* allocateNodeValue(uint32_t nchildren);
+  /**
+   * Deallocate the memory of the node value nv, which was allocated by
+   * allocateNodeValue if it is not a constant, and by malloc otherwise.
+   */
+  void deallocateNodeValue(expr::NodeValue* nv);
+
+  /**
+   * Called on every node value nv created by this node manager before it is
+   * handed out. If this node manager is shared, this marks nv as shared,
+   * which makes its reference count thread-safe (see NodeValue::incShared()).
+   * Must be called while holding a SharedLock.
+   */
+  inline void notifyNewNodeValue(expr::NodeValue* nv)
+  {
+    nv->d_shared = d_shared;
+  }
+
   /**
    * Register a NodeValue as a zombie.
    */
   inline void markForDeletion(expr::NodeValue* nv)
   {
-    Assert(nv->d_rc == 0);
+    Assert(nv->getRefCount() == 0);
 
     // if d_reclaiming is set, make sure we don't call
     // reclaimZombies(), because it's already running.
@@ -902,17 +992,13 @@ class NodeManager
                   << std::endl;
     }
 
-    // `d_zombies` uses the node id to hash and compare nodes. If `d_zombies`
-    // already contains a node value with the same id as `nv`, but the pointers
-    // are different, then the wrong `NodeManager` was in scope for one of the
-    // two nodes when it reached refcount zero.
-    Assert(d_zombies.find(nv) == d_zombies.end() || *d_zombies.find(nv) == nv);
-
-    d_zombies.insert(nv);
+    // Zombies are reclaimed in bulk, duplicates, which occur if a zombie is
+    // resurrected and zombified again, are removed by reclaimZombies().
+    d_zombies.push_back(nv);
 
     if (safeToReclaimZombies())
     {
-      if (d_zombies.size() > 5000)
+      if (d_zombies.size() > s_zombieThreshold)
       {
         reclaimZombies();
       }
@@ -957,12 +1043,31 @@ class NodeManager
   /** Create a variable with the given type. */
   Node mkVar(const TypeNode& type);
 
+  /** The shared node manager of the innermost NodeManagerScope, if any */
+  static thread_local NodeManager* s_current;
+
+  /** Whether this node manager is shared between threads */
+  const bool d_shared;
+  /** The lock of this node manager, only used if it is shared */
+  mutable std::recursive_mutex d_mutex;
+
   /** The skolem manager */
   std::unique_ptr<SkolemManager> d_skManager;
   /** The bound variable manager */
   std::unique_ptr<BoundVarManager> d_bvManager;
 
-  NodeValuePool d_nodeValuePool;
+  /** The pool of all node values that are not variables */
+  expr::NodeValueTable d_nodeValuePool;
+
+  /** The arena of the node values with few children */
+  expr::NodeValueArena d_nodeValueArena;
+
+  /**
+   * The number of bytes of the node values that are allocated by malloc,
+   * including those cropped by NodeBuilder, where the payloads of constants
+   * are not counted.
+   */
+  size_t d_mallocNodeValueBytes;
 
   /** The next node identifier */
   size_t d_nextId;
@@ -988,11 +1093,10 @@ class NodeManager
   bool d_inReclaimZombies;
 
   /**
-   * The set of zombie nodes.  We may want to revisit this design, as
-   * we might like to delete nodes in least-recently-used order.  But
-   * we also need to avoid processing a zombie twice.
+   * The zombie nodes, in the order in which they were zombified. This may
+   * contain duplicates, and node values that were resurrected.
    */
-  NodeValueIDSet d_zombies;
+  std::vector<expr::NodeValue*> d_zombies;
 
   /**
    * NodeValues with maxed out reference counts. These live as long as the
@@ -1023,6 +1127,26 @@ class NodeManager
   RecTypeCache d_rt_cache;
 }; /* class NodeManager */
 
+/**
+ * Makes the given shared node manager the current node manager of the calling
+ * thread (see NodeManager::currentNM()) for the lifetime of this object.
+ * Scopes may be nested, but must be destroyed in the thread that created them.
+ */
+class NodeManagerScope
+{
+ public:
+  NodeManagerScope(NodeManager* nm) : d_previous(NodeManager::s_current)
+  {
+    Assert(nm->isShared());
+    NodeManager::s_current = nm;
+  }
+  ~NodeManagerScope() { NodeManager::s_current = d_previous; }
+
+ private:
+  /** The node manager that was current before this scope */
+  NodeManager* d_previous;
+};
+
 inline TypeNode NodeManager::mkArrayType(TypeNode indexType,
                                          TypeNode constituentType)
 {
@@ -1041,24 +1165,14 @@ inline TypeNode NodeManager::mkSetType(TypeNode elementType)
 }
 
 inline expr::NodeValue* NodeManager::poolLookup(expr::NodeValue* nv) const {
-  NodeValuePool::const_iterator find = d_nodeValuePool.find(nv);
-  if(find == d_nodeValuePool.end()) {
-    return NULL;
-  } else {
-    return *find;
-  }
+  return d_nodeValuePool.find(nv);
 }
 
 inline void NodeManager::poolInsert(expr::NodeValue* nv) {
-  Assert(d_nodeValuePool.find(nv) == d_nodeValuePool.end())
-      << "NodeValue already in the pool!";
   d_nodeValuePool.insert(nv);
 }
 
 inline void NodeManager::poolRemove(expr::NodeValue* nv) {
-  Assert(d_nodeValuePool.find(nv) != d_nodeValuePool.end())
-      << "NodeValue is not in the pool!";
-
   d_nodeValuePool.erase(nv);
 }
 
@@ -0,0 +1,1071 @@
+/******************************************************************************
+ * Top contributors (to current version):
+ *   agent
+ *
+ * This file is part of the cvc5 project.
+ *
+ * Copyright (c) 2009-2023 by the authors listed in the file AUTHORS
+ * in the top-level source directory and their institutional affiliations.
+ * All rights reserved.  See the file COPYING in the top-level source
+ * directory for licensing information.
+ * ****************************************************************************
+ *
+ * Binary serialization of terms, types and problems.
+ */
+
+#include "expr/node_serializer.h"
+
+#include <cstring>
+#include <iostream>
+#include <sstream>
+
+#include "base/check.h"
+#include "base/exception.h"
+#include "expr/node_builder.h"
+#include "expr/node_manager.h"
+#include "util/bitvector.h"
+#include "util/divisible.h"
+#include "util/floatingpoint.h"
+#include "util/iand.h"
+#include "util/rational.h"
+#include "util/regexp.h"
+#include "util/roundingmode.h"
+#include "util/string.h"
+
+namespace cvc5::internal {
+
+namespace {
+
+/** The magic string at the start of the binary format */
+const char s_magic[] = "cvc5bin\n";
+/** The size of the magic string, without the terminating null character */
+constexpr size_t s_magicSize = sizeof(s_magic) - 1;
+/** The version of the binary format */
+constexpr uint64_t s_version = 1;
+
+/** The rounding modes, in the order of their encoding */
+const RoundingMode s_roundingModes[] = {
+    RoundingMode::ROUND_NEAREST_TIES_TO_EVEN,
+    RoundingMode::ROUND_TOWARD_POSITIVE,
+    RoundingMode::ROUND_TOWARD_NEGATIVE,
+    RoundingMode::ROUND_TOWARD_ZERO,
+    RoundingMode::ROUND_NEAREST_TIES_TO_AWAY};
+
+/** Get the kind with the given name, or UNDEFINED_KIND */
+Kind getKindByName(const std::string& name)
+{
+  static const std::unordered_map<std::string, Kind> kinds = []() {
+    std::unordered_map<std::string, Kind> res;
+    for (int32_t k = kind::NULL_EXPR + 1; k < kind::LAST_KIND; k++)
+    {
+      res[kind::toString(static_cast<Kind>(k))] = static_cast<Kind>(k);
+    }
+    return res;
+  }();
+  auto it = kinds.find(name);
+  return it == kinds.end() ? kind::UNDEFINED_KIND : it->second;
+}
+
+/** Get the type constant with the given name, or LAST_TYPE */
+TypeConstant getTypeConstantByName(const std::string& name)
+{
+  static const std::unordered_map<std::string, TypeConstant> tcs = []() {
+    std::unordered_map<std::string, TypeConstant> res;
+    for (int32_t tc = 0; tc < LAST_TYPE; tc++)
+    {
+      res[toString(static_cast<TypeConstant>(tc))] =
+          static_cast<TypeConstant>(tc);
+    }
+    return res;
+  }();
+  auto it = tcs.find(name);
+  return it == tcs.end() ? LAST_TYPE : it->second;
+}
+
+}  // namespace
+
+/* -------------------------------------------------------------------------- */
+
+NodeSerializer::NodeSerializer(std::ostream& out)
+    : d_out(out), d_kindIndex(kind::LAST_KIND, -1), d_numKinds(0), d_nextId(0)
+{
+  d_out.write(s_magic, s_magicSize);
+  writeUnsigned(s_version);
+}
+
+void NodeSerializer::writeLogic(const std::string& logic)
+{
+  writeRecordKind(BinaryRecord::LOGIC);
+  writeString(logic);
+}
+
+void NodeSerializer::writeDeclareSort(const TypeNode& tn)
+{
+  writeRecord(BinaryRecord::DECLARE_SORT, addType(tn));
+}
+
+void NodeSerializer::writeDeclareFun(TNode n)
+{
+  writeRecord(BinaryRecord::DECLARE_FUN, addNode(n));
+}
+
+void NodeSerializer::writeAssert(TNode n)
+{
+  writeRecord(BinaryRecord::ASSERT, addNode(n));
+}
+
+void NodeSerializer::writeTerm(TNode n)
+{
+  writeRecord(BinaryRecord::TERM, addNode(n));
+}
+
+void NodeSerializer::writeCheckSat()
+{
+  writeRecordKind(BinaryRecord::CHECK_SAT);
+}
+
+void NodeSerializer::finish() { writeRecordKind(BinaryRecord::END); }
+
+uint64_t NodeSerializer::addNode(TNode n)
+{
+  // post-order traversal, writing the definition of a term after those of
+  // its operator and children
+  std::vector<std::pair<TNode, bool>> visit;
+  visit.emplace_back(n, false);
+  while (!visit.empty())
+  {
+    std::pair<TNode, bool>& cur = visit.back();
+    TNode cn = cur.first;
+    if (d_nodeIds.find(cn) != d_nodeIds.end())
+    {
+      visit.pop_back();
+      continue;
+    }
+    if (cur.second || cn.getNumChildren() == 0)
+    {
+      visit.pop_back();
+      writeNodeDefinition(cn);
+      continue;
+    }
+    cur.second = true;
+    if (cn.getMetaKind() == kind::metakind::PARAMETERIZED)
+    {
+      visit.emplace_back(cn.getOperator(), false);
+    }
+    for (const Node& cc : cn)
+    {
+      visit.emplace_back(cc, false);
+    }
+  }
+  return d_nodeIds[n];
+}
+
+void NodeSerializer::writeNodeDefinition(TNode n)
+{
+  Kind k = n.getKind();
+  kind::MetaKind mk = n.getMetaKind();
+  if (mk == kind::metakind::CONSTANT)
+  {
+    declareKind(k);
+    writeRecordKind(BinaryRecord::TERM_CONST);
+    writeKind(k);
+    writeNodePayload(n);
+  }
+  else if (mk == kind::metakind::VARIABLE
+           || mk == kind::metakind::NULLARY_OPERATOR)
+  {
+    if (mk == kind::metakind::VARIABLE && k != kind::VARIABLE
+        && k != kind::BOUND_VARIABLE)
+    {
+      std::stringstream ss;
+      ss << "cannot serialize variable " << n << " of kind " << k;
+      throw Exception(ss.str());
+    }
+    uint64_t tid = addType(n.getType());
+    declareKind(k);
+    writeRecordKind(BinaryRecord::TERM_VAR);
+    writeKind(k);
+    writeString(n.hasName() ? n.getName() : std::string());
+    writeRef(tid);
+  }
+  else
+  {
+    declareKind(k);
+    writeRecordKind(BinaryRecord::TERM_APP);
+    writeKind(k);
+    writeUnsigned(n.getNumChildren());
+    if (mk == kind::metakind::PARAMETERIZED)
+    {
+      writeRef(d_nodeIds[n.getOperator()]);
+    }
+    for (const Node& nc : n)
+    {
+      writeRef(d_nodeIds[nc]);
+    }
+  }
+  d_nodeIds[n] = d_nextId++;
+}
+
+void NodeSerializer::writeNodePayload(TNode n)
+{
+  switch (n.getKind())
+  {
+    case kind::CONST_BOOLEAN: writeUnsigned(n.getConst<bool>() ? 1 : 0); break;
+    case kind::CONST_RATIONAL:
+    case kind::CONST_INTEGER:
+    {
+      const Rational& r = n.getConst<Rational>();
+      writeInteger(r.getNumerator());
+      writeInteger(r.getDenominator());
+      break;
+    }
+    case kind::CONST_BITVECTOR:
+    {
+      const BitVector& bv = n.getConst<BitVector>();
+      writeUnsigned(bv.getSize());
+      writeInteger(bv.getValue());
+      break;
+    }
+    case kind::CONST_STRING:
+    {
+      const std::vector<unsigned>& vec = n.getConst<String>().getVec();
+      writeUnsigned(vec.size());
+      for (unsigned c : vec)
+      {
+        writeUnsigned(c);
+      }
+      break;
+    }
+    case kind::CONST_ROUNDINGMODE:
+    {
+      RoundingMode rm = n.getConst<RoundingMode>();
+      uint64_t i = 0;
+      while (s_roundingModes[i] != rm)
+      {
+        i++;
+      }
+      writeUnsigned(i);
+      break;
+    }
+    case kind::CONST_FLOATINGPOINT:
+    {
+      const FloatingPoint& fp = n.getConst<FloatingPoint>();
+      writeFloatingPointSize(fp.getSize());
+      writeInteger(fp.pack().getValue());
+      break;
+    }
+    case kind::BITVECTOR_EXTRACT_OP:
+    {
+      const BitVectorExtract& ext = n.getConst<BitVectorExtract>();
+      writeUnsigned(ext.d_high);
+      writeUnsigned(ext.d_low);
+      break;
+    }
+    case kind::BITVECTOR_BITOF_OP:
+      writeUnsigned(n.getConst<BitVectorBitOf>().d_bitIndex);
+      break;
+    case kind::BITVECTOR_REPEAT_OP:
+      writeUnsigned(n.getConst<BitVectorRepeat>());
+      break;
+    case kind::BITVECTOR_ZERO_EXTEND_OP:
+      writeUnsigned(n.getConst<BitVectorZeroExtend>());
+      break;
+    case kind::BITVECTOR_SIGN_EXTEND_OP:
+      writeUnsigned(n.getConst<BitVectorSignExtend>());
+      break;
+    case kind::BITVECTOR_ROTATE_LEFT_OP:
+      writeUnsigned(n.getConst<BitVectorRotateLeft>());
+      break;
+    case kind::BITVECTOR_ROTATE_RIGHT_OP:
+      writeUnsigned(n.getConst<BitVectorRotateRight>());
+      break;
+    case kind::INT_TO_BITVECTOR_OP:
+      writeUnsigned(n.getConst<IntToBitVector>());
+      break;
+    case kind::IAND_OP: writeUnsigned(n.getConst<IntAnd>()); break;
+    case kind::DIVISIBLE_OP: writeInteger(n.getConst<Divisible>().k); break;
+    case kind::REGEXP_REPEAT_OP:
+      writeUnsigned(n.getConst<RegExpRepeat>().d_repeatAmount);
+      break;
+    case kind::REGEXP_LOOP_OP:
+    {
+      const RegExpLoop& loop = n.getConst<RegExpLoop>();
+      writeUnsigned(loop.d_loopMinOcc);
+      writeUnsigned(loop.d_loopMaxOcc);
+      break;
+    }
+    case kind::FLOATINGPOINT_TO_FP_FROM_IEEE_BV_OP:
+      writeFloatingPointSize(
+          n.getConst<FloatingPointToFPIEEEBitVector>().getSize());
+      break;
+    case kind::FLOATINGPOINT_TO_FP_FROM_FP_OP:
+      writeFloatingPointSize(
+          n.getConst<FloatingPointToFPFloatingPoint>().getSize());
+      break;
+    case kind::FLOATINGPOINT_TO_FP_FROM_REAL_OP:
+      writeFloatingPointSize(n.getConst<FloatingPointToFPReal>().getSize());
+      break;
+    case kind::FLOATINGPOINT_TO_FP_FROM_SBV_OP:
+      writeFloatingPointSize(
+          n.getConst<FloatingPointToFPSignedBitVector>().getSize());
+      break;
+    case kind::FLOATINGPOINT_TO_FP_FROM_UBV_OP:
+      writeFloatingPointSize(
+          n.getConst<FloatingPointToFPUnsignedBitVector>().getSize());
+      break;
+    case kind::FLOATINGPOINT_TO_UBV_OP:
+      writeUnsigned(n.getConst<FloatingPointToUBV>());
+      break;
+    case kind::FLOATINGPOINT_TO_UBV_TOTAL_OP:
+      writeUnsigned(n.getConst<FloatingPointToUBVTotal>());
+      break;
+    case kind::FLOATINGPOINT_TO_SBV_OP:
+      writeUnsigned(n.getConst<FloatingPointToSBV>());
+      break;
+    case kind::FLOATINGPOINT_TO_SBV_TOTAL_OP:
+      writeUnsigned(n.getConst<FloatingPointToSBVTotal>());
+      break;
+    default:
+    {
+      std::stringstream ss;
+      ss << "cannot serialize constant " << n << " of kind " << n.getKind();
+      throw Exception(ss.str());
+    }
+  }
+}
+
+uint64_t NodeSerializer::addType(const TypeNode& tn)
+{
+  auto it = d_typeIds.find(tn);
+  if (it != d_typeIds.end())
+  {
+    return it->second;
+  }
+  // types are shallow, hence we use recursion here
+  Kind k = tn.getKind();
+  if (k == kind::SORT_TYPE)
+  {
+    writeRecordKind(BinaryRecord::TYPE_SORT);
+    writeString(tn.hasName() ? tn.getName() : std::string());
+    writeUnsigned(tn.isUninterpretedSortConstructor()
+                      ? tn.getUninterpretedSortConstructorArity()
+                      : 0);
+  }
+  else if (tn.getMetaKind() == kind::metakind::CONSTANT)
+  {
+    declareKind(k);
+    writeRecordKind(BinaryRecord::TYPE_CONST);
+    writeKind(k);
+    writeTypePayload(tn);
+  }
+  else
+  {
+    std::vector<uint64_t> cids;
+    for (const TypeNode& tc : tn)
+    {
+      cids.push_back(addType(tc));
+    }
+    declareKind(k);
+    writeRecordKind(BinaryRecord::TYPE_APP);
+    writeKind(k);
+    writeUnsigned(cids.size());
+    for (uint64_t cid : cids)
+    {
+      writeRef(cid);
+    }
+  }
+  d_typeIds[tn] = d_nextId;
+  return d_nextId++;
+}
+
+void NodeSerializer::writeTypePayload(const TypeNode& tn)
+{
+  switch (tn.getKind())
+  {
+    case kind::TYPE_CONSTANT:
+      writeString(toString(tn.getConst<TypeConstant>()));
+      break;
+    case kind::BITVECTOR_TYPE:
+      writeUnsigned(tn.getConst<BitVectorSize>());
+      break;
+    case kind::FLOATINGPOINT_TYPE:
+    {
+      writeFloatingPointSize(tn.getConst<FloatingPointSize>());
+      break;
+    }
+    default:
+    {
+      std::stringstream ss;
+      ss << "cannot serialize type " << tn << " of kind " << tn.getKind();
+      throw Exception(ss.str());
+    }
+  }
+}
+
+void NodeSerializer::writeRecord(BinaryRecord r, uint64_t id)
+{
+  writeRecordKind(r);
+  writeRef(id);
+}
+
+void NodeSerializer::writeRef(uint64_t id)
+{
+  Assert(id < d_nextId);
+  writeUnsigned(d_nextId - id);
+}
+
+void NodeSerializer::declareKind(Kind k)
+{
+  if (d_kindIndex[k] < 0)
+  {
+    writeRecordKind(BinaryRecord::KIND);
+    writeString(kind::toString(k));
+    d_kindIndex[k] = static_cast<int64_t>(d_numKinds++);
+  }
+}
+
+void NodeSerializer::writeKind(Kind k)
+{
+  Assert(d_kindIndex[k] >= 0);
+  writeUnsigned(static_cast<uint64_t>(d_kindIndex[k]));
+}
+
+void NodeSerializer::writeUnsigned(uint64_t val)
+{
+  char buf[10];
+  size_t len = 0;
+  while (val >= 0x80)
+  {
+    buf[len++] = static_cast<char>((val & 0x7f) | 0x80);
+    val >>= 7;
+  }
+  buf[len++] = static_cast<char>(val);
+  d_out.write(buf, len);
+}
+
+void NodeSerializer::writeString(const std::string& s)
+{
+  writeUnsigned(s.size());
+  d_out.write(s.data(), s.size());
+}
+
+void NodeSerializer::writeInteger(const Integer& i)
+{
+  writeString(i.toString(16));
+}
+
+void NodeSerializer::writeFloatingPointSize(const FloatingPointSize& fps)
+{
+  writeUnsigned(fps.exponentWidth());
+  writeUnsigned(fps.significandWidth());
+}
+
+void NodeSerializer::writeRecordKind(BinaryRecord r)
+{
+  d_out.put(static_cast<char>(r));
+}
+
+/* -------------------------------------------------------------------------- */
+
+NodeDeserializer::NodeDeserializer(NodeManager* nm, std::istream& in)
+    : d_nm(nm),
+      d_in(&in),
+      d_buffer(1 << 16),
+      d_pos(nullptr),
+      d_end(nullptr),
+      d_finished(false)
+{
+  readHeader();
+}
+
+NodeDeserializer::NodeDeserializer(NodeManager* nm,
+                                   const char* buffer,
+                                   size_t size)
+    : d_nm(nm),
+      d_in(nullptr),
+      d_pos(buffer),
+      d_end(buffer + size),
+      d_finished(false)
+{
+  readHeader();
+}
+
+void NodeDeserializer::readHeader()
+{
+  char magic[s_magicSize];
+  for (size_t i = 0; i < s_magicSize; i++)
+  {
+    int c = readByte();
+    if (c < 0)
+    {
+      error("not a binary cvc5 input");
+    }
+    magic[i] = static_cast<char>(c);
+  }
+  if (std::memcmp(magic, s_magic, s_magicSize) != 0)
+  {
+    error("not a binary cvc5 input");
+  }
+  uint64_t version = readUnsigned();
+  if (version != s_version)
+  {
+    std::stringstream ss;
+    ss << "unsupported version " << version << " of the binary format";
+    error(ss.str());
+  }
+}
+
+bool NodeDeserializer::next(Record& r)
+{
+  while (!d_finished)
+  {
+    int c = readByte();
+    if (c < 0)
+    {
+      d_finished = true;
+      break;
+    }
+    BinaryRecord rk = static_cast<BinaryRecord>(c);
+    switch (rk)
+    {
+      case BinaryRecord::END: d_finished = true; break;
+      case BinaryRecord::KIND:
+      {
+        std::string name = readString();
+        Kind k = getKindByName(name);
+        if (k == kind::UNDEFINED_KIND)
+        {
+          error("unknown kind " + name);
+        }
+        d_kinds.push_back(k);
+        break;
+      }
+      case BinaryRecord::TYPE_CONST:
+      case BinaryRecord::TYPE_SORT:
+      case BinaryRecord::TYPE_APP:
+      case BinaryRecord::TERM_CONST:
+      case BinaryRecord::TERM_VAR:
+      case BinaryRecord::TERM_APP: readDefinition(rk); break;
+      case BinaryRecord::CHECK_SAT: r.d_kind = rk; return true;
+      case BinaryRecord::LOGIC:
+        r.d_kind = rk;
+        r.d_logic = readString();
+        return true;
+      case BinaryRecord::DECLARE_SORT:
+        r.d_kind = rk;
+        r.d_type = readTypeRef();
+        return true;
+      case BinaryRecord::DECLARE_FUN:
+      case BinaryRecord::ASSERT:
+      case BinaryRecord::TERM:
+        r.d_kind = rk;
+        r.d_node = readNodeRef();
+        return true;
+      default: error("unknown record"); break;
+    }
+  }
+  return false;
+}
+
+void NodeDeserializer::readDefinition(BinaryRecord r)
+{
+  Node n;
+  TypeNode tn;
+  switch (r)
+  {
+    case BinaryRecord::TYPE_CONST:
+    {
+      Kind k = readKind();
+      if (kind::metaKindOf(k) != kind::metakind::CONSTANT)
+      {
+        error("unexpected kind of type constant");
+      }
+      tn = readTypePayload(k);
+      break;
+    }
+    case BinaryRecord::TYPE_SORT:
+    {
+      std::string name = readString();
+      uint64_t arity = readUnsigned();
+      tn = arity > 0 ? d_nm->mkSortConstructor(name, arity)
+                     : d_nm->mkSort(name);
+      break;
+    }
+    case BinaryRecord::TYPE_APP:
+    {
+      Kind k = readKind();
+      uint64_t nchildren = readUnsigned();
+      checkArity(k, nchildren);
+      std::vector<TypeNode> children;
+      for (uint64_t i = 0; i < nchildren; i++)
+      {
+        children.push_back(readTypeRef());
+      }
+      if (k == kind::INSTANTIATED_SORT_TYPE)
+      {
+        if (!children[0].isUninterpretedSortConstructor()
+            || children[0].getUninterpretedSortConstructorArity()
+                   != children.size() - 1)
+        {
+          error("ill-formed instantiated sort");
+        }
+        TypeNode ctor = children[0];
+        children.erase(children.begin());
+        tn = d_nm->mkSort(ctor, children);
+        break;
+      }
+      for (const TypeNode& c : children)
+      {
+        if (!c.isFirstClass() || c.isUninterpretedSortConstructor())
+        {
+          error("ill-formed type");
+        }
+      }
+      switch (k)
+      {
+        case kind::FUNCTION_TYPE:
+          if (children.back().isFunction())
+          {
+            error("ill-formed function type");
+          }
+          tn = d_nm->mkFunctionType(children);
+          break;
+        case kind::ARRAY_TYPE:
+          tn = d_nm->mkArrayType(children[0], children[1]);
+          break;
+        case kind::SET_TYPE: tn = d_nm->mkSetType(children[0]); break;
+        case kind::BAG_TYPE: tn = d_nm->mkBagType(children[0]); break;
+        case kind::SEQUENCE_TYPE: tn = d_nm->mkSequenceType(children[0]); break;
+        case kind::TUPLE_TYPE: tn = d_nm->mkTupleType(children); break;
+        default:
+        {
+          std::stringstream ss;
+          ss << "unsupported type of kind " << k;
+          error(ss.str());
+        }
+      }
+      break;
+    }
+    case BinaryRecord::TERM_CONST:
+    {
+      Kind k = readKind();
+      if (kind::metaKindOf(k) != kind::metakind::CONSTANT)
+      {
+        error("unexpected kind of constant");
+      }
+      n = readNodePayload(k);
+      break;
+    }
+    case BinaryRecord::TERM_VAR:
+    {
+      Kind k = readKind();
+      std::string name = readString();
+      TypeNode type = readTypeRef();
+      if (!type.isFirstClass() || type.isUninterpretedSortConstructor())
+      {
+        error("invalid type of variable");
+      }
+      if (k == kind::VARIABLE)
+      {
+        n = name.empty() ? d_nm->mkVar(type) : d_nm->mkVar(name, type);
+      }
+      else if (k == kind::BOUND_VARIABLE)
+      {
+        n = name.empty() ? d_nm->mkBoundVar(type)
+                         : d_nm->mkBoundVar(name, type);
+      }
+      else if (kind::metaKindOf(k) == kind::metakind::NULLARY_OPERATOR)
+      {
+        n = d_nm->mkNullaryOperator(type, k);
+      }
+      else
+      {
+        error("unexpected kind of variable");
+      }
+      break;
+    }
+    case BinaryRecord::TERM_APP:
+    {
+      Kind k = readKind();
+      uint64_t nchildren = readUnsigned();
+      kind::MetaKind mk = kind::metaKindOf(k);
+      if (mk != kind::metakind::PARAMETERIZED && mk != kind::metakind::OPERATOR)
+      {
+        error("unexpected kind of term with children");
+      }
+      checkArity(k, nchildren);
+      NodeBuilder nb(d_nm, k);
+      if (mk == kind::metakind::PARAMETERIZED)
+      {
+        Node op = readNodeRef();
+        // the operator of these kinds is a term, and a constant of a
+        // dedicated kind otherwise
+        bool termOp = k == kind::APPLY_UF || k == kind::APPLY_CONSTRUCTOR
+                      || k == kind::APPLY_SELECTOR || k == kind::APPLY_TESTER
+                      || k == kind::APPLY_UPDATER;
+        if (termOp ? op.isConst()
+                   : (op.getMetaKind() != kind::metakind::CONSTANT
+                      || NodeManager::operatorToKind(op) != k))
+        {
+          error("invalid operator");
+        }
+        nb << op;
+      }
+      for (uint64_t i = 0; i < nchildren; i++)
+      {
+        nb << readNodeRef();
+      }
+      try
+      {
+        n = nb.constructNode();
+      }
+      catch (const TypeCheckingExceptionPrivate& e)
+      {
+        error("ill-typed term: " + e.getMessage());
+      }
+      break;
+    }
+    default: Unreachable();
+  }
+  if (!n.isNull())
+  {
+    try
+    {
+      n.getType(true);
+    }
+    catch (const TypeCheckingExceptionPrivate& e)
+    {
+      error("ill-typed term: " + e.getMessage());
+    }
+  }
+  d_nodes.push_back(n);
+  d_types.push_back(tn);
+}
+
+Node NodeDeserializer::readNodePayload(Kind k)
+{
+  switch (k)
+  {
+    case kind::CONST_BOOLEAN: return d_nm->mkConst(readUnsigned() != 0);
+    case kind::CONST_RATIONAL:
+    case kind::CONST_INTEGER:
+    {
+      Integer num = readInteger();
+      Integer den = readInteger();
+      if (den.sgn() <= 0 || (k == kind::CONST_INTEGER && !den.isOne()))
+      {
+        error("invalid denominator");
+      }
+      return d_nm->mkConst(k, Rational(num, den));
+    }
+    case kind::CONST_BITVECTOR:
+    {
+      uint32_t size = readBitVectorSize();
+      Integer val = readInteger();
+      if (val.sgn() < 0 || val.length() > size)
+      {
+        error("invalid bit-vector value");
+      }
+      return d_nm->mkConst(BitVector(size, val));
+    }
+    case kind::CONST_STRING:
+    {
+      uint64_t len = readUnsigned();
+      std::vector<unsigned> vec;
+      for (uint64_t i = 0; i < len; i++)
+      {
+        uint32_t c = readUnsigned32();
+        if (c >= String::num_codes())
+        {
+          error("invalid character in string");
+        }
+        vec.push_back(c);
+      }
+      return d_nm->mkConst(String(vec));
+    }
+    case kind::CONST_ROUNDINGMODE:
+    {
+      uint64_t i = readUnsigned();
+      if (i >= sizeof(s_roundingModes) / sizeof(s_roundingModes[0]))
+      {
+        error("invalid rounding mode");
+      }
+      return d_nm->mkConst(s_roundingModes[i]);
+    }
+    case kind::CONST_FLOATINGPOINT:
+    {
+      FloatingPointSize fps = readFloatingPointSize();
+      Integer val = readInteger();
+      if (val.sgn() < 0 || val.length() > fps.packedWidth())
+      {
+        error("invalid floating-point value");
+      }
+      return d_nm->mkConst(
+          FloatingPoint(fps, BitVector(fps.packedWidth(), val)));
+    }
+    case kind::BITVECTOR_EXTRACT_OP:
+    {
+      uint32_t high = readUnsigned32();
+      uint32_t low = readUnsigned32();
+      if (high < low)
+      {
+        error("invalid bit-vector extract");
+      }
+      return d_nm->mkConst(BitVectorExtract(high, low));
+    }
+    case kind::BITVECTOR_BITOF_OP:
+      return d_nm->mkConst(BitVectorBitOf(readUnsigned32()));
+    case kind::BITVECTOR_REPEAT_OP:
+      return d_nm->mkConst(BitVectorRepeat(readUnsigned32()));
+    case kind::BITVECTOR_ZERO_EXTEND_OP:
+      return d_nm->mkConst(BitVectorZeroExtend(readUnsigned32()));
+    case kind::BITVECTOR_SIGN_EXTEND_OP:
+      return d_nm->mkConst(BitVectorSignExtend(readUnsigned32()));
+    case kind::BITVECTOR_ROTATE_LEFT_OP:
+      return d_nm->mkConst(BitVectorRotateLeft(readUnsigned32()));
+    case kind::BITVECTOR_ROTATE_RIGHT_OP:
+      return d_nm->mkConst(BitVectorRotateRight(readUnsigned32()));
+    case kind::INT_TO_BITVECTOR_OP:
+      return d_nm->mkConst(IntToBitVector(readBitVectorSize()));
+    case kind::IAND_OP: return d_nm->mkConst(IntAnd(readBitVectorSize()));
+    case kind::DIVISIBLE_OP:
+    {
+      Integer d = readInteger();
+      if (d.sgn() <= 0)
+      {
+        error("invalid divisor");
+      }
+      return d_nm->mkConst(Divisible(d));
+    }
+    case kind::REGEXP_REPEAT_OP:
+      return d_nm->mkConst(RegExpRepeat(readUnsigned32()));
+    case kind::REGEXP_LOOP_OP:
+    {
+      uint32_t lo = readUnsigned32();
+      uint32_t hi = readUnsigned32();
+      return d_nm->mkConst(RegExpLoop(lo, hi));
+    }
+    case kind::FLOATINGPOINT_TO_FP_FROM_IEEE_BV_OP:
+    case kind::FLOATINGPOINT_TO_FP_FROM_FP_OP:
+    case kind::FLOATINGPOINT_TO_FP_FROM_REAL_OP:
+    case kind::FLOATINGPOINT_TO_FP_FROM_SBV_OP:
+    case kind::FLOATINGPOINT_TO_FP_FROM_UBV_OP:
+    {
+      FloatingPointSize fps = readFloatingPointSize();
+      switch (k)
+      {
+        case kind::FLOATINGPOINT_TO_FP_FROM_IEEE_BV_OP:
+          return d_nm->mkConst(FloatingPointToFPIEEEBitVector(fps));
+        case kind::FLOATINGPOINT_TO_FP_FROM_FP_OP:
+          return d_nm->mkConst(FloatingPointToFPFloatingPoint(fps));
+        case kind::FLOATINGPOINT_TO_FP_FROM_REAL_OP:
+          return d_nm->mkConst(FloatingPointToFPReal(fps));
+        case kind::FLOATINGPOINT_TO_FP_FROM_SBV_OP:
+          return d_nm->mkConst(FloatingPointToFPSignedBitVector(fps));
+        default: return d_nm->mkConst(FloatingPointToFPUnsignedBitVector(fps));
+      }
+    }
+    case kind::FLOATINGPOINT_TO_UBV_OP:
+      return d_nm->mkConst(FloatingPointToUBV(readBitVectorSize()));
+    case kind::FLOATINGPOINT_TO_UBV_TOTAL_OP:
+      return d_nm->mkConst(FloatingPointToUBVTotal(readBitVectorSize()));
+    case kind::FLOATINGPOINT_TO_SBV_OP:
+      return d_nm->mkConst(FloatingPointToSBV(readBitVectorSize()));
+    case kind::FLOATINGPOINT_TO_SBV_TOTAL_OP:
+      return d_nm->mkConst(FloatingPointToSBVTotal(readBitVectorSize()));
+    default:
+    {
+      std::stringstream ss;
+      ss << "unsupported constant of kind " << k;
+      error(ss.str());
+    }
+  }
+}
+
+TypeNode NodeDeserializer::readTypePayload(Kind k)
+{
+  switch (k)
+  {
+    case kind::TYPE_CONSTANT:
+    {
+      std::string name = readString();
+      TypeConstant tc = getTypeConstantByName(name);
+      if (tc == LAST_TYPE)
+      {
+        error("unknown type constant " + name);
+      }
+      return d_nm->mkTypeConst(tc);
+    }
+    case kind::BITVECTOR_TYPE:
+      return d_nm->mkBitVectorType(readBitVectorSize());
+    case kind::FLOATINGPOINT_TYPE:
+      return d_nm->mkFloatingPointType(readFloatingPointSize());
+    default:
+    {
+      std::stringstream ss;
+      ss << "unsupported type constant of kind " << k;
+      error(ss.str());
+    }
+  }
+}
+
+Node NodeDeserializer::readNodeRef()
+{
+  uint64_t id = readRef();
+  if (d_nodes[id].isNull())
+  {
+    error("reference to a type where a term is expected");
+  }
+  return d_nodes[id];
+}
+
+TypeNode NodeDeserializer::readTypeRef()
+{
+  uint64_t id = readRef();
+  if (d_types[id].isNull())
+  {
+    error("reference to a term where a type is expected");
+  }
+  return d_types[id];
+}
+
+uint64_t NodeDeserializer::readRef()
+{
+  uint64_t diff = readUnsigned();
+  if (diff == 0 || diff > d_nodes.size())
+  {
+    error("invalid reference");
+  }
+  return d_nodes.size() - diff;
+}
+
+void NodeDeserializer::checkArity(Kind k, uint64_t nchildren) const
+{
+  if (nchildren < kind::metakind::getMinArityForKind(k)
+      || nchildren > kind::metakind::getMaxArityForKind(k))
+  {
+    std::stringstream ss;
+    ss << "invalid number of children for kind " << k;
+    error(ss.str());
+  }
+}
+
+Kind NodeDeserializer::readKind()
+{
+  uint64_t i = readUnsigned();
+  if (i >= d_kinds.size())
+  {
+    error("invalid kind");
+  }
+  return d_kinds[i];
+}
+
+uint64_t NodeDeserializer::readUnsigned()
+{
+  uint64_t res = 0;
+  for (uint32_t shift = 0; shift < 64; shift += 7)
+  {
+    uint8_t b = readByteChecked();
+    res |= static_cast<uint64_t>(b & 0x7f) << shift;
+    if ((b & 0x80) == 0)
+    {
+      return res;
+    }
+  }
+  error("integer too large");
+}
+
+uint32_t NodeDeserializer::readUnsigned32()
+{
+  uint64_t res = readUnsigned();
+  if (res > std::numeric_limits<uint32_t>::max())
+  {
+    error("integer too large");
+  }
+  return static_cast<uint32_t>(res);
+}
+
+uint32_t NodeDeserializer::readBitVectorSize()
+{
+  uint32_t size = readUnsigned32();
+  if (size == 0)
+  {
+    error("invalid bit-vector size");
+  }
+  return size;
+}
+
+FloatingPointSize NodeDeserializer::readFloatingPointSize()
+{
+  uint32_t e = readUnsigned32();
+  uint32_t s = readUnsigned32();
+  if (!validExponentSize(e) || !validSignificandSize(s)
+      || e > std::numeric_limits<uint32_t>::max() - s)
+  {
+    error("invalid floating-point size");
+  }
+  return FloatingPointSize(e, s);
+}
+
+std::string NodeDeserializer::readString()
+{
+  uint64_t len = readUnsigned();
+  std::string res;
+  while (len > 0)
+  {
+    if (d_pos == d_end && !fill())
+    {
+      error("unexpected end of input");
+    }
+    size_t n = std::min(len, static_cast<uint64_t>(d_end - d_pos));
+    res.append(d_pos, n);
+    d_pos += n;
+    len -= n;
+  }
+  return res;
+}
+
+Integer NodeDeserializer::readInteger()
+{
+  std::string s = readString();
+  // an optional minus sign followed by hexadecimal digits
+  size_t start = !s.empty() && s[0] == '-' ? 1 : 0;
+  if (s.size() == start
+      || s.find_first_not_of("0123456789abcdef", start) != std::string::npos)
+  {
+    error("invalid integer");
+  }
+  return Integer(s, 16);
+}
+
+uint8_t NodeDeserializer::readByteChecked()
+{
+  int c = readByte();
+  if (c < 0)
+  {
+    error("unexpected end of input");
+  }
+  return static_cast<uint8_t>(c);
+}
+
+bool NodeDeserializer::fill()
+{
+  if (d_in == nullptr)
+  {
+    return false;
+  }
+  d_in->read(d_buffer.data(), d_buffer.size());
+  size_t size = static_cast<size_t>(d_in->gcount());
+  d_pos = d_buffer.data();
+  d_end = d_pos + size;
+  return size > 0;
+}
+
+void NodeDeserializer::error(const std::string& msg) const
+{
+  std::stringstream ss;
+  ss << "error in binary input: " << msg;
+  throw Exception(ss.str());
+}
+
+}  // namespace cvc5::internal
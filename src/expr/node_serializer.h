@@ -0,0 +1,258 @@
+/******************************************************************************
+ * Top contributors (to current version):
+ *   agent
+ *
+ * This file is part of the cvc5 project.
+ *
+ * Copyright (c) 2009-2023 by the authors listed in the file AUTHORS
+ * in the top-level source directory and their institutional affiliations.
+ * All rights reserved.  See the file COPYING in the top-level source
+ * directory for licensing information.
+ * ****************************************************************************
+ *
+ * Binary serialization of terms, types and problems.
+ */
+
+#include "cvc5_private.h"
+
+#ifndef CVC5__EXPR__NODE_SERIALIZER_H
+#define CVC5__EXPR__NODE_SERIALIZER_H
+
+#include <cvc5/cvc5_export.h>
+
+#include <cstdint>
+#include <iosfwd>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "expr/node.h"
+#include "expr/type_node.h"
+
+namespace cvc5::internal {
+
+class FloatingPointSize;
+class NodeManager;
+
+/**
+ * The records of the binary format.
+ *
+ * A binary file starts with a header, consisting of the magic string
+ * "cvc5bin\n" and the version of the format, followed by a sequence of
+ * records, each starting with a byte for its kind. All integers are encoded
+ * as unsigned LEB128, strings by their length followed by their characters.
+ *
+ * The definitions of terms and types are numbered consecutively, starting
+ * from zero. They refer to their children by the difference of their own
+ * number and the number of the child, which has been defined before. Thus,
+ * every term and type is written only once, and the size of the file is
+ * linear in the size of the DAG of its terms. Kinds are referred to by the
+ * index of a KIND record giving their name, so that the format does not
+ * depend on the numbering of kinds.
+ */
+enum class BinaryRecord : uint8_t
+{
+  /** The end of the input */
+  END = 0,
+  /** A kind: <name> */
+  KIND,
+  /** A type constant: <kind> <payload> */
+  TYPE_CONST,
+  /** An uninterpreted sort or sort constructor: <name> <arity> */
+  TYPE_SORT,
+  /** A type with children: <kind> <#children> <child>* */
+  TYPE_APP,
+  /** A constant term: <kind> <payload> */
+  TERM_CONST,
+  /** A free or bound variable or a nullary operator: <kind> <name> <type> */
+  TERM_VAR,
+  /** A term with children: <kind> <#children> <operator>? <child>* */
+  TERM_APP,
+  /** The logic: <name> */
+  LOGIC,
+  /** The declaration of a sort: <type> */
+  DECLARE_SORT,
+  /** The declaration of a free variable: <term> */
+  DECLARE_FUN,
+  /** An assertion: <term> */
+  ASSERT,
+  /** A term without a particular role: <term> */
+  TERM,
+  /** A check for satisfiability of the assertions */
+  CHECK_SAT,
+};
+
+/**
+ * Writes terms, types and problems in the binary format to an output stream.
+ *
+ * Terms and types are shared between all records written by the same
+ * serializer. Skolems, datatypes and constants other than those of the
+ * arithmetic, bit-vector, floating-point and string theories are not
+ * supported.
+ */
+class CVC5_EXPORT NodeSerializer
+{
+ public:
+  /** Writes the header to out */
+  NodeSerializer(std::ostream& out);
+  /** Write the logic */
+  void writeLogic(const std::string& logic);
+  /** Write the declaration of an uninterpreted sort or sort constructor */
+  void writeDeclareSort(const TypeNode& tn);
+  /** Write the declaration of a free variable */
+  void writeDeclareFun(TNode n);
+  /** Write an assertion */
+  void writeAssert(TNode n);
+  /** Write a term */
+  void writeTerm(TNode n);
+  /** Write a check for satisfiability */
+  void writeCheckSat();
+  /** Write the end of the input, after which nothing may be written */
+  void finish();
+
+ private:
+  /** Write the definitions of n and all its subterms, return the id of n */
+  uint64_t addNode(TNode n);
+  /** Write the definitions of tn and all its subtypes, return its id */
+  uint64_t addType(const TypeNode& tn);
+  /** Write the definition of n, whose subterms have been written */
+  void writeNodeDefinition(TNode n);
+  /** Write the payload of constant n */
+  void writeNodePayload(TNode n);
+  /** Write the payload of type constant tn */
+  void writeTypePayload(const TypeNode& tn);
+  /** Write a record referring to a term or type */
+  void writeRecord(BinaryRecord r, uint64_t id);
+  /** Write a reference to the term or type with the given id */
+  void writeRef(uint64_t id);
+  /** Write the KIND record for k, unless it has been written before */
+  void declareKind(Kind k);
+  /** Write the index of kind k, whose KIND record has been written */
+  void writeKind(Kind k);
+  /** Write an unsigned integer */
+  void writeUnsigned(uint64_t val);
+  /** Write a string */
+  void writeString(const std::string& s);
+  /** Write an arbitrary precision integer */
+  void writeInteger(const Integer& i);
+  /** Write the size of a floating-point type */
+  void writeFloatingPointSize(const FloatingPointSize& fps);
+  /** Write a record kind */
+  void writeRecordKind(BinaryRecord r);
+  /** The stream we write to */
+  std::ostream& d_out;
+  /** The ids of the terms that have been written */
+  std::unordered_map<Node, uint64_t> d_nodeIds;
+  /** The ids of the types that have been written */
+  std::unordered_map<TypeNode, uint64_t> d_typeIds;
+  /** The indices of the kinds that have been written, or -1 */
+  std::vector<int64_t> d_kindIndex;
+  /** The number of kinds that have been written */
+  uint64_t d_numKinds;
+  /** The id of the next term or type */
+  uint64_t d_nextId;
+};
+
+/**
+ * Reads terms, types and problems in the binary format, either from an input
+ * stream or from a buffer, e.g., a memory-mapped file.
+ *
+ * Free variables and sorts are created fresh, i.e., they are distinct from
+ * the variables and sorts of any other input. Throws an Exception if the
+ * input is malformed.
+ */
+class CVC5_EXPORT NodeDeserializer
+{
+ public:
+  /** A record with a role, i.e., a record that does not define a term */
+  struct Record
+  {
+    /** The kind of the record */
+    BinaryRecord d_kind;
+    /** The term, for DECLARE_FUN, ASSERT and TERM */
+    Node d_node;
+    /** The type, for DECLARE_SORT */
+    TypeNode d_type;
+    /** The logic, for LOGIC */
+    std::string d_logic;
+  };
+  /** Read from the given input stream */
+  NodeDeserializer(NodeManager* nm, std::istream& in);
+  /** Read from the given buffer, which must remain valid */
+  NodeDeserializer(NodeManager* nm, const char* buffer, size_t size);
+  /**
+   * Read the records up to and including the next one that is not the
+   * definition of a term or type. Returns false if the end of the input was
+   * reached instead, including if it ended without an END record.
+   */
+  bool next(Record& r);
+
+ private:
+  /** Read and check the header */
+  void readHeader();
+  /** Read the definition of a term or type */
+  void readDefinition(BinaryRecord r);
+  /** Read the payload of a constant of kind k */
+  Node readNodePayload(Kind k);
+  /** Read the payload of a type constant of kind k */
+  TypeNode readTypePayload(Kind k);
+  /** Raise an error if kind k does not allow nchildren children */
+  void checkArity(Kind k, uint64_t nchildren) const;
+  /** Read a reference to a term */
+  Node readNodeRef();
+  /** Read a reference to a type */
+  TypeNode readTypeRef();
+  /** Read a reference, return the id */
+  uint64_t readRef();
+  /** Read the index of a kind, return the kind */
+  Kind readKind();
+  /** Read an unsigned integer */
+  uint64_t readUnsigned();
+  /** Read an unsigned integer that fits into 32 bits */
+  uint32_t readUnsigned32();
+  /** Read the size of a bit-vector, which must be positive */
+  uint32_t readBitVectorSize();
+  /** Read a valid floating-point size */
+  FloatingPointSize readFloatingPointSize();
+  /** Read a string */
+  std::string readString();
+  /** Read an arbitrary precision integer */
+  Integer readInteger();
+  /** Read a byte, return -1 at the end of the input */
+  int readByte()
+  {
+    if (d_pos == d_end && !fill())
+    {
+      return -1;
+    }
+    return static_cast<unsigned char>(*d_pos++);
+  }
+  /** Read a byte, which must exist */
+  uint8_t readByteChecked();
+  /** Refill the buffer from the stream, return false at the end */
+  bool fill();
+  /** Raise an error about malformed input */
+  [[noreturn]] void error(const std::string& msg) const;
+  /** The node manager */
+  NodeManager* d_nm;
+  /** The input stream, if we read from a stream */
+  std::istream* d_in;
+  /** The buffer for reading from the stream */
+  std::vector<char> d_buffer;
+  /** The current position in the input */
+  const char* d_pos;
+  /** The end of the available input */
+  const char* d_end;
+  /** The terms, indexed by their id, or null for types */
+  std::vector<Node> d_nodes;
+  /** The types, indexed by their id, or null for terms */
+  std::vector<TypeNode> d_types;
+  /** The kinds, indexed by the index of their KIND record */
+  std::vector<Kind> d_kinds;
+  /** Whether we have read an END record */
+  bool d_finished;
+};
+
+}  // namespace cvc5::internal
+
+#endif /* CVC5__EXPR__NODE_SERIALIZER_H */
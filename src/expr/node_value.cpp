@@ -95,6 +95,80 @@ std::ostream& operator<<(std::ostream& out, const NodeValue& nv)
   return out;
 }
 
+void NodeValue::incShared()
+{
+  uint32_t rc = __atomic_load_n(&d_rc, __ATOMIC_RELAXED);
+  // increments of a live node value below the maximum need no lock
+  while (rc > 0 && rc < MAX_RC - 1)
+  {
+    if (__atomic_compare_exchange_n(
+            &d_rc, &rc, rc + 1, true, __ATOMIC_RELAXED, __ATOMIC_RELAXED))
+    {
+      return;
+    }
+  }
+  if (rc == MAX_RC)
+  {
+    return;
+  }
+  NodeManager* nm = NodeManager::currentNM();
+  Assert(nm != nullptr && nm->isShared())
+      << "No current shared NodeManager on incrementing of a shared "
+         "NodeValue: maybe a thread is missing a NodeManagerScope ?";
+  NodeManager::SharedLock lock(nm);
+  rc = __atomic_load_n(&d_rc, __ATOMIC_ACQUIRE);
+  do
+  {
+    if (rc == MAX_RC)
+    {
+      return;
+    }
+  } while (!__atomic_compare_exchange_n(
+      &d_rc, &rc, rc + 1, true, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE));
+  if (rc + 1 == MAX_RC)
+  {
+    nm->markRefCountMaxedOut(this);
+  }
+}
+
+void NodeValue::decShared()
+{
+  uint32_t rc = __atomic_load_n(&d_rc, __ATOMIC_RELAXED);
+  // decrements that do not zombify this node value need no lock
+  while (rc > 1 && rc < MAX_RC)
+  {
+    if (__atomic_compare_exchange_n(
+            &d_rc, &rc, rc - 1, true, __ATOMIC_RELEASE, __ATOMIC_RELAXED))
+    {
+      return;
+    }
+  }
+  if (rc == MAX_RC)
+  {
+    return;
+  }
+  NodeManager* nm = NodeManager::currentNM();
+  Assert(nm != nullptr && nm->isShared())
+      << "No current shared NodeManager on decrementing of a shared "
+         "NodeValue: maybe a thread is missing a NodeManagerScope ?";
+  NodeManager::SharedLock lock(nm);
+  // the reference count may have been incremented concurrently, but it is
+  // neither zombified nor resurrected by another thread while we hold the lock
+  rc = __atomic_load_n(&d_rc, __ATOMIC_ACQUIRE);
+  do
+  {
+    if (rc == MAX_RC)
+    {
+      return;
+    }
+  } while (!__atomic_compare_exchange_n(
+      &d_rc, &rc, rc - 1, true, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE));
+  if (rc == 1)
+  {
+    nm->markForDeletion(this);
+  }
+}
+
 void NodeValue::markRefCountMaxedOut()
 {
   Assert(NodeManager::currentNM() != nullptr)
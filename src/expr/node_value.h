@@ -168,15 +168,22 @@ class CVC5_EXPORT NodeValue
   static constexpr uint32_t NBITS_ID = 40;
   /** Number of bits reserved for number of children. */
   static const uint32_t NBITS_NCHILDREN = 26;
-  static_assert(NBITS_REFCOUNT + NBITS_KIND + NBITS_ID + NBITS_NCHILDREN == 96,
-                "NodeValue header bit assignment does not sum to 96 !");
-  /* ------------------- This header fits into 96 bits ---------------------- */
+  static_assert(NBITS_KIND + NBITS_ID + 1 + NBITS_NCHILDREN <= 96,
+                "NodeValue header bit assignment does not fit into 96 bits !");
+  /*
+   * This header fits into 128 bits, where the reference count is a word of its
+   * own, such that it can be updated atomically (see incShared()). Only
+   * NBITS_REFCOUNT bits of it are used.
+   */
 
   /** Maximum number of children possible. */
   static constexpr uint32_t MAX_CHILDREN =
       (static_cast<uint32_t>(1) << NBITS_NCHILDREN) - 1;
 
-  uint32_t getRefCount() const { return d_rc; }
+  uint32_t getRefCount() const
+  {
+    return __atomic_load_n(&d_rc, __ATOMIC_RELAXED);
+  }
 
   NodeValue* getOperator() const;
   NodeValue* getChild(int i) const;
@@ -294,6 +301,11 @@ class CVC5_EXPORT NodeValue
 
   void inc()
   {
+    if (__builtin_expect(d_shared, false))
+    {
+      incShared();
+      return;
+    }
     if (__builtin_expect((d_rc < MAX_RC - 1), true))
     {
       ++d_rc;
@@ -307,7 +319,11 @@ class CVC5_EXPORT NodeValue
 
   void dec()
   {
-    // FIXME multithreading
+    if (__builtin_expect(d_shared, false))
+    {
+      decShared();
+      return;
+    }
     if (__builtin_expect((d_rc < MAX_RC), true))
     {
       --d_rc;
@@ -318,6 +334,17 @@ class CVC5_EXPORT NodeValue
     }
   }
 
+  /**
+   * inc() and dec() for node values of a shared node manager, which may be
+   * referenced by several threads. The reference count is updated atomically.
+   * The transitions from and to zero, i.e., the resurrection of a zombie and
+   * the zombification of a node value, as well as maxing out the reference
+   * count, are done while holding the lock of the node manager, which also
+   * protects its pool and its zombies.
+   */
+  void incShared();
+  void decShared();
+
   void markRefCountMaxedOut();
   void markForDeletion();
 
@@ -349,15 +376,18 @@ class CVC5_EXPORT NodeValue
   /** The ID (0 is reserved for the null value) */
   uint64_t d_id : NBITS_ID;
 
-  /** The expression's reference count. */
-  uint32_t d_rc : NBITS_REFCOUNT;
-
   /** Kind of the expression */
   uint32_t d_kind : NBITS_KIND;
 
+  /** Whether this node value was created by a shared node manager */
+  uint32_t d_shared : 1;
+
   /** Number of children */
   uint32_t d_nchildren : NBITS_NCHILDREN;
 
+  /** The expression's reference count. */
+  uint32_t d_rc;
+
   /** Variable number of child nodes */
   NodeValue* d_children[0];
 }; /* class NodeValue */
@@ -414,9 +444,10 @@ std::ostream& operator<<(std::ostream& out, const NodeValue& nv);
 
 inline NodeValue::NodeValue(int) :
   d_id(0),
-  d_rc(MAX_RC),
   d_kind(kind::NULL_EXPR),
-  d_nchildren(0) {
+  d_shared(0),
+  d_nchildren(0),
+  d_rc(MAX_RC) {
 }
 
 inline void NodeValue::decrRefCounts() {
@@ -0,0 +1,88 @@
+/******************************************************************************
+ * Top contributors (to current version):
+ *   agent
+ *
+ * This file is part of the cvc5 project.
+ *
+ * Copyright (c) 2009-2023 by the authors listed in the file AUTHORS
+ * in the top-level source directory and their institutional affiliations.
+ * All rights reserved.  See the file COPYING in the top-level source
+ * directory for licensing information.
+ * ****************************************************************************
+ *
+ * Slab allocator for node values.
+ */
+
+#include "expr/node_value_arena.h"
+
+#include <cstdlib>
+#include <new>
+
+#include "base/check.h"
+#include "expr/node_value.h"
+
+namespace cvc5::internal {
+namespace expr {
+
+NodeValueArena::NodeValueArena() : d_cur(nullptr), d_end(nullptr)
+{
+  for (uint32_t i = 0; i <= MAX_CHILDREN; i++)
+  {
+    d_free[i] = nullptr;
+  }
+}
+
+NodeValueArena::~NodeValueArena()
+{
+  for (char* slab : d_slabs)
+  {
+    std::free(slab);
+  }
+}
+
+size_t NodeValueArena::getBlockSize(uint32_t nchildren)
+{
+  return sizeof(NodeValue) + sizeof(NodeValue*) * nchildren;
+}
+
+NodeValue* NodeValueArena::allocate(uint32_t nchildren)
+{
+  Assert(isArenaAllocated(nchildren));
+  FreeBlock* fb = d_free[nchildren];
+  if (fb != nullptr)
+  {
+    d_free[nchildren] = fb->d_next;
+    return reinterpret_cast<NodeValue*>(fb);
+  }
+  size_t size = getBlockSize(nchildren);
+  if (d_cur == nullptr || static_cast<size_t>(d_end - d_cur) < size)
+  {
+    // the rest of the current slab is too small, it is not used
+    char* slab = static_cast<char*>(std::malloc(SLAB_SIZE));
+    if (slab == nullptr)
+    {
+      throw std::bad_alloc();
+    }
+    d_slabs.push_back(slab);
+    d_cur = slab;
+    d_end = slab + SLAB_SIZE;
+  }
+  NodeValue* nv = reinterpret_cast<NodeValue*>(d_cur);
+  d_cur += size;
+  return nv;
+}
+
+void NodeValueArena::deallocate(NodeValue* nv, uint32_t nchildren)
+{
+  Assert(isArenaAllocated(nchildren));
+  static_assert(sizeof(NodeValue) >= sizeof(FreeBlock),
+                "node values must be able to hold a free block");
+  FreeBlock* fb = reinterpret_cast<FreeBlock*>(nv);
+  fb->d_next = d_free[nchildren];
+  d_free[nchildren] = fb;
+}
+
+size_t NodeValueArena::getNumSlabs() const { return d_slabs.size(); }
+
+}  // namespace expr
+}  // namespace cvc5::internal
@@ -0,0 +1,95 @@
+/******************************************************************************
+ * Top contributors (to current version):
+ *   agent
+ *
+ * This file is part of the cvc5 project.
+ *
+ * Copyright (c) 2009-2023 by the authors listed in the file AUTHORS
+ * in the top-level source directory and their institutional affiliations.
+ * All rights reserved.  See the file COPYING in the top-level source
+ * directory for licensing information.
+ * ****************************************************************************
+ *
+ * Slab allocator for node values.
+ */
+
+#include "cvc5_private.h"
+
+#ifndef CVC5__EXPR__NODE_VALUE_ARENA_H
+#define CVC5__EXPR__NODE_VALUE_ARENA_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace cvc5::internal {
+namespace expr {
+
+class NodeValue;
+
+/**
+ * An allocator for the node values of a node manager that have few children.
+ *
+ * Node values are carved out of large slabs, one size class per number of
+ * children. Deallocated node values are put on the free list of their size
+ * class and are reused by the next allocation of that class. Compared to
+ * allocating each node value with malloc, this avoids the per-allocation
+ * overhead of the system allocator, and keeps node values that are created
+ * together close to each other in memory, which benefits traversals.
+ *
+ * The memory of the slabs is only returned to the system when the arena is
+ * destroyed.
+ */
+class NodeValueArena
+{
+ public:
+  /** The maximal number of children of a node value allocated in an arena */
+  static constexpr uint32_t MAX_CHILDREN = 10;
+  /** The size of the slabs */
+  static constexpr size_t SLAB_SIZE = static_cast<size_t>(1) << 16;
+
+  NodeValueArena();
+  ~NodeValueArena();
+  NodeValueArena(const NodeValueArena&) = delete;
+  NodeValueArena& operator=(const NodeValueArena&) = delete;
+
+  /** Are node values with nchildren children allocated in an arena? */
+  static bool isArenaAllocated(uint32_t nchildren)
+  {
+    return nchildren <= MAX_CHILDREN;
+  }
+  /**
+   * Allocate memory for a node value with nchildren children, which must be
+   * at most MAX_CHILDREN. The returned memory is uninitialized.
+   */
+  NodeValue* allocate(uint32_t nchildren);
+  /**
+   * Deallocate the memory of nv, which was allocated by this arena for
+   * nchildren children.
+   */
+  void deallocate(NodeValue* nv, uint32_t nchildren);
+  /** Get the number of slabs allocated so far */
+  size_t getNumSlabs() const;
+
+ private:
+  /** A deallocated block, linked in the free list of its size class */
+  struct FreeBlock
+  {
+    FreeBlock* d_next;
+  };
+  /** The size in bytes of a node value with nchildren children */
+  static size_t getBlockSize(uint32_t nchildren);
+  /** The free lists, one for each number of children */
+  FreeBlock* d_free[MAX_CHILDREN + 1];
+  /** The slabs */
+  std::vector<char*> d_slabs;
+  /** The unused part of the last slab */
+  char* d_cur;
+  /** The end of the last slab */
+  char* d_end;
+};
+
+}  // namespace expr
+}  // namespace cvc5::internal
+
+#endif /* CVC5__EXPR__NODE_VALUE_ARENA_H */
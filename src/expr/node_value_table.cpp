@@ -0,0 +1,149 @@
+/******************************************************************************
+ * Top contributors (to current version):
+ *   agent
+ *
+ * This file is part of the cvc5 project.
+ *
+ * Copyright (c) 2009-2023 by the authors listed in the file AUTHORS
+ * in the top-level source directory and their institutional affiliations.
+ * All rights reserved.  See the file COPYING in the top-level source
+ * directory for licensing information.
+ * ****************************************************************************
+ *
+ * Open-addressing hash table of node values, used for hash-consing.
+ */
+
+#include "expr/node_value_table.h"
+
+#include <cstdint>
+
+#include "base/check.h"
+#include "expr/metakind.h"
+#include "expr/node_value.h"
+
+namespace cvc5::internal {
+namespace expr {
+
+namespace {
+/** The initial number of entries, must be a power of two */
+constexpr size_t s_initialCapacity = static_cast<size_t>(1) << 12;
+}  // namespace
+
+NodeValueTable::NodeValueTable()
+    : d_entries(s_initialCapacity, Entry{nullptr, 0}),
+      d_mask(s_initialCapacity - 1),
+      d_size(0)
+{
+}
+
+size_t NodeValueTable::hash(const NodeValue* nv)
+{
+  // The pool hash of node values is a combination of the identifiers of their
+  // children, whose low bits are not well distributed. We mix them as in the
+  // finalizer of MurmurHash3, since we use the low bits as index.
+  uint64_t h = static_cast<uint64_t>(nv->poolHash());
+  h ^= h >> 33;
+  h *= 0xff51afd7ed558ccdULL;
+  h ^= h >> 33;
+  h *= 0xc4ceb9fe1a85ec53ULL;
+  h ^= h >> 33;
+  return static_cast<size_t>(h);
+}
+
+size_t NodeValueTable::findIndex(const NodeValue* nv, size_t h) const
+{
+  NodeValuePoolEq eq;
+  size_t i = h & d_mask;
+  while (d_entries[i].d_nv != nullptr)
+  {
+    const Entry& e = d_entries[i];
+    if (e.d_hash == h && (e.d_nv == nv || eq(nv, e.d_nv)))
+    {
+      return i;
+    }
+    i = (i + 1) & d_mask;
+  }
+  return i;
+}
+
+NodeValue* NodeValueTable::find(const NodeValue* nv) const
+{
+  return d_entries[findIndex(nv, hash(nv))].d_nv;
+}
+
+void NodeValueTable::insert(NodeValue* nv)
+{
+  // keep the load factor below 3/4
+  if (4 * (d_size + 1) > 3 * d_entries.size())
+  {
+    grow();
+  }
+  size_t h = hash(nv);
+  size_t i = findIndex(nv, h);
+  Assert(d_entries[i].d_nv == nullptr) << "NodeValue already in the pool!";
+  d_entries[i].d_nv = nv;
+  d_entries[i].d_hash = h;
+  d_size++;
+}
+
+void NodeValueTable::erase(NodeValue* nv)
+{
+  size_t i = findIndex(nv, hash(nv));
+  Assert(d_entries[i].d_nv == nv) << "NodeValue is not in the pool!";
+  // Move back the entries after i that would not be found anymore once i is
+  // empty, i.e. those whose home index is not in the cyclic range (i, j].
+  size_t j = i;
+  for (;;)
+  {
+    j = (j + 1) & d_mask;
+    if (d_entries[j].d_nv == nullptr)
+    {
+      break;
+    }
+    size_t k = d_entries[j].d_hash & d_mask;
+    bool stays = i <= j ? (i < k && k <= j) : (i < k || k <= j);
+    if (!stays)
+    {
+      d_entries[i] = d_entries[j];
+      i = j;
+    }
+  }
+  d_entries[i].d_nv = nullptr;
+  d_size--;
+}
+
+size_t NodeValueTable::size() const { return d_size; }
+
+void NodeValueTable::getNodeValues(std::vector<NodeValue*>& nvs) const
+{
+  for (const Entry& e : d_entries)
+  {
+    if (e.d_nv != nullptr)
+    {
+      nvs.push_back(e.d_nv);
+    }
+  }
+}
+
+void NodeValueTable::grow()
+{
+  std::vector<Entry> old(2 * d_entries.size(), Entry{nullptr, 0});
+  old.swap(d_entries);
+  d_mask = d_entries.size() - 1;
+  for (const Entry& e : old)
+  {
+    if (e.d_nv != nullptr)
+    {
+      // the hash is stored, and the node values are distinct
+      size_t i = e.d_hash & d_mask;
+      while (d_entries[i].d_nv != nullptr)
+      {
+        i = (i + 1) & d_mask;
+      }
+      d_entries[i] = e;
+    }
+  }
+}
+
+}  // namespace expr
+}  // namespace cvc5::internal
@@ -0,0 +1,83 @@
+/******************************************************************************
+ * Top contributors (to current version):
+ *   agent
+ *
+ * This file is part of the cvc5 project.
+ *
+ * Copyright (c) 2009-2023 by the authors listed in the file AUTHORS
+ * in the top-level source directory and their institutional affiliations.
+ * All rights reserved.  See the file COPYING in the top-level source
+ * directory for licensing information.
+ * ****************************************************************************
+ *
+ * Open-addressing hash table of node values, used for hash-consing.
+ */
+
+#include "cvc5_private.h"
+
+#ifndef CVC5__EXPR__NODE_VALUE_TABLE_H
+#define CVC5__EXPR__NODE_VALUE_TABLE_H
+
+#include <cstddef>
+#include <vector>
+
+namespace cvc5::internal {
+namespace expr {
+
+class NodeValue;
+
+/**
+ * The pool of a node manager, which maps node values to the unique node value
+ * in the pool that is equal to them, where equality and hashing are the ones
+ * of NodeValuePoolEq and NodeValue::poolHash. In particular, lookups may use
+ * node values that are not fully constructed, see NodeManager::poolLookup.
+ *
+ * This is a hash table with open addressing and linear probing, where each
+ * entry stores the node value together with its hash. Hence, a lookup
+ * usually inspects a few consecutive entries, and only compares node values
+ * whose hash is equal. Deleting a node value moves back the entries following
+ * it, hence the table has no tombstones.
+ */
+class NodeValueTable
+{
+ public:
+  NodeValueTable();
+  /** Get the node value equal to nv, or nullptr if none exists */
+  NodeValue* find(const NodeValue* nv) const;
+  /** Insert nv, which must not be equal to a node value of this table */
+  void insert(NodeValue* nv);
+  /** Remove nv, which must be in this table */
+  void erase(NodeValue* nv);
+  /** Get the number of node values in this table */
+  size_t size() const;
+  /** Get the node values in this table */
+  void getNodeValues(std::vector<NodeValue*>& nvs) const;
+
+ private:
+  /** An entry of the table, which is empty if d_nv is nullptr */
+  struct Entry
+  {
+    NodeValue* d_nv;
+    size_t d_hash;
+  };
+  /** The hash of nv, which mixes the bits of its pool hash */
+  static size_t hash(const NodeValue* nv);
+  /**
+   * Get the index of the entry of the node value equal to nv whose hash is h,
+   * or of the empty entry where it would be inserted.
+   */
+  size_t findIndex(const NodeValue* nv, size_t h) const;
+  /** Double the capacity of this table */
+  void grow();
+  /** The entries, whose number is a power of two */
+  std::vector<Entry> d_entries;
+  /** The number of entries minus one */
+  size_t d_mask;
+  /** The number of node values in this table */
+  size_t d_size;
+};
+
+}  // namespace expr
+}  // namespace cvc5::internal
+
+#endif /* CVC5__EXPR__NODE_VALUE_TABLE_H */
@@ -122,6 +122,7 @@ Node SkolemManager::mkPurifySkolem(Node t,
                                    int flags,
                                    ProofGenerator* pg)
 {
+  NodeManager::SharedLock lock(NodeManager::currentNM());
   // We do not recursively compute the original form of t here
   Node k;
   if (t.getKind() == WITNESS)
@@ -161,6 +162,7 @@ Node SkolemManager::mkSkolemFunction(SkolemFunId id,
                                      Node cacheVal,
                                      int flags)
 {
+  NodeManager::SharedLock lock(NodeManager::currentNM());
   std::tuple<SkolemFunId, TypeNode, Node> key(id, tn, cacheVal);
   std::map<std::tuple<SkolemFunId, TypeNode, Node>, Node>::iterator it =
       d_skolemFuns.find(key);
@@ -198,6 +200,7 @@ bool SkolemManager::isSkolemFunction(TNode k,
                                      SkolemFunId& id,
                                      Node& cacheVal) const
 {
+  NodeManager::SharedLock lock(NodeManager::currentNM());
   std::map<Node, std::tuple<SkolemFunId, TypeNode, Node>>::const_iterator it =
       d_skolemFunMap.find(k);
   if (it == d_skolemFunMap.end())
@@ -230,6 +233,7 @@ Node SkolemManager::mkDummySkolem(const std::string& prefix,
 
 ProofGenerator* SkolemManager::getProofGenerator(Node t) const
 {
+  NodeManager::SharedLock lock(NodeManager::currentNM());
   std::map<Node, ProofGenerator*>::const_iterator it = d_gens.find(t);
   if (it != d_gens.end())
   {
@@ -362,6 +366,7 @@ Node SkolemManager::mkSkolemInternal(Node w,
 {
   // note that witness, original forms are independent, but share skolems
   // w is not necessarily a witness term
+  NodeManager::SharedLock lock(NodeManager::currentNM());
   SkolemFormAttribute sfa;
   // could already have a skolem if we used w already
   if (w.hasAttribute(sfa))
@@ -383,6 +388,7 @@ Node SkolemManager::mkSkolemNode(const std::string& prefix,
                                  int flags)
 {
   NodeManager* nm = NodeManager::currentNM();
+  NodeManager::SharedLock lock(nm);
   Node n;
   if (flags & SKOLEM_BOOL_TERM_VAR)
   {
@@ -138,6 +138,8 @@ int runCvc5(int argc, char* argv[], std::unique_ptr<cvc5::Solver>& solver)
                 || (len >= 3 && !strcmp(".sl", filename + len - 3))) {
         // version 2 sygus is the default
         solver->setOption("input-language", "sygus2");
+      } else if(len >= 6 && !strcmp(".cvc5b", filename + len - 6)) {
+        solver->setOption("input-language", "binary");
       }
     }
   }
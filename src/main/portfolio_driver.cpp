@@ -14,6 +14,7 @@
 #include "main/portfolio_driver.h"
 
 #if HAVE_SYS_WAIT_H
+#include <fcntl.h>
 #include <signal.h>
 #include <sys/wait.h>
 #include <unistd.h>
@@ -21,9 +22,15 @@
 
 #include <cvc5/cvc5.h>
 
+#include <algorithm>
 #include <chrono>
+#include <cstdio>
 #include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <limits>
 #include <optional>
+#include <sstream>
 #include <thread>
 
 #include "base/check.h"
@@ -39,6 +46,10 @@ enum SolveStatus : int
 {
   STATUS_SOLVED = 0,
   STATUS_UNSOLVED = 1,
+  /** All partitions assigned to a partition worker are unsat. */
+  STATUS_REFUTED = 2,
+  /** The input was partitioned and the partitions remain to be solved. */
+  STATUS_PARTITIONED = 3,
 };
 
 bool ExecutionContext::solveContinuous(parser::InputParser* parser,
@@ -408,6 +419,341 @@ class PortfolioProcessPool
   const uint64_t d_timeout;
 };
 
+/**
+ * Create a new, empty temporary file and return its name.
+ */
+std::string makeTempFile(const std::string& prefix)
+{
+  std::string tmpl =
+      (std::filesystem::temp_directory_path() / (prefix + "XXXXXX")).string();
+  std::vector<char> name(tmpl.begin(), tmpl.end());
+  name.push_back('\0');
+  int fd = mkstemp(name.data());
+  if (fd == -1)
+  {
+    throw internal::Exception("Unable to create temporary file");
+  }
+  close(fd);
+  return name.data();
+}
+
+/**
+ * Solves the input by cube-and-conquer within cvc5 itself, based on the
+ * partitions generated via --compute-partitions.
+ *
+ * In a first phase, a worker process solves the input while generating the
+ * partitions (cubes) into a temporary file. If this already determines the
+ * result (sat, or unsat without any cubes emitted), we are done. Otherwise,
+ * in a second phase, the cubes are distributed over --partition-solve-jobs
+ * worker processes that solve them via checkSatAssuming. The input is sat as
+ * soon as one cube is sat, and unsat if all cubes are unsat.
+ *
+ * Workers share what they learn: the negation of every refuted cube is
+ * entailed by the input and is appended to a shared file, from which all
+ * other workers assert it before solving their next cube. For cubes of a
+ * single literal, these are unit literals.
+ *
+ * This requires the input to have exactly one check-sat command, otherwise
+ * the input is solved as usual.
+ */
+class PartitionProcessPool
+{
+ public:
+  PartitionProcessPool(ExecutionContext& ctx, parser::InputParser* parser)
+      : d_ctx(ctx),
+        d_parser(parser),
+        d_numJobs(
+            ctx.solver().getOptionInfo("partition-solve-jobs").uintValue())
+  {
+  }
+
+  bool run()
+  {
+    d_commands = d_ctx.parseCommands(d_parser);
+    size_t numCheckSat = 0;
+    for (size_t i = 0, size = d_commands.size(); i < size; ++i)
+    {
+      Command* cmd = d_commands[i].get();
+      if (dynamic_cast<CheckSatCommand*>(cmd) != nullptr)
+      {
+        d_checkSatIndex = i;
+        ++numCheckSat;
+      }
+      else if (dynamic_cast<CheckSatAssumingCommand*>(cmd) != nullptr)
+      {
+        ++numCheckSat;
+      }
+    }
+    if (numCheckSat != 1 || d_checkSatIndex >= d_commands.size())
+    {
+      Warning() << "Can only solve partitions for inputs with a single "
+                   "check-sat command."
+                << std::endl;
+      return d_ctx.solveCommands(d_commands);
+    }
+
+    d_cubesFile = makeTempFile("cvc5-cubes-");
+    d_learnedFile = makeTempFile("cvc5-learned-");
+    bool res = solve();
+    std::remove(d_cubesFile.c_str());
+    std::remove(d_learnedFile.c_str());
+    return res;
+  }
+
+ private:
+  /** A worker process and the pipes capturing its output. */
+  struct Worker
+  {
+    pid_t d_pid = -1;
+    Pipe d_errPipe;
+    Pipe d_outPipe;
+  };
+
+  bool solve()
+  {
+    // Phase 1: solve the input while generating the partitions.
+    Worker partitioner;
+    startWorker(partitioner, [this]() { return partition(); });
+    int wstatus = 0;
+    waitpid(partitioner.d_pid, &wstatus, 0);
+    if (!WIFEXITED(wstatus)
+        || WEXITSTATUS(wstatus) != SolveStatus::STATUS_PARTITIONED)
+    {
+      partitioner.d_errPipe.flushTo(std::cerr);
+      partitioner.d_outPipe.flushTo(std::cout);
+      return WIFEXITED(wstatus)
+             && WEXITSTATUS(wstatus) == SolveStatus::STATUS_SOLVED;
+    }
+
+    std::vector<std::string> cubes;
+    std::ifstream cubesIn(d_cubesFile);
+    std::string line;
+    while (std::getline(cubesIn, line))
+    {
+      if (!line.empty())
+      {
+        cubes.push_back(line);
+      }
+    }
+    Trace("partition-solve") << "Solving " << cubes.size() << " partitions"
+                             << std::endl;
+
+    // Phase 2: distribute the cubes over the workers.
+    size_t numWorkers = std::min<size_t>(d_numJobs, cubes.size());
+    std::vector<Worker> workers(numWorkers);
+    for (size_t i = 0; i < numWorkers; ++i)
+    {
+      std::vector<std::string> assigned;
+      for (size_t j = i; j < cubes.size(); j += numWorkers)
+      {
+        assigned.push_back(cubes[j]);
+      }
+      startWorker(workers[i],
+                  [this, assigned]() { return solveCubes(assigned); });
+    }
+
+    bool incomplete = false;
+    for (size_t running = numWorkers; running > 0; --running)
+    {
+      pid_t child = wait(&wstatus);
+      auto it = std::find_if(
+          workers.begin(), workers.end(), [child](const Worker& w) {
+            return w.d_pid == child;
+          });
+      if (it == workers.end())
+      {
+        ++running;
+        continue;
+      }
+      if (WIFEXITED(wstatus)
+          && WEXITSTATUS(wstatus) == SolveStatus::STATUS_SOLVED)
+      {
+        Trace("partition-solve") << "Found sat partition" << std::endl;
+        for (const Worker& w : workers)
+        {
+          if (w.d_pid != child)
+          {
+            kill(w.d_pid, SIGKILL);
+            waitpid(w.d_pid, nullptr, 0);
+          }
+        }
+        it->d_errPipe.flushTo(std::cerr);
+        it->d_outPipe.flushTo(std::cout);
+        return true;
+      }
+      if (!WIFEXITED(wstatus)
+          || WEXITSTATUS(wstatus) != SolveStatus::STATUS_REFUTED)
+      {
+        incomplete = true;
+      }
+    }
+    d_ctx.solver().getDriverOptions().out()
+        << (incomplete ? "unknown" : "unsat") << std::endl;
+    return !incomplete;
+  }
+
+  /** Fork a worker process that runs `work` and exits with its status. */
+  template <typename Func>
+  void startWorker(Worker& worker, Func work)
+  {
+    worker.d_errPipe.open();
+    worker.d_outPipe.open();
+    worker.d_pid = fork();
+    if (worker.d_pid == -1)
+    {
+      throw internal::Exception("Unable to fork");
+    }
+    if (worker.d_pid == 0)
+    {
+      worker.d_errPipe.dup(STDERR_FILENO);
+      worker.d_outPipe.dup(STDOUT_FILENO);
+      SolveStatus rc = work();
+      d_ctx.d_executor->flushOutputStreams();
+      _exit(rc);
+    }
+    worker.d_errPipe.closeIn();
+    worker.d_outPipe.closeIn();
+  }
+
+  /** Execute the commands in the range [begin, end). */
+  bool runCommands(size_t begin, size_t end)
+  {
+    for (size_t i = begin; i < end; ++i)
+    {
+      Command* cmd = d_commands[i].get();
+      if (!d_ctx.d_executor->doCommand(cmd) || cmd->interrupted())
+      {
+        return false;
+      }
+      if (dynamic_cast<QuitCommand*>(cmd) != nullptr)
+      {
+        break;
+      }
+    }
+    return true;
+  }
+
+  /** Phase 1, run in a worker: solve the input and generate partitions. */
+  SolveStatus partition()
+  {
+    d_ctx.solver().setOption("write-partitions-to", d_cubesFile);
+    if (!runCommands(0, d_checkSatIndex + 1))
+    {
+      return SolveStatus::STATUS_UNSOLVED;
+    }
+    Result res = d_ctx.d_executor->getResult();
+    // Answering unsat after emitting cubes only means that all cubes have
+    // been emitted.
+    if (res.isUnsat() && std::filesystem::file_size(d_cubesFile) > 0)
+    {
+      return SolveStatus::STATUS_PARTITIONED;
+    }
+    if (!res.isSat() && !res.isUnsat())
+    {
+      return SolveStatus::STATUS_UNSOLVED;
+    }
+    runCommands(d_checkSatIndex + 1, d_commands.size());
+    return SolveStatus::STATUS_SOLVED;
+  }
+
+  /** Phase 2, run in a worker: solve the given cubes one by one. */
+  SolveStatus solveCubes(const std::vector<std::string>& cubes)
+  {
+    Solver& solver = d_ctx.solver();
+    solver.setOption("compute-partitions", "0");
+    solver.setOption("incremental", "true");
+    if (!runCommands(0, d_checkSatIndex))
+    {
+      return SolveStatus::STATUS_UNSOLVED;
+    }
+    for (const std::string& cube : cubes)
+    {
+      importLearned();
+      Term c = parseTerm(cube);
+      Trace("partition-solve") << "Solve partition " << c << std::endl;
+      Result res = solver.checkSatAssuming(c);
+      if (res.isSat())
+      {
+        solver.getDriverOptions().out() << res << std::endl;
+        runCommands(d_checkSatIndex + 1, d_commands.size());
+        return SolveStatus::STATUS_SOLVED;
+      }
+      if (!res.isUnsat())
+      {
+        return SolveStatus::STATUS_UNSOLVED;
+      }
+      exportLearned(c.notTerm());
+    }
+    return SolveStatus::STATUS_REFUTED;
+  }
+
+  /** Parse the given term in the current symbol context. */
+  Term parseTerm(const std::string& str)
+  {
+    InputParser ip(&d_ctx.solver(), d_parser->getSymbolManager());
+    ip.setIncrementalStringInput(d_ctx.solver().getOption("input-language"),
+                                 "partition");
+    ip.appendIncrementalStringInput(str);
+    return ip.nextExpression();
+  }
+
+  /** Append the learned formula to the file shared by all workers. */
+  void exportLearned(const Term& learned)
+  {
+    std::string line = learned.toString() + "\n";
+    int fd = open(d_learnedFile.c_str(), O_WRONLY | O_APPEND);
+    if (fd != -1)
+    {
+      // A single write in append mode is not interleaved with other writes.
+      ssize_t cnt = write(fd, line.c_str(), line.size());
+      (void)cnt;
+      close(fd);
+    }
+  }
+
+  /** Assert the formulas learned by other workers since the last import. */
+  void importLearned()
+  {
+    std::ifstream in(d_learnedFile);
+    in.seekg(d_learnedOffset);
+    std::stringstream ss;
+    ss << in.rdbuf();
+    std::string content = ss.str();
+    // Only consider complete lines.
+    size_t end = content.rfind('\n');
+    if (end == std::string::npos)
+    {
+      return;
+    }
+    d_learnedOffset += end + 1;
+    std::istringstream lines(content.substr(0, end));
+    std::string line;
+    while (std::getline(lines, line))
+    {
+      if (!line.empty())
+      {
+        Trace("partition-solve") << "Import learned " << line << std::endl;
+        d_ctx.solver().assertFormula(parseTerm(line));
+      }
+    }
+  }
+
+  ExecutionContext& d_ctx;
+  parser::InputParser* d_parser;
+  /** The number of workers solving the cubes in parallel. */
+  const uint64_t d_numJobs;
+  /** All commands of the input. */
+  std::vector<std::unique_ptr<Command>> d_commands;
+  /** The index of the check-sat command within d_commands. */
+  size_t d_checkSatIndex = std::numeric_limits<size_t>::max();
+  /** The file the cubes are written to. */
+  std::string d_cubesFile;
+  /** The file learned formulas are shared through. */
+  std::string d_learnedFile;
+  /** The offset up to which this worker imported d_learnedFile. */
+  std::streamoff d_learnedOffset = 0;
+};
+
 }  // namespace
 
 #endif
@@ -416,6 +762,17 @@ bool PortfolioDriver::solve(std::unique_ptr<CommandExecutor>& executor)
 {
   ExecutionContext ctx{executor.get()};
   Solver& solver = ctx.solver();
+  if (solver.getOptionInfo("partition-solve-jobs").uintValue() > 0
+      && solver.getOptionInfo("compute-partitions").uintValue() > 1)
+  {
+#if HAVE_SYS_WAIT_H
+    PartitionProcessPool pool(ctx, d_parser);
+    return pool.run();
+#else
+    Warning() << "Can't solve partitions without <sys/wait.h>.";
+    return ctx.solveContinuous(d_parser, false);
+#endif
+  }
   bool use_portfolio = solver.getOption("use-portfolio") == "true";
   if (!use_portfolio)
   {
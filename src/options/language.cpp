@@ -27,6 +27,7 @@ std::ostream& operator<<(std::ostream& out, Language lang)
     case Language::LANG_SMTLIB_V2_6: out << "LANG_SMTLIB_V2_6"; break;
     case Language::LANG_TPTP: out << "LANG_TPTP"; break;
     case Language::LANG_SYGUS_V2: out << "LANG_SYGUS_V2"; break;
+    case Language::LANG_BINARY: out << "LANG_BINARY"; break;
     default: out << "undefined_language";
   }
   return out;
@@ -51,6 +52,10 @@ Language toLanguage(const std::string& language)
   {
     return Language::LANG_SYGUS_V2;
   }
+  else if (language == "binary" || language == "LANG_BINARY")
+  {
+    return Language::LANG_BINARY;
+  }
   else if (language == "ast" || language == "LANG_AST")
   {
     return Language::LANG_AST;
@@ -38,6 +38,8 @@ enum class Language
   LANG_TPTP,
   /** The SyGuS language version 2.0 */
   LANG_SYGUS_V2,
+  /** The binary (input) format of cvc5 */
+  LANG_BINARY,
 
   /** The AST (output) language */
   LANG_AST,
@@ -122,6 +122,7 @@ Languages currently supported as arguments to the -L / --lang option:
   smt2.6 | smtlib2.6             SMT-LIB format 2.6 with support for the strings standard
   tptp                           TPTP format (cnf, fof and tff)
   sygus | sygus2                 SyGuS version 2.0
+  binary                         binary format of cvc5 (see Solver::writeBinary)
 
 Languages currently supported as arguments to the --output-lang option:
   auto                           match output language to input language
@@ -154,8 +155,11 @@ void OptionsHandler::setInputLanguage(const std::string& flag, Language lang)
   }
   if (!d_options->printer.outputLanguageWasSetByUser)
   {
-    d_options->writePrinter().outputLanguage = lang;
-    ioutils::setDefaultOutputLanguage(lang);
+    // the binary format is an input language only, we print in smt2 instead
+    Language olang =
+        lang == Language::LANG_BINARY ? Language::LANG_SMTLIB_V2_6 : lang;
+    d_options->writePrinter().outputLanguage = olang;
+    ioutils::setDefaultOutputLanguage(olang);
   }
 }
 
@@ -223,6 +227,20 @@ void OptionsHandler::setStatsDetail(const std::string& flag, bool value)
   }
 }
 
+void OptionsHandler::setStatsInterval(const std::string& flag, uint64_t value)
+{
+#ifndef CVC5_STATISTICS_ON
+  if (value > 0)
+  {
+    std::stringstream ss;
+    ss << "option `" << flag
+       << "' requires a statistics-enabled build of cvc5; this binary was not "
+          "built with statistics support";
+    throw OptionException(ss.str());
+  }
+#endif /* CVC5_STATISTICS_ON */
+}
+
 void OptionsHandler::enableTraceTag(const std::string& flag,
                                     const std::string& optarg)
 {
@@ -265,6 +283,27 @@ void OptionsHandler::setResourceWeight(const std::string& flag,
   d_options->writeBase().resourceWeightHolder.emplace_back(optarg);
 }
 
+void OptionsHandler::setResourceBudget(const std::string& flag,
+                                       const std::string& optarg)
+{
+  d_options->writeBase().resourceBudgetHolder.emplace_back(optarg);
+}
+
+void OptionsHandler::checkSatSolver(const std::string& flag,
+                                    CDCLTSatSolverMode m)
+{
+  if (m == CDCLTSatSolverMode::CADICAL
+      && !Configuration::isBuiltWithCadicalPropagator())
+  {
+    std::stringstream ss;
+    ss << "option `" << flag
+       << "' requires a build of cvc5 with a CaDiCaL version that supports "
+          "the external propagator interface (IPASIR-UP); this binary was "
+          "not built with it";
+    throw OptionException(ss.str());
+  }
+}
+
 void OptionsHandler::checkBvSatSolver(const std::string& flag, SatSolverMode m)
 {
   if (m == SatSolverMode::CRYPTOMINISAT
@@ -370,6 +409,8 @@ void OptionsHandler::showConfiguration(const std::string& flag, bool value)
 
   print_config_cond("cln", Configuration::isBuiltWithCln());
   print_config_cond("glpk", Configuration::isBuiltWithGlpk());
+  print_config_cond("cadical-propagator",
+                    Configuration::isBuiltWithCadicalPropagator());
   print_config_cond("cryptominisat", Configuration::isBuiltWithCryptominisat());
   print_config_cond("gmp", Configuration::isBuiltWithGmp());
   print_config_cond("kissat", Configuration::isBuiltWithKissat());
@@ -28,6 +28,7 @@
 #include "options/language.h"
 #include "options/managed_streams.h"
 #include "options/option_exception.h"
+#include "options/prop_options.h"
 #include "options/quantifiers_options.h"
 
 namespace cvc5::internal {
@@ -89,18 +90,27 @@ class OptionsHandler
   void setStats(const std::string& flag, bool value);
   /** If statistics sub-option is disabled, enable statistics */
   void setStatsDetail(const std::string& flag, bool value);
+  /** Check that statistics are enabled if a statistics interval is set */
+  void setStatsInterval(const std::string& flag, uint64_t value);
   /** Enable a particular trace tag */
   void enableTraceTag(const std::string& flag, const std::string& optarg);
   /** Enable a particular output tag */
   void enableOutputTag(const std::string& flag, OutputTag optarg);
   /** Pass the resource weight specification to the resource manager */
   void setResourceWeight(const std::string& flag, const std::string& optarg);
+  /** Pass the resource budget specification to the resource manager */
+  void setResourceBudget(const std::string& flag, const std::string& optarg);
 
   /******************************* bv options *******************************/
 
   /** Check that the sat solver mode is compatible with other bv options */
   void checkBvSatSolver(const std::string& flag, SatSolverMode m);
 
+  /****************************** prop options *******************************/
+
+  /** Check that the main SAT solver is supported by this build */
+  void checkSatSolver(const std::string& flag, CDCLTSatSolverMode m);
+
   /******************************* main options *******************************/
   /** Show the solver build configuration and exit */
   void showConfiguration(const std::string& flag, bool value);
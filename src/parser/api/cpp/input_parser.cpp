@@ -47,6 +47,11 @@ void InputParser::initialize()
   {
     d_useFlex = false;
   }
+  // the binary format is only supported by flex
+  else if (d_solver->getOption("input-language") == "LANG_BINARY")
+  {
+    d_useFlex = true;
+  }
   if (d_useFlex)
   {
     // process the forced logic
@@ -0,0 +1,116 @@
+/******************************************************************************
+ * Top contributors (to current version):
+ *   agent
+ *
+ * This file is part of the cvc5 project.
+ *
+ * Copyright (c) 2009-2023 by the authors listed in the file AUTHORS
+ * in the top-level source directory and their institutional affiliations.
+ * All rights reserved.  See the file COPYING in the top-level source
+ * directory for licensing information.
+ * ****************************************************************************
+ *
+ * The parser for the binary format of cvc5.
+ */
+
+#include "parser/binary_parser.h"
+
+#include "base/output.h"
+#include "expr/node_serializer.h"
+#include "parser/api/cpp/command.h"
+#include "parser/parser_exception.h"
+
+namespace cvc5 {
+namespace parser {
+
+BinaryParser::BinaryParser(Solver* solver, SymbolManager* sm)
+    : FlexParser(solver, sm)
+{
+}
+
+BinaryParser::~BinaryParser() {}
+
+void BinaryParser::warning(const std::string& msg)
+{
+  Warning() << d_inputName << ": " << msg << std::endl;
+}
+
+void BinaryParser::parseError(const std::string& msg)
+{
+  throw ParserException(msg, d_inputName, 0, 0);
+}
+
+void BinaryParser::unexpectedEOF(const std::string& msg)
+{
+  throw ParserEndOfFileException(msg, d_inputName, 0, 0);
+}
+
+void BinaryParser::initializeInput(const std::string& name)
+{
+  setDone(false);
+  d_inputName = name;
+  const char* buffer = d_flexInput->getBuffer();
+  if (buffer != nullptr)
+  {
+    d_reader.reset(new internal::NodeDeserializer(
+        d_solver->d_nm, buffer, d_flexInput->getBufferSize()));
+  }
+  else
+  {
+    d_reader.reset(new internal::NodeDeserializer(d_solver->d_nm,
+                                                  *d_flexInput->getStream()));
+  }
+}
+
+std::unique_ptr<Command> BinaryParser::parseNextCommand()
+{
+  internal::NodeDeserializer::Record r;
+  while (d_reader->next(r))
+  {
+    switch (r.d_kind)
+    {
+      case internal::BinaryRecord::LOGIC:
+        return std::make_unique<SetBenchmarkLogicCommand>(r.d_logic);
+      case internal::BinaryRecord::DECLARE_SORT:
+      {
+        Sort s(d_solver->d_nm, r.d_type);
+        size_t arity = s.isUninterpretedSortConstructor()
+                           ? s.getUninterpretedSortConstructorArity()
+                           : 0;
+        std::string name = s.hasSymbol() ? s.getSymbol() : s.toString();
+        return std::make_unique<DeclareSortCommand>(name, arity, s);
+      }
+      case internal::BinaryRecord::DECLARE_FUN:
+      {
+        Term t(d_solver->d_nm, r.d_node);
+        std::string name = t.hasSymbol() ? t.getSymbol() : t.toString();
+        return std::make_unique<DeclareFunctionCommand>(name, t, t.getSort());
+      }
+      case internal::BinaryRecord::ASSERT:
+        return std::make_unique<AssertCommand>(
+            Term(d_solver->d_nm, r.d_node));
+      case internal::BinaryRecord::CHECK_SAT:
+        return std::make_unique<CheckSatCommand>();
+      default:
+        // terms without a role are ignored
+        break;
+    }
+  }
+  return nullptr;
+}
+
+Term BinaryParser::parseNextExpression()
+{
+  internal::NodeDeserializer::Record r;
+  while (d_reader->next(r))
+  {
+    if (r.d_kind == internal::BinaryRecord::TERM)
+    {
+      return Term(d_solver->d_nm, r.d_node);
+    }
+  }
+  return Term();
+}
+
+}  // namespace parser
+}  // namespace cvc5
@@ -0,0 +1,73 @@
+/******************************************************************************
+ * Top contributors (to current version):
+ *   agent
+ *
+ * This file is part of the cvc5 project.
+ *
+ * Copyright (c) 2009-2023 by the authors listed in the file AUTHORS
+ * in the top-level source directory and their institutional affiliations.
+ * All rights reserved.  See the file COPYING in the top-level source
+ * directory for licensing information.
+ * ****************************************************************************
+ *
+ * The parser for the binary format of cvc5.
+ */
+
+#include "cvc5parser_public.h"
+
+#ifndef CVC5__PARSER__BINARY_PARSER_H
+#define CVC5__PARSER__BINARY_PARSER_H
+
+#include <cvc5/cvc5.h>
+
+#include <memory>
+#include <string>
+
+#include "parser/flex_parser.h"
+
+namespace cvc5 {
+
+namespace internal {
+class NodeDeserializer;
+}
+
+namespace parser {
+
+/**
+ * Parser for problems in the binary format of cvc5, as written by
+ * Solver::writeBinaryProblem. The records of the input are turned into the
+ * corresponding commands. If the input is a file, it is read directly from
+ * the memory-mapped file, otherwise it is read incrementally from the input
+ * stream.
+ */
+class BinaryParser : public FlexParser
+{
+ public:
+  BinaryParser(Solver* solver, SymbolManager* sm);
+  ~BinaryParser();
+  /** Issue a warning to the user. */
+  void warning(const std::string& msg) override;
+  /** Raise a parse error with the given message. */
+  void parseError(const std::string& msg) override;
+  /** Unexpectedly encountered an EOF */
+  void unexpectedEOF(const std::string& msg) override;
+
+ protected:
+  /** Initialize the reader for the input */
+  void initializeInput(const std::string& name) override;
+  /** Read and return the next command */
+  std::unique_ptr<Command> parseNextCommand() override;
+  /** Read and return the next term without a particular role */
+  Term parseNextExpression() override;
+
+ private:
+  /** The name of the input */
+  std::string d_inputName;
+  /** The reader for the input */
+  std::unique_ptr<internal::NodeDeserializer> d_reader;
+};
+
+}  // namespace parser
+}  // namespace cvc5
+
+#endif /* CVC5__PARSER__BINARY_PARSER_H */
@@ -17,8 +17,16 @@
 
 #include <fstream>
 
+#include "base/cvc5config.h"
 #include "parser/parser_exception.h"
 
+#if HAVE_MMAP
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
 namespace cvc5 {
 namespace parser {
 
@@ -44,6 +52,73 @@ class FlexFileInput : public FlexInput
 };
 
 /** Stream reference input class */
+#if HAVE_MMAP
+/**
+ * A file input that is memory-mapped, hence its characters are read directly
+ * from the page cache, without copying them into a stream buffer.
+ */
+class FlexMappedFileInput : public FlexInput
+{
+ public:
+  ~FlexMappedFileInput()
+  {
+    if (d_size > 0)
+    {
+      munmap(const_cast<char*>(d_data), d_size);
+    }
+  }
+  /**
+   * Map the given file, returns nullptr if the file cannot be opened or is
+   * not a regular file, or if mapping fails.
+   */
+  static FlexMappedFileInput* mkMappedFileInput(const std::string& filename)
+  {
+    int fd = open(filename.c_str(), O_RDONLY);
+    if (fd < 0)
+    {
+      return nullptr;
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0 || !S_ISREG(st.st_mode))
+    {
+      close(fd);
+      return nullptr;
+    }
+    size_t size = static_cast<size_t>(st.st_size);
+    const char* data = "";
+    if (size > 0)
+    {
+      void* addr = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+      if (addr == MAP_FAILED)
+      {
+        close(fd);
+        return nullptr;
+      }
+#ifdef MADV_SEQUENTIAL
+      // the lexer reads the file once from the beginning to the end
+      madvise(addr, size, MADV_SEQUENTIAL);
+#endif
+      data = static_cast<const char*>(addr);
+    }
+    // the mapping remains valid after closing the file
+    close(fd);
+    return new FlexMappedFileInput(data, size);
+  }
+  const char* getBuffer() const override { return d_data; }
+  size_t getBufferSize() const override { return d_size; }
+
+ private:
+  FlexMappedFileInput(const char* data, size_t size)
+      : FlexInput(), d_data(data), d_size(size)
+  {
+  }
+  /** The mapped file */
+  const char* d_data;
+  /** The size of the file */
+  size_t d_size;
+};
+#endif
+
 class FlexStreamInput : public FlexInput
 {
  public:
@@ -60,18 +135,28 @@ class FlexStreamInput : public FlexInput
 class FlexStringInput : public FlexInput
 {
  public:
-  FlexStringInput(const std::string& input) : FlexInput() { d_input << input; }
-  std::istream* getStream() override { return &d_input; }
+  FlexStringInput(const std::string& input) : FlexInput(), d_input(input) {}
+  const char* getBuffer() const override { return d_input.data(); }
+  size_t getBufferSize() const override { return d_input.size(); }
 
  private:
-  /** Reference to stream */
-  std::stringstream d_input;
+  /** Copy of the input string */
+  std::string d_input;
 };
 
 FlexInput::FlexInput() {}
 
 std::unique_ptr<FlexInput> FlexInput::mkFileInput(const std::string& filename)
 {
+#if HAVE_MMAP
+  FlexInput* mapped = FlexMappedFileInput::mkMappedFileInput(filename);
+  if (mapped != nullptr)
+  {
+    return std::unique_ptr<FlexInput>(mapped);
+  }
+#endif
+  // otherwise read the file as a stream, which also reports an error if it
+  // cannot be opened
   return std::unique_ptr<FlexInput>(new FlexFileInput(filename));
 }
 
@@ -84,6 +169,9 @@ std::unique_ptr<FlexInput> FlexInput::mkStringInput(const std::string& input)
 {
   return std::unique_ptr<FlexInput>(new FlexStringInput(input));
 }
+std::istream* FlexInput::getStream() { return nullptr; }
+const char* FlexInput::getBuffer() const { return nullptr; }
+size_t FlexInput::getBufferSize() const { return 0; }
 bool FlexInput::isInteractive() const { return false; }
 
 }  // namespace parser
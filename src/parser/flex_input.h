@@ -18,6 +18,7 @@
 #ifndef CVC5__PARSER__FLEX_INPUT_H
 #define CVC5__PARSER__FLEX_INPUT_H
 
+#include <cstddef>
 #include <memory>
 #include <sstream>
 #include <string>
@@ -30,12 +31,21 @@ namespace parser {
  *
  * Currently this is std::istream& obtainable via getStream.
  */
+/**
+ * The input of a flex lexer, which is either given as a stream or as a buffer
+ * holding the entire input. In the latter case, the lexer reads the characters
+ * directly from the buffer, and the text of tokens refers into it.
+ */
 class FlexInput
 {
  public:
   FlexInput();
   virtual ~FlexInput() {}
   /** Set the input for the given file.
+   *
+   * If possible, the file is memory-mapped and the input is given as a
+   * buffer. Otherwise, e.g. if the file is not a regular file, it is read as
+   * a stream.
    *
    * @param filename the input filename
    */
@@ -54,8 +64,19 @@ class FlexInput
    * @param name the name of the stream, for use in error messages
    */
   static std::unique_ptr<FlexInput> mkStringInput(const std::string& input);
-  /** Get the stream to pass to the flex lexer. */
-  virtual std::istream* getStream() = 0;
+  /**
+   * Get the stream to pass to the flex lexer, or nullptr if this input is
+   * given as a buffer.
+   */
+  virtual std::istream* getStream();
+  /**
+   * Get the buffer holding the entire input, which remains valid for the
+   * lifetime of this object, or nullptr if this input is given as a stream.
+   * Note that the buffer is not null terminated.
+   */
+  virtual const char* getBuffer() const;
+  /** Get the size of the buffer of getBuffer() */
+  virtual size_t getBufferSize() const;
   /**
    * Is the stream of this input an interactive input? If so, we will read
    * it character-by-character.
@@ -35,7 +35,14 @@ std::ostream& operator<<(std::ostream& o, const Span& l)
 }
 
 FlexLexer::FlexLexer()
-    : d_bufferPos(0), d_bufferEnd(0), d_peekedChar(false), d_chPeeked(0)
+    : d_istream(nullptr),
+      d_isInteractive(false),
+      d_isBufferInput(false),
+      d_bufferPos(nullptr),
+      d_bufferEnd(nullptr),
+      d_lastCharPos(nullptr),
+      d_peekedChar(false),
+      d_chPeeked(0)
 {
 }
 
@@ -75,8 +82,21 @@ void FlexLexer::initialize(FlexInput* input, const std::string& inputName)
   d_inputName = inputName;
   initSpan();
   d_peeked.clear();
-  d_bufferPos = 0;
-  d_bufferEnd = 0;
+  const char* buffer = input->getBuffer();
+  d_isBufferInput = buffer != nullptr;
+  if (d_isBufferInput)
+  {
+    // read directly from the input
+    d_bufferPos = buffer;
+    d_bufferEnd = buffer + input->getBufferSize();
+  }
+  else
+  {
+    Assert(d_istream != nullptr);
+    d_bufferPos = d_buffer;
+    d_bufferEnd = d_buffer;
+  }
+  d_lastCharPos = d_bufferPos;
   d_peekedChar = false;
   d_chPeeked = 0;
 }
@@ -21,6 +21,7 @@
 #include <fstream>
 #include <iosfwd>
 #include <string>
+#include <string_view>
 #include <vector>
 
 #include "base/check.h"
@@ -72,6 +73,13 @@ class FlexLexer
    * valid if no tokens are currently peeked.
    */
   virtual const char* tokenStr() const = 0;
+  /**
+   * View of the characters of the last token, which is only valid if no tokens
+   * are currently peeked, and until the next token is read. If the input is a
+   * buffer, this refers into the input, hence it does not require copying the
+   * characters of the token.
+   */
+  virtual std::string_view tokenView() const = 0;
   /** Advance to the next token (pop from stack) */
   Token nextToken();
   /** Add a token back into the stream (push to stack) */
@@ -99,11 +107,17 @@ class FlexLexer
   /** Get the next character */
   char readNextChar()
   {
+    d_lastCharPos = d_bufferPos;
     if (d_bufferPos < d_bufferEnd)
     {
-      d_ch = d_buffer[d_bufferPos];
+      d_ch = *d_bufferPos;
       d_bufferPos++;
     }
+    else if (d_isBufferInput)
+    {
+      // the buffer is the entire input
+      d_ch = EOF;
+    }
     else if (d_isInteractive)
     {
       d_ch = d_istream->get();
@@ -111,16 +125,17 @@ class FlexLexer
     else
     {
       d_istream->read(d_buffer, INPUT_BUFFER_SIZE);
-      d_bufferEnd = static_cast<size_t>(d_istream->gcount());
-      if (d_bufferEnd == 0)
+      size_t size = static_cast<size_t>(d_istream->gcount());
+      d_bufferPos = d_buffer;
+      d_bufferEnd = d_buffer + size;
+      if (size == 0)
       {
         d_ch = EOF;
-        d_bufferPos = 0;
       }
       else
       {
         d_ch = d_buffer[0];
-        d_bufferPos = 1;
+        d_bufferPos++;
       }
     }
     return d_ch;
@@ -149,13 +164,32 @@ class FlexLexer
     }
     return res;
   }
-  /** Save character */
+  /** Save character, which must be the last one returned by nextChar */
   void saveChar(char ch)
   {
     Assert(!d_peekedChar);
     d_peekedChar = true;
     d_chPeeked = ch;
   }
+  /**
+   * Is the input given as a buffer? If so, the characters returned by
+   * nextChar are read from consecutive positions of the input buffer.
+   */
+  bool isBufferInput() const { return d_isBufferInput; }
+  /**
+   * Get the position in the input buffer of the last character returned by
+   * nextChar, or the end of the buffer if it was EOF. Only valid if
+   * isBufferInput().
+   */
+  const char* getLastCharPos() const { return d_lastCharPos; }
+  /**
+   * Get the position in the input buffer after the last character returned by
+   * nextChar that was not saved. Only valid if isBufferInput().
+   */
+  const char* getConsumedPos() const
+  {
+    return d_peekedChar ? d_lastCharPos : d_bufferPos;
+  }
   // -----------------
   /** Used to initialize d_span. */
   void initSpan();
@@ -184,16 +218,23 @@ class FlexLexer
   std::vector<Token> d_peeked;
 
  private:
-  /** The input */
+  /** The input stream, if the input is not a buffer */
   std::istream* d_istream;
   /** True if the input stream is interactive */
   bool d_isInteractive;
-  /** The current buffer */
+  /** True if the input is given as a buffer */
+  bool d_isBufferInput;
+  /** The buffer for reading the input stream */
   char d_buffer[INPUT_BUFFER_SIZE];
-  /** The position in the current buffer we are reading from */
-  size_t d_bufferPos;
-  /** The size of characters in the current buffer */
-  size_t d_bufferEnd;
+  /**
+   * The position we are reading from in the current buffer, which is either
+   * d_buffer or the input buffer.
+   */
+  const char* d_bufferPos;
+  /** The end of the current buffer */
+  const char* d_bufferEnd;
+  /** The position of the last character read from the current buffer */
+  const char* d_lastCharPos;
   /** The current character we read. */
   char d_ch;
   /** True if we have a saved character that has not been consumed yet. */
@@ -18,6 +18,7 @@
 #include "base/check.h"
 #include "base/output.h"
 #include "parser/api/cpp/command.h"
+#include "parser/binary_parser.h"
 #include "parser/flex_lexer.h"
 #include "parser/parser_exception.h"
 #include "parser/smt2/smt2_parser.h"
@@ -141,7 +142,12 @@ std::unique_ptr<FlexParser> FlexParser::mkFlexParser(const std::string& lang,
   {
     bool isSygus = (lang == "LANG_SYGUS_V2");
     bool strictMode = solver->getOptionInfo("strict-parsing").boolValue();
-    parser.reset(new Smt2Parser(solver, sm, strictMode, isSygus));
+    bool pipelined = solver->getOptionInfo("pipelined-lexing").boolValue();
+    parser.reset(new Smt2Parser(solver, sm, strictMode, isSygus, pipelined));
+  }
+  else if (lang == "LANG_BINARY")
+  {
+    parser.reset(new BinaryParser(solver, sm));
   }
   else if (lang == "LANG_TPTP")
   {
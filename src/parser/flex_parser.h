@@ -98,7 +98,7 @@ class FlexParser : public ParserStateCallback
 
  protected:
   /** Initialize input */
-  void initializeInput(const std::string& name);
+  virtual void initializeInput(const std::string& name);
 
   /** Sets the done flag */
   void setDone(bool done = true) { d_done = done; }
@@ -0,0 +1,129 @@
+/******************************************************************************
+ * Top contributors (to current version):
+ *   agent
+ *
+ * This file is part of the cvc5 project.
+ *
+ * Copyright (c) 2009-2023 by the authors listed in the file AUTHORS
+ * in the top-level source directory and their institutional affiliations.
+ * All rights reserved.  See the file COPYING in the top-level source
+ * directory for licensing information.
+ * ****************************************************************************
+ *
+ * Runs a lexer ahead of the parser in a separate thread.
+ */
+
+#include "parser/lexer_pipeline.h"
+
+#include "base/check.h"
+
+namespace cvc5 {
+namespace parser {
+
+LexerPipeline::LexerPipeline(NextFunction next)
+    : d_next(next),
+      d_currentIndex(0),
+      d_last{Token::EOF_TOK, Span(), std::string_view()},
+      d_finished(false),
+      d_stop(false)
+{
+  // start the thread last, after all fields are initialized
+  d_thread = std::thread(&LexerPipeline::run, this);
+}
+
+LexerPipeline::~LexerPipeline()
+{
+  {
+    std::lock_guard<std::mutex> lock(d_mutex);
+    d_stop = true;
+  }
+  d_notFull.notify_all();
+  d_thread.join();
+}
+
+const LexedToken& LexerPipeline::next()
+{
+  if (d_currentIndex < d_current.size())
+  {
+    d_last = d_current[d_currentIndex++];
+    return d_last;
+  }
+  std::unique_lock<std::mutex> lock(d_mutex);
+  d_notEmpty.wait(lock, [this]() { return !d_queue.empty() || d_finished; });
+  if (d_queue.empty())
+  {
+    // all tokens have been read
+    if (d_error)
+    {
+      std::rethrow_exception(d_error);
+    }
+    Assert(d_last.d_token == Token::EOF_TOK);
+    return d_last;
+  }
+  d_free.emplace_back(std::move(d_current));
+  d_current = std::move(d_queue.front());
+  d_queue.pop_front();
+  lock.unlock();
+  d_notFull.notify_one();
+  Assert(!d_current.empty());
+  d_currentIndex = 1;
+  d_last = d_current[0];
+  return d_last;
+}
+
+void LexerPipeline::run()
+{
+  std::vector<LexedToken> batch;
+  for (;;)
+  {
+    batch.clear();
+    batch.reserve(BATCH_SIZE);
+    bool finished = false;
+    std::exception_ptr error;
+    try
+    {
+      while (batch.size() < BATCH_SIZE)
+      {
+        batch.emplace_back(d_next());
+        if (batch.back().d_token == Token::EOF_TOK)
+        {
+          finished = true;
+          break;
+        }
+      }
+    }
+    catch (...)
+    {
+      // passed to the parser after the tokens preceding the error
+      error = std::current_exception();
+      finished = true;
+    }
+    std::unique_lock<std::mutex> lock(d_mutex);
+    d_notFull.wait(
+        lock, [this]() { return d_queue.size() < MAX_BATCHES || d_stop; });
+    if (d_stop)
+    {
+      return;
+    }
+    if (!batch.empty())
+    {
+      d_queue.emplace_back(std::move(batch));
+    }
+    d_error = error;
+    d_finished = finished;
+    if (!d_free.empty())
+    {
+      batch = std::move(d_free.back());
+      d_free.pop_back();
+    }
+    lock.unlock();
+    d_notEmpty.notify_one();
+    if (finished)
+    {
+      return;
+    }
+  }
+}
+
+}  // namespace parser
+}  // namespace cvc5
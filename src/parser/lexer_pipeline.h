@@ -0,0 +1,111 @@
+/******************************************************************************
+ * Top contributors (to current version):
+ *   agent
+ *
+ * This file is part of the cvc5 project.
+ *
+ * Copyright (c) 2009-2023 by the authors listed in the file AUTHORS
+ * in the top-level source directory and their institutional affiliations.
+ * All rights reserved.  See the file COPYING in the top-level source
+ * directory for licensing information.
+ * ****************************************************************************
+ *
+ * Runs a lexer ahead of the parser in a separate thread.
+ */
+
+#include "cvc5parser_private.h"
+
+#ifndef CVC5__PARSER__LEXER_PIPELINE_H
+#define CVC5__PARSER__LEXER_PIPELINE_H
+
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include "parser/flex_lexer.h"
+#include "parser/tokens.h"
+
+namespace cvc5 {
+namespace parser {
+
+/** A token computed by a lexer, with its location and characters. */
+struct LexedToken
+{
+  /** The token */
+  Token d_token;
+  /** The span of the token in the input */
+  Span d_span;
+  /** The characters of the token */
+  std::string_view d_text;
+};
+
+/**
+ * A pipeline that computes the tokens of an input in a separate thread, so
+ * that lexing the input overlaps with parsing it and constructing its terms.
+ *
+ * The lexing thread computes batches of tokens, which are passed to the
+ * parser through a bounded queue. The characters of the tokens must remain
+ * valid after the lexer moved on, hence this may only be used if the input
+ * is a buffer. The lexing thread stops after the end of the input, after
+ * the lexer raised an error, or when the pipeline is destroyed.
+ */
+class LexerPipeline
+{
+ public:
+  /** The function computing the next token of the lexer */
+  using NextFunction = std::function<LexedToken()>;
+  /** Start the lexing thread, which computes tokens with next */
+  LexerPipeline(NextFunction next);
+  /** Stop the lexing thread */
+  ~LexerPipeline();
+  /**
+   * Get the next token. This blocks until the lexing thread computed it. If
+   * the lexer raised an exception instead, it is rethrown here. The end of
+   * the input is returned repeatedly once it has been reached.
+   */
+  const LexedToken& next();
+
+ private:
+  /** The maximal number of tokens in a batch */
+  static constexpr size_t BATCH_SIZE = 1024;
+  /** The maximal number of batches in the queue */
+  static constexpr size_t MAX_BATCHES = 16;
+  /** The main function of the lexing thread */
+  void run();
+  /** The function computing the next token */
+  NextFunction d_next;
+  /** The batch the parser currently reads from */
+  std::vector<LexedToken> d_current;
+  /** The index of the next token in d_current */
+  size_t d_currentIndex;
+  /** The last token returned by next */
+  LexedToken d_last;
+  /** Protects the following fields, which are shared by both threads */
+  std::mutex d_mutex;
+  /** Notified when a batch is added to the queue or the lexer finished */
+  std::condition_variable d_notEmpty;
+  /** Notified when a batch is removed from the queue or we stop */
+  std::condition_variable d_notFull;
+  /** The batches computed by the lexing thread, not yet read by the parser */
+  std::deque<std::vector<LexedToken>> d_queue;
+  /** Batches that have been read, which are reused by the lexing thread */
+  std::vector<std::vector<LexedToken>> d_free;
+  /** The exception raised by the lexer, if any */
+  std::exception_ptr d_error;
+  /** Whether the lexing thread has reached the end of the input or an error */
+  bool d_finished;
+  /** Whether the lexing thread should stop */
+  bool d_stop;
+  /** The lexing thread */
+  std::thread d_thread;
+};
+
+}  // namespace parser
+}  // namespace cvc5
+
+#endif /* CVC5__PARSER__LEXER_PIPELINE_H */
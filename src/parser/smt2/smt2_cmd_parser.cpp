@@ -99,8 +99,8 @@ Token Smt2CmdParser::nextCommandToken()
   // symbols as commands
   if (tok == Token::SYMBOL)
   {
-    std::string str(d_lex.tokenStr());
-    std::map<std::string, Token>::iterator it = d_table.find(str);
+    std::map<std::string, Token, std::less<>>::iterator it =
+        d_table.find(d_lex.tokenView());
     if (it != d_table.end())
     {
       return it->second;
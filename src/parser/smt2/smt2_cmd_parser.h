@@ -50,8 +50,11 @@ class Smt2CmdParser
   Smt2State& d_state;
   /** The term parser */
   Smt2TermParser& d_tparser;
-  /** Map strings to tokens */
-  std::map<std::string, Token> d_table;
+  /**
+   * Map strings to tokens, which allows lookups of the views of tokens
+   * without constructing strings.
+   */
+  std::map<std::string, Token, std::less<>> d_table;
   /** is strict */
   bool d_isStrict;
   /** is sygus */
@@ -16,6 +16,7 @@
 #include "parser/smt2/smt2_lexer_new.h"
 
 #include <cstdio>
+#include <thread>
 
 #include "base/output.h"
 #include "parser/flex_lexer.h"
@@ -23,10 +24,18 @@
 namespace cvc5 {
 namespace parser {
 
-Smt2LexerNew::Smt2LexerNew(bool isStrict, bool isSygus)
+/**
+ * The minimal size of inputs that are lexed in a separate thread if pipelined
+ * lexing is enabled. For smaller inputs, starting the thread does not pay off.
+ */
+static constexpr size_t s_minPipelinedInputSize = 1 << 16;
+
+Smt2LexerNew::Smt2LexerNew(bool isStrict, bool isSygus, bool isPipelined)
     : FlexLexer(),
+      d_tokenBegin(nullptr),
       d_isStrict(isStrict),
-      d_isSygus(isSygus)
+      d_isSygus(isSygus),
+      d_isPipelined(isPipelined)
 {
   for (char ch = 'a'; ch <= 'z'; ++ch)
   {
@@ -67,26 +76,79 @@ Smt2LexerNew::Smt2LexerNew(bool isStrict, bool isSygus)
   d_charClass['\n'] |= static_cast<uint32_t>(CharacterClass::WHITESPACE);
 }
 
+void Smt2LexerNew::initialize(FlexInput* input, const std::string& inputName)
+{
+  // stop lexing the previous input
+  d_pipeline.reset();
+  d_source.reset();
+  FlexLexer::initialize(input, inputName);
+  // The tokens computed in the lexing thread refer to the characters of the
+  // input, hence this requires the input to be a buffer. Without a second
+  // core, the threads would only take turns.
+  if (d_isPipelined && isBufferInput()
+      && input->getBufferSize() >= s_minPipelinedInputSize
+      && std::thread::hardware_concurrency() > 1)
+  {
+    d_source.reset(new Smt2LexerNew(d_isStrict, d_isSygus));
+    d_source->initialize(input, inputName);
+    Smt2LexerNew* source = d_source.get();
+    d_pipeline.reset(
+        new LexerPipeline([source]() { return source->nextLexedToken(); }));
+  }
+}
+
 const char* Smt2LexerNew::tokenStr() const
 {
+  if (isBufferInput())
+  {
+    // copy the token from the input to null terminate it
+    d_token.assign(d_tokenView.begin(), d_tokenView.end());
+    d_token.push_back(0);
+  }
   Assert(!d_token.empty() && d_token.back() == 0);
   return d_token.data();
 }
+std::string_view Smt2LexerNew::tokenView() const { return d_tokenView; }
 bool Smt2LexerNew::isStrict() const { return d_isStrict; }
 bool Smt2LexerNew::isSygus() const { return d_isSygus; }
 
 Token Smt2LexerNew::nextTokenInternal()
 {
   Trace("lexer-debug") << "Call nextToken" << std::endl;
+  if (d_pipeline != nullptr)
+  {
+    const LexedToken& lt = d_pipeline->next();
+    d_span = lt.d_span;
+    d_tokenView = lt.d_text;
+    Trace("lexer-debug") << "Return pipelined nextToken " << lt.d_token
+                         << " / " << d_tokenView << std::endl;
+    return lt.d_token;
+  }
   d_token.clear();
+  d_tokenBegin = nullptr;
   Token ret = computeNextToken();
-  // null terminate?
-  d_token.push_back(0);
-  Trace("lexer-debug") << "Return nextToken " << ret << " / " << tokenStr()
+  if (isBufferInput())
+  {
+    d_tokenView = d_tokenBegin == nullptr ? std::string_view()
+                                          : currentToken();
+  }
+  else
+  {
+    // null terminate
+    d_token.push_back(0);
+    d_tokenView = std::string_view(d_token.data(), d_token.size() - 1);
+  }
+  Trace("lexer-debug") << "Return nextToken " << ret << " / " << d_tokenView
                        << std::endl;
   return ret;
 }
 
+LexedToken Smt2LexerNew::nextLexedToken()
+{
+  Token t = nextTokenInternal();
+  return LexedToken{t, d_span, d_tokenView};
+}
+
 Token Smt2LexerNew::computeNextToken()
 {
   bumpSpan();
@@ -115,6 +177,8 @@ Token Smt2LexerNew::computeNextToken()
     }
   }
   bumpSpan();
+  // the token starts with ch
+  d_tokenBegin = getLastCharPos();
   pushToToken(ch);
   switch (ch)
   {
@@ -300,36 +364,36 @@ void Smt2LexerNew::parseCharList(CharacterClass cc)
 
 Token Smt2LexerNew::tokenizeCurrentSymbol() const
 {
-  Assert(!d_token.empty());
-  switch (d_token[0])
+  std::string_view token = currentToken();
+  Assert(!token.empty());
+  switch (token[0])
   {
     case 'a':
-      if (d_token.size() == 2 && d_token[1] == 's')
+      if (token == "as")
       {
         return Token::AS_TOK;
       }
       break;
     case 'p':
-      if (d_token.size() == 3 && d_token[1] == 'a' && d_token[2] == 'r')
+      if (token == "par")
       {
         return Token::PAR_TOK;
       }
       break;
     case 'l':
-      if (d_token.size() == 3 && d_token[1] == 'e' && d_token[2] == 't')
+      if (token == "let")
       {
         return Token::LET_TOK;
       }
       break;
     case 'm':
-      if (d_token.size() == 5 && d_token[1] == 'a' && d_token[2] == 't'
-          && d_token[3] == 'c' && d_token[4] == 'h')
+      if (token == "match")
       {
         return Token::MATCH_TOK;
       }
       break;
     case '_':
-      if (d_token.size() == 1)
+      if (token.size() == 1)
       {
         return Token::INDEX_TOK;
       }
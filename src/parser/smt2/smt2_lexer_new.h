@@ -22,10 +22,13 @@
 #include <cstdlib>
 #include <istream>
 #include <map>
+#include <memory>
+#include <string_view>
 #include <vector>
 
 #include "base/check.h"
 #include "parser/flex_lexer.h"
+#include "parser/lexer_pipeline.h"
 #include "parser/tokens.h"
 
 namespace cvc5 {
@@ -41,8 +44,21 @@ namespace parser {
 class Smt2LexerNew : public FlexLexer
 {
  public:
-  Smt2LexerNew(bool isStrict, bool isSygus);
+  /**
+   * @param isStrict Whether strict mode is enabled
+   * @param isSygus Whether we are parsing sygus
+   * @param isPipelined Whether large inputs are lexed in a separate thread,
+   * see initialize.
+   */
+  Smt2LexerNew(bool isStrict, bool isSygus, bool isPipelined = false);
+  /**
+   * Initialize the lexer to generate tokens from the given input. If this
+   * lexer is pipelined and the input is a large buffer, the tokens are
+   * computed by a second lexer running ahead in a separate thread.
+   */
+  void initialize(FlexInput* input, const std::string& inputName) override;
   const char* tokenStr() const override;
+  std::string_view tokenView() const override;
   /** Are we in strict mode? */
   bool isStrict() const;
   /** Are we parsing sygus? */
@@ -54,16 +70,31 @@ class Smt2LexerNew : public FlexLexer
    * its characters to d_token.
    */
   Token nextTokenInternal() override;
+  /** Compute the next token, along with its span and characters. */
+  LexedToken nextLexedToken();
   /**
    * Computes the next token and adds its characters to d_token. Does not
-   * null terminate.
+   * null terminate. If the input is a buffer, the characters are not copied,
+   * instead d_tokenBegin is set to the start of the token in the input.
    */
   Token computeNextToken();
   /** Push a character to the stored token */
   void pushToToken(char ch)
   {
     Assert(ch != EOF);
-    d_token.push_back(ch);
+    if (!isBufferInput())
+    {
+      d_token.push_back(ch);
+    }
+  }
+  /** Get the characters of the token that is currently computed */
+  std::string_view currentToken() const
+  {
+    if (isBufferInput())
+    {
+      return std::string_view(d_tokenBegin, getConsumedPos() - d_tokenBegin);
+    }
+    return std::string_view(d_token.data(), d_token.size());
   }
   //----------- Utilities for parsing the current character stream
   enum class CharacterClass
@@ -91,11 +122,11 @@ class Smt2LexerNew : public FlexLexer
   {
     return d_charClass[static_cast<uint8_t>(ch)] & static_cast<uint8_t>(cc);
   }
-  //----------- Utilizes for tokenizing d_token
+  //----------- Utilizes for tokenizing the current token
   /**
-   * Tokenize current symbol stored in d_token.
+   * Tokenize current symbol given by currentToken().
    *
-   * This method changes the string in d_token into the appropriate token.
+   * This method changes the current symbol into the appropriate token.
    * Otherwise, we return Token::SYMBOL.
    *
    * The list of all simple symbols that are converted by this method.
@@ -104,12 +135,28 @@ class Smt2LexerNew : public FlexLexer
    * We don't handle command tokens here.
    */
   Token tokenizeCurrentSymbol() const;
-  /** The characters in the current token */
-  std::vector<char> d_token;
+  /**
+   * The characters in the current token. If the input is a buffer, this is
+   * only computed on demand by tokenStr.
+   */
+  mutable std::vector<char> d_token;
+  /** The start of the current token in the input, if it is a buffer */
+  const char* d_tokenBegin;
+  /** The characters of the last token */
+  std::string_view d_tokenView;
   /** Is strict parsing enabled */
   bool d_isStrict;
   /** Is sygus enabled */
   bool d_isSygus;
+  /** Is pipelined lexing enabled */
+  bool d_isPipelined;
+  /**
+   * The lexer computing the tokens in the lexing thread of d_pipeline, if
+   * the input is lexed in a separate thread.
+   */
+  std::unique_ptr<Smt2LexerNew> d_source;
+  /** The pipeline running d_source, which is destroyed before it */
+  std::unique_ptr<LexerPipeline> d_pipeline;
   /** The character classes. */
   std::array<uint8_t, 256> d_charClass{};  // value-initialized to 0
 };
@@ -24,9 +24,10 @@ namespace parser {
 Smt2Parser::Smt2Parser(Solver* solver,
                        SymbolManager* sm,
                        bool isStrict,
-                       bool isSygus)
+                       bool isSygus,
+                       bool isPipelined)
     : FlexParser(solver, sm),
-      d_slex(isStrict, isSygus),
+      d_slex(isStrict, isSygus, isPipelined),
       d_state(this, solver, sm, isStrict, isSygus),
       d_termParser(d_slex, d_state),
       d_cmdParser(d_slex, d_state, d_termParser)
@@ -40,7 +40,8 @@ class Smt2Parser : public FlexParser
   Smt2Parser(Solver* solver,
              SymbolManager* sm,
              bool isStrict = false,
-             bool isSygus = false);
+             bool isSygus = false,
+             bool isPipelined = false);
   virtual ~Smt2Parser() {}
   /** Set the logic */
   void setLogic(const std::string& logic) override;
@@ -17,6 +17,9 @@
 
 #include <string.h>
 
+#include <charconv>
+#include <limits>
+
 #include "base/check.h"
 #include "base/output.h"
 
@@ -270,43 +273,43 @@ Term Smt2TermParser::parseTerm()
         break;
       case Token::INTEGER_LITERAL:
       {
-        ret = d_state.mkRealOrIntFromNumeral(d_lex.tokenStr());
+        ret = d_state.mkRealOrIntFromNumeral(std::string(d_lex.tokenView()));
       }
       break;
       case Token::DECIMAL_LITERAL:
       {
-        ret = d_state.getSolver()->mkReal(d_lex.tokenStr());
+        ret = d_state.getSolver()->mkReal(std::string(d_lex.tokenView()));
       }
       break;
       case Token::HEX_LITERAL:
       {
-        std::string hexStr = d_lex.tokenStr();
-        hexStr = hexStr.substr(2);
+        // strip off the initial #x
+        std::string hexStr(d_lex.tokenView().substr(2));
         ret = d_state.getSolver()->mkBitVector(hexStr.size() * 4, hexStr, 16);
       }
       break;
       case Token::BINARY_LITERAL:
       {
-        std::string binStr = d_lex.tokenStr();
-        binStr = binStr.substr(2);
+        // strip off the initial #b
+        std::string binStr(d_lex.tokenView().substr(2));
         ret = d_state.getSolver()->mkBitVector(binStr.size(), binStr, 2);
       }
       break;
       case Token::FIELD_LITERAL:
       {
-        std::string ffStr = d_lex.tokenStr();
+        std::string_view ffStr = d_lex.tokenView();
         Assert(ffStr.find("#f") == 0);
         size_t mPos = ffStr.find("m");
         Assert(mPos > 2);
-        std::string ffValStr = ffStr.substr(2, mPos - 2);
-        std::string ffModStr = ffStr.substr(mPos + 1);
+        std::string ffValStr(ffStr.substr(2, mPos - 2));
+        std::string ffModStr(ffStr.substr(mPos + 1));
         Sort ffSort = d_state.getSolver()->mkFiniteFieldSort(ffModStr);
         ret = d_state.getSolver()->mkFiniteFieldElem(ffValStr, ffSort);
       }
       break;
       case Token::STRING_LITERAL:
       {
-        std::string s = d_lex.tokenStr();
+        std::string s(d_lex.tokenView());
         unescapeString(s);
         ret = d_state.getSolver()->mkString(s, true);
       }
@@ -504,7 +507,7 @@ Term Smt2TermParser::parseTerm()
           // see if there is another keyword
           if (d_lex.eatTokenChoice(Token::KEYWORD, Token::RPAREN_TOK))
           {
-            std::string key = d_lex.tokenStr();
+            std::string key(d_lex.tokenView());
             // Based on the keyword, determine the context.
             // Set needsUpdateCtx to true if we are finished parsing the
             // current attribute.
@@ -518,7 +521,7 @@ Term Smt2TermParser::parseTerm()
             {
               // a numeral
               d_lex.eatToken(Token::INTEGER_LITERAL);
-              attrValue = slv->mkInteger(d_lex.tokenStr());
+              attrValue = slv->mkInteger(std::string(d_lex.tokenView()));
             }
             else if (key == ":named")
             {
@@ -555,7 +558,7 @@ Term Smt2TermParser::parseTerm()
             else
             {
               // warn that the attribute is not supported
-              d_state.attributeNotSupported(d_lex.tokenStr());
+              d_state.attributeNotSupported(key);
               tok = d_lex.nextToken();
               // We don't know whether to expect an attribute value. Thus,
               // we will either see keyword (the next attribute), rparen
@@ -691,7 +694,7 @@ Term Smt2TermParser::parseSymbolicExpr()
       default:
       {
         // note that there are no tokens that are forbidden here
-        std::string str = d_lex.tokenStr();
+        std::string str(d_lex.tokenView());
         ret = slv->mkVar(dummyType, str);
       }
       break;
@@ -862,7 +865,7 @@ std::vector<std::string> Smt2TermParser::parseSymbolList(DeclarationCheck check,
 std::string Smt2TermParser::parseKeyword()
 {
   d_lex.eatToken(Token::KEYWORD);
-  std::string s = d_lex.tokenStr();
+  std::string s(d_lex.tokenView());
   // strip off the initial colon
   return s.erase(0, 1);
 }
@@ -922,7 +925,7 @@ Grammar* Smt2TermParser::parseGrammar(const std::vector<Term>& sygusVars,
         Token tok2 = d_lex.nextToken();
         if (tok2 == Token::SYMBOL)
         {
-          std::string tokenStr(d_lex.tokenStr());
+          std::string_view tokenStr = d_lex.tokenView();
           if (tokenStr == "Constant")
           {
             t = parseSort();
@@ -990,18 +993,23 @@ uint32_t Smt2TermParser::parseIntegerNumeral()
 
 uint32_t Smt2TermParser::tokenStrToUnsigned()
 {
+  std::string_view str = d_lex.tokenView();
   // forbid leading zeroes if in strict mode
   if (d_lex.isStrict())
   {
-    if (d_lex.tokenStr()[0] == '0')
+    if (str[0] == '0')
     {
       d_lex.parseError("Numeral with leading zeroes are forbidden");
     }
   }
-  uint32_t result;
-  std::stringstream ss;
-  ss << d_lex.tokenStr();
-  ss >> result;
+  uint32_t result = 0;
+  std::from_chars_result res =
+      std::from_chars(str.data(), str.data() + str.size(), result);
+  if (res.ec == std::errc::result_out_of_range)
+  {
+    // saturate, as when reading from a stream
+    result = std::numeric_limits<uint32_t>::max();
+  }
   return result;
 }
 
@@ -1010,13 +1018,14 @@ std::string Smt2TermParser::tokenStrToSymbol(Token tok)
   std::string id;
   switch (tok)
   {
-    case Token::SYMBOL: id = d_lex.tokenStr(); break;
+    case Token::SYMBOL: id = d_lex.tokenView(); break;
     case Token::QUOTED_SYMBOL:
-      id = d_lex.tokenStr();
+    {
+      std::string_view quoted = d_lex.tokenView();
       // strip off the quotes
-      id = id.erase(0, 1);
-      id = id.erase(id.size() - 1, 1);
-      break;
+      id = quoted.substr(1, quoted.size() - 2);
+    }
+    break;
     case Token::UNTERMINATED_QUOTED_SYMBOL:
       d_lex.parseError("Expected SMT-LIBv2 symbol", true);
       break;
@@ -1033,7 +1042,7 @@ std::vector<std::string> Smt2TermParser::parseNumeralList()
   Token tok = d_lex.nextToken();
   while (tok == Token::INTEGER_LITERAL)
   {
-    numerals.emplace_back(d_lex.tokenStr());
+    numerals.emplace_back(d_lex.tokenView());
     tok = d_lex.nextToken();
   }
   d_lex.reinsertToken(tok);
@@ -1163,7 +1172,7 @@ void Smt2TermParser::parseConstructorDefinitionList(DatatypeDecl& type)
 std::string Smt2TermParser::parseStr(bool unescape)
 {
   d_lex.eatToken(Token::STRING_LITERAL);
-  std::string s = d_lex.tokenStr();
+  std::string s(d_lex.tokenView());
   if (unescape)
   {
     unescapeString(s);
@@ -1221,13 +1230,13 @@ ParseOp Smt2TermParser::continueParseIndexedIdentifier(bool isOperator)
         {
           // If we parsed a symbol, treat the remaining indices as symbols
           // This is required for parsing fmf.card.
-          symbols.push_back(d_lex.tokenStr());
+          symbols.emplace_back(d_lex.tokenView());
         }
         break;
       case Token::SYMBOL:
       case Token::HEX_LITERAL:
         // (_ char <hex_literal>) expects a hex literal
-        symbols.push_back(d_lex.tokenStr());
+        symbols.emplace_back(d_lex.tokenView());
         break;
       default:
         d_lex.unexpectedTokenError(
@@ -1333,7 +1342,7 @@ Term Smt2TermParser::parseMatchCasePattern(Sort headSort,
   if (d_lex.eatTokenChoice(Token::SYMBOL, Token::LPAREN_TOK))
   {
     // a nullary constructor or variable, depending on if the symbol is declared
-    std::string name = d_lex.tokenStr();
+    std::string name(d_lex.tokenView());
     if (d_state.isDeclared(name, SYM_VARIABLE))
     {
       Term pat = d_state.getVariable(name);
@@ -1375,7 +1384,8 @@ Term Smt2TermParser::parseMatchCasePattern(Sort headSort,
     }
     // make of proper type
     Term arg =
-        d_state.bindBoundVar(d_lex.tokenStr(), argTypes[boundVars.size()]);
+        d_state.bindBoundVar(std::string(d_lex.tokenView()),
+                             argTypes[boundVars.size()]);
     boundVars.push_back(arg);
   }
   std::vector<Term> cargs;
@@ -23,7 +23,6 @@ LetBinding::LetBinding(uint32_t thresh)
     : d_thresh(thresh),
       d_context(),
       d_visitList(&d_context),
-      d_count(&d_context),
       d_letList(&d_context),
       d_letMap(&d_context)
 {
@@ -61,9 +60,32 @@ void LetBinding::letify(std::vector<Node>& letList)
   letList.insert(letList.end(), d_letList.begin() + prevSize, d_letList.end());
 }
 
-void LetBinding::pushScope() { d_context.push(); }
+void LetBinding::pushScope()
+{
+  d_context.push();
+  d_countTrailLimits.push_back(d_countTrail.size());
+}
 
-void LetBinding::popScope() { d_context.pop(); }
+void LetBinding::popScope()
+{
+  Assert(!d_countTrailLimits.empty());
+  size_t limit = d_countTrailLimits.back();
+  d_countTrailLimits.pop_back();
+  while (d_countTrail.size() > limit)
+  {
+    std::pair<Node, Count>& saved = d_countTrail.back();
+    if (saved.second.d_level == s_absent)
+    {
+      d_count.erase(saved.first);
+    }
+    else
+    {
+      d_count[saved.first] = saved.second;
+    }
+    d_countTrail.pop_back();
+  }
+  d_context.pop();
+}
 
 uint32_t LetBinding::getId(Node n) const
 {
@@ -147,7 +169,7 @@ Node LetBinding::convert(Node n, const std::string& prefix, bool letTop) const
 
 void LetBinding::updateCounts(Node n)
 {
-  NodeIdMap::iterator it;
+  std::unordered_map<Node, Count>::iterator it;
   std::vector<Node> visit;
   TNode cur;
   visit.push_back(n);
@@ -161,34 +183,56 @@ void LetBinding::updateCounts(Node n)
       if (cur.getNumChildren() == 0 || cur.isClosure())
       {
         d_visitList.push_back(cur);
-        d_count[cur] = 1;
+        setCount(cur, 1);
         visit.pop_back();
       }
       else
       {
-        d_count[cur] = 0;
+        setCount(cur, 0);
         visit.insert(visit.end(), cur.begin(), cur.end());
       }
     }
     else
     {
-      if ((*it).second == 0)
+      if (it->second.d_count == 0)
       {
         d_visitList.push_back(cur);
       }
-      d_count[cur] = (*it).second + 1;
+      setCount(cur, it->second.d_count + 1);
       visit.pop_back();
     }
   } while (!visit.empty());
 }
 
+void LetBinding::setCount(const Node& n, uint32_t c)
+{
+  uint32_t level = d_context.getLevel();
+  std::unordered_map<Node, Count>::iterator it = d_count.find(n);
+  if (it == d_count.end())
+  {
+    if (level > 0)
+    {
+      d_countTrail.emplace_back(n, Count{0, s_absent});
+    }
+    d_count[n] = Count{c, level};
+    return;
+  }
+  if (it->second.d_level < level)
+  {
+    // first change in this scope
+    d_countTrail.emplace_back(n, it->second);
+    it->second.d_level = level;
+  }
+  it->second.d_count = c;
+}
+
 void LetBinding::convertCountToLet()
 {
   Assert(d_thresh > 0);
   // Assign ids for those whose d_count is >= d_thresh, traverse in d_visitList
   // in order so that deeper nodes are assigned lower identifiers, which
   // ensures the let list can be printed.
-  NodeIdMap::const_iterator itc;
+  std::unordered_map<Node, Count>::const_iterator itc;
   for (const Node& n : d_visitList)
   {
     if (n.getNumChildren() == 0)
@@ -203,7 +247,7 @@ void LetBinding::convertCountToLet()
     }
     itc = d_count.find(n);
     Assert(itc != d_count.end());
-    if ((*itc).second >= d_thresh)
+    if (itc->second.d_count >= d_thresh)
     {
       d_letList.push_back(n);
       // start with id 1
@@ -18,6 +18,7 @@
 #ifndef CVC5__PRINTER__LET_BINDING_H
 #define CVC5__PRINTER__LET_BINDING_H
 
+#include <unordered_map>
 #include <vector>
 
 #include "context/cdhashmap.h"
@@ -144,14 +145,34 @@ class LetBinding
    * Convert a count to a let binding.
    */
   void convertCountToLet();
+  /** Set the count of n to c, saving its previous count on the trail */
+  void setCount(const Node& n, uint32_t c);
+  /** The count of a node */
+  struct Count
+  {
+    /** The count, which is 0 while the children of the node are counted */
+    uint32_t d_count;
+    /** The context level at which the count was last saved on the trail */
+    uint32_t d_level;
+  };
+  /** The level of counts on the trail that were not in d_count */
+  static constexpr uint32_t s_absent = UINT32_MAX;
   /** The dag threshold */
   uint32_t d_thresh;
   /** An internal context */
   context::Context d_context;
   /** Visit list */
   NodeList d_visitList;
-  /** Count */
-  NodeIdMap d_count;
+  /**
+   * Count. This is not a context-dependent map, since it contains an entry
+   * for every subterm of the processed terms. Instead, the previous count of
+   * a node is saved on d_countTrail once per scope, and restored by popScope.
+   */
+  std::unordered_map<Node, Count> d_count;
+  /** The saved counts, where a level of s_absent means not in d_count */
+  std::vector<std::pair<Node, Count>> d_countTrail;
+  /** The size of d_countTrail at the start of each scope */
+  std::vector<size_t> d_countTrailLimits;
   /** The let list */
   NodeList d_letList;
 
@@ -14,6 +14,7 @@
  */
 #include "printer/printer.h"
 
+#include <mutex>
 #include <sstream>
 #include <string>
 
@@ -49,6 +50,11 @@ unique_ptr<Printer> Printer::makePrinter(Language lang)
       return unique_ptr<Printer>(
           new printer::smt2::Smt2Printer(printer::smt2::smt2_6_variant));
 
+    case Language::LANG_BINARY:
+      // the binary format is an input language only, we print in smt2
+      return unique_ptr<Printer>(
+          new printer::smt2::Smt2Printer(printer::smt2::smt2_6_variant));
+
     case Language::LANG_AST:
       return unique_ptr<Printer>(new printer::ast::AstPrinter());
 
@@ -134,6 +140,9 @@ Printer* Printer::getPrinter(Language lang)
   {
     lang = Language::LANG_SMTLIB_V2_6;  // default
   }
+  // printers are created lazily, possibly by several threads at once
+  static std::mutex mutex;
+  std::lock_guard<std::mutex> lock(mutex);
   if (d_printers[static_cast<size_t>(lang)] == nullptr)
   {
     d_printers[static_cast<size_t>(lang)] = makePrinter(lang);
@@ -148,36 +148,41 @@ void Smt2Printer::toStreamWithLetify(std::ostream& out,
     toStream(out, n, toDepth);
     return;
   }
-  std::stringstream cparen;
   std::vector<Node> letList;
   lbind->letify(n, letList);
-  if (!letList.empty())
+  // The let definitions and the body are printed directly, where letified
+  // subterms are printed as their let symbol (see toStream). This avoids
+  // constructing the converted terms.
+  for (const Node& nl : letList)
   {
-    std::map<Node, uint32_t>::const_iterator it;
-    for (size_t i = 0, nlets = letList.size(); i < nlets; i++)
-    {
-      Node nl = letList[i];
-      out << "(let ((";
-      uint32_t id = lbind->getId(nl);
-      out << "_let_" << id << " ";
-      Node nlc = lbind->convert(nl, "_let_", false);
-      toStream(out, nlc, toDepth, lbind);
-      out << ")) ";
-      cparen << ")";
-    }
+    out << "(let ((_let_" << lbind->getId(nl) << " ";
+    toStream(out, nl, toDepth, lbind, false);
+    out << ")) ";
   }
-  Node nc = lbind->convert(n, "_let_");
   // print the body, passing the lbind object
-  toStream(out, nc, toDepth, lbind);
-  out << cparen.str();
+  toStream(out, n, toDepth, lbind);
+  for (size_t i = 0, nlets = letList.size(); i < nlets; i++)
+  {
+    out << ')';
+  }
   lbind->popScope();
 }
 
 void Smt2Printer::toStream(std::ostream& out,
                            TNode n,
                            int toDepth,
-                           LetBinding* lbind) const
+                           LetBinding* lbind,
+                           bool letTop) const
 {
+  if (lbind != nullptr && letTop)
+  {
+    uint32_t id = lbind->getId(n);
+    if (id > 0)
+    {
+      out << "_let_" << id;
+      return;
+    }
+  }
   // null
   if(n.getKind() == kind::NULL_EXPR) {
     out << "null";
@@ -619,7 +624,7 @@ void Smt2Printer::toStream(std::ostream& out,
     // Must print as HO apply instead. This ensures un-beta-reduced function
     // applications can be reparsed.
     Node hoa = theory::uf::TheoryUfRewriter::getHoApplyForApplyUf(n);
-    toStream(out, hoa, toDepth);
+    toStream(out, hoa, toDepth, lbind, false);
     return;
   }
 
@@ -659,7 +664,9 @@ void Smt2Printer::toStream(std::ostream& out,
       {
         Node head = n;
         std::vector<Node> args;
-        while (head.getKind() == kind::HO_APPLY)
+        // do not collapse letified applications
+        while (head.getKind() == kind::HO_APPLY
+               && (head == n || lbind == nullptr || lbind->getId(head) == 0))
         {
           args.insert(args.begin(), head[1]);
           head = head[0];
@@ -798,7 +805,7 @@ void Smt2Printer::toStream(std::ostream& out,
   case kind::SEQ_UNIT:
   {
     out << smtKindString(k) << " ";
-    toStream(out, n[0], toDepth < 0 ? toDepth : toDepth - 1);
+    toStream(out, n[0], toDepth < 0 ? toDepth : toDepth - 1, lbind);
     out << ")";
     return;
   }
@@ -808,7 +815,7 @@ void Smt2Printer::toStream(std::ostream& out,
   case kind::SET_SINGLETON:
   {
     out << smtKindString(k) << " ";
-    toStream(out, n[0], toDepth < 0 ? toDepth : toDepth - 1);
+    toStream(out, n[0], toDepth < 0 ? toDepth : toDepth - 1, lbind);
     out << ")";
     return;
   }
@@ -820,8 +827,10 @@ void Smt2Printer::toStream(std::ostream& out,
   {
     // print (bag (BAG_MAKE_OP Real) 1 3) as (bag 1.0 3)
     out << smtKindString(k) << " ";
-    toStream(out, n[0], toDepth < 0 ? toDepth : toDepth - 1);
-    out << " " << n[1] << ")";
+    toStream(out, n[0], toDepth < 0 ? toDepth : toDepth - 1, lbind);
+    out << " ";
+    toStream(out, n[1], toDepth < 0 ? toDepth : toDepth - 1, lbind);
+    out << ")";
     return;
   }
 
@@ -1034,8 +1043,6 @@ void Smt2Printer::toStream(std::ostream& out,
       out << ' ';
     }
   }
-  stringstream parens;
-
   for(size_t i = 0, c = 1; i < n.getNumChildren(); ) {
     if(toDepth != 0) {
       toStream(out, n[i], toDepth < 0 ? toDepth : toDepth - c, lbind);
@@ -1048,7 +1055,7 @@ void Smt2Printer::toStream(std::ostream& out,
   }
   if (n.getNumChildren() != 0)
   {
-    out << parens.str() << ')';
+    out << ')';
   }
 }
 
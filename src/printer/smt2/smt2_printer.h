@@ -281,12 +281,15 @@ class Smt2Printer : public cvc5::internal::Printer
 
  private:
   /**
-   * The main printing method for nodes n.
+   * The main printing method for nodes n. If lbind is provided, subterms of
+   * n that are letified by lbind are printed as their let symbol, where n
+   * itself is printed as its let symbol only if letTop is true.
    */
   void toStream(std::ostream& out,
                 TNode n,
                 int toDepth,
-                LetBinding* lbind = nullptr) const;
+                LetBinding* lbind = nullptr,
+                bool letTop = true) const;
   /**
    * Prints the vector as a sorted variable list
    */
@@ -12,12 +12,19 @@
  *
  * Wrapper for CaDiCaL SAT Solver.
  *
- * Implementation of the CaDiCaL SAT solver for cvc5 (bit-vectors).
+ * Implementation of the CaDiCaL SAT solver for cvc5 (bit-vectors and, if
+ * CaDiCaL provides the IPASIR-UP external propagator interface, the main
+ * CDCL(T) engine).
  */
 
 #include "prop/cadical.h"
 
+#include <cstdlib>
+#include <deque>
+
 #include "base/check.h"
+#include "base/output.h"
+#include "prop/theory_proxy.h"
 #include "util/resource_manager.h"
 #include "util/statistics_registry.h"
 
@@ -54,15 +61,533 @@ CadicalLit toCadicalLit(const SatLiteral lit)
 
 CadicalVar toCadicalVar(SatVariable var) { return var; }
 
+#ifdef CVC5_USE_CADICAL_PROPAGATOR
+SatLiteral toSatLiteral(CadicalLit lit)
+{
+  return SatLiteral(std::abs(lit), lit < 0);
+}
+#endif
+
 }  // namespace helper functions
 
+#ifdef CVC5_USE_CADICAL_PROPAGATOR
+
+/**
+ * The external propagator (IPASIR-UP) that connects CaDiCaL to the theories
+ * via the TheoryProxy. It mirrors the interaction of our MiniSat core with
+ * the TheoryProxy:
+ * - every new decision level pushes the SAT context, backtracking pops it,
+ * - assignments to theory atoms are enqueued to the theories,
+ * - after Boolean propagation, a standard effort theory check is performed
+ *   and theory propagations are passed back to CaDiCaL, with explanations
+ *   computed lazily via cb_add_reason_clause_lit,
+ * - on a complete assignment, a full effort theory check is performed,
+ * - lemmas added while CaDiCaL is searching are buffered and passed to
+ *   CaDiCaL as external clauses,
+ * - decisions are requested from the theories and the decision engine.
+ *
+ * All variables are observed, since the decision engine queries the current
+ * assignment of arbitrary (not only theory) literals via value().
+ */
+class CadicalPropagator : public CaDiCaL::ExternalPropagator
+{
+ public:
+  CadicalPropagator(prop::TheoryProxy* proxy,
+                    context::Context* context,
+                    CaDiCaL::Solver& solver)
+      : d_proxy(proxy), d_context(context), d_solver(solver)
+  {
+    d_var_info.emplace_back();  // Placeholder for variable 0.
+  }
+
+#ifdef CVC5_CADICAL_PROPAGATOR_API_V2
+  /**
+   * Notification from CaDiCaL that `lits` were assigned. Literals assigned
+   * at decision level 0 are fixed.
+   */
+  void notify_assignment(const std::vector<int>& lits) override
+  {
+    bool is_fixed = d_decision_levels.empty();
+    for (int lit : lits)
+    {
+      notifyAssignment(lit, is_fixed);
+    }
+  }
+#else
+  /** Notification from CaDiCaL that `lit` was assigned. */
+  void notify_assignment(int lit, bool is_fixed) override
+  {
+    notifyAssignment(lit, is_fixed);
+  }
+#endif
+
+  /**
+   * Notification from CaDiCaL that a new decision level was started.
+   */
+  void notify_new_decision_level() override
+  {
+    d_context->push();
+    d_decision_levels.push_back(d_assignments.size());
+    Trace("cadical::propagator")
+        << "notify_new_decision_level: " << d_decision_levels.size()
+        << std::endl;
+  }
+
+  /**
+   * Notification from CaDiCaL to backtrack to `level`.
+   */
+  void notify_backtrack(size_t level) override
+  {
+    if (level >= d_decision_levels.size())
+    {
+      // Already backtracked via backtrackToRoot().
+      return;
+    }
+    Trace("cadical::propagator") << "notify_backtrack: " << level << std::endl;
+    backtrack(level);
+  }
+
+  /**
+   * Callback of CaDiCaL when a complete assignment was found. Performs a full
+   * effort theory check.
+   *
+   * @return True if the theories accept the model, false if they added new
+   *         clauses or propagations, or new variables that must be decided
+   *         first (see cb_decide). In each case, CaDiCaL can make progress
+   *         before checking the next model.
+   */
+  bool cb_check_found_model(const std::vector<int>& model) override
+  {
+    Trace("cadical::propagator") << "cb_check_found_model" << std::endl;
+    if (d_found_solution)
+    {
+      return true;
+    }
+    bool recheck;
+    do
+    {
+      d_proxy->theoryCheck(theory::Theory::Effort::EFFORT_FULL);
+      theoryPropagate();
+      recheck = d_proxy->theoryNeedCheck();
+      if (!d_new_clauses.empty() || !d_propagations.empty())
+      {
+        return false;
+      }
+      // Theories may have introduced new literals that are not yet assigned,
+      // which cb_decide() decides next.
+      if (getUnassignedNewVar() != 0)
+      {
+        return false;
+      }
+    } while (recheck);
+    d_found_solution = true;
+    return true;
+  }
+
+  /**
+   * Callback of CaDiCaL asking for the next decision. Theory decision
+   * requests take precedence over the variables that the theories introduced
+   * in this call to solve(), which take precedence over the decision engine.
+   * Returns 0 to let CaDiCaL pick the decision.
+   */
+  int cb_decide() override
+  {
+    SatLiteral lit = d_proxy->getNextTheoryDecisionRequest();
+    while (lit != undefSatLiteral)
+    {
+      if (value(lit) == SAT_VALUE_UNKNOWN)
+      {
+        Trace("cadical::propagator")
+            << "cb_decide (theory): " << lit << std::endl;
+        return toCadicalLit(lit);
+      }
+      lit = d_proxy->getNextTheoryDecisionRequest();
+    }
+    // The theories cannot accept a model before the new variables are
+    // assigned, see cb_check_found_model().
+    SatVariable var = getUnassignedNewVar();
+    if (var != 0)
+    {
+      lit = SatLiteral(var, true);
+      Trace("cadical::propagator")
+          << "cb_decide (new variable): " << lit << std::endl;
+      return toCadicalLit(lit);
+    }
+    bool stopSearch = false;
+    lit = d_proxy->getNextDecisionEngineRequest(stopSearch);
+    if (!stopSearch && lit != undefSatLiteral)
+    {
+      Assert(value(lit) == SAT_VALUE_UNKNOWN);
+      Trace("cadical::propagator")
+          << "cb_decide (decision engine): " << lit << std::endl;
+      return toCadicalLit(lit);
+    }
+    return 0;
+  }
+
+  /**
+   * Callback of CaDiCaL after Boolean propagation reached a fixed point.
+   * Performs a standard effort theory check (if new theory literals were
+   * asserted) and returns the next theory propagation, or 0 if there is none.
+   */
+  int cb_propagate() override
+  {
+    if (d_propagations.empty() && d_check_pending)
+    {
+      d_check_pending = false;
+      d_proxy->theoryCheck(theory::Theory::Effort::EFFORT_STANDARD);
+      theoryPropagate();
+    }
+    while (!d_propagations.empty())
+    {
+      SatLiteral next = d_propagations.front();
+      d_propagations.pop_front();
+      // Multiple theories may propagate the same literal.
+      if (value(next) == SAT_VALUE_UNKNOWN)
+      {
+        Trace("cadical::propagator") << "cb_propagate: " << next << std::endl;
+        return toCadicalLit(next);
+      }
+    }
+    return 0;
+  }
+
+  /**
+   * Callback of CaDiCaL asking for the reason clause of a theory propagated
+   * literal, one literal at a time. Returns 0 to terminate the clause.
+   */
+  int cb_add_reason_clause_lit(int propagated_lit) override
+  {
+    if (!d_processing_reason)
+    {
+      Assert(d_reason.empty());
+      SatClause explanation;
+      d_proxy->explainPropagation(toSatLiteral(propagated_lit), explanation);
+      d_reason.assign(explanation.begin(), explanation.end());
+      d_processing_reason = true;
+    }
+    if (d_reason.empty())
+    {
+      d_processing_reason = false;
+      return 0;
+    }
+    SatLiteral next = d_reason.front();
+    d_reason.pop_front();
+    return toCadicalLit(next);
+  }
+
+#ifdef CVC5_CADICAL_PROPAGATOR_API_V2
+  /**
+   * Callback of CaDiCaL asking whether there are new external clauses. Our
+   * lemmas are never forgettable, since the theories may rely on them.
+   */
+  bool cb_has_external_clause(bool& is_forgettable) override
+  {
+    is_forgettable = false;
+    return !d_new_clauses.empty();
+  }
+#else
+  /** Callback of CaDiCaL asking whether there are new external clauses. */
+  bool cb_has_external_clause() override { return !d_new_clauses.empty(); }
+#endif
+
+  /**
+   * Callback of CaDiCaL asking for the literals of the next external clause,
+   * one literal at a time. Clauses are terminated by 0.
+   */
+  int cb_add_external_clause_lit() override
+  {
+    Assert(!d_new_clauses.empty());
+    CadicalLit lit = d_new_clauses.front();
+    d_new_clauses.pop_front();
+    return lit;
+  }
+
+  /**
+   * Add a clause while CaDiCaL is searching. The clause is buffered and
+   * passed to CaDiCaL via cb_add_external_clause_lit().
+   */
+  void addClause(const std::vector<CadicalLit>& clause)
+  {
+    d_new_clauses.insert(d_new_clauses.end(), clause.begin(), clause.end());
+    d_new_clauses.push_back(0);
+    d_found_solution = false;
+  }
+
+  /** Register new variable `var`. */
+  void addVar(SatVariable var, bool isTheoryAtom, bool inSearch)
+  {
+    Assert(var == d_var_info.size());
+    d_var_info.emplace_back();
+    d_var_info.back().is_theory_atom = isTheoryAtom;
+    d_solver.add_observed_var(toCadicalVar(var));
+    // Variables added during search must be assigned before the theories can
+    // accept a model.
+    if (inSearch)
+    {
+      d_new_vars.push_back(var);
+      d_found_solution = false;
+    }
+  }
+
+  /** Return the current assignment of `lit`. */
+  SatValue value(SatLiteral lit) const
+  {
+    SatVariable var = lit.getSatVariable();
+    Assert(var < d_var_info.size());
+    CadicalLit assignment = d_var_info[var].assignment;
+    if (assignment == 0)
+    {
+      return SAT_VALUE_UNKNOWN;
+    }
+    return toSatValueLit(lit.isNegated() ? -assignment : assignment);
+  }
+
+  /** Return true if `var` has a fixed (root-level) assignment. */
+  bool isFixed(SatVariable var) const
+  {
+    Assert(var < d_var_info.size());
+    return d_var_info[var].is_fixed;
+  }
+
+  /** Return the current decisions. */
+  const std::vector<SatLiteral>& getDecisions() const { return d_decisions; }
+
+  /**
+   * Backtrack our view of the trail to decision level 0 without waiting for
+   * CaDiCaL to do so. This is required before user push/pop and after
+   * solving, since CaDiCaL backtracks lazily.
+   */
+  void backtrackToRoot()
+  {
+    if (!d_decision_levels.empty())
+    {
+      backtrack(0);
+    }
+  }
+
+  /**
+   * Re-enqueue fixed theory literals that were asserted at a context level
+   * that has been popped. CaDiCaL does not report fixed assignments again.
+   */
+  void renotifyFixed()
+  {
+    for (SatVariable var : d_fixed)
+    {
+      VarInfo& info = d_var_info[var];
+      if (info.is_theory_atom && info.level > d_context->getLevel())
+      {
+        info.level = d_context->getLevel();
+        d_proxy->enqueueTheoryLiteral(toSatLiteral(info.assignment));
+        d_check_pending = true;
+      }
+    }
+  }
+
+  /** Notify the propagator of a new call to solve(). */
+  void notifySolve()
+  {
+    d_found_solution = false;
+    d_check_pending = true;
+  }
+
+  /** Notify the propagator of a finished call to solve(). */
+  void notifySolveDone()
+  {
+    d_new_clauses.clear();
+    d_propagations.clear();
+    d_reason.clear();
+    d_processing_reason = false;
+    d_new_vars.clear();
+  }
+
+ private:
+  /** Per-variable information. */
+  struct VarInfo
+  {
+    /** The current assignment as CaDiCaL literal, 0 if unassigned. */
+    CadicalLit assignment = 0;
+    /** The context level at which the variable was (last) assigned. */
+    uint32_t level = 0;
+    /** Whether the assignment is fixed at the root level. */
+    bool is_fixed = false;
+    /** Whether the variable is a theory atom. */
+    bool is_theory_atom = false;
+  };
+
+  /**
+   * Process the assignment of `lit`, which is fixed if `is_fixed` is true.
+   * Theory atoms are enqueued to the theories.
+   */
+  void notifyAssignment(int lit, bool is_fixed)
+  {
+    SatLiteral slit = toSatLiteral(lit);
+    SatVariable var = slit.getSatVariable();
+    Assert(var < d_var_info.size());
+    VarInfo& info = d_var_info[var];
+    Trace("cadical::propagator")
+        << "notify_assignment: " << slit << (is_fixed ? " (fixed)" : "")
+        << std::endl;
+
+    // CaDiCaL re-notifies literals that became fixed after being assigned.
+    if (info.assignment != 0)
+    {
+      Assert(info.assignment == lit);
+      if (is_fixed && !info.is_fixed)
+      {
+        info.is_fixed = true;
+        d_fixed.push_back(var);
+      }
+      return;
+    }
+    // The decision literal is the first literal assigned on a new decision
+    // level.
+    if (d_decisions.size() < d_decision_levels.size())
+    {
+      d_decisions.push_back(slit);
+    }
+    info.assignment = lit;
+    info.level = d_context->getLevel();
+    if (is_fixed)
+    {
+      info.is_fixed = true;
+      d_fixed.push_back(var);
+    }
+    else
+    {
+      d_assignments.push_back(var);
+    }
+    if (info.is_theory_atom)
+    {
+      d_proxy->enqueueTheoryLiteral(slit);
+      d_check_pending = true;
+    }
+  }
+
+  /** Backtrack to decision level `level`. */
+  void backtrack(size_t level)
+  {
+    Assert(level < d_decision_levels.size());
+    size_t nlevels = d_decision_levels.size() - level;
+    size_t pos = d_decision_levels[level];
+    for (size_t i = pos, size = d_assignments.size(); i < size; ++i)
+    {
+      VarInfo& info = d_var_info[d_assignments[i]];
+      // Literals that became fixed after being assigned stay assigned.
+      if (!info.is_fixed)
+      {
+        info.assignment = 0;
+      }
+    }
+    d_assignments.resize(pos);
+    d_decision_levels.resize(level);
+    if (d_decisions.size() > level)
+    {
+      d_decisions.resize(level);
+    }
+    d_context->popto(d_context->getLevel() - nlevels);
+    d_propagations.clear();
+    d_proxy->notifyBacktrack(nlevels);
+    // Fixed assignments that were notified above `level` are still valid.
+    renotifyFixed();
+    d_found_solution = false;
+  }
+
+  /**
+   * Return a variable introduced in this call to solve() that is unassigned,
+   * or 0 if there is none.
+   */
+  SatVariable getUnassignedNewVar() const
+  {
+    for (SatVariable var : d_new_vars)
+    {
+      if (d_var_info[var].assignment == 0)
+      {
+        return var;
+      }
+    }
+    return 0;
+  }
+
+  /** Collect the literals propagated by the theories. */
+  void theoryPropagate()
+  {
+    SatClause propagated;
+    d_proxy->theoryPropagate(propagated);
+    for (const SatLiteral& lit : propagated)
+    {
+      SatValue val = value(lit);
+      if (val == SAT_VALUE_UNKNOWN)
+      {
+        d_propagations.push_back(lit);
+      }
+      else if (val == SAT_VALUE_FALSE)
+      {
+        // Conflict in theory propagation, add the explanation as clause.
+        SatClause explanation;
+        d_proxy->explainPropagation(lit, explanation);
+        std::vector<CadicalLit> clause;
+        for (const SatLiteral& l : explanation)
+        {
+          clause.push_back(toCadicalLit(l));
+        }
+        addClause(clause);
+      }
+    }
+  }
+
+  /** The theory proxy. */
+  prop::TheoryProxy* d_proxy;
+  /** The SAT context. */
+  context::Context* d_context;
+  /** The CaDiCaL instance. */
+  CaDiCaL::Solver& d_solver;
+
+  /** Per-variable information, indexed by variable. */
+  std::vector<VarInfo> d_var_info;
+  /** The non-fixed assigned variables in assignment order. */
+  std::vector<SatVariable> d_assignments;
+  /** The fixed variables. */
+  std::vector<SatVariable> d_fixed;
+  /** The size of d_assignments at the start of each decision level. */
+  std::vector<size_t> d_decision_levels;
+  /** The decision literal of each decision level. */
+  std::vector<SatLiteral> d_decisions;
+  /** The variables added during the current call to solve(). */
+  std::vector<SatVariable> d_new_vars;
+
+  /** Buffered theory propagations. */
+  std::deque<SatLiteral> d_propagations;
+  /** Buffered literals of new clauses, each clause is terminated by 0. */
+  std::deque<CadicalLit> d_new_clauses;
+  /** The remaining literals of the reason clause currently being added. */
+  std::deque<SatLiteral> d_reason;
+  /** Whether we are currently passing a reason clause to CaDiCaL. */
+  bool d_processing_reason = false;
+  /** Whether new theory literals were asserted since the last check. */
+  bool d_check_pending = false;
+  /** Whether the theories accepted the current complete assignment. */
+  bool d_found_solution = false;
+};
+
+#else
+
+/** Placeholder if CaDiCaL does not provide the external propagator API. */
+class CadicalPropagator
+{
+};
+
+#endif
+
 CadicalSolver::CadicalSolver(StatisticsRegistry& registry,
                              const std::string& name)
     : d_solver(new CaDiCaL::Solver()),
       // Note: CaDiCaL variables start with index 1 rather than 0 since negated
       //       literals are represented as the negation of the index.
+      d_context(nullptr),
       d_nextVarIdx(1),
       d_inSatMode(false),
+      d_inSearch(false),
       d_statistics(registry, name)
 {
 }
@@ -108,6 +633,34 @@ void CadicalSolver::setResourceLimit(ResourceManager* resmgr)
 
 ClauseId CadicalSolver::addClause(SatClause& clause, bool removable)
 {
+#ifdef CVC5_USE_CADICAL_PROPAGATOR
+  if (d_propagator)
+  {
+    std::vector<CadicalLit> lits;
+    for (const SatLiteral& lit : clause)
+    {
+      lits.push_back(toCadicalLit(lit));
+    }
+    // Guard clauses added in user level > 0 by the activation literal.
+    if (!d_activationLits.empty())
+    {
+      lits.push_back(-toCadicalLit(d_activationLits.back()));
+    }
+    ++d_statistics.d_numClauses;
+    if (d_inSearch)
+    {
+      d_propagator->addClause(lits);
+      return ClauseIdError;
+    }
+    for (CadicalLit lit : lits)
+    {
+      d_solver->add(lit);
+    }
+    d_solver->add(0);
+    d_inSatMode = false;
+    return ClauseIdError;
+  }
+#endif
   for (const SatLiteral& lit : clause)
   {
     d_solver->add(toCadicalLit(lit));
@@ -127,23 +680,55 @@ ClauseId CadicalSolver::addXorClause(SatClause& clause,
 SatVariable CadicalSolver::newVar(bool isTheoryAtom, bool canErase)
 {
   ++d_statistics.d_numVariables;
-  return d_nextVarIdx++;
+  SatVariable var = d_nextVarIdx++;
+#ifdef CVC5_USE_CADICAL_PROPAGATOR
+  if (d_propagator)
+  {
+    d_propagator->addVar(var, isTheoryAtom, d_inSearch);
+  }
+#endif
+  return var;
 }
 
 SatVariable CadicalSolver::trueVar() { return d_true; }
 
 SatVariable CadicalSolver::falseVar() { return d_false; }
 
-SatValue CadicalSolver::solve()
+SatValue CadicalSolver::_solve(const std::vector<SatLiteral>& assumptions)
 {
   TimerStat::CodeTimer codeTimer(d_statistics.d_solveTime);
   d_assumptions.clear();
+  for (const SatLiteral& lit : d_activationLits)
+  {
+    d_solver->assume(toCadicalLit(lit));
+  }
+  for (const SatLiteral& lit : assumptions)
+  {
+    d_solver->assume(toCadicalLit(lit));
+    d_assumptions.push_back(lit);
+  }
+#ifdef CVC5_USE_CADICAL_PROPAGATOR
+  if (d_propagator)
+  {
+    d_propagator->notifySolve();
+    d_inSearch = true;
+  }
+#endif
   SatValue res = toSatValue(d_solver->solve());
+#ifdef CVC5_USE_CADICAL_PROPAGATOR
+  if (d_propagator)
+  {
+    d_inSearch = false;
+    d_propagator->notifySolveDone();
+  }
+#endif
   d_inSatMode = (res == SAT_VALUE_TRUE);
   ++d_statistics.d_numSatCalls;
   return res;
 }
 
+SatValue CadicalSolver::solve() { return _solve({}); }
+
 SatValue CadicalSolver::solve(long unsigned int&)
 {
   Unimplemented() << "Setting limits for CaDiCaL not supported yet";
@@ -151,17 +736,7 @@ SatValue CadicalSolver::solve(long unsigned int&)
 
 SatValue CadicalSolver::solve(const std::vector<SatLiteral>& assumptions)
 {
-  TimerStat::CodeTimer codeTimer(d_statistics.d_solveTime);
-  d_assumptions.clear();
-  for (const SatLiteral& lit : assumptions)
-  {
-    d_solver->assume(toCadicalLit(lit));
-    d_assumptions.push_back(lit);
-  }
-  SatValue res = toSatValue(d_solver->solve());
-  d_inSatMode = (res == SAT_VALUE_TRUE);
-  ++d_statistics.d_numSatCalls;
-  return res;
+  return _solve(assumptions);
 }
 
 bool CadicalSolver::setPropagateOnly()
@@ -185,6 +760,13 @@ void CadicalSolver::interrupt() { d_solver->terminate(); }
 
 SatValue CadicalSolver::value(SatLiteral l)
 {
+#ifdef CVC5_USE_CADICAL_PROPAGATOR
+  // During search the current assignment is tracked by the propagator.
+  if (d_propagator && (d_inSearch || !d_inSatMode))
+  {
+    return d_propagator->value(l);
+  }
+#endif
   Assert(d_inSatMode);
   return toSatValueLit(d_solver->val(toCadicalLit(l)));
 }
@@ -197,11 +779,123 @@ SatValue CadicalSolver::modelValue(SatLiteral l)
 
 uint32_t CadicalSolver::getAssertionLevel() const
 {
-  Unreachable() << "CaDiCaL does not support assertion levels.";
+  Assert(d_propagator) << "CaDiCaL only supports assertion levels if used as "
+                          "CDCL(T) SAT solver.";
+  return d_activationLits.size();
 }
 
 bool CadicalSolver::ok() const { return d_inSatMode; }
 
+/* CDCLTSatSolver interface ------------------------------------------------- */
+
+void CadicalSolver::initialize(context::Context* context,
+                               prop::TheoryProxy* theoryProxy,
+                               context::UserContext* userContext,
+                               ProofNodeManager* pnm)
+{
+#ifdef CVC5_USE_CADICAL_PROPAGATOR
+  Assert(pnm == nullptr) << "CaDiCaL does not support SAT proofs yet.";
+  d_context = context;
+  d_propagator.reset(new CadicalPropagator(theoryProxy, context, *d_solver));
+  d_solver->connect_external_propagator(d_propagator.get());
+  // The variables for true and false were created before the propagator was
+  // connected.
+  d_propagator->addVar(d_true, false, false);
+  d_propagator->addVar(d_false, false, false);
+#else
+  Unreachable() << "cvc5 was not compiled with a version of CaDiCaL that "
+                   "supports the external propagator interface.";
+#endif
+}
+
+void CadicalSolver::push()
+{
+#ifdef CVC5_USE_CADICAL_PROPAGATOR
+  Assert(!d_inSearch);
+  d_propagator->backtrackToRoot();
+  d_context->push();
+  SatVariable act = newVar(false, false);
+  d_activationLits.emplace_back(act);
+  Trace("cadical") << "push: activation literal " << act << std::endl;
+#endif
+}
+
+void CadicalSolver::pop()
+{
+#ifdef CVC5_USE_CADICAL_PROPAGATOR
+  Assert(!d_inSearch);
+  Assert(!d_activationLits.empty());
+  d_propagator->backtrackToRoot();
+  d_context->pop();
+  // Permanently disable the clauses of the popped level.
+  SatLiteral act = d_activationLits.back();
+  d_activationLits.pop_back();
+  Trace("cadical") << "pop: disable activation literal " << act << std::endl;
+  d_solver->add(-toCadicalLit(act));
+  d_solver->add(0);
+  d_propagator->renotifyFixed();
+  d_inSatMode = false;
+#endif
+}
+
+void CadicalSolver::resetTrail()
+{
+#ifdef CVC5_USE_CADICAL_PROPAGATOR
+  // CaDiCaL backtracks lazily on the next call to solve, but cvc5 expects the
+  // SAT context to be at the root level after resetTrail().
+  d_propagator->backtrackToRoot();
+#endif
+}
+
+void CadicalSolver::requirePhase(SatLiteral lit)
+{
+  Trace("cadical") << "requirePhase(" << lit << ")" << std::endl;
+  d_solver->phase(toCadicalLit(lit));
+}
+
+bool CadicalSolver::isDecision(SatVariable decn) const
+{
+#ifdef CVC5_USE_CADICAL_PROPAGATOR
+  return d_solver->is_decision(toCadicalVar(decn));
+#else
+  return false;
+#endif
+}
+
+bool CadicalSolver::isFixed(SatVariable var) const
+{
+#ifdef CVC5_USE_CADICAL_PROPAGATOR
+  if (d_propagator)
+  {
+    return d_propagator->isFixed(var);
+  }
+#endif
+  return d_solver->fixed(toCadicalVar(var)) != 0;
+}
+
+std::vector<SatLiteral> CadicalSolver::getDecisions() const
+{
+#ifdef CVC5_USE_CADICAL_PROPAGATOR
+  if (d_propagator)
+  {
+    return d_propagator->getDecisions();
+  }
+#endif
+  return {};
+}
+
+std::vector<Node> CadicalSolver::getOrderHeap() const
+{
+  // CaDiCaL does not expose its variable scores.
+  return {};
+}
+
+std::shared_ptr<ProofNode> CadicalSolver::getProof()
+{
+  Unreachable() << "CaDiCaL does not support SAT proofs yet.";
+  return nullptr;
+}
+
 CadicalSolver::Statistics::Statistics(StatisticsRegistry& registry,
                                       const std::string& prefix)
     : d_numSatCalls(registry.registerInt(prefix + "cadical::calls_to_solve")),
@@ -12,7 +12,9 @@
  *
  * Wrapper for CaDiCaL SAT Solver.
  *
- * Implementation of the CaDiCaL SAT solver for cvc5 (bit-vectors).
+ * Implementation of the CaDiCaL SAT solver for cvc5 (bit-vectors and, if
+ * CaDiCaL provides the IPASIR-UP external propagator interface, the main
+ * CDCL(T) engine).
  */
 
 #include "cvc5_private.h"
@@ -20,6 +22,7 @@
 #ifndef CVC5__PROP__CADICAL_H
 #define CVC5__PROP__CADICAL_H
 
+#include "context/context.h"
 #include "prop/sat_solver.h"
 
 #include <cadical.hpp>
@@ -27,7 +30,9 @@
 namespace cvc5::internal {
 namespace prop {
 
-class CadicalSolver : public SatSolver
+class CadicalPropagator;
+
+class CadicalSolver : public CDCLTSatSolver
 {
   friend class SatSolverFactory;
 
@@ -60,6 +65,39 @@ class CadicalSolver : public SatSolver
 
   bool ok() const override;
 
+  /* CDCLTSatSolver interface --------------------------------------------- */
+
+  void initialize(context::Context* context,
+                  prop::TheoryProxy* theoryProxy,
+                  context::UserContext* userContext,
+                  ProofNodeManager* pnm) override;
+
+  /**
+   * Push a new user level. Clauses added in this level are guarded by a fresh
+   * activation literal that is assumed during solving.
+   */
+  void push() override;
+
+  /**
+   * Pop the current user level. The activation literal of the popped level is
+   * permanently disabled, which removes all clauses added in this level.
+   */
+  void pop() override;
+
+  void resetTrail() override;
+
+  void requirePhase(SatLiteral lit) override;
+
+  bool isDecision(SatVariable decn) const override;
+
+  bool isFixed(SatVariable var) const override;
+
+  std::vector<SatLiteral> getDecisions() const override;
+
+  std::vector<Node> getOrderHeap() const override;
+
+  std::shared_ptr<ProofNode> getProof() override;
+
  private:
   /**
    * Private to disallow creation outside of SatSolverFactory.
@@ -77,6 +115,12 @@ class CadicalSolver : public SatSolver
    */
   void setResourceLimit(ResourceManager* resmgr);
 
+  /**
+   * Solve with the given assumptions and the activation literals of all
+   * active user levels.
+   */
+  SatValue _solve(const std::vector<SatLiteral>& assumptions);
+
   std::unique_ptr<CaDiCaL::Solver> d_solver;
   std::unique_ptr<CaDiCaL::Terminator> d_terminator;
 
@@ -86,8 +130,25 @@ class CadicalSolver : public SatSolver
    */
   std::vector<SatLiteral> d_assumptions;
 
+  /**
+   * The external propagator connecting CaDiCaL to the theories, only set if
+   * CaDiCaL is used as the main CDCL(T) SAT solver (see initialize()).
+   */
+  std::unique_ptr<CadicalPropagator> d_propagator;
+
+  /** The SAT context, set if used as CDCL(T) SAT solver. */
+  context::Context* d_context;
+
+  /**
+   * The activation literals of all active user levels. Clauses added at user
+   * level i > 0 contain the negation of d_activationLits[i - 1].
+   */
+  std::vector<SatLiteral> d_activationLits;
+
   unsigned d_nextVarIdx;
   bool d_inSatMode;
+  /** Whether CaDiCaL is currently searching (only set for CDCL(T)). */
+  bool d_inSearch;
   SatVariable d_true;
   SatVariable d_false;
 
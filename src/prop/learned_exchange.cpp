@@ -0,0 +1,107 @@
+/******************************************************************************
+ * Top contributors (to current version):
+ *   agent
+ *
+ * This file is part of the cvc5 project.
+ *
+ * Copyright (c) 2009-2023 by the authors listed in the file AUTHORS
+ * in the top-level source directory and their institutional affiliations.
+ * All rights reserved.  See the file COPYING in the top-level source
+ * directory for licensing information.
+ * ****************************************************************************
+ *
+ * Lock-free buffer for exchanging learned clauses between solvers.
+ */
+
+#include "prop/learned_exchange.h"
+
+#include <algorithm>
+
+namespace cvc5::internal {
+namespace prop {
+
+LearnedExchange::LearnedExchange(size_t capacity)
+    : d_capacity(capacity),
+      d_slots(new std::atomic<SharedClause*>[capacity]),
+      d_reserved(0),
+      d_numSolvers(0),
+      d_stop(false)
+{
+  for (size_t i = 0; i < d_capacity; i++)
+  {
+    d_slots[i].store(nullptr, std::memory_order_relaxed);
+  }
+}
+
+LearnedExchange::~LearnedExchange()
+{
+  for (size_t i = 0; i < d_capacity; i++)
+  {
+    delete d_slots[i].load(std::memory_order_relaxed);
+  }
+}
+
+size_t LearnedExchange::registerSolver()
+{
+  return d_numSolvers.fetch_add(1, std::memory_order_relaxed);
+}
+
+bool LearnedExchange::publish(size_t source,
+                              std::vector<std::pair<std::string, bool>>&& lits)
+{
+  // cheap check to avoid incrementing the counter forever once full
+  if (d_reserved.load(std::memory_order_relaxed) >= d_capacity)
+  {
+    return false;
+  }
+  size_t index = d_reserved.fetch_add(1, std::memory_order_relaxed);
+  if (index >= d_capacity)
+  {
+    return false;
+  }
+  SharedClause* c = new SharedClause;
+  c->d_source = source;
+  c->d_lits = std::move(lits);
+  // release, so that readers that see the pointer also see its contents
+  d_slots[index].store(c, std::memory_order_release);
+  return true;
+}
+
+void LearnedExchange::fetch(size_t source,
+                            size_t& cursor,
+                            std::vector<const SharedClause*>& clauses) const
+{
+  size_t end = std::min(d_reserved.load(std::memory_order_relaxed), d_capacity);
+  while (cursor < end)
+  {
+    const SharedClause* c = d_slots[cursor].load(std::memory_order_acquire);
+    if (c == nullptr)
+    {
+      // reserved but not published yet, we will see it on the next fetch
+      break;
+    }
+    cursor++;
+    if (c->d_source != source)
+    {
+      clauses.push_back(c);
+    }
+  }
+}
+
+size_t LearnedExchange::size() const
+{
+  return std::min(d_reserved.load(std::memory_order_relaxed), d_capacity);
+}
+
+void LearnedExchange::requestStop()
+{
+  d_stop.store(true, std::memory_order_release);
+}
+
+bool LearnedExchange::isStopRequested() const
+{
+  return d_stop.load(std::memory_order_acquire);
+}
+
+}  // namespace prop
+}  // namespace cvc5::internal
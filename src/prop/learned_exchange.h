@@ -0,0 +1,104 @@
+/******************************************************************************
+ * Top contributors (to current version):
+ *   agent
+ *
+ * This file is part of the cvc5 project.
+ *
+ * Copyright (c) 2009-2023 by the authors listed in the file AUTHORS
+ * in the top-level source directory and their institutional affiliations.
+ * All rights reserved.  See the file COPYING in the top-level source
+ * directory for licensing information.
+ * ****************************************************************************
+ *
+ * Lock-free buffer for exchanging learned clauses between solvers.
+ */
+
+#include "cvc5_private.h"
+
+#ifndef CVC5__PROP__LEARNED_EXCHANGE_H
+#define CVC5__PROP__LEARNED_EXCHANGE_H
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace cvc5::internal {
+namespace prop {
+
+/**
+ * A clause exchanged between solvers. Since each solver lives in its own
+ * thread and owns its own NodeManager, atoms are not represented as nodes but
+ * by a printed form of the atom that is identical in every solver that
+ * contains the atom. Each literal is a pair of such a key and its polarity.
+ */
+struct SharedClause
+{
+  /** The identifier of the solver that published this clause */
+  size_t d_source;
+  /** The literals of this clause */
+  std::vector<std::pair<std::string, bool>> d_lits;
+};
+
+/**
+ * A bounded, append-only buffer of learned clauses that is shared between a
+ * fixed set of solvers running in separate threads.
+ *
+ * Publishing and fetching clauses are lock-free: a publisher reserves a slot
+ * by atomically incrementing the reservation counter and then publishes its
+ * clause into that slot; readers keep their own cursor into the buffer and
+ * stop at the first slot whose clause has not been published yet. Clauses
+ * are immutable once published and are only freed when the buffer is
+ * destroyed, hence readers may keep pointers to them for the lifetime of the
+ * buffer. Clauses published after the buffer is full are dropped.
+ *
+ * The buffer additionally carries a flag that is used to tell all solvers
+ * sharing it that one of them has found a definitive result and that they
+ * should stop.
+ */
+class LearnedExchange
+{
+ public:
+  /** Construct a buffer that holds at most capacity clauses. */
+  LearnedExchange(size_t capacity);
+  ~LearnedExchange();
+  /** Register a solver, returns the identifier to use for that solver. */
+  size_t registerSolver();
+  /**
+   * Publish a clause on behalf of the solver with identifier source. Returns
+   * false if the buffer is full and the clause was dropped.
+   */
+  bool publish(size_t source, std::vector<std::pair<std::string, bool>>&& lits);
+  /**
+   * Append to clauses all clauses published by solvers other than source
+   * since the position cursor, and advance cursor past them.
+   */
+  void fetch(size_t source,
+             size_t& cursor,
+             std::vector<const SharedClause*>& clauses) const;
+  /** Get the number of clauses published so far */
+  size_t size() const;
+  /** Request all solvers sharing this buffer to stop */
+  void requestStop();
+  /** Has a stop been requested? */
+  bool isStopRequested() const;
+
+ private:
+  /** The capacity of this buffer */
+  const size_t d_capacity;
+  /** The slots of this buffer, nullptr for slots not published yet */
+  std::unique_ptr<std::atomic<SharedClause*>[]> d_slots;
+  /** The number of slots reserved by publishers */
+  std::atomic<size_t> d_reserved;
+  /** The number of registered solvers */
+  std::atomic<size_t> d_numSolvers;
+  /** Whether a stop has been requested */
+  std::atomic<bool> d_stop;
+};
+
+}  // namespace prop
+}  // namespace cvc5::internal
+
+#endif
@@ -0,0 +1,220 @@
+/******************************************************************************
+ * Top contributors (to current version):
+ *   agent
+ *
+ * This file is part of the cvc5 project.
+ *
+ * Copyright (c) 2009-2023 by the authors listed in the file AUTHORS
+ * in the top-level source directory and their institutional affiliations.
+ * All rights reserved.  See the file COPYING in the top-level source
+ * directory for licensing information.
+ * ****************************************************************************
+ *
+ * Exports and imports learned clauses of a solver via a learned exchange.
+ */
+
+#include "prop/learned_sharer.h"
+
+#include <sstream>
+
+#include "expr/node_algorithm.h"
+#include "options/io_utils.h"
+#include "options/language.h"
+#include "options/parallel_options.h"
+#include "options/quantifiers_options.h"
+#include "options/strings_options.h"
+#include "prop/learned_exchange.h"
+#include "util/statistics_registry.h"
+
+namespace cvc5::internal {
+namespace prop {
+
+LearnedSharer::LearnedSharer(Env& env, LearnedExchange* exchange)
+    : EnvObj(env),
+      d_exchange(exchange),
+      d_id(exchange->registerSolver()),
+      d_cursor(0),
+      d_export(!options().quantifiers.finiteModelFind
+               && !options().quantifiers.fmfBound
+               && !options().strings.stringFMF),
+      d_numExported(
+          statisticsRegistry().registerInt("prop::LearnedSharer::exported")),
+      d_numImported(
+          statisticsRegistry().registerInt("prop::LearnedSharer::imported")),
+      d_numIgnored(
+          statisticsRegistry().registerInt("prop::LearnedSharer::ignored"))
+{
+  Trace("learned-sharer") << "Export learned clauses: " << d_export
+                          << std::endl;
+}
+
+LearnedSharer::~LearnedSharer() {}
+
+void LearnedSharer::getAtoms(TNode a,
+                             std::unordered_set<TNode>& visited,
+                             std::unordered_set<Node>& atoms)
+{
+  std::vector<TNode> visit;
+  TNode cur;
+  visit.push_back(a);
+  do
+  {
+    cur = visit.back();
+    visit.pop_back();
+    if (visited.find(cur) == visited.end())
+    {
+      visited.insert(cur);
+      if (expr::isBooleanConnective(cur))
+      {
+        visit.insert(visit.end(), cur.begin(), cur.end());
+        continue;
+      }
+      atoms.insert(cur);
+    }
+  } while (!visit.empty());
+}
+
+bool LearnedSharer::isShareableAtom(TNode atom)
+{
+  return !atom.isConst() && !expr::hasSubtermKind(kind::SKOLEM, atom)
+         && !expr::hasBoundVar(atom);
+}
+
+std::string LearnedSharer::mkKey(TNode atom)
+{
+  // print independently of the options of this solver, since the key must be
+  // the same in all solvers
+  std::stringstream ss;
+  options::ioutils::applyOutputLanguage(ss, Language::LANG_SMTLIB_V2_6);
+  options::ioutils::applyDagThresh(ss, 0);
+  atom.toStream(ss);
+  return ss.str();
+}
+
+void LearnedSharer::notifyInputFormulas(const std::vector<Node>& assertions)
+{
+  std::unordered_set<TNode> visited;
+  std::unordered_set<Node> atoms;
+  for (const Node& a : assertions)
+  {
+    getAtoms(a, visited, atoms);
+  }
+  for (const Node& a : atoms)
+  {
+    if (d_atomToKey.find(a) != d_atomToKey.end() || !isShareableAtom(a))
+    {
+      continue;
+    }
+    std::string key = mkKey(a);
+    if (d_ambiguous.find(key) != d_ambiguous.end())
+    {
+      continue;
+    }
+    std::unordered_map<std::string, Node>::iterator it = d_keyToAtom.find(key);
+    if (it != d_keyToAtom.end())
+    {
+      // two distinct atoms with the same printed form, e.g. due to symbols
+      // with the same name, neither can be shared
+      Trace("learned-sharer") << "Ambiguous key " << key << std::endl;
+      d_atomToKey.erase(it->second);
+      d_keyToAtom.erase(it);
+      d_ambiguous.insert(key);
+      continue;
+    }
+    d_atomToKey[a] = key;
+    d_keyToAtom[key] = a;
+  }
+  Trace("learned-sharer") << "#Shareable atoms = " << d_atomToKey.size()
+                          << std::endl;
+}
+
+void LearnedSharer::exportLiteral(TNode lit)
+{
+  std::vector<Node> lits{lit};
+  exportClause(lits);
+}
+
+void LearnedSharer::exportClause(const std::vector<Node>& lits)
+{
+  if (lits.empty() || !d_export)
+  {
+    return;
+  }
+  Node cl = lits.size() == 1 ? lits[0] : NodeManager::currentNM()->mkOr(lits);
+  if (d_exported.find(cl) != d_exported.end())
+  {
+    return;
+  }
+  d_exported.insert(cl);
+  if (publish(lits))
+  {
+    Trace("learned-sharer") << "Export " << cl << std::endl;
+    ++d_numExported;
+  }
+}
+
+bool LearnedSharer::publish(const std::vector<Node>& lits)
+{
+  std::vector<std::pair<std::string, bool>> slits;
+  for (const Node& l : lits)
+  {
+    bool pol = l.getKind() != kind::NOT;
+    TNode atom = pol ? l : l[0];
+    std::unordered_map<Node, std::string>::const_iterator it =
+        d_atomToKey.find(atom);
+    if (it == d_atomToKey.end())
+    {
+      return false;
+    }
+    slits.emplace_back(it->second, pol);
+  }
+  return d_exchange->publish(d_id, std::move(slits));
+}
+
+std::vector<Node> LearnedSharer::importClauses()
+{
+  std::vector<Node> ret;
+  std::vector<const SharedClause*> clauses;
+  d_exchange->fetch(d_id, d_cursor, clauses);
+  NodeManager* nm = NodeManager::currentNM();
+  for (const SharedClause* c : clauses)
+  {
+    std::vector<Node> lits;
+    for (const std::pair<std::string, bool>& sl : c->d_lits)
+    {
+      std::unordered_map<std::string, Node>::const_iterator it =
+          d_keyToAtom.find(sl.first);
+      if (it == d_keyToAtom.end())
+      {
+        break;
+      }
+      lits.push_back(sl.second ? it->second : it->second.notNode());
+    }
+    if (lits.size() != c->d_lits.size())
+    {
+      // some atom does not occur in our input
+      ++d_numIgnored;
+      continue;
+    }
+    Node cl = lits.size() == 1 ? lits[0] : nm->mkOr(lits);
+    // do not export it back
+    d_exported.insert(cl);
+    Trace("learned-sharer") << "Import " << cl << std::endl;
+    ++d_numImported;
+    ret.push_back(cl);
+  }
+  return ret;
+}
+
+bool LearnedSharer::isStopRequested() const
+{
+  return d_exchange->isStopRequested();
+}
+
+size_t LearnedSharer::getMaxClauseLength() const
+{
+  return d_export ? options().parallel.learnedShareLength : 0;
+}
+
+}  // namespace prop
+}  // namespace cvc5::internal
@@ -0,0 +1,114 @@
+/******************************************************************************
+ * Top contributors (to current version):
+ *   agent
+ *
+ * This file is part of the cvc5 project.
+ *
+ * Copyright (c) 2009-2023 by the authors listed in the file AUTHORS
+ * in the top-level source directory and their institutional affiliations.
+ * All rights reserved.  See the file COPYING in the top-level source
+ * directory for licensing information.
+ * ****************************************************************************
+ *
+ * Exports and imports learned clauses of a solver via a learned exchange.
+ */
+
+#include "cvc5_private.h"
+
+#ifndef CVC5__PROP__LEARNED_SHARER_H
+#define CVC5__PROP__LEARNED_SHARER_H
+
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "expr/node.h"
+#include "smt/env_obj.h"
+#include "util/statistics_stats.h"
+
+namespace cvc5::internal {
+namespace prop {
+
+class LearnedExchange;
+
+/**
+ * The interface of a single solver to a learned exchange that it shares with
+ * other solvers working on the same set of assertions.
+ *
+ * Only clauses whose atoms are shareable are exchanged. An atom is shareable
+ * if it occurs in the (preprocessed) input formulas, and it contains neither
+ * skolems nor bound variables. This ensures its printed form has the same
+ * meaning in every solver, since it is built only from symbols declared by
+ * the user.
+ *
+ * The shared clauses must be entailed by the input, since they are added as
+ * lemmas by solvers with other configurations. Preprocessing that does not
+ * preserve equivalence is disabled when sharing (see SetDefaults). Solvers
+ * whose theories add lemmas that are not entailed, e.g. the cardinality
+ * restrictions of finite model finding, import clauses but do not export
+ * any.
+ */
+class LearnedSharer : protected EnvObj
+{
+ public:
+  LearnedSharer(Env& env, LearnedExchange* exchange);
+  ~LearnedSharer();
+  /** Notify the input formulas, which determines the shareable atoms */
+  void notifyInputFormulas(const std::vector<Node>& assertions);
+  /** Export literal learned at decision level zero, if it is shareable */
+  void exportLiteral(TNode lit);
+  /** Export learned clause, if all its literals are shareable */
+  void exportClause(const std::vector<Node>& lits);
+  /**
+   * Get the clauses published by other solvers since the last call to this
+   * method that are over atoms that are shareable for this solver.
+   */
+  std::vector<Node> importClauses();
+  /** Has another solver requested that we stop? */
+  bool isStopRequested() const;
+  /** The maximal length of learned clauses to export */
+  size_t getMaxClauseLength() const;
+
+ private:
+  /** Get the atoms of assertion a, as in the zero-level learner */
+  static void getAtoms(TNode a,
+                       std::unordered_set<TNode>& visited,
+                       std::unordered_set<Node>& atoms);
+  /** Is atom shareable, independent of the input formulas? */
+  static bool isShareableAtom(TNode atom);
+  /** Compute the key of atom, which is its printed form */
+  static std::string mkKey(TNode atom);
+  /** Publish clause lits, return true if all its literals are shareable */
+  bool publish(const std::vector<Node>& lits);
+  /** The exchange */
+  LearnedExchange* d_exchange;
+  /** Our identifier in the exchange */
+  size_t d_id;
+  /** Our position in the exchange */
+  size_t d_cursor;
+  /**
+   * Whether we export clauses, which is false if our lemmas may not be
+   * entailed by the input
+   */
+  bool d_export;
+  /** Maps shareable atoms to their key */
+  std::unordered_map<Node, std::string> d_atomToKey;
+  /** Maps keys to shareable atoms */
+  std::unordered_map<std::string, Node> d_keyToAtom;
+  /** Keys that are ambiguous, i.e. the printed form of several atoms */
+  std::unordered_set<std::string> d_ambiguous;
+  /** The clauses we have exported, to avoid exporting them twice */
+  std::unordered_set<Node> d_exported;
+  /** Number of exported clauses */
+  IntStat d_numExported;
+  /** Number of imported clauses */
+  IntStat d_numImported;
+  /** Number of clauses of other solvers we could not import */
+  IntStat d_numIgnored;
+};
+
+}  // namespace prop
+}  // namespace cvc5::internal
+
+#endif
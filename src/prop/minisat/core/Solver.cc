@@ -1581,6 +1581,14 @@ lbool Solver::search(int nof_conflicts)
                 << ca[cr].level() << " / " << assertionLevel << "\n";
           }
         }
+        // share short learned clauses with other solvers, if applicable
+        if (static_cast<size_t>(learnt_clause.size())
+            <= d_proxy->getLearnedShareLength())
+        {
+          SatClause satClause;
+          MinisatSatSolver::toSatClause(ca[cr], satClause);
+          d_proxy->notifyLearnedClause(satClause);
+        }
       }
 
       varDecayActivity();
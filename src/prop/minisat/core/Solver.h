@@ -300,6 +300,7 @@ public:
  int nLearnts() const;  // The current number of learnt clauses.
  int nVars() const;     // The current number of variables.
  int nFreeVars() const;
+ size_t clauseMemory() const;  // The number of bytes of the clause database.
  bool isDecision(Var x) const;  // is the given var a decision?
 
  // Debugging SMT explanations
@@ -677,6 +678,7 @@ inline lbool    Solver::modelValue    (Var x) const   { return model[x]; }
 inline lbool    Solver::modelValue    (Lit p) const   { return model[var(p)] ^ sign(p); }
 inline int      Solver::nAssigns      ()      const   { return trail.size(); }
 inline int      Solver::nClauses      ()      const   { return clauses_persistent.size(); }
+inline size_t   Solver::clauseMemory  ()      const   { return static_cast<size_t>(ca.size()) * sizeof(uint32_t); }
 inline int      Solver::nLearnts      ()      const   { return clauses_removable.size(); }
 inline int      Solver::nVars         ()      const   { return vardata.size(); }
 inline int      Solver::nFreeVars     ()      const   { return (int)dec_vars - (trail_lim.size() == 0 ? trail.size() : trail_lim[0]); }
@@ -286,6 +286,11 @@ std::vector<Node> MinisatSatSolver::getOrderHeap() const
   return d_minisat->getMiniSatOrderHeap();
 }
 
+size_t MinisatSatSolver::getClauseMemoryUsage() const
+{
+  return d_minisat->clauseMemory();
+}
+
 SatProofManager* MinisatSatSolver::getProofManager()
 {
   return d_minisat->getProofManager();
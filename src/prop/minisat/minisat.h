@@ -101,6 +101,8 @@ class MinisatSatSolver : public CDCLTSatSolver, protected EnvObj
    */
   std::vector<Node> getOrderHeap() const override;
 
+  size_t getClauseMemoryUsage() const override;
+
   /** Retrieve a pointer to the underlying solver. */
   Minisat::SimpSolver* getSolver() { return d_minisat; }
 
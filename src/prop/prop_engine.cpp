@@ -27,6 +27,7 @@
 #include "options/main_options.h"
 #include "options/options.h"
 #include "options/proof_options.h"
+#include "options/prop_options.h"
 #include "options/smt_options.h"
 #include "proof/proof_node_algorithm.h"
 #include "prop/cnf_stream.h"
@@ -76,14 +77,29 @@ PropEngine::PropEngine(Env& env, TheoryEngine* te)
       d_theoryLemmaPg(d_env, d_env.getUserContext(), "PropEngine::ThLemmaPg"),
       d_ppm(nullptr),
       d_interrupted(false),
-      d_assumptions(d_env.getUserContext())
+      d_assumptions(d_env.getUserContext()),
+      d_nodeManagerMemory(
+          statisticsRegistry().registerMemory("memory::nodeManager")),
+      d_satContextMemory(
+          statisticsRegistry().registerMemory("memory::satContext")),
+      d_userContextMemory(
+          statisticsRegistry().registerMemory("memory::userContext")),
+      d_clauseMemory(statisticsRegistry().registerMemory("memory::satClauses"))
 {
   Trace("prop") << "Constructing the PropEngine" << std::endl;
   context::UserContext* userContext = d_env.getUserContext();
   ProofNodeManager* pnm = d_env.getProofNodeManager();
 
-  d_satSolver =
-      SatSolverFactory::createCDCLTMinisat(d_env, statisticsRegistry());
+  if (options().prop.satSolver == options::CDCLTSatSolverMode::CADICAL)
+  {
+    d_satSolver =
+        SatSolverFactory::createCDCLTCadical(d_env, statisticsRegistry());
+  }
+  else
+  {
+    d_satSolver =
+        SatSolverFactory::createCDCLTMinisat(d_env, statisticsRegistry());
+  }
 
   // CNF stream and theory proxy required pointers to each other, make the
   // theory proxy first
@@ -397,6 +413,16 @@ void PropEngine::outputIncompleteReason(UnknownExplanation uexp,
     {
       output(OutputTag::INCOMPLETE) << " " << iid;
     }
+    if (uexp == UnknownExplanation::RESOURCEOUT
+        || uexp == UnknownExplanation::TIMEOUT)
+    {
+      // the limit that was exhausted
+      std::string limit = resourceManager()->getExhaustedLimit();
+      if (!limit.empty())
+      {
+        output(OutputTag::INCOMPLETE) << " " << limit;
+      }
+    }
     output(OutputTag::INCOMPLETE) << ")" << std::endl;
   }
 }
@@ -438,6 +464,7 @@ Result PropEngine::checkSat() {
   }
 
   d_theoryProxy->postsolve();
+  updateMemoryStatistics();
 
   if( result == SAT_VALUE_UNKNOWN ) {
     ResourceManager* rm = resourceManager();
@@ -753,5 +780,16 @@ modes::LearnedLitType PropEngine::getLiteralType(const Node& lit) const
   return d_theoryProxy->getLiteralType(lit);
 }
 
+void PropEngine::updateMemoryStatistics()
+{
+  d_nodeManagerMemory.set(NodeManager::currentNM()->getMemoryUsage());
+  d_satContextMemory.set(context()->getCMM()->getMemoryUsage());
+  d_userContextMemory.set(userContext()->getCMM()->getMemoryUsage());
+  if (d_satSolver != nullptr)
+  {
+    d_clauseMemory.set(d_satSolver->getClauseMemoryUsage());
+  }
+}
+
 }  // namespace prop
 }  // namespace cvc5::internal
@@ -32,6 +32,7 @@
 #include "theory/output_channel.h"
 #include "theory/skolem_lemma.h"
 #include "util/result.h"
+#include "util/statistics_stats.h"
 
 namespace cvc5::internal {
 
@@ -339,6 +340,12 @@ class PropEngine : protected EnvObj
   /** Get the literal type through the ZLL utilities */
   modes::LearnedLitType getLiteralType(const Node& lit) const;
 
+  /**
+   * Update the statistics for the memory usage of the node manager, of the
+   * SAT and user contexts, and of the clause database of the SAT solver.
+   */
+  void updateMemoryStatistics();
+
  private:
   /** Dump out the satisfying assignment (after SAT result) */
   void printSatisfyingAssignment();
@@ -420,6 +427,15 @@ class PropEngine : protected EnvObj
    * cores are enabled.
    */
   context::CDList<Node> d_assumptions;
+
+  /** The memory usage of the node values of the node manager */
+  MemoryStat d_nodeManagerMemory;
+  /** The memory usage of the context objects of the SAT context */
+  MemoryStat d_satContextMemory;
+  /** The memory usage of the context objects of the user context */
+  MemoryStat d_userContextMemory;
+  /** The memory usage of the clause database of the SAT solver */
+  MemoryStat d_clauseMemory;
 };
 
 }  // namespace prop
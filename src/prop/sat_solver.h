@@ -114,6 +114,12 @@ public:
     Unimplemented() << "getUnsatAssumptions not implemented";
   }
 
+  /**
+   * Get the number of bytes of the clause database of this solver, or 0 if
+   * this is not supported by the solver.
+   */
+  virtual size_t getClauseMemoryUsage() const { return 0; }
+
 };/* class SatSolver */
 
 class CDCLTSatSolver : public SatSolver
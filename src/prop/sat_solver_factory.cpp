@@ -29,6 +29,21 @@ CDCLTSatSolver* SatSolverFactory::createCDCLTMinisat(
   return new MinisatSatSolver(env, registry);
 }
 
+CDCLTSatSolver* SatSolverFactory::createCDCLTCadical(
+    Env& env, StatisticsRegistry& registry)
+{
+#ifdef CVC5_USE_CADICAL_PROPAGATOR
+  CadicalSolver* res = new CadicalSolver(registry, "prop::");
+  res->init();
+  res->setResourceLimit(env.getResourceManager());
+  return res;
+#else
+  Unreachable() << "cvc5 was not compiled with a version of CaDiCaL that "
+                   "supports the external propagator interface.";
+  return nullptr;
+#endif
+}
+
 SatSolver* SatSolverFactory::createCryptoMinisat(StatisticsRegistry& registry,
                                                  ResourceManager* resmgr,
                                                  const std::string& name)
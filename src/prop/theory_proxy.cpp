@@ -27,6 +27,8 @@
 #include "options/prop_options.h"
 #include "options/smt_options.h"
 #include "prop/cnf_stream.h"
+#include "prop/learned_exchange.h"
+#include "prop/learned_sharer.h"
 #include "prop/proof_cnf_stream.h"
 #include "prop/prop_engine.h"
 #include "prop/skolem_def_manager.h"
@@ -53,18 +55,27 @@ TheoryProxy::TheoryProxy(Env& env,
       d_tpp(env, *theoryEngine),
       d_skdm(skdm),
       d_zll(nullptr),
+      d_sharer(nullptr),
       d_prr(nullptr),
       d_stopSearch(userContext(), false),
       d_activatedSkDefs(false)
 {
+  // imported clauses are added as lemmas without proofs, hence we only share
+  // learned clauses if we are not producing proofs
+  LearnedExchange* exchange = env.getLearnedExchange();
+  if (exchange != nullptr && !options().smt.produceProofs)
+  {
+    d_sharer = std::make_unique<LearnedSharer>(env, exchange);
+  }
   bool trackZeroLevel =
       options().smt.deepRestartMode != options::DeepRestartMode::NONE
       || isOutputOn(OutputTag::LEARNED_LITS)
       || options().smt.produceLearnedLiterals
-      || options().parallel.computePartitions > 0;
+      || options().parallel.computePartitions > 0 || d_sharer != nullptr;
   if (trackZeroLevel)
   {
     d_zll = std::make_unique<ZeroLevelLearner>(env, theoryEngine);
+    d_zll->setLearnedSharer(d_sharer.get());
   }
 }
 
@@ -146,6 +157,11 @@ void TheoryProxy::notifyInputFormulas(
   {
     d_zll->notifyInputFormulas(assertions);
   }
+  // the learned sharer similarly determines which atoms are shareable
+  if (d_sharer != nullptr)
+  {
+    d_sharer->notifyInputFormulas(assertions);
+  }
 }
 
 void TheoryProxy::notifySkolemDefinition(Node a, TNode skolem)
@@ -174,6 +190,15 @@ void TheoryProxy::variableNotify(SatVariable var) {
 void TheoryProxy::theoryCheck(theory::Theory::Effort effort) {
   Trace("theory-proxy") << "TheoryProxy: check " << effort << std::endl;
   d_activatedSkDefs = false;
+  // stop if another solver sharing learned clauses with us is done
+  if (d_sharer != nullptr && d_sharer->isStopRequested())
+  {
+    d_propEngine->interrupt();
+  }
+  if (effort == theory::Theory::EFFORT_FULL)
+  {
+    d_propEngine->updateMemoryStatistics();
+  }
   // check with the preregistrar
   d_prr->check();
   TNode assertion;
@@ -385,6 +410,32 @@ TNode TheoryProxy::getNode(SatLiteral lit) {
 void TheoryProxy::notifyRestart() {
   d_propEngine->spendResource(Resource::RestartStep);
   d_theoryEngine->notifyRestart();
+  // we are at decision level zero, add the clauses learned by other solvers
+  if (d_sharer != nullptr)
+  {
+    std::vector<Node> clauses = d_sharer->importClauses();
+    for (const Node& cl : clauses)
+    {
+      d_propEngine->assertLemma(TrustNode::mkTrustLemma(cl),
+                                theory::LemmaProperty::NONE);
+    }
+  }
+}
+
+size_t TheoryProxy::getLearnedShareLength() const
+{
+  return d_sharer == nullptr ? 0 : d_sharer->getMaxClauseLength();
+}
+
+void TheoryProxy::notifyLearnedClause(const SatClause& clause)
+{
+  Assert(d_sharer != nullptr);
+  std::vector<Node> lits;
+  for (const SatLiteral& l : clause)
+  {
+    lits.push_back(d_cnfStream->getNode(l));
+  }
+  d_sharer->exportClause(lits);
 }
 
 void TheoryProxy::spendResource(Resource r)
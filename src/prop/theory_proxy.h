@@ -50,6 +50,7 @@ class PropEngine;
 class CnfStream;
 class SkolemDefManager;
 class ZeroLevelLearner;
+class LearnedSharer;
 
 /**
  * The proxy class that allows the SatSolver to communicate with the theories
@@ -152,6 +153,15 @@ class TheoryProxy : protected EnvObj, public Registrar
 
   void notifyRestart();
 
+  /**
+   * Get the maximal length of learned clauses the SAT solver should notify us
+   * of via notifyLearnedClause, which is zero if we are not sharing learned
+   * clauses with other solvers.
+   */
+  size_t getLearnedShareLength() const;
+  /** Notify that the SAT solver learned the given (short) clause */
+  void notifyLearnedClause(const SatClause& clause);
+
   void spendResource(Resource r);
 
   bool isDecisionEngineDone();
@@ -238,6 +248,9 @@ class TheoryProxy : protected EnvObj, public Registrar
   /** The zero level learner */
   std::unique_ptr<ZeroLevelLearner> d_zll;
 
+  /** The learned sharer, if we share learned clauses with other solvers */
+  std::unique_ptr<LearnedSharer> d_sharer;
+
   /** Preregister policy */
   std::unique_ptr<TheoryPreregistrar> d_prr;
 
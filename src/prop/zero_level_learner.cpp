@@ -19,6 +19,7 @@
 #include "expr/skolem_manager.h"
 #include "options/base_options.h"
 #include "options/smt_options.h"
+#include "prop/learned_sharer.h"
 #include "smt/env.h"
 #include "theory/theory_engine.h"
 #include "theory/trust_substitutions.h"
@@ -35,7 +36,8 @@ ZeroLevelLearner::ZeroLevelLearner(Env& env, TheoryEngine* theoryEngine)
       d_ppnAtoms(userContext()),
       d_ppnTerms(userContext()),
       d_ppnSyms(userContext()),
-      d_assertNoLearnCount(0)
+      d_assertNoLearnCount(0),
+      d_sharer(nullptr)
 {
   // get the learned types
   options::DeepRestartMode lmode = options().smt.deepRestartMode;
@@ -280,6 +282,11 @@ void ZeroLevelLearner::processLearnedLiteral(const Node& lit,
 {
   // add to the database
   d_ldb.addLearnedLiteral(lit, ltype);
+  // literals over input atoms may be useful to other solvers
+  if (d_sharer != nullptr && ltype == modes::LEARNED_LIT_INPUT)
+  {
+    d_sharer->exportLiteral(lit);
+  }
   // reset the counter for deep restart if the literal was learnable
   if (isLearnable(ltype))
   {
@@ -343,6 +350,8 @@ bool ZeroLevelLearner::hasLearnedLiteralForRestart() const
   return false;
 }
 
+void ZeroLevelLearner::setLearnedSharer(LearnedSharer* ls) { d_sharer = ls; }
+
 bool ZeroLevelLearner::isLearnable(modes::LearnedLitType ltype) const
 {
   return d_learnedTypes.find(ltype) != d_learnedTypes.end();
@@ -33,6 +33,8 @@ class TheoryEngine;
 
 namespace prop {
 
+class LearnedSharer;
+
 /**
  * The module for processing literals that are learned at decision level zero.
  *
@@ -68,6 +70,10 @@ class ZeroLevelLearner : protected EnvObj
   std::vector<Node> getLearnedZeroLevelLiteralsForRestart() const;
   /** compute type for learned literal */
   modes::LearnedLitType computeLearnedLiteralType(const Node& lit);
+  /**
+   * Set the learned sharer, to which we export the input literals we learn.
+   */
+  void setLearnedSharer(LearnedSharer* ls);
 
  private:
   static void getAtoms(TNode a,
@@ -109,6 +115,8 @@ class ZeroLevelLearner : protected EnvObj
   size_t d_deepRestartThreshold;
   /** learnable learned literal types (for deep restart), based on option */
   std::unordered_set<modes::LearnedLitType> d_learnedTypes;
+  /** The learned sharer, if we are sharing learned literals */
+  LearnedSharer* d_sharer;
 }; /* class ZeroLevelLearner */
 
 }  // namespace prop
@@ -23,6 +23,7 @@
 #include "options/quantifiers_options.h"
 #include "options/smt_options.h"
 #include "options/strings_options.h"
+#include "options/theory_options.h"
 #include "printer/printer.h"
 #include "proof/conv_proof_generator.h"
 #include "smt/solver_engine_stats.h"
@@ -49,7 +50,8 @@ Env::Env(const Options* opts)
       d_statisticsRegistry(std::make_unique<StatisticsRegistry>(*this)),
       d_options(),
       d_resourceManager(),
-      d_uninterpretedSortOwner(theory::THEORY_UF)
+      d_uninterpretedSortOwner(theory::THEORY_UF),
+      d_learnedExchange(nullptr)
 {
   if (opts != nullptr)
   {
@@ -75,6 +77,11 @@ void Env::finishInit(ProofNodeManager* pnm)
     d_proofNodeManager = pnm;
     d_rewriter->finishInit(*this);
   }
+  if (d_options.theory.rewriteCacheLimit > 0)
+  {
+    d_rewriter->d_cache = std::make_unique<theory::RewriteCache>(
+        *d_statisticsRegistry, d_options.theory.rewriteCacheLimit);
+  }
   d_topLevelSubs.reset(
       new theory::TrustSubstitutionMap(*this, d_userContext.get()));
 }
@@ -130,6 +137,11 @@ ResourceManager* Env::getResourceManager() const
   return d_resourceManager.get();
 }
 
+prop::LearnedExchange* Env::getLearnedExchange() const
+{
+  return d_learnedExchange;
+}
+
 bool Env::isOutputOn(OutputTag tag) const
 {
   return d_options.base.outputTagHolder[static_cast<size_t>(tag)];
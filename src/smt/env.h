@@ -44,6 +44,10 @@ enum class OutputTag;
 }
 using OutputTag = options::OutputTag;
 
+namespace prop {
+class LearnedExchange;
+}
+
 namespace smt {
 class PfManager;
 }
@@ -128,6 +132,12 @@ class Env
   /** Get a pointer to the StatisticsRegistry. */
   StatisticsRegistry& getStatisticsRegistry();
 
+  /**
+   * Get the learned exchange shared with other solvers of a thread portfolio,
+   * or nullptr if this solver does not share learned clauses.
+   */
+  prop::LearnedExchange* getLearnedExchange() const;
+
   /* Option helpers---------------------------------------------------------- */
 
   /**
@@ -326,6 +336,8 @@ class Env
   /** The separation logic location and data types */
   TypeNode d_sepLocType;
   TypeNode d_sepDataType;
+  /** The learned exchange, not owned by this class */
+  prop::LearnedExchange* d_learnedExchange;
 }; /* class Env */
 
 }  // namespace cvc5::internal
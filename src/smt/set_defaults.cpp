@@ -863,6 +863,20 @@ void SetDefaults::setDefaultsPost(const LogicInfo& logic, Options& opts) const
         opts.writeArith().nlExt = options::NlExtMode::FULL;
       }
   }
+
+  // Disable options incompatible with sharing learned clauses with other
+  // solvers, or output an error if enabled explicitly.
+  if (d_env.getLearnedExchange() != nullptr)
+  {
+    std::stringstream reasonNoSharing;
+    if (incompatibleWithSharing(opts, reasonNoSharing))
+    {
+      std::stringstream ss;
+      ss << reasonNoSharing.str()
+         << " not supported when sharing learned clauses in a portfolio.";
+      throw OptionException(ss.str());
+    }
+  }
 }
 
 bool SetDefaults::isSygus(const Options& opts) const
@@ -971,6 +985,20 @@ bool SetDefaults::incompatibleWithProofs(Options& opts,
     reason << "deep restarts";
     return true;
   }
+  // CaDiCaL does not produce SAT proofs, which are required unless we only
+  // produce preprocessing proofs.
+  if (opts.prop.satSolver == options::CDCLTSatSolverMode::CADICAL
+      && opts.smt.proofMode != options::ProofMode::PP_ONLY)
+  {
+    if (opts.prop.satSolverWasSetByUser)
+    {
+      reason << "sat-solver=cadical";
+      return true;
+    }
+    verbose(1) << "Using MiniSat as main SAT solver due to proof production."
+               << std::endl;
+    opts.writeProp().satSolver = options::CDCLTSatSolverMode::MINISAT;
+  }
   return false;
 }
 
@@ -1224,6 +1252,57 @@ bool SetDefaults::incompatibleWithSeparationLogic(Options& opts,
   return false;
 }
 
+bool SetDefaults::incompatibleWithSharing(Options& opts,
+                                          std::ostream& reason) const
+{
+  // The clauses and literals we share are learned from the preprocessed
+  // assertions, and are added by solvers with other configurations. Hence,
+  // preprocessing must preserve equivalence, since passes that only preserve
+  // satisfiability may add assertions that are not entailed by the input,
+  // e.g. symmetry breaking, which is on by default for QF_UF.
+  if (opts.uf.ufSymmetryBreaker)
+  {
+    if (opts.uf.ufSymmetryBreakerWasSetByUser)
+    {
+      reason << "symmetry breaker";
+      return true;
+    }
+    notifyModifyOption("ufSymmetryBreaker", "false", "sharing");
+    opts.writeUf().ufSymmetryBreaker = false;
+  }
+  if (opts.smt.sortInference)
+  {
+    if (opts.smt.sortInferenceWasSetByUser)
+    {
+      reason << "sort inference";
+      return true;
+    }
+    notifyModifyOption("sortInference", "false", "sharing");
+    opts.writeSmt().sortInference = false;
+  }
+  if (opts.quantifiers.globalNegate)
+  {
+    if (opts.quantifiers.globalNegateWasSetByUser)
+    {
+      reason << "global-negate";
+      return true;
+    }
+    notifyModifyOption("globalNegate", "false", "sharing");
+    opts.writeQuantifiers().globalNegate = false;
+  }
+  if (opts.quantifiers.sygusInference)
+  {
+    if (opts.quantifiers.sygusInferenceWasSetByUser)
+    {
+      reason << "sygus inference";
+      return true;
+    }
+    notifyModifyOption("sygusInference", "false", "sharing");
+    opts.writeQuantifiers().sygusInference = false;
+  }
+  return false;
+}
+
 void SetDefaults::widenLogic(LogicInfo& logic, const Options& opts) const
 {
   bool needsUf = false;
@@ -132,6 +132,14 @@ class SetDefaults : protected EnvObj
    */
   bool incompatibleWithSeparationLogic(Options& opts,
                                        std::ostream& reason) const;
+  /**
+   * Check if incompatible with sharing learned clauses with the other solvers
+   * of a portfolio, which is the case for preprocessing that does not
+   * preserve equivalence. Notice this method may modify the options to
+   * ensure that we are compatible with sharing. The output stream reason is
+   * similar to above.
+   */
+  bool incompatibleWithSharing(Options& opts, std::ostream& reason) const;
   //------------------------- options setting, prior finalization of logic
   /**
    * Set defaults pre, which sets all options prior to finalizing the logic.
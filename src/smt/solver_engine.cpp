@@ -1962,6 +1962,14 @@ void SolverEngine::setIsInternalSubsolver() { d_isInternalSubsolver = true; }
 
 bool SolverEngine::isInternalSubsolver() const { return d_isInternalSubsolver; }
 
+void SolverEngine::setLearnedExchange(prop::LearnedExchange* exchange)
+{
+  Assert(!d_state->isFullyInited())
+      << "setting learned exchange in SolverEngine but the engine has "
+         "already finished initializing";
+  d_env->d_learnedExchange = exchange;
+}
+
 std::string SolverEngine::getOption(const std::string& key) const
 {
   Trace("smt") << "SMT getOption(" << key << ")" << endl;
@@ -76,6 +76,12 @@ class UnsatCoreManager;
 
 /* -------------------------------------------------------------------------- */
 
+namespace prop {
+class LearnedExchange;
+}  // namespace prop
+
+/* -------------------------------------------------------------------------- */
+
 namespace theory {
 class TheoryModel;
 class QuantifiersEngine;
@@ -197,6 +203,14 @@ class CVC5_EXPORT SolverEngine
   /** Is this an internal subsolver? */
   bool isInternalSubsolver() const;
 
+  /**
+   * Set the learned exchange that this SolverEngine shares with the other
+   * solvers of a thread portfolio. Learned clauses are exported to and
+   * imported from the exchange during search. This must be called before
+   * this SolverEngine is fully initialized.
+   */
+  void setLearnedExchange(prop::LearnedExchange* exchange);
+
   /**
    * Block the current model. Can be called only if immediately preceded by
    * a SAT or INVALID query. Only permitted if produce-models is on, and the
@@ -56,25 +56,10 @@ EvalResult& EvalResult::operator=(const EvalResult& other)
 {
   if (this != &other)
   {
-    d_tag = other.d_tag;
-    switch (d_tag)
-    {
-      case BOOL: d_bool = other.d_bool; break;
-      case BITVECTOR:
-        new (&d_bv) BitVector;
-        d_bv = other.d_bv;
-        break;
-      case RATIONAL:
-        new (&d_rat) Rational;
-        d_rat = other.d_rat;
-        break;
-      case STRING:
-        new (&d_str) String;
-        d_str = other.d_str;
-        break;
-      case UVALUE: new (&d_av) UninterpretedSortValue(other.d_av); break;
-      case INVALID: break;
-    }
+    // destroy the current value first, since results are reused, e.g. by the
+    // slots of an EvalProgram
+    this->~EvalResult();
+    new (this) EvalResult(other);
   }
   return *this;
 }
@@ -325,798 +310,801 @@ EvalResult Evaluator::evalInternal(
 
       Trace("evaluator") << "Current node val : " << currNodeVal << std::endl;
 
-      switch (currNodeVal.getKind())
+      if (currNodeVal.getKind() == kind::APPLY_UF)
       {
         // APPLY_UF is a special case where we look up the operator and apply
         // beta reduction if possible
-        case kind::APPLY_UF:
-        {
-          Trace("evaluator") << "Evaluate " << currNode << std::endl;
-          TNode op = currNode.getOperator();
-          if (op.getKind() == kind::FUNCTION_ARRAY_CONST)
-          {
-            // If we have a function constant as the operator, it was not
-            // processed. We require converting to a lambda now.
-            op = uf::FunctionConst::toLambda(op);
-          }
-          else
-          {
-            Assert(evalAsNode.find(op) != evalAsNode.end());
-            // no function can be a valid EvalResult
-            op = evalAsNode[op];
-          }
-          Trace("evaluator") << "Operator evaluated to " << op << std::endl;
-          if (op.getKind() != kind::LAMBDA)
-          {
-            // this node is not evaluatable due to operator, must add to
-            // evalAsNode
-            results[currNode] = EvalResult();
-            evalAsNode[currNode] = reconstruct(currNode, results, evalAsNode);
-            continue;
-          }
-          // Create a copy of the current substitutions
-          std::vector<Node> lambdaArgs(args);
-          std::vector<Node> lambdaVals(vals);
-
-          // Add the values for the arguments of the lambda as substitutions at
-          // the beginning of the vector to shadow variables from outer scopes
-          // with the same name
-          for (const auto& lambdaArg : op[0])
-          {
-            lambdaArgs.insert(lambdaArgs.begin(), lambdaArg);
-          }
-
-          for (const auto& lambdaVal : currNode)
-          {
-            lambdaVals.insert(lambdaVals.begin(),
-                              results[lambdaVal].toNode(lambdaVal.getType()));
-          }
-
-          // Lambdas are evaluated in a recursive fashion because each
-          // evaluation requires different substitutions. We use a fresh cache
-          // since the evaluation of op[1] is under a new substitution and
-          // thus should not be cached. We could alternatively copy evalAsNode
-          // to evalAsNodeC but favor avoiding this copy for performance
-          // reasons.
-          std::unordered_map<TNode, Node> evalAsNodeC;
-          std::unordered_map<TNode, EvalResult> resultsC;
-          results[currNode] = evalInternal(
-              op[1], lambdaArgs, lambdaVals, evalAsNodeC, resultsC);
-          Trace("evaluator") << "Evaluated via arguments to "
-                             << results[currNode].d_tag << std::endl;
-          if (results[currNode].d_tag == EvalResult::INVALID)
-          {
-            // evaluation was invalid, we take the node of op[1] as the result
-            evalAsNode[currNode] = evalAsNodeC[op[1]];
-            Trace("evaluator")
-                << "Take node evaluation: " << evalAsNodeC[op[1]] << std::endl;
-          }
-        }
-        break;
-        case kind::CONST_BOOLEAN:
-          results[currNode] = EvalResult(currNodeVal.getConst<bool>());
-          break;
-
-        case kind::NOT:
-        {
-          results[currNode] = EvalResult(!(results[currNode[0]].d_bool));
-          break;
-        }
-
-        case kind::AND:
+        Trace("evaluator") << "Evaluate " << currNode << std::endl;
+        TNode op = currNode.getOperator();
+        if (op.getKind() == kind::FUNCTION_ARRAY_CONST)
         {
-          bool res = results[currNode[0]].d_bool;
-          for (size_t i = 1, end = currNode.getNumChildren(); i < end; i++)
-          {
-            res = res && results[currNode[i]].d_bool;
-          }
-          results[currNode] = EvalResult(res);
-          break;
+          // If we have a function constant as the operator, it was not
+          // processed. We require converting to a lambda now.
+          op = uf::FunctionConst::toLambda(op);
         }
-
-        case kind::OR:
+        else
         {
-          bool res = results[currNode[0]].d_bool;
-          for (size_t i = 1, end = currNode.getNumChildren(); i < end; i++)
-          {
-            res = res || results[currNode[i]].d_bool;
-          }
-          results[currNode] = EvalResult(res);
-          break;
+          Assert(evalAsNode.find(op) != evalAsNode.end());
+          // no function can be a valid EvalResult
+          op = evalAsNode[op];
         }
-        case kind::XOR:
+        Trace("evaluator") << "Operator evaluated to " << op << std::endl;
+        if (op.getKind() != kind::LAMBDA)
         {
-          bool res = results[currNode[0]].d_bool;
-          for (size_t i = 1, end = currNode.getNumChildren(); i < end; i++)
-          {
-            res = res != results[currNode[i]].d_bool;
-          }
-          results[currNode] = EvalResult(res);
-          break;
+          // this node is not evaluatable due to operator, must add to
+          // evalAsNode
+          results[currNode] = EvalResult();
+          evalAsNode[currNode] = reconstruct(currNode, results, evalAsNode);
+          continue;
         }
+        // Create a copy of the current substitutions
+        std::vector<Node> lambdaArgs(args);
+        std::vector<Node> lambdaVals(vals);
 
-        case kind::CONST_RATIONAL:
-        case kind::CONST_INTEGER:
-        {
-          const Rational& r = currNodeVal.getConst<Rational>();
-          results[currNode] = EvalResult(r);
-          break;
-        }
-        case kind::UNINTERPRETED_SORT_VALUE:
+        // Add the values for the arguments of the lambda as substitutions at
+        // the beginning of the vector to shadow variables from outer scopes
+        // with the same name
+        for (const auto& lambdaArg : op[0])
         {
-          const UninterpretedSortValue& av =
-              currNodeVal.getConst<UninterpretedSortValue>();
-          results[currNode] = EvalResult(av);
-          break;
-        }
-        case kind::ADD:
-        {
-          Rational res = results[currNode[0]].d_rat;
-          for (size_t i = 1, end = currNode.getNumChildren(); i < end; i++)
-          {
-            res = res + results[currNode[i]].d_rat;
-          }
-          results[currNode] = EvalResult(res);
-          break;
+          lambdaArgs.insert(lambdaArgs.begin(), lambdaArg);
         }
 
-        case kind::SUB:
+        for (const auto& lambdaVal : currNode)
         {
-          const Rational& x = results[currNode[0]].d_rat;
-          const Rational& y = results[currNode[1]].d_rat;
-          results[currNode] = EvalResult(x - y);
-          break;
+          lambdaVals.insert(lambdaVals.begin(),
+                            results[lambdaVal].toNode(lambdaVal.getType()));
         }
 
-        case kind::NEG:
-        {
-          const Rational& x = results[currNode[0]].d_rat;
-          results[currNode] = EvalResult(-x);
-          break;
-        }
-        case kind::MULT:
-        case kind::NONLINEAR_MULT:
-        {
-          Rational res = results[currNode[0]].d_rat;
-          for (size_t i = 1, end = currNode.getNumChildren(); i < end; i++)
-          {
-            res = res * results[currNode[i]].d_rat;
-          }
-          results[currNode] = EvalResult(res);
-          break;
-        }
-        case kind::DIVISION:
-        case kind::DIVISION_TOTAL:
-        case kind::INTS_DIVISION:
-        case kind::INTS_DIVISION_TOTAL:
-        case kind::INTS_MODULUS:
-        case kind::INTS_MODULUS_TOTAL:
-        {
-          Rational res = results[currNode[0]].d_rat;
-          bool divbyzero = false;
-          Kind k = currNodeVal.getKind();
-          bool isReal = (k == kind::DIVISION || k == kind::DIVISION_TOTAL);
-          bool isMod =
-              (k == kind::INTS_MODULUS || k == kind::INTS_MODULUS_TOTAL);
-          for (size_t i = 1, end = currNode.getNumChildren(); i < end; i++)
-          {
-            if (results[currNode[i]].d_rat.isZero())
-            {
-              if (k == kind::DIVISION_TOTAL || k == kind::INTS_DIVISION_TOTAL
-                  || k == kind::INTS_MODULUS_TOTAL)
-              {
-                res = Rational(0);
-                continue;
-              }
-              else
-              {
-                Trace("evaluator")
-                    << "Division/modulus by zero not supported" << std::endl;
-                divbyzero = true;
-                results[currNode] = EvalResult();
-                break;
-              }
-            }
-            if (isReal)
-            {
-              res = res / results[currNode[i]].d_rat;
-            }
-            else
-            {
-              Integer a = res.getNumerator();
-              Integer b = results[currNode[i]].d_rat.getNumerator();
-              res = Rational(isMod ? a.euclidianDivideRemainder(b)
-                                   : a.euclidianDivideQuotient(b));
-            }
-          }
-          if (divbyzero)
-          {
-            processUnhandled(
-                currNode, currNodeVal, evalAsNode, results, needsReconstruct);
-          }
-          else
-          {
-            results[currNode] = EvalResult(res);
-          }
-          break;
-        }
-        case kind::GEQ:
-        {
-          const Rational& x = results[currNode[0]].d_rat;
-          const Rational& y = results[currNode[1]].d_rat;
-          results[currNode] = EvalResult(x >= y);
-          break;
-        }
-        case kind::LEQ:
-        {
-          const Rational& x = results[currNode[0]].d_rat;
-          const Rational& y = results[currNode[1]].d_rat;
-          results[currNode] = EvalResult(x <= y);
-          break;
-        }
-        case kind::GT:
-        {
-          const Rational& x = results[currNode[0]].d_rat;
-          const Rational& y = results[currNode[1]].d_rat;
-          results[currNode] = EvalResult(x > y);
-          break;
-        }
-        case kind::LT:
-        {
-          const Rational& x = results[currNode[0]].d_rat;
-          const Rational& y = results[currNode[1]].d_rat;
-          results[currNode] = EvalResult(x < y);
-          break;
-        }
-        case kind::ABS:
-        {
-          const Rational& x = results[currNode[0]].d_rat;
-          results[currNode] = EvalResult(x.abs());
-          break;
-        }
-        case kind::TO_REAL:
+        // Lambdas are evaluated in a recursive fashion because each
+        // evaluation requires different substitutions. We use a fresh cache
+        // since the evaluation of op[1] is under a new substitution and
+        // thus should not be cached. We could alternatively copy evalAsNode
+        // to evalAsNodeC but favor avoiding this copy for performance
+        // reasons.
+        std::unordered_map<TNode, Node> evalAsNodeC;
+        std::unordered_map<TNode, EvalResult> resultsC;
+        results[currNode] = evalInternal(
+            op[1], lambdaArgs, lambdaVals, evalAsNodeC, resultsC);
+        Trace("evaluator") << "Evaluated via arguments to "
+                           << results[currNode].d_tag << std::endl;
+        if (results[currNode].d_tag == EvalResult::INVALID)
         {
-          // casting to real is a no-op
-          const Rational& x = results[currNode[0]].d_rat;
-          results[currNode] = EvalResult(x);
-          break;
+          // evaluation was invalid, we take the node of op[1] as the result
+          evalAsNode[currNode] = evalAsNodeC[op[1]];
+          Trace("evaluator")
+              << "Take node evaluation: " << evalAsNodeC[op[1]] << std::endl;
         }
-        case kind::TO_INTEGER:
+      }
+      else
+      {
+        std::vector<const EvalResult*> children;
+        for (const Node& currNodeChild : currNodeVal)
         {
-          // casting to int takes the floor
-          const Rational& x = results[currNode[0]].d_rat.floor();
-          results[currNode] = EvalResult(x);
-          break;
+          children.push_back(&results[currNodeChild]);
         }
-        case kind::IS_INTEGER:
+        EvalResult res = evalNode(currNodeVal, children);
+        if (res.d_tag == EvalResult::INVALID)
         {
-          const Rational& x = results[currNode[0]].d_rat;
-          results[currNode] = EvalResult(x.isIntegral());
-          break;
+          processUnhandled(
+              currNode, currNodeVal, evalAsNode, results, needsReconstruct);
         }
-        case kind::POW2:
+        else
         {
-          const Rational& x = results[currNode[0]].d_rat;
-          bool valid = false;
-          if (x.getNumerator().fitsUnsignedInt())
-          {
-            uint32_t value = x.getNumerator().toUnsignedInt();
-            if (value <= 256)
-            {
-              valid = true;
-              results[currNode] = EvalResult(Rational(Integer(2).pow(value)));
-            }
-          }
-          if (!valid)
-          {
-            processUnhandled(
-                currNode, currNodeVal, evalAsNode, results, needsReconstruct);
-          }
-          break;
+          results[currNode] = res;
         }
-        case kind::CONST_STRING:
-          results[currNode] = EvalResult(currNodeVal.getConst<String>());
-          break;
+      }
+    }
+  }
 
-        case kind::STRING_CONCAT:
-        {
-          String res = results[currNode[0]].d_str;
-          for (size_t i = 1, end = currNode.getNumChildren(); i < end; i++)
-          {
-            res = res.concat(results[currNode[i]].d_str);
-          }
-          results[currNode] = EvalResult(res);
-          break;
-        }
+  return results[n];
+}
 
-        case kind::STRING_LENGTH:
-        {
-          const String& s = results[currNode[0]].d_str;
-          results[currNode] = EvalResult(Rational(s.size()));
-          break;
-        }
+EvalResult Evaluator::evalNode(
+    TNode currNode, const std::vector<const EvalResult*>& children) const
+{
+  EvalResult ret;
+  switch (currNode.getKind())
+  {
+    case kind::CONST_BOOLEAN:
+      ret = EvalResult(currNode.getConst<bool>());
+      break;
 
-        case kind::STRING_SUBSTR:
-        {
-          const String& s = results[currNode[0]].d_str;
-          Integer s_len(s.size());
-          Integer i = results[currNode[1]].d_rat.getNumerator();
-          Integer j = results[currNode[2]].d_rat.getNumerator();
+    case kind::NOT:
+    {
+      ret = EvalResult(!(children[0]->d_bool));
+      break;
+    }
 
-          if (i.strictlyNegative() || j.strictlyNegative() || i >= s_len)
-          {
-            results[currNode] = EvalResult(String(""));
-          }
-          else if (i + j > s_len)
-          {
-            results[currNode] =
-                EvalResult(s.suffix((s_len - i).toUnsignedInt()));
-          }
-          else
-          {
-            results[currNode] =
-                EvalResult(s.substr(i.toUnsignedInt(), j.toUnsignedInt()));
-          }
-          break;
-        }
-        case kind::SEQ_NTH:
-        {
-          // only strings evaluate
-          Assert (currNode[0].getType().isString());
-          const String& s = results[currNode[0]].d_str;
-          Integer s_len(s.size());
-          Integer i = results[currNode[1]].d_rat.getNumerator();
-          if (i.strictlyNegative() || i >= s_len)
-          {
-            results[currNode] = EvalResult(Rational(-1));
-          }
-          else
-          {
-            results[currNode] = EvalResult(Rational(s.getVec()[i.toUnsignedInt()]));
-          }
-          break;
-        }
+    case kind::AND:
+    {
+      bool res = children[0]->d_bool;
+      for (size_t i = 1, end = currNode.getNumChildren(); i < end; i++)
+      {
+        res = res && children[i]->d_bool;
+      }
+      ret = EvalResult(res);
+      break;
+    }
 
-        case kind::STRING_UPDATE:
-        {
-          const String& s = results[currNode[0]].d_str;
-          Integer s_len(s.size());
-          Integer i = results[currNode[1]].d_rat.getNumerator();
-          const String& t = results[currNode[2]].d_str;
+    case kind::OR:
+    {
+      bool res = children[0]->d_bool;
+      for (size_t i = 1, end = currNode.getNumChildren(); i < end; i++)
+      {
+        res = res || children[i]->d_bool;
+      }
+      ret = EvalResult(res);
+      break;
+    }
+    case kind::XOR:
+    {
+      bool res = children[0]->d_bool;
+      for (size_t i = 1, end = currNode.getNumChildren(); i < end; i++)
+      {
+        res = res != children[i]->d_bool;
+      }
+      ret = EvalResult(res);
+      break;
+    }
 
-          if (i.strictlyNegative() || i >= s_len)
-          {
-            results[currNode] = EvalResult(s);
-          }
-          else
-          {
-            results[currNode] = EvalResult(s.update(i.toUnsignedInt(), t));
-          }
-          break;
-        }
-        case kind::STRING_CHARAT:
-        {
-          const String& s = results[currNode[0]].d_str;
-          Integer s_len(s.size());
-          Integer i = results[currNode[1]].d_rat.getNumerator();
-          if (i.strictlyNegative() || i >= s_len)
-          {
-            results[currNode] = EvalResult(String(""));
-          }
-          else
-          {
-            results[currNode] = EvalResult(s.substr(i.toUnsignedInt(), 1));
-          }
-          break;
-        }
+    case kind::CONST_RATIONAL:
+    case kind::CONST_INTEGER:
+    {
+      const Rational& r = currNode.getConst<Rational>();
+      ret = EvalResult(r);
+      break;
+    }
+    case kind::UNINTERPRETED_SORT_VALUE:
+    {
+      const UninterpretedSortValue& av =
+          currNode.getConst<UninterpretedSortValue>();
+      ret = EvalResult(av);
+      break;
+    }
+    case kind::ADD:
+    {
+      Rational res = children[0]->d_rat;
+      for (size_t i = 1, end = currNode.getNumChildren(); i < end; i++)
+      {
+        res = res + children[i]->d_rat;
+      }
+      ret = EvalResult(res);
+      break;
+    }
 
-        case kind::STRING_CONTAINS:
-        {
-          const String& s = results[currNode[0]].d_str;
-          const String& t = results[currNode[1]].d_str;
-          results[currNode] = EvalResult(s.find(t) != std::string::npos);
-          break;
-        }
+    case kind::SUB:
+    {
+      const Rational& x = children[0]->d_rat;
+      const Rational& y = children[1]->d_rat;
+      ret = EvalResult(x - y);
+      break;
+    }
 
-        case kind::STRING_INDEXOF:
+    case kind::NEG:
+    {
+      const Rational& x = children[0]->d_rat;
+      ret = EvalResult(-x);
+      break;
+    }
+    case kind::MULT:
+    case kind::NONLINEAR_MULT:
+    {
+      Rational res = children[0]->d_rat;
+      for (size_t i = 1, end = currNode.getNumChildren(); i < end; i++)
+      {
+        res = res * children[i]->d_rat;
+      }
+      ret = EvalResult(res);
+      break;
+    }
+    case kind::DIVISION:
+    case kind::DIVISION_TOTAL:
+    case kind::INTS_DIVISION:
+    case kind::INTS_DIVISION_TOTAL:
+    case kind::INTS_MODULUS:
+    case kind::INTS_MODULUS_TOTAL:
+    {
+      Rational res = children[0]->d_rat;
+      bool divbyzero = false;
+      Kind k = currNode.getKind();
+      bool isReal = (k == kind::DIVISION || k == kind::DIVISION_TOTAL);
+      bool isMod =
+          (k == kind::INTS_MODULUS || k == kind::INTS_MODULUS_TOTAL);
+      for (size_t i = 1, end = currNode.getNumChildren(); i < end; i++)
+      {
+        if (children[i]->d_rat.isZero())
         {
-          const String& s = results[currNode[0]].d_str;
-          Integer s_len(s.size());
-          const String& x = results[currNode[1]].d_str;
-          Integer i = results[currNode[2]].d_rat.getNumerator();
-
-          if (i.strictlyNegative())
+          if (k == kind::DIVISION_TOTAL || k == kind::INTS_DIVISION_TOTAL
+              || k == kind::INTS_MODULUS_TOTAL)
           {
-            results[currNode] = EvalResult(Rational(-1));
+            res = Rational(0);
+            continue;
           }
           else
           {
-            size_t r = s.find(x, i.toUnsignedInt());
-            if (r == std::string::npos)
-            {
-              results[currNode] = EvalResult(Rational(-1));
-            }
-            else
-            {
-              results[currNode] = EvalResult(Rational(r));
-            }
+            Trace("evaluator")
+                << "Division/modulus by zero not supported" << std::endl;
+            divbyzero = true;
+            break;
           }
-          break;
         }
-
-        case kind::STRING_REPLACE:
+        if (isReal)
         {
-          const String& s = results[currNode[0]].d_str;
-          const String& x = results[currNode[1]].d_str;
-          const String& y = results[currNode[2]].d_str;
-          results[currNode] = EvalResult(s.replace(x, y));
-          break;
+          res = res / children[i]->d_rat;
         }
-
-        case kind::STRING_PREFIX:
+        else
         {
-          const String& t = results[currNode[0]].d_str;
-          const String& s = results[currNode[1]].d_str;
-          if (s.size() < t.size())
-          {
-            results[currNode] = EvalResult(false);
-          }
-          else
-          {
-            results[currNode] = EvalResult(s.prefix(t.size()) == t);
-          }
-          break;
+          Integer a = res.getNumerator();
+          Integer b = children[i]->d_rat.getNumerator();
+          res = Rational(isMod ? a.euclidianDivideRemainder(b)
+                               : a.euclidianDivideQuotient(b));
         }
-
-        case kind::STRING_SUFFIX:
+      }
+      if (!divbyzero)
+      {
+        ret = EvalResult(res);
+      }
+      break;
+    }
+    case kind::GEQ:
+    {
+      const Rational& x = children[0]->d_rat;
+      const Rational& y = children[1]->d_rat;
+      ret = EvalResult(x >= y);
+      break;
+    }
+    case kind::LEQ:
+    {
+      const Rational& x = children[0]->d_rat;
+      const Rational& y = children[1]->d_rat;
+      ret = EvalResult(x <= y);
+      break;
+    }
+    case kind::GT:
+    {
+      const Rational& x = children[0]->d_rat;
+      const Rational& y = children[1]->d_rat;
+      ret = EvalResult(x > y);
+      break;
+    }
+    case kind::LT:
+    {
+      const Rational& x = children[0]->d_rat;
+      const Rational& y = children[1]->d_rat;
+      ret = EvalResult(x < y);
+      break;
+    }
+    case kind::ABS:
+    {
+      const Rational& x = children[0]->d_rat;
+      ret = EvalResult(x.abs());
+      break;
+    }
+    case kind::TO_REAL:
+    {
+      // casting to real is a no-op
+      const Rational& x = children[0]->d_rat;
+      ret = EvalResult(x);
+      break;
+    }
+    case kind::TO_INTEGER:
+    {
+      // casting to int takes the floor
+      const Rational& x = children[0]->d_rat.floor();
+      ret = EvalResult(x);
+      break;
+    }
+    case kind::IS_INTEGER:
+    {
+      const Rational& x = children[0]->d_rat;
+      ret = EvalResult(x.isIntegral());
+      break;
+    }
+    case kind::POW2:
+    {
+      const Rational& x = children[0]->d_rat;
+      // otherwise, the result is too large to be computed
+      if (x.getNumerator().fitsUnsignedInt())
+      {
+        uint32_t value = x.getNumerator().toUnsignedInt();
+        if (value <= 256)
         {
-          const String& t = results[currNode[0]].d_str;
-          const String& s = results[currNode[1]].d_str;
-          if (s.size() < t.size())
-          {
-            results[currNode] = EvalResult(false);
-          }
-          else
-          {
-            results[currNode] = EvalResult(s.suffix(t.size()) == t);
-          }
-          break;
+          ret = EvalResult(Rational(Integer(2).pow(value)));
         }
+      }
+      break;
+    }
+    case kind::CONST_STRING:
+      ret = EvalResult(currNode.getConst<String>());
+      break;
 
-        case kind::STRING_ITOS:
-        {
-          Integer i = results[currNode[0]].d_rat.getNumerator();
-          if (i.strictlyNegative())
-          {
-            results[currNode] = EvalResult(String(""));
-          }
-          else
-          {
-            results[currNode] = EvalResult(String(i.toString()));
-          }
-          break;
-        }
+    case kind::STRING_CONCAT:
+    {
+      String res = children[0]->d_str;
+      for (size_t i = 1, end = currNode.getNumChildren(); i < end; i++)
+      {
+        res = res.concat(children[i]->d_str);
+      }
+      ret = EvalResult(res);
+      break;
+    }
 
-        case kind::STRING_STOI:
-        {
-          const String& s = results[currNode[0]].d_str;
-          if (s.isNumber())
-          {
-            results[currNode] = EvalResult(Rational(s.toNumber()));
-          }
-          else
-          {
-            results[currNode] = EvalResult(Rational(-1));
-          }
-          break;
-        }
+    case kind::STRING_LENGTH:
+    {
+      const String& s = children[0]->d_str;
+      ret = EvalResult(Rational(s.size()));
+      break;
+    }
 
-        case kind::STRING_FROM_CODE:
-        {
-          Integer i = results[currNode[0]].d_rat.getNumerator();
-          if (i >= 0 && i < d_alphaCard)
-          {
-            std::vector<unsigned> svec = {i.toUnsignedInt()};
-            results[currNode] = EvalResult(String(svec));
-          }
-          else
-          {
-            results[currNode] = EvalResult(String(""));
-          }
-          break;
-        }
+    case kind::STRING_SUBSTR:
+    {
+      const String& s = children[0]->d_str;
+      Integer s_len(s.size());
+      Integer i = children[1]->d_rat.getNumerator();
+      Integer j = children[2]->d_rat.getNumerator();
 
-        case kind::STRING_TO_CODE:
-        {
-          const String& s = results[currNode[0]].d_str;
-          if (s.size() == 1)
-          {
-            results[currNode] = EvalResult(Rational(s.getVec()[0]));
-          }
-          else
-          {
-            results[currNode] = EvalResult(Rational(-1));
-          }
-          break;
-        }
+      if (i.strictlyNegative() || j.strictlyNegative() || i >= s_len)
+      {
+        ret = EvalResult(String(""));
+      }
+      else if (i + j > s_len)
+      {
+        ret = EvalResult(s.suffix((s_len - i).toUnsignedInt()));
+      }
+      else
+      {
+        ret = EvalResult(s.substr(i.toUnsignedInt(), j.toUnsignedInt()));
+      }
+      break;
+    }
+    case kind::SEQ_NTH:
+    {
+      // only strings evaluate
+      Assert (currNode[0].getType().isString());
+      const String& s = children[0]->d_str;
+      Integer s_len(s.size());
+      Integer i = children[1]->d_rat.getNumerator();
+      if (i.strictlyNegative() || i >= s_len)
+      {
+        ret = EvalResult(Rational(-1));
+      }
+      else
+      {
+        ret = EvalResult(Rational(s.getVec()[i.toUnsignedInt()]));
+      }
+      break;
+    }
 
-        case kind::CONST_BITVECTOR:
-          results[currNode] = EvalResult(currNodeVal.getConst<BitVector>());
-          break;
+    case kind::STRING_UPDATE:
+    {
+      const String& s = children[0]->d_str;
+      Integer s_len(s.size());
+      Integer i = children[1]->d_rat.getNumerator();
+      const String& t = children[2]->d_str;
 
-        case kind::BITVECTOR_NOT:
-          results[currNode] = EvalResult(~results[currNode[0]].d_bv);
-          break;
+      if (i.strictlyNegative() || i >= s_len)
+      {
+        ret = EvalResult(s);
+      }
+      else
+      {
+        ret = EvalResult(s.update(i.toUnsignedInt(), t));
+      }
+      break;
+    }
+    case kind::STRING_CHARAT:
+    {
+      const String& s = children[0]->d_str;
+      Integer s_len(s.size());
+      Integer i = children[1]->d_rat.getNumerator();
+      if (i.strictlyNegative() || i >= s_len)
+      {
+        ret = EvalResult(String(""));
+      }
+      else
+      {
+        ret = EvalResult(s.substr(i.toUnsignedInt(), 1));
+      }
+      break;
+    }
 
-        case kind::BITVECTOR_NEG:
-          results[currNode] = EvalResult(-results[currNode[0]].d_bv);
-          break;
+    case kind::STRING_CONTAINS:
+    {
+      const String& s = children[0]->d_str;
+      const String& t = children[1]->d_str;
+      ret = EvalResult(s.find(t) != std::string::npos);
+      break;
+    }
 
-        case kind::BITVECTOR_EXTRACT:
-        {
-          unsigned lo = bv::utils::getExtractLow(currNodeVal);
-          unsigned hi = bv::utils::getExtractHigh(currNodeVal);
-          results[currNode] =
-              EvalResult(results[currNode[0]].d_bv.extract(hi, lo));
-          break;
-        }
+    case kind::STRING_INDEXOF:
+    {
+      const String& s = children[0]->d_str;
+      Integer s_len(s.size());
+      const String& x = children[1]->d_str;
+      Integer i = children[2]->d_rat.getNumerator();
 
-        case kind::BITVECTOR_CONCAT:
+      if (i.strictlyNegative())
+      {
+        ret = EvalResult(Rational(-1));
+      }
+      else
+      {
+        size_t r = s.find(x, i.toUnsignedInt());
+        if (r == std::string::npos)
         {
-          BitVector res = results[currNode[0]].d_bv;
-          for (size_t i = 1, end = currNode.getNumChildren(); i < end; i++)
-          {
-            res = res.concat(results[currNode[i]].d_bv);
-          }
-          results[currNode] = EvalResult(res);
-          break;
+          ret = EvalResult(Rational(-1));
         }
-
-        case kind::BITVECTOR_ADD:
+        else
         {
-          BitVector res = results[currNode[0]].d_bv;
-          for (size_t i = 1, end = currNode.getNumChildren(); i < end; i++)
-          {
-            res = res + results[currNode[i]].d_bv;
-          }
-          results[currNode] = EvalResult(res);
-          break;
+          ret = EvalResult(Rational(r));
         }
+      }
+      break;
+    }
 
-        case kind::BITVECTOR_MULT:
-        {
-          BitVector res = results[currNode[0]].d_bv;
-          for (size_t i = 1, end = currNode.getNumChildren(); i < end; i++)
-          {
-            res = res * results[currNode[i]].d_bv;
-          }
-          results[currNode] = EvalResult(res);
-          break;
-        }
-        case kind::BITVECTOR_AND:
-        {
-          BitVector res = results[currNode[0]].d_bv;
-          for (size_t i = 1, end = currNode.getNumChildren(); i < end; i++)
-          {
-            res = res & results[currNode[i]].d_bv;
-          }
-          results[currNode] = EvalResult(res);
-          break;
-        }
+    case kind::STRING_REPLACE:
+    {
+      const String& s = children[0]->d_str;
+      const String& x = children[1]->d_str;
+      const String& y = children[2]->d_str;
+      ret = EvalResult(s.replace(x, y));
+      break;
+    }
 
-        case kind::BITVECTOR_OR:
-        {
-          BitVector res = results[currNode[0]].d_bv;
-          for (size_t i = 1, end = currNode.getNumChildren(); i < end; i++)
-          {
-            res = res | results[currNode[i]].d_bv;
-          }
-          results[currNode] = EvalResult(res);
-          break;
-        }
+    case kind::STRING_PREFIX:
+    {
+      const String& t = children[0]->d_str;
+      const String& s = children[1]->d_str;
+      if (s.size() < t.size())
+      {
+        ret = EvalResult(false);
+      }
+      else
+      {
+        ret = EvalResult(s.prefix(t.size()) == t);
+      }
+      break;
+    }
 
-        case kind::BITVECTOR_XOR:
-        {
-          BitVector res = results[currNode[0]].d_bv;
-          for (size_t i = 1, end = currNode.getNumChildren(); i < end; i++)
-          {
-            res = res ^ results[currNode[i]].d_bv;
-          }
-          results[currNode] = EvalResult(res);
-          break;
-        }
-        case kind::BITVECTOR_UDIV:
-        {
-          BitVector res = results[currNode[0]].d_bv;
-          res = res.unsignedDivTotal(results[currNode[1]].d_bv);
-          results[currNode] = EvalResult(res);
-          break;
-        }
-        case kind::BITVECTOR_UREM:
-        {
-          BitVector res = results[currNode[0]].d_bv;
-          res = res.unsignedRemTotal(results[currNode[1]].d_bv);
-          results[currNode] = EvalResult(res);
-          break;
-        }
-        case kind::BITVECTOR_SHL:
-        {
-          BitVector res = results[currNode[0]].d_bv;
-          res = res.leftShift(results[currNode[1]].d_bv);
-          results[currNode] = EvalResult(res);
-          break;
-        }
-        case kind::BITVECTOR_ASHR:
-        {
-          BitVector res = results[currNode[0]].d_bv;
-          res = res.arithRightShift(results[currNode[1]].d_bv);
-          results[currNode] = EvalResult(res);
-          break;
-        }
-        case kind::BITVECTOR_ULT:
-        {
-          BitVector res = results[currNode[0]].d_bv;
-          bool b = res.unsignedLessThan(results[currNode[1]].d_bv);
-          results[currNode] = EvalResult(b);
-          break;
-        }
-        case kind::BITVECTOR_SLT:
-        {
-          BitVector res = results[currNode[0]].d_bv;
-          bool b = res.signedLessThan(results[currNode[1]].d_bv);
-          results[currNode] = EvalResult(b);
-          break;
-        }
-        case kind::BITVECTOR_SLE:
-        {
-          BitVector res = results[currNode[0]].d_bv;
-          bool b = res.signedLessThanEq(results[currNode[1]].d_bv);
-          results[currNode] = EvalResult(b);
-          break;
-        }
-        case kind::BITVECTOR_ULE:
-        {
-          BitVector res = results[currNode[0]].d_bv;
-          bool b = res.unsignedLessThanEq(results[currNode[1]].d_bv);
-          results[currNode] = EvalResult(b);
-          break;
-        }
-        case kind::BITVECTOR_UGT:
-        {
-          BitVector res = results[currNode[1]].d_bv;
-          bool b = res.unsignedLessThan(results[currNode[0]].d_bv);
-          results[currNode] = EvalResult(b);
-          break;
-        }
-        case kind::BITVECTOR_SGT:
-        {
-          BitVector res = results[currNode[1]].d_bv;
-          bool b = res.signedLessThan(results[currNode[0]].d_bv);
-          results[currNode] = EvalResult(b);
-          break;
-        }
-        case kind::BITVECTOR_SGE:
-        {
-          BitVector res = results[currNode[1]].d_bv;
-          bool b = res.signedLessThanEq(results[currNode[0]].d_bv);
-          results[currNode] = EvalResult(b);
-          break;
-        }
-        case kind::BITVECTOR_UGE:
-        {
-          BitVector res = results[currNode[1]].d_bv;
-          bool b = res.unsignedLessThanEq(results[currNode[0]].d_bv);
-          results[currNode] = EvalResult(b);
-          break;
-        }
-        case kind::BITVECTOR_SIGN_EXTEND:
-        {
-          BitVector res = results[currNode[0]].d_bv;
-          unsigned amount = currNode.getOperator()
-                                .getConst<BitVectorSignExtend>()
-                                .d_signExtendAmount;
-          results[currNode] = EvalResult(res.signExtend(amount));
-          break;
-        }
-        case kind::BITVECTOR_ZERO_EXTEND:
+    case kind::STRING_SUFFIX:
+    {
+      const String& t = children[0]->d_str;
+      const String& s = children[1]->d_str;
+      if (s.size() < t.size())
+      {
+        ret = EvalResult(false);
+      }
+      else
+      {
+        ret = EvalResult(s.suffix(t.size()) == t);
+      }
+      break;
+    }
+
+    case kind::STRING_ITOS:
+    {
+      Integer i = children[0]->d_rat.getNumerator();
+      if (i.strictlyNegative())
+      {
+        ret = EvalResult(String(""));
+      }
+      else
+      {
+        ret = EvalResult(String(i.toString()));
+      }
+      break;
+    }
+
+    case kind::STRING_STOI:
+    {
+      const String& s = children[0]->d_str;
+      if (s.isNumber())
+      {
+        ret = EvalResult(Rational(s.toNumber()));
+      }
+      else
+      {
+        ret = EvalResult(Rational(-1));
+      }
+      break;
+    }
+
+    case kind::STRING_FROM_CODE:
+    {
+      Integer i = children[0]->d_rat.getNumerator();
+      if (i >= 0 && i < d_alphaCard)
+      {
+        std::vector<unsigned> svec = {i.toUnsignedInt()};
+        ret = EvalResult(String(svec));
+      }
+      else
+      {
+        ret = EvalResult(String(""));
+      }
+      break;
+    }
+
+    case kind::STRING_TO_CODE:
+    {
+      const String& s = children[0]->d_str;
+      if (s.size() == 1)
+      {
+        ret = EvalResult(Rational(s.getVec()[0]));
+      }
+      else
+      {
+        ret = EvalResult(Rational(-1));
+      }
+      break;
+    }
+
+    case kind::CONST_BITVECTOR:
+      ret = EvalResult(currNode.getConst<BitVector>());
+      break;
+
+    case kind::BITVECTOR_NOT:
+      ret = EvalResult(~children[0]->d_bv);
+      break;
+
+    case kind::BITVECTOR_NEG:
+      ret = EvalResult(-children[0]->d_bv);
+      break;
+
+    case kind::BITVECTOR_EXTRACT:
+    {
+      unsigned lo = bv::utils::getExtractLow(currNode);
+      unsigned hi = bv::utils::getExtractHigh(currNode);
+      ret = EvalResult(children[0]->d_bv.extract(hi, lo));
+      break;
+    }
+
+    case kind::BITVECTOR_CONCAT:
+    {
+      BitVector res = children[0]->d_bv;
+      for (size_t i = 1, end = currNode.getNumChildren(); i < end; i++)
+      {
+        res = res.concat(children[i]->d_bv);
+      }
+      ret = EvalResult(res);
+      break;
+    }
+
+    case kind::BITVECTOR_ADD:
+    {
+      BitVector res = children[0]->d_bv;
+      for (size_t i = 1, end = currNode.getNumChildren(); i < end; i++)
+      {
+        res = res + children[i]->d_bv;
+      }
+      ret = EvalResult(res);
+      break;
+    }
+
+    case kind::BITVECTOR_MULT:
+    {
+      BitVector res = children[0]->d_bv;
+      for (size_t i = 1, end = currNode.getNumChildren(); i < end; i++)
+      {
+        res = res * children[i]->d_bv;
+      }
+      ret = EvalResult(res);
+      break;
+    }
+    case kind::BITVECTOR_AND:
+    {
+      BitVector res = children[0]->d_bv;
+      for (size_t i = 1, end = currNode.getNumChildren(); i < end; i++)
+      {
+        res = res & children[i]->d_bv;
+      }
+      ret = EvalResult(res);
+      break;
+    }
+
+    case kind::BITVECTOR_OR:
+    {
+      BitVector res = children[0]->d_bv;
+      for (size_t i = 1, end = currNode.getNumChildren(); i < end; i++)
+      {
+        res = res | children[i]->d_bv;
+      }
+      ret = EvalResult(res);
+      break;
+    }
+
+    case kind::BITVECTOR_XOR:
+    {
+      BitVector res = children[0]->d_bv;
+      for (size_t i = 1, end = currNode.getNumChildren(); i < end; i++)
+      {
+        res = res ^ children[i]->d_bv;
+      }
+      ret = EvalResult(res);
+      break;
+    }
+    case kind::BITVECTOR_UDIV:
+    {
+      BitVector res = children[0]->d_bv;
+      res = res.unsignedDivTotal(children[1]->d_bv);
+      ret = EvalResult(res);
+      break;
+    }
+    case kind::BITVECTOR_UREM:
+    {
+      BitVector res = children[0]->d_bv;
+      res = res.unsignedRemTotal(children[1]->d_bv);
+      ret = EvalResult(res);
+      break;
+    }
+    case kind::BITVECTOR_SHL:
+    {
+      BitVector res = children[0]->d_bv;
+      res = res.leftShift(children[1]->d_bv);
+      ret = EvalResult(res);
+      break;
+    }
+    case kind::BITVECTOR_ASHR:
+    {
+      BitVector res = children[0]->d_bv;
+      res = res.arithRightShift(children[1]->d_bv);
+      ret = EvalResult(res);
+      break;
+    }
+    case kind::BITVECTOR_ULT:
+    {
+      BitVector res = children[0]->d_bv;
+      bool b = res.unsignedLessThan(children[1]->d_bv);
+      ret = EvalResult(b);
+      break;
+    }
+    case kind::BITVECTOR_SLT:
+    {
+      BitVector res = children[0]->d_bv;
+      bool b = res.signedLessThan(children[1]->d_bv);
+      ret = EvalResult(b);
+      break;
+    }
+    case kind::BITVECTOR_SLE:
+    {
+      BitVector res = children[0]->d_bv;
+      bool b = res.signedLessThanEq(children[1]->d_bv);
+      ret = EvalResult(b);
+      break;
+    }
+    case kind::BITVECTOR_ULE:
+    {
+      BitVector res = children[0]->d_bv;
+      bool b = res.unsignedLessThanEq(children[1]->d_bv);
+      ret = EvalResult(b);
+      break;
+    }
+    case kind::BITVECTOR_UGT:
+    {
+      BitVector res = children[1]->d_bv;
+      bool b = res.unsignedLessThan(children[0]->d_bv);
+      ret = EvalResult(b);
+      break;
+    }
+    case kind::BITVECTOR_SGT:
+    {
+      BitVector res = children[1]->d_bv;
+      bool b = res.signedLessThan(children[0]->d_bv);
+      ret = EvalResult(b);
+      break;
+    }
+    case kind::BITVECTOR_SGE:
+    {
+      BitVector res = children[1]->d_bv;
+      bool b = res.signedLessThanEq(children[0]->d_bv);
+      ret = EvalResult(b);
+      break;
+    }
+    case kind::BITVECTOR_UGE:
+    {
+      BitVector res = children[1]->d_bv;
+      bool b = res.unsignedLessThanEq(children[0]->d_bv);
+      ret = EvalResult(b);
+      break;
+    }
+    case kind::BITVECTOR_SIGN_EXTEND:
+    {
+      BitVector res = children[0]->d_bv;
+      unsigned amount = currNode.getOperator()
+                            .getConst<BitVectorSignExtend>()
+                            .d_signExtendAmount;
+      ret = EvalResult(res.signExtend(amount));
+      break;
+    }
+    case kind::BITVECTOR_ZERO_EXTEND:
+    {
+      BitVector res = children[0]->d_bv;
+      unsigned amount = currNode.getOperator()
+                            .getConst<BitVectorZeroExtend>()
+                            .d_zeroExtendAmount;
+      ret = EvalResult(res.zeroExtend(amount));
+      break;
+    }
+
+    case kind::EQUAL:
+    {
+      const EvalResult& lhs = *children[0];
+      const EvalResult& rhs = *children[1];
+
+      switch (lhs.d_tag)
+      {
+        case EvalResult::BOOL:
         {
-          BitVector res = results[currNode[0]].d_bv;
-          unsigned amount = currNode.getOperator()
-                                .getConst<BitVectorZeroExtend>()
-                                .d_zeroExtendAmount;
-          results[currNode] = EvalResult(res.zeroExtend(amount));
+          ret = EvalResult(lhs.d_bool == rhs.d_bool);
           break;
         }
 
-        case kind::EQUAL:
+        case EvalResult::BITVECTOR:
         {
-          EvalResult lhs = results[currNode[0]];
-          EvalResult rhs = results[currNode[1]];
-
-          switch (lhs.d_tag)
-          {
-            case EvalResult::BOOL:
-            {
-              results[currNode] = EvalResult(lhs.d_bool == rhs.d_bool);
-              break;
-            }
-
-            case EvalResult::BITVECTOR:
-            {
-              results[currNode] = EvalResult(lhs.d_bv == rhs.d_bv);
-              break;
-            }
-
-            case EvalResult::RATIONAL:
-            {
-              results[currNode] = EvalResult(lhs.d_rat == rhs.d_rat);
-              break;
-            }
-
-            case EvalResult::STRING:
-            {
-              results[currNode] = EvalResult(lhs.d_str == rhs.d_str);
-              break;
-            }
-            case EvalResult::UVALUE:
-            {
-              results[currNode] = EvalResult(lhs.d_av == rhs.d_av);
-              break;
-            }
-
-            default:
-            {
-              Trace("evaluator") << "Evaluation of " << currNode[0].getKind()
-                                 << " not supported" << std::endl;
-              results[currNode] = EvalResult();
-              evalAsNode[currNode] =
-                  needsReconstruct ? reconstruct(currNode, results, evalAsNode)
-                                   : currNodeVal;
-              break;
-            }
-          }
-
+          ret = EvalResult(lhs.d_bv == rhs.d_bv);
           break;
         }
 
-        case kind::ITE:
+        case EvalResult::RATIONAL:
         {
-          if (results[currNode[0]].d_bool)
-          {
-            results[currNode] = results[currNode[1]];
-          }
-          else
-          {
-            results[currNode] = results[currNode[2]];
-          }
+          ret = EvalResult(lhs.d_rat == rhs.d_rat);
           break;
         }
-        case kind::BITVECTOR_TO_NAT:
+
+        case EvalResult::STRING:
         {
-          BitVector res = results[currNode[0]].d_bv;
-          results[currNode] = EvalResult(Rational(res.toInteger()));
+          ret = EvalResult(lhs.d_str == rhs.d_str);
           break;
         }
-        case kind::INT_TO_BITVECTOR:
+        case EvalResult::UVALUE:
         {
-          Integer i = results[currNode[0]].d_rat.getNumerator();
-          const uint32_t size =
-              currNodeVal.getOperator().getConst<IntToBitVector>().d_size;
-          results[currNode] = EvalResult(BitVector(size, i));
+          ret = EvalResult(lhs.d_av == rhs.d_av);
           break;
         }
+
         default:
         {
-          Trace("evaluator") << "Kind " << currNodeVal.getKind()
+          Trace("evaluator") << "Evaluation of " << currNode[0].getKind()
                              << " not supported" << std::endl;
-          processUnhandled(
-              currNode, currNodeVal, evalAsNode, results, needsReconstruct);
+          break;
         }
       }
+
+      break;
     }
-  }
 
-  return results[n];
+    case kind::ITE:
+    {
+      if (children[0]->d_bool)
+      {
+        ret = *children[1];
+      }
+      else
+      {
+        ret = *children[2];
+      }
+      break;
+    }
+    case kind::BITVECTOR_TO_NAT:
+    {
+      BitVector res = children[0]->d_bv;
+      ret = EvalResult(Rational(res.toInteger()));
+      break;
+    }
+    case kind::INT_TO_BITVECTOR:
+    {
+      Integer i = children[0]->d_rat.getNumerator();
+      const uint32_t size =
+          currNode.getOperator().getConst<IntToBitVector>().d_size;
+      ret = EvalResult(BitVector(size, i));
+      break;
+    }
+    default:
+    {
+      Trace("evaluator") << "Kind " << currNode.getKind()
+                         << " not supported" << std::endl;
+    }
+  }
+  return ret;
 }
 
 Node Evaluator::reconstruct(TNode n,
@@ -1193,5 +1181,222 @@ void Evaluator::processUnhandled(TNode n,
   evalAsNode[n] = needsReconstruct ? reconstruct(n, results, evalAsNode) : Node(nv);
 }
 
+EvalProgram::EvalProgram(const Evaluator& ev,
+                         TNode n,
+                         const std::vector<Node>& args)
+    : d_ev(ev), d_n(n), d_args(args), d_compiled(true)
+{
+  std::unordered_map<TNode, size_t> slot;
+  std::unordered_map<TNode, size_t>::iterator it;
+  std::vector<TNode> visit;
+  TNode cur;
+  visit.push_back(d_n);
+  do
+  {
+    cur = visit.back();
+    if (slot.find(cur) != slot.end())
+    {
+      visit.pop_back();
+      continue;
+    }
+    Instr instr;
+    instr.d_node = cur;
+    instr.d_arg = -1;
+    instr.d_const = false;
+    if (cur.isVar())
+    {
+      std::vector<Node>::iterator ita =
+          std::find(d_args.begin(), d_args.end(), cur);
+      if (ita == d_args.end())
+      {
+        // variable with no substitution is never a valid EvalResult
+        d_compiled = false;
+        break;
+      }
+      instr.d_arg = std::distance(d_args.begin(), ita);
+    }
+    else if (cur.getMetaKind() == kind::metakind::PARAMETERIZED
+             && !cur.getOperator().isConst())
+    {
+      // e.g. APPLY_UF, which requires beta-reduction
+      d_compiled = false;
+      break;
+    }
+    else if (cur.getNumChildren() == 0)
+    {
+      instr.d_const = true;
+    }
+    else
+    {
+      bool childrenDone = true;
+      for (const Node& cn : cur)
+      {
+        it = slot.find(cn);
+        if (it == slot.end())
+        {
+          visit.push_back(cn);
+          childrenDone = false;
+        }
+        else if (childrenDone)
+        {
+          instr.d_children.push_back(it->second);
+        }
+      }
+      if (!childrenDone)
+      {
+        continue;
+      }
+    }
+    visit.pop_back();
+    slot[cur] = d_instrs.size();
+    d_instrs.push_back(instr);
+  } while (!visit.empty());
+  if (!d_compiled)
+  {
+    Trace("evaluator") << "Could not compile " << d_n << std::endl;
+    d_instrs.clear();
+    return;
+  }
+  d_slots.resize(d_instrs.size());
+  for (size_t i = 0, ninstrs = d_instrs.size(); i < ninstrs; i++)
+  {
+    if (d_instrs[i].d_const)
+    {
+      d_slots[i] = d_ev.evalNode(d_instrs[i].d_node, d_children);
+      if (d_slots[i].d_tag == EvalResult::INVALID)
+      {
+        // will not evaluate for any values
+        Trace("evaluator") << "Could not compile " << d_n << " due to "
+                           << d_instrs[i].d_node << std::endl;
+        d_compiled = false;
+        d_instrs.clear();
+        d_slots.clear();
+        return;
+      }
+    }
+  }
+  Trace("evaluator") << "Compiled " << d_n << " into " << d_instrs.size()
+                     << " instructions" << std::endl;
+}
+
+bool EvalProgram::isCompiled() const { return d_compiled; }
+
+EvalResult EvalProgram::evalValue(TNode val) const
+{
+  if (val.getNumChildren() > 0)
+  {
+    return EvalResult();
+  }
+  return d_ev.evalNode(val, d_children);
+}
+
+Node EvalProgram::eval(const std::vector<Node>& vals)
+{
+  Assert(vals.size() == d_args.size());
+  if (!d_compiled)
+  {
+    return d_ev.eval(d_n, d_args, vals);
+  }
+  for (size_t i = 0, ninstrs = d_instrs.size(); i < ninstrs; i++)
+  {
+    const Instr& instr = d_instrs[i];
+    if (instr.d_const)
+    {
+      continue;
+    }
+    if (instr.d_arg >= 0)
+    {
+      d_slots[i] = evalValue(vals[instr.d_arg]);
+    }
+    else
+    {
+      d_children.clear();
+      for (size_t c : instr.d_children)
+      {
+        d_children.push_back(&d_slots[c]);
+      }
+      d_slots[i] = d_ev.evalNode(instr.d_node, d_children);
+      d_children.clear();
+    }
+    if (d_slots[i].d_tag == EvalResult::INVALID)
+    {
+      // e.g. division by zero or a value that is not supported
+      return d_ev.eval(d_n, d_args, vals);
+    }
+  }
+  return d_slots.back().toNode(d_n.getType());
+}
+
+std::vector<Node> EvalProgram::evalBatch(
+    const std::vector<std::vector<Node>>& points)
+{
+  size_t npoints = points.size();
+  std::vector<Node> ret(npoints);
+  if (!d_compiled)
+  {
+    for (size_t j = 0; j < npoints; j++)
+    {
+      ret[j] = d_ev.eval(d_n, d_args, points[j]);
+    }
+    return ret;
+  }
+  size_t ninstrs = d_instrs.size();
+  // the result of (non-constant) instruction i on point j is stored at
+  // index i * npoints + j
+  std::vector<EvalResult> slots(ninstrs * npoints);
+  std::vector<bool> failed(npoints, false);
+  for (size_t i = 0; i < ninstrs; i++)
+  {
+    const Instr& instr = d_instrs[i];
+    if (instr.d_const)
+    {
+      continue;
+    }
+    for (size_t j = 0; j < npoints; j++)
+    {
+      if (failed[j])
+      {
+        continue;
+      }
+      EvalResult& res = slots[i * npoints + j];
+      if (instr.d_arg >= 0)
+      {
+        Assert(points[j].size() == d_args.size());
+        res = evalValue(points[j][instr.d_arg]);
+      }
+      else
+      {
+        d_children.clear();
+        for (size_t c : instr.d_children)
+        {
+          d_children.push_back(d_instrs[c].d_const ? &d_slots[c]
+                                                   : &slots[c * npoints + j]);
+        }
+        res = d_ev.evalNode(instr.d_node, d_children);
+        d_children.clear();
+      }
+      failed[j] = (res.d_tag == EvalResult::INVALID);
+    }
+  }
+  size_t root = ninstrs - 1;
+  TypeNode tn = d_n.getType();
+  for (size_t j = 0; j < npoints; j++)
+  {
+    if (failed[j])
+    {
+      ret[j] = d_ev.eval(d_n, d_args, points[j]);
+    }
+    else if (d_instrs[root].d_const)
+    {
+      ret[j] = d_slots[root].toNode(tn);
+    }
+    else
+    {
+      ret[j] = slots[root * npoints + j].toNode(tn);
+    }
+  }
+  return ret;
+}
+
 }  // namespace theory
 }  // namespace cvc5::internal
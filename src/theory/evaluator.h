@@ -85,11 +85,14 @@ class Rewriter;
 
 /**
  * The class that performs the actual evaluation of a term under a
- * substitution. Right now, the class does not cache anything between different
- * calls to `eval` but this might change in the future.
+ * substitution. The class does not cache anything between different calls to
+ * `eval`. Terms that are evaluated many times under different substitutions
+ * should be compiled into an EvalProgram instead.
  */
 class Evaluator
 {
+  friend class EvalProgram;
+
  public:
   /**
    * @param rr (optional) the rewriter to use when a node cannot be evaluated.
@@ -127,6 +130,15 @@ class Evaluator
             const std::unordered_map<Node, Node>& visited) const;
 
  private:
+  /**
+   * Evaluates the application currNode, whose children have the (valid)
+   * evaluations children, or the constant currNode if it has no children.
+   * Returns an invalid EvalResult if currNode is not supported, or if its
+   * value cannot be represented by an EvalResult, e.g. for division by zero.
+   * Notice that this method does not handle APPLY_UF.
+   */
+  EvalResult evalNode(TNode currNode,
+                      const std::vector<const EvalResult*>& children) const;
   /**
    * Evaluates node `n` under the substitution described by the variable names
    * `args` and the corresponding values `vals`. The internal version returns
@@ -177,6 +189,74 @@ class Evaluator
   uint32_t d_alphaCard;
 };
 
+/**
+ * A term compiled for evaluating it many times under different values for a
+ * fixed list of variables, e.g. on the sample points of a SyGuS sampler.
+ *
+ * The term is compiled once into a flat list of instructions in postorder,
+ * one for each distinct subterm, where an instruction either loads the value
+ * of a variable, is a constant that is evaluated at compile time, or applies
+ * the operator of its subterm to the results of earlier instructions. The
+ * results are stored in slots that are reused between calls, hence no maps
+ * are built when evaluating.
+ *
+ * The results of eval and evalBatch are the same as the ones of
+ * Evaluator::eval. If the term cannot be compiled, e.g. since it contains
+ * applications of uninterpreted functions or variables that are not in args,
+ * or if the evaluation of some subterm for the given values is not supported
+ * by EvalResult, we fall back to Evaluator::eval.
+ */
+class EvalProgram
+{
+ public:
+  /**
+   * @param ev The evaluator to use, which must outlive this program
+   * @param n The term to compile
+   * @param args The variables whose values are given when evaluating
+   */
+  EvalProgram(const Evaluator& ev, TNode n, const std::vector<Node>& args);
+  /** Was the term compiled? Otherwise, we always use Evaluator::eval. */
+  bool isCompiled() const;
+  /** Evaluate the term under the substitution args -> vals. */
+  Node eval(const std::vector<Node>& vals);
+  /**
+   * Evaluate the term on each of the given points, where each point is a list
+   * of values for args. This runs each instruction on all points before
+   * running the next one.
+   */
+  std::vector<Node> evalBatch(const std::vector<std::vector<Node>>& points);
+
+ private:
+  /** An instruction of the program */
+  struct Instr
+  {
+    /** The subterm computed by this instruction */
+    TNode d_node;
+    /** The index of d_node in args if it is a variable, or -1 */
+    int64_t d_arg;
+    /** Whether d_node is a constant, evaluated at compile time */
+    bool d_const;
+    /** The instructions computing the children of d_node */
+    std::vector<size_t> d_children;
+  };
+  /** Evaluate the value val of a variable, which must have no children */
+  EvalResult evalValue(TNode val) const;
+  /** The evaluator */
+  const Evaluator& d_ev;
+  /** The compiled term */
+  Node d_n;
+  /** The variables */
+  std::vector<Node> d_args;
+  /** Whether the term was compiled */
+  bool d_compiled;
+  /** The instructions, the last one computes d_n */
+  std::vector<Instr> d_instrs;
+  /** The result slots of the instructions */
+  std::vector<EvalResult> d_slots;
+  /** Scratch vector for the results of the children of an instruction */
+  std::vector<const EvalResult*> d_children;
+};
+
 }  // namespace theory
 }  // namespace cvc5::internal
 
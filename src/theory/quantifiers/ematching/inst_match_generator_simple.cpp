@@ -14,7 +14,10 @@
  */
 #include "theory/quantifiers/ematching/inst_match_generator_simple.h"
 
+#include <unordered_set>
+
 #include "options/quantifiers_options.h"
+#include "theory/quantifiers/ematching/trigger_index.h"
 #include "theory/quantifiers/ematching/trigger_term_info.h"
 #include "theory/quantifiers/instantiate.h"
 #include "theory/quantifiers/quantifiers_state.h"
@@ -33,7 +36,12 @@ InstMatchGeneratorSimple::InstMatchGeneratorSimple(Env& env,
                                                    Trigger* tparent,
                                                    Node q,
                                                    Node pat)
-    : IMGenerator(env, tparent), d_quant(q), d_match_pattern(pat)
+    : IMGenerator(env, tparent),
+      d_quant(q),
+      d_match_pattern(pat),
+      d_index(nullptr),
+      d_useDelta(false),
+      d_deltaIndex(context(), 0)
 {
   if (d_match_pattern.getKind() == NOT)
   {
@@ -69,12 +77,62 @@ InstMatchGeneratorSimple::InstMatchGeneratorSimple(Env& env,
   }
   TermDb* tdb = d_treg.getTermDatabase();
   d_op = tdb->getMatchOperator(d_match_pattern);
+  if (options().quantifiers.triggerDelta && d_eqc.isNull()
+      && !logicInfo().isHigherOrder())
+  {
+    std::unordered_set<int> vars;
+    d_useDelta = true;
+    for (size_t i = 0, nchild = d_match_pattern.getNumChildren(); i < nchild;
+         i++)
+    {
+      std::map<size_t, int>::iterator it = d_var_num.find(i);
+      if (it == d_var_num.end() || it->second < 0
+          || !vars.insert(it->second).second)
+      {
+        d_useDelta = false;
+        break;
+      }
+    }
+  }
+}
+
+void InstMatchGeneratorSimple::resetInstantiationRound()
+{
+  if (d_index != nullptr)
+  {
+    d_index->resetGenerator(this);
+  }
 }
 
-void InstMatchGeneratorSimple::resetInstantiationRound() {}
 uint64_t InstMatchGeneratorSimple::addInstantiations(InstMatch& m)
 {
   uint64_t addedLemmas = 0;
+  if (d_index != nullptr)
+  {
+    // our matches are computed together with those of the other simple
+    // triggers with the same match operator
+    std::vector<std::vector<Node>>& matches = d_index->getMatches(this);
+    for (std::vector<Node>& terms : matches)
+    {
+      if (d_qstate.isInConflict())
+      {
+        break;
+      }
+      if (sendInstantiation(terms,
+                            InferenceId::QUANTIFIERS_INST_E_MATCHING_SIMPLE))
+      {
+        addedLemmas++;
+        Trace("simple-trigger")
+            << "-> Produced instantiation " << terms << std::endl;
+      }
+    }
+    matches.clear();
+    return addedLemmas;
+  }
+  if (d_useDelta)
+  {
+    return addInstantiationsDelta();
+  }
   TNodeTrie* tat;
   TermDb* tdb = d_treg.getTermDatabase();
   if (d_eqc.isNull())
@@ -194,6 +252,76 @@ void InstMatchGeneratorSimple::addInstantiations(InstMatch& m,
   }
 }
 
+uint64_t InstMatchGeneratorSimple::addInstantiationsDelta()
+{
+  uint64_t addedLemmas = 0;
+  TermDb* tdb = d_treg.getTermDatabase();
+  // computing the term index determines which terms are active
+  if (tdb->getTermArgTrie(d_op) == nullptr || d_qstate.isInConflict())
+  {
+    return 0;
+  }
+  DbList* dbl = tdb->getGroundTermList(d_op);
+  if (dbl == nullptr)
+  {
+    return 0;
+  }
+  const context::CDList<Node>& gterms = dbl->d_list;
+  size_t nvars = d_quant[0].getNumChildren();
+  // the number of terms from the start of the list that we are done with
+  size_t done = d_deltaIndex.get();
+  bool allDone = true;
+  Trace("simple-trigger-debug")
+      << "Add delta instantiations for " << d_match_pattern << " from "
+      << done << " / " << gterms.size() << std::endl;
+  for (size_t i = d_deltaIndex.get(), nterms = gterms.size(); i < nterms; i++)
+  {
+    if (d_qstate.isInConflict())
+    {
+      break;
+    }
+    Node t = gterms[i];
+    if (!tdb->hasTermCurrent(t) || !d_qstate.hasTerm(t))
+    {
+      // may become relevant later, so we consider it again in the next round
+      allDone = false;
+      continue;
+    }
+    // inactive terms are congruent to an active one, which is the match
+    if (tdb->isTermActive(t))
+    {
+      Assert(t.getNumChildren() == d_match_pattern.getNumChildren());
+      std::vector<Node> terms;
+      terms.resize(nvars);
+      for (const auto& v : d_var_num)
+      {
+        terms[v.second] = t[v.first];
+      }
+      if (sendInstantiation(terms,
+                            InferenceId::QUANTIFIERS_INST_E_MATCHING_SIMPLE))
+      {
+        addedLemmas++;
+        Trace("simple-trigger")
+            << "-> Produced instantiation " << terms << std::endl;
+      }
+    }
+    if (allDone)
+    {
+      done = i + 1;
+    }
+  }
+  d_deltaIndex = done;
+  return addedLemmas;
+}
+
+void InstMatchGeneratorSimple::setTriggerIndex(TriggerIndex* ti)
+{
+  if (ti->addGenerator(this))
+  {
+    d_index = ti;
+  }
+}
+
 int InstMatchGeneratorSimple::getActiveScore()
 {
   TermDb* tdb = d_treg.getTermDatabase();
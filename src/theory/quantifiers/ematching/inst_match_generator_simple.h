@@ -21,6 +21,7 @@
 #include <map>
 #include <vector>
 
+#include "context/cdo.h"
 #include "expr/node_trie.h"
 #include "theory/quantifiers/ematching/inst_match_generator.h"
 
@@ -29,6 +30,8 @@ namespace theory {
 namespace quantifiers {
 namespace inst {
 
+class TriggerIndex;
+
 /** InstMatchGeneratorSimple class
  *
  * This is the default generator class for simple single triggers.
@@ -45,6 +48,8 @@ namespace inst {
  */
 class InstMatchGeneratorSimple : public IMGenerator
 {
+  friend class TriggerIndex;
+
  public:
   /** constructors */
   InstMatchGeneratorSimple(Env& env, Trigger* tparent, Node q, Node pat);
@@ -55,6 +60,12 @@ class InstMatchGeneratorSimple : public IMGenerator
   uint64_t addInstantiations(InstMatch& m) override;
   /** Get active score. */
   int getActiveScore() override;
+  /**
+   * Add this generator to the trigger index ti, which computes the matches of
+   * this generator together with other simple triggers from now on if
+   * possible.
+   */
+  void setTriggerIndex(TriggerIndex* ti);
 
  private:
   /** quantified formula for the trigger term */
@@ -83,6 +94,23 @@ class InstMatchGeneratorSimple : public IMGenerator
    * child is not a variable.
    */
   std::map<size_t, int> d_var_num;
+  /** The trigger index computing our matches, if any */
+  TriggerIndex* d_index;
+  /**
+   * Whether we match only against the ground terms added since the last
+   * round (see --trigger-delta). This is the case if the arguments of the
+   * trigger are distinct variables, since then any term with the match
+   * operator is a match and merges of equivalence classes do not create new
+   * matches.
+   */
+  bool d_useDelta;
+  /**
+   * The number of ground terms of the match operator that we have matched
+   * against in the current context, if d_useDelta is true.
+   */
+  context::CDO<size_t> d_deltaIndex;
+  /** add instantiations for the ground terms added since the last round */
+  uint64_t addInstantiationsDelta();
   /** add instantiations, helper function.
    *
    * @param m the current match we are building,
@@ -15,7 +15,9 @@
 
 #include "theory/quantifiers/ematching/trigger_database.h"
 
+#include "options/quantifiers_options.h"
 #include "theory/quantifiers/ematching/ho_trigger.h"
+#include "theory/quantifiers/ematching/inst_match_generator_simple.h"
 #include "theory/quantifiers/ematching/trigger.h"
 #include "theory/quantifiers/term_util.h"
 
@@ -31,6 +33,10 @@ TriggerDatabase::TriggerDatabase(Env& env,
                                  TermRegistry& tr)
     : EnvObj(env), d_qs(qs), d_qim(qim), d_qreg(qr), d_treg(tr)
 {
+  if (options().quantifiers.triggerIndex)
+  {
+    d_index.reset(new TriggerIndex(env, qs, tr));
+  }
 }
 TriggerDatabase::~TriggerDatabase() {}
 
@@ -85,6 +91,15 @@ Trigger* TriggerDatabase::mkTrigger(Node q,
   else
   {
     t = new Trigger(d_env, d_qs, d_qim, d_qreg, d_treg, q, trNodes);
+    if (d_index != nullptr)
+    {
+      InstMatchGeneratorSimple* gs =
+          dynamic_cast<InstMatchGeneratorSimple*>(t->getGenerator());
+      if (gs != nullptr)
+      {
+        gs->setTriggerIndex(d_index.get());
+      }
+    }
   }
   d_trie.addTrigger(trNodes, t);
   return t;
@@ -18,10 +18,12 @@
 #ifndef CVC5__THEORY__QUANTIFIERS__TRIGGER_DATABASE_H
 #define CVC5__THEORY__QUANTIFIERS__TRIGGER_DATABASE_H
 
+#include <memory>
 #include <vector>
 
 #include "expr/node.h"
 #include "smt/env_obj.h"
+#include "theory/quantifiers/ematching/trigger_index.h"
 #include "theory/quantifiers/ematching/trigger_trie.h"
 
 namespace cvc5::internal {
@@ -95,6 +97,8 @@ class TriggerDatabase : protected EnvObj
  private:
   /** The trigger trie, containing the triggers */
   TriggerTrie d_trie;
+  /** The index of simple triggers, if --trigger-index is enabled */
+  std::unique_ptr<TriggerIndex> d_index;
   /** Reference to the quantifiers state */
   QuantifiersState& d_qs;
   /** Reference to the quantifiers inference manager */
@@ -0,0 +1,258 @@
+/******************************************************************************
+ * Top contributors (to current version):
+ *   agent
+ *
+ * This file is part of the cvc5 project.
+ *
+ * Copyright (c) 2009-2023 by the authors listed in the file AUTHORS
+ * in the top-level source directory and their institutional affiliations.
+ * All rights reserved.  See the file COPYING in the top-level source
+ * directory for licensing information.
+ * ****************************************************************************
+ *
+ * Implementation of trigger index class.
+ */
+
+#include "theory/quantifiers/ematching/trigger_index.h"
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+
+#include "expr/node_manager.h"
+#include "options/quantifiers_options.h"
+#include "theory/quantifiers/ematching/inst_match_generator_simple.h"
+#include "theory/quantifiers/quantifiers_state.h"
+#include "theory/quantifiers/term_database.h"
+#include "theory/quantifiers/term_registry.h"
+
+namespace cvc5::internal {
+namespace theory {
+namespace quantifiers {
+namespace inst {
+
+TriggerIndex::TriggerIndex(Env& env, QuantifiersState& qs, TermRegistry& tr)
+    : EnvObj(env), d_qstate(qs), d_treg(tr)
+{
+}
+
+TriggerIndex::~TriggerIndex() {}
+
+bool TriggerIndex::addGenerator(InstMatchGeneratorSimple* g)
+{
+  if (!g->d_eqc.isNull())
+  {
+    // matched against the term index of an equivalence class
+    return false;
+  }
+  Trace("trigger-index") << "Add " << g->d_match_pattern << " to trigger index"
+                         << std::endl;
+  IndexNode* in = &d_roots[g->d_op];
+  for (size_t i = 0, nchild = g->d_match_pattern.getNumChildren(); i < nchild;
+       i++)
+  {
+    std::map<size_t, int>::iterator it = g->d_var_num.find(i);
+    bool isVar = it != g->d_var_num.end() && it->second >= 0;
+    in = &in->d_children[isVar ? Node::null() : g->d_match_pattern[i]];
+  }
+  in->d_gens.push_back(g);
+  d_matches[g];
+  return true;
+}
+
+void TriggerIndex::resetGenerator(InstMatchGeneratorSimple* g)
+{
+  Matches& m = d_matches[g];
+  m.d_computed = false;
+  m.d_matches.clear();
+}
+
+std::vector<std::vector<Node>>& TriggerIndex::getMatches(
+    InstMatchGeneratorSimple* g)
+{
+  Assert(d_matches.find(g) != d_matches.end());
+  Matches& m = d_matches[g];
+  if (!m.d_computed)
+  {
+    size_t nthreads = options().quantifiers.triggerIndexThreads;
+    if (nthreads > 1 && NodeManager::currentNM()->isShared())
+    {
+      computeMatchesParallel(nthreads);
+    }
+    else
+    {
+      TermDb* tdb = d_treg.getTermDatabase();
+      computeMatches(g->d_op, tdb->getTermArgTrie(g->d_op));
+      markComputed(g->d_op);
+    }
+    Assert(m.d_computed);
+  }
+  return m.d_matches;
+}
+
+void TriggerIndex::computeMatches(TNode op, TNodeTrie* tat)
+{
+  Trace("trigger-index") << "Compute matches for " << op << std::endl;
+  if (tat != nullptr)
+  {
+    std::map<Node, IndexNode>::iterator it = d_roots.find(op);
+    Assert(it != d_roots.end());
+    std::vector<TNode> path;
+    match(tat, &it->second, path);
+  }
+}
+
+void TriggerIndex::computeMatchesParallel(size_t nthreads)
+{
+  // The term indices are computed lazily by the term database, hence we get
+  // them here before starting the threads. The threads only read the term
+  // indices, the discrimination tree and the equality engine, and each of
+  // them writes the matches of the generators of the operators it takes.
+  TermDb* tdb = d_treg.getTermDatabase();
+  std::vector<std::pair<TNode, TNodeTrie*>> ops;
+  for (std::pair<const Node, IndexNode>& r : d_roots)
+  {
+    ops.emplace_back(r.first, tdb->getTermArgTrie(r.first));
+  }
+  nthreads = std::min(nthreads, ops.size());
+  Trace("trigger-index") << "Compute matches for " << ops.size()
+                         << " operators using " << nthreads << " threads"
+                         << std::endl;
+  NodeManager* nm = NodeManager::currentNM();
+  std::atomic<size_t> next(0);
+  std::vector<std::thread> workers;
+  for (size_t i = 0; i < nthreads; i++)
+  {
+    workers.emplace_back([&]() {
+      NodeManagerScope scope(nm);
+      // matching and the equality engine trace, which would race on the
+      // trace stream
+      TraceChannel.setSuppressed(true);
+      for (size_t j = next++; j < ops.size(); j = next++)
+      {
+        computeMatches(ops[j].first, ops[j].second);
+      }
+    });
+  }
+  for (std::thread& w : workers)
+  {
+    w.join();
+  }
+  for (const std::pair<TNode, TNodeTrie*>& op : ops)
+  {
+    markComputed(op.first);
+  }
+}
+
+void TriggerIndex::markComputed(TNode op)
+{
+  // mark all generators of the operator as computed, including those that
+  // have no matches
+  std::vector<IndexNode*> visit{&d_roots[op]};
+  while (!visit.empty())
+  {
+    IndexNode* in = visit.back();
+    visit.pop_back();
+    for (InstMatchGeneratorSimple* gc : in->d_gens)
+    {
+      d_matches[gc].d_computed = true;
+    }
+    for (std::pair<const Node, IndexNode>& c : in->d_children)
+    {
+      visit.push_back(&c.second);
+    }
+  }
+}
+
+void TriggerIndex::match(TNodeTrie* tat,
+                         IndexNode* in,
+                         std::vector<TNode>& path)
+{
+  if (!in->d_gens.empty())
+  {
+    Assert(!tat->d_data.empty());
+    TNode t = tat->getData();
+    for (InstMatchGeneratorSimple* g : in->d_gens)
+    {
+      // we use find, since the matches may be computed by several threads
+      std::map<InstMatchGeneratorSimple*, Matches>::iterator it =
+          d_matches.find(g);
+      Assert(it != d_matches.end());
+      if (!it->second.d_computed)
+      {
+        addMatch(g, t, path);
+      }
+    }
+  }
+  if (in->d_children.empty())
+  {
+    return;
+  }
+  for (std::pair<const Node, IndexNode>& c : in->d_children)
+  {
+    if (c.first.isNull())
+    {
+      // the wildcard matches any argument, we visit each argument once for
+      // all triggers that have a variable at this position
+      for (std::pair<const TNode, TNodeTrie>& tt : tat->d_data)
+      {
+        path.push_back(tt.first);
+        match(&tt.second, &c.second, path);
+        path.pop_back();
+      }
+    }
+    else
+    {
+      Node r = d_qstate.getRepresentative(c.first);
+      std::map<TNode, TNodeTrie>::iterator it = tat->d_data.find(r);
+      if (it != tat->d_data.end())
+      {
+        path.push_back(r);
+        match(&it->second, &c.second, path);
+        path.pop_back();
+      }
+    }
+  }
+}
+
+void TriggerIndex::addMatch(InstMatchGeneratorSimple* g,
+                            TNode t,
+                            const std::vector<TNode>& path)
+{
+  size_t nvars = g->d_quant[0].getNumChildren();
+  std::vector<Node> terms(nvars);
+  // the argument position at which each variable was matched
+  std::vector<size_t> pos(nvars, path.size());
+  for (const std::pair<const size_t, int>& v : g->d_var_num)
+  {
+    if (v.second < 0)
+    {
+      continue;
+    }
+    Assert(v.first < t.getNumChildren());
+    size_t vn = static_cast<size_t>(v.second);
+    if (pos[vn] < path.size())
+    {
+      // a variable that occurs more than once must match equal terms
+      if (path[pos[vn]] != path[v.first])
+      {
+        return;
+      }
+    }
+    else
+    {
+      pos[vn] = v.first;
+    }
+    terms[vn] = t[v.first];
+  }
+  Trace("trigger-index") << "...match " << terms << " for "
+                         << g->d_match_pattern << std::endl;
+  std::map<InstMatchGeneratorSimple*, Matches>::iterator it = d_matches.find(g);
+  Assert(it != d_matches.end());
+  it->second.d_matches.push_back(terms);
+}
+
+}  // namespace inst
+}  // namespace quantifiers
+}  // namespace theory
+}  // namespace cvc5::internal
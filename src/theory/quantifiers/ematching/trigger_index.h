@@ -0,0 +1,146 @@
+/******************************************************************************
+ * Top contributors (to current version):
+ *   agent
+ *
+ * This file is part of the cvc5 project.
+ *
+ * Copyright (c) 2009-2023 by the authors listed in the file AUTHORS
+ * in the top-level source directory and their institutional affiliations.
+ * All rights reserved.  See the file COPYING in the top-level source
+ * directory for licensing information.
+ * ****************************************************************************
+ *
+ * Trigger index class.
+ */
+
+#include "cvc5_private.h"
+
+#ifndef CVC5__THEORY__QUANTIFIERS__TRIGGER_INDEX_H
+#define CVC5__THEORY__QUANTIFIERS__TRIGGER_INDEX_H
+
+#include <map>
+#include <vector>
+
+#include "expr/node.h"
+#include "expr/node_trie.h"
+#include "smt/env_obj.h"
+
+namespace cvc5::internal {
+namespace theory {
+namespace quantifiers {
+
+class QuantifiersState;
+class TermRegistry;
+
+namespace inst {
+
+class InstMatchGeneratorSimple;
+
+/** A discrimination tree of simple single triggers.
+ *
+ * This class indexes the simple single triggers of all quantified formulas
+ * by their match operator and then by their arguments, where an argument
+ * that is a variable of the quantified formula of the trigger is a wildcard.
+ * For example, the triggers f( x, a ), f( x, y ) and f( y, b ) of different
+ * quantified formulas share the path for their first argument.
+ *
+ * The matches of all triggers with the same match operator are computed by a
+ * single simultaneous traversal of the term index of that operator (see
+ * TermDb::getTermArgTrie) and the tree. Hence, the terms of the term index
+ * are visited once for all triggers with common prefixes, instead of once
+ * per trigger as done by InstMatchGeneratorSimple.
+ *
+ * The matches are buffered per generator, since each generator sends its own
+ * instantiations when its quantified formula is processed.
+ *
+ * If option triggerIndexThreads is greater than one and the current node
+ * manager is shared (see NodeManagerScope), the matches of all match
+ * operators are computed at once by a pool of threads, where each operator
+ * is handled by a single thread. Matching only reads the term index and the
+ * equality engine, and the matches of each generator are computed in the
+ * same order as in the sequential case. Hence, the instantiations are the
+ * same regardless of the number of threads.
+ */
+class TriggerIndex : protected EnvObj
+{
+ public:
+  TriggerIndex(Env& env, QuantifiersState& qs, TermRegistry& tr);
+  ~TriggerIndex();
+  /**
+   * Add the generator g to this index. Returns true if g is matched via this
+   * index from now on, which is the case if g does not have an equivalence
+   * class constraint.
+   */
+  bool addGenerator(InstMatchGeneratorSimple* g);
+  /** Reset the generator g, which forgets its matches */
+  void resetGenerator(InstMatchGeneratorSimple* g);
+  /**
+   * Get the matches of generator g in the current context, where each match
+   * is the vector of terms for the variables of its quantified formula. If
+   * the matches of g are not computed, this computes the matches of all
+   * generators with the match operator of g that are not computed either.
+   * The caller may modify the returned matches.
+   */
+  std::vector<std::vector<Node>>& getMatches(InstMatchGeneratorSimple* g);
+
+ private:
+  /** A node of the discrimination tree */
+  class IndexNode
+  {
+   public:
+    /**
+     * The children, where the null node is the wildcard and other keys are
+     * the ground arguments of the triggers.
+     */
+    std::map<Node, IndexNode> d_children;
+    /** The generators whose arguments are the path to this node */
+    std::vector<InstMatchGeneratorSimple*> d_gens;
+  };
+  /** The matches of a generator */
+  class Matches
+  {
+   public:
+    Matches() : d_computed(false) {}
+    /** Whether the matches are computed */
+    bool d_computed;
+    /** The matches */
+    std::vector<std::vector<Node>> d_matches;
+  };
+  /**
+   * Compute the matches of the generators with match operator op that are
+   * not computed yet, where tat is the term index of op, which may be null.
+   */
+  void computeMatches(TNode op, TNodeTrie* tat);
+  /** Compute the matches of all generators using nthreads threads */
+  void computeMatchesParallel(size_t nthreads);
+  /** Mark the generators with match operator op as computed */
+  void markComputed(TNode op);
+  /**
+   * Compute the matches of the generators below in, where tat is the
+   * position in the term index corresponding to in, and path are the
+   * representatives of the arguments matched so far.
+   */
+  void match(TNodeTrie* tat, IndexNode* in, std::vector<TNode>& path);
+  /**
+   * Add the match of generator g against the term t, whose arguments are
+   * equal to path.
+   */
+  void addMatch(InstMatchGeneratorSimple* g,
+                TNode t,
+                const std::vector<TNode>& path);
+  /** Reference to the quantifiers state */
+  QuantifiersState& d_qstate;
+  /** Reference to the term registry */
+  TermRegistry& d_treg;
+  /** The roots of the discrimination tree for each match operator */
+  std::map<Node, IndexNode> d_roots;
+  /** The matches for each generator in this index */
+  std::map<InstMatchGeneratorSimple*, Matches> d_matches;
+};
+
+}  // namespace inst
+}  // namespace quantifiers
+}  // namespace theory
+}  // namespace cvc5::internal
+
+#endif /* CVC5__THEORY__QUANTIFIERS__TRIGGER_INDEX_H */
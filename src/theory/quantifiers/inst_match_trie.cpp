@@ -15,6 +15,8 @@
 
 #include "theory/quantifiers/inst_match_trie.h"
 
+#include <algorithm>
+
 using namespace cvc5::context;
 
 namespace cvc5::internal {
@@ -120,129 +122,218 @@ void InstMatchTrie::print(std::ostream& out, Node q) const
   print(out, q, terms);
 }
 
-CDInstMatchTrie::~CDInstMatchTrie()
+FlatInstMatchTrie::FlatInstMatchTrie(context::Context* c) : d_shift(64 - 6)
 {
-  for (std::pair<const Node, CDInstMatchTrie*>& d : d_data)
+  // the root
+  d_nodes.emplace_back(TNode::null(), 0, 0);
+  d_slots.resize(size_t(1) << (64 - d_shift), 0);
+  if (c != nullptr)
   {
-    CDInstMatchTrie* current = d.second;
-    delete current;
+    d_cdSize.reset(new CDSize(c, *this, d_nodes.size()));
   }
-  d_data.clear();
 }
 
-bool CDInstMatchTrie::existsInstMatch(context::Context* context,
-                                      Node q,
-                                      const std::vector<Node>& m,
-                                      unsigned index)
+FlatInstMatchTrie::~FlatInstMatchTrie() {}
+
+bool FlatInstMatchTrie::existsInstMatch(Node q, const std::vector<Node>& m)
 {
-  return !addInstMatch(context, q, m, index, true);
+  Assert(m.size() == q[0].getNumChildren());
+  uint32_t id = findChild(0, q);
+  for (size_t i = 0, size = m.size(); i < size && id != 0; i++)
+  {
+    id = findChild(id, m[i]);
+  }
+  return id != 0;
 }
 
-bool CDInstMatchTrie::addInstMatch(context::Context* context,
-                                   Node f,
-                                   const std::vector<Node>& m,
-                                   unsigned index,
-                                   bool onlyExist)
+bool FlatInstMatchTrie::addInstMatch(Node q, const std::vector<Node>& m)
 {
-  bool reset = false;
-  if (!d_valid.get())
+  Assert(m.size() == q[0].getNumChildren());
+  uint32_t id = 0;
+  bool added = false;
+  for (size_t i = 0, size = m.size(); i <= size; i++)
   {
-    if (onlyExist)
+    TNode key = i == 0 ? TNode(q) : TNode(m[i - 1]);
+    uint32_t cid = added ? 0 : findChild(id, key);
+    if (cid == 0)
     {
-      return true;
-    }
-    else
-    {
-      d_valid.set(true);
-      reset = true;
+      cid = addChild(id, key);
+      added = true;
     }
+    id = cid;
   }
-  if (index == f[0].getNumChildren())
+  if (added && d_cdSize != nullptr)
   {
-    return reset;
+    d_cdSize->d_size = d_nodes.size();
   }
-  Node n = m[index];
-  std::map<Node, CDInstMatchTrie*>::iterator it = d_data.find(n);
-  if (it != d_data.end())
+  return added;
+}
+
+void FlatInstMatchTrie::getQuantifiedFormulas(std::vector<Node>& qs) const
+{
+  std::vector<uint32_t> children;
+  getChildren(0, children);
+  for (uint32_t c : children)
   {
-    bool ret = it->second->addInstMatch(context, f, m, index + 1, onlyExist);
-    if (!onlyExist || !ret)
-    {
-      return reset || ret;
-    }
+    qs.push_back(d_nodes[c].d_key);
   }
-  if (!onlyExist)
+}
+
+void FlatInstMatchTrie::getInstantiations(
+    Node q, std::vector<std::vector<Node>>& insts) const
+{
+  uint32_t id = findChild(0, q);
+  if (id != 0)
   {
-    CDInstMatchTrie* imt = new CDInstMatchTrie(context);
-    Assert(d_data.find(n) == d_data.end());
-    d_data[n] = imt;
-    imt->addInstMatch(context, f, m, index + 1, false);
+    std::vector<Node> terms;
+    getInstantiations(id, q[0].getNumChildren(), insts, terms);
   }
-  return true;
 }
 
-void CDInstMatchTrie::print(std::ostream& out,
-                            Node q,
-                            std::vector<TNode>& terms) const
+void FlatInstMatchTrie::getInstantiations(
+    uint32_t id,
+    size_t depth,
+    std::vector<std::vector<Node>>& insts,
+    std::vector<Node>& terms) const
 {
-  if (d_valid.get())
+  if (terms.size() == depth)
   {
-    if (terms.size() == q[0].getNumChildren())
-    {
-      out << "  ( ";
-      for (unsigned i = 0; i < terms.size(); i++)
-      {
-        if (i > 0) out << " ";
-        out << terms[i];
-      }
-      out << " )" << std::endl;
-    }
-    else
+    insts.push_back(terms);
+    return;
+  }
+  std::vector<uint32_t> children;
+  getChildren(id, children);
+  for (uint32_t c : children)
+  {
+    terms.push_back(d_nodes[c].d_key);
+    getInstantiations(c, depth, insts, terms);
+    terms.pop_back();
+  }
+}
+
+void FlatInstMatchTrie::print(std::ostream& out, Node q) const
+{
+  std::vector<std::vector<Node>> insts;
+  getInstantiations(q, insts);
+  for (const std::vector<Node>& terms : insts)
+  {
+    out << "  ( ";
+    for (size_t i = 0, size = terms.size(); i < size; i++)
     {
-      for (const std::pair<const Node, CDInstMatchTrie*>& d : d_data)
+      if (i > 0)
       {
-        terms.push_back(d.first);
-        d.second->print(out, q, terms);
-        terms.pop_back();
+        out << " ";
       }
+      out << terms[i];
     }
+    out << " )" << std::endl;
   }
 }
 
-void CDInstMatchTrie::getInstantiations(
-    Node q, std::vector<std::vector<Node>>& insts) const
+size_t FlatInstMatchTrie::slot(uint32_t parent, TNode key) const
 {
-  std::vector<Node> terms;
-  getInstantiations(q, insts, terms);
+  uint64_t h = key.getId() * UINT64_C(0x9e3779b97f4a7c15) + parent;
+  return static_cast<size_t>((h * UINT64_C(0x9e3779b97f4a7c15)) >> d_shift);
 }
 
-void CDInstMatchTrie::getInstantiations(Node q,
-                                        std::vector<std::vector<Node>>& insts,
-                                        std::vector<Node>& terms) const
+uint32_t FlatInstMatchTrie::findChild(uint32_t parent, TNode key) const
 {
-  if (!d_valid.get())
+  size_t mask = d_slots.size() - 1;
+  for (size_t i = slot(parent, key);; i = (i + 1) & mask)
   {
-    // do nothing
+    uint32_t c = d_slots[i];
+    if (c == 0
+        || (d_nodes[c].d_parent == parent && d_nodes[c].d_key == key))
+    {
+      return c;
+    }
   }
-  else if (terms.size() == q[0].getNumChildren())
+}
+
+uint32_t FlatInstMatchTrie::addChild(uint32_t parent, TNode key)
+{
+  Assert(findChild(parent, key) == 0);
+  // keep the load factor of the slots at most 1/2
+  if (2 * d_nodes.size() > d_slots.size())
   {
-    insts.push_back(terms);
+    grow();
   }
-  else
+  uint32_t id = static_cast<uint32_t>(d_nodes.size());
+  d_nodes.emplace_back(key, parent, d_nodes[parent].d_firstChild);
+  d_nodes[parent].d_firstChild = id;
+  size_t mask = d_slots.size() - 1;
+  size_t i = slot(parent, key);
+  while (d_slots[i] != 0)
+  {
+    i = (i + 1) & mask;
+  }
+  d_slots[i] = id;
+  return id;
+}
+
+void FlatInstMatchTrie::grow()
+{
+  std::vector<uint32_t> old(d_slots.size() * 2, 0);
+  old.swap(d_slots);
+  d_shift--;
+  size_t mask = d_slots.size() - 1;
+  for (uint32_t c : old)
   {
-    for (const std::pair<const Node, CDInstMatchTrie*>& d : d_data)
+    if (c != 0)
     {
-      terms.push_back(d.first);
-      d.second->getInstantiations(q, insts, terms);
-      terms.pop_back();
+      size_t i = slot(d_nodes[c].d_parent, d_nodes[c].d_key);
+      while (d_slots[i] != 0)
+      {
+        i = (i + 1) & mask;
+      }
+      d_slots[i] = c;
     }
   }
 }
 
-void CDInstMatchTrie::print(std::ostream& out, Node q) const
+void FlatInstMatchTrie::backtrack()
 {
-  std::vector<TNode> terms;
-  print(out, q, terms);
+  size_t size = d_cdSize->d_size.get();
+  size_t mask = d_slots.size() - 1;
+  while (d_nodes.size() > size)
+  {
+    uint32_t id = static_cast<uint32_t>(d_nodes.size() - 1);
+    TrieNode& n = d_nodes[id];
+    // the most recent node is the first child of its parent
+    Assert(d_nodes[n.d_parent].d_firstChild == id);
+    d_nodes[n.d_parent].d_firstChild = n.d_next;
+    // erase its slot, shifting back the following slots of its cluster
+    size_t i = slot(n.d_parent, n.d_key);
+    while (d_slots[i] != id)
+    {
+      i = (i + 1) & mask;
+    }
+    for (size_t j = (i + 1) & mask; d_slots[j] != 0; j = (j + 1) & mask)
+    {
+      const TrieNode& nj = d_nodes[d_slots[j]];
+      size_t home = slot(nj.d_parent, nj.d_key);
+      if (((j - home) & mask) >= ((j - i) & mask))
+      {
+        d_slots[i] = d_slots[j];
+        i = j;
+      }
+    }
+    d_slots[i] = 0;
+    d_nodes.pop_back();
+  }
+}
+
+void FlatInstMatchTrie::getChildren(uint32_t id,
+                                    std::vector<uint32_t>& children) const
+{
+  for (uint32_t c = d_nodes[id].d_firstChild; c != 0; c = d_nodes[c].d_next)
+  {
+    children.push_back(c);
+  }
+  // use the order of the keys, as for InstMatchTrie
+  std::sort(children.begin(), children.end(), [this](uint32_t a, uint32_t b) {
+    return d_nodes[a].d_key < d_nodes[b].d_key;
+  });
 }
 
 bool InstMatchTrieOrdered::addInstMatch(Node q, const std::vector<Node>& m)
@@ -19,9 +19,10 @@
 #define CVC5__THEORY__QUANTIFIERS__INST_MATCH_TRIE_H
 
 #include <map>
+#include <memory>
 
-#include "context/cdlist.h"
 #include "context/cdo.h"
+#include "context/context.h"
 #include "expr/node.h"
 #include "smt/env_obj.h"
 
@@ -95,60 +96,111 @@ class InstMatchTrie
   void print(std::ostream& out, Node q, std::vector<TNode>& terms) const;
 };
 
-/** trie for InstMatch objects
+/** Flat trie for the instantiations of all quantified formulas
+ *
+ * This class stores instantiations (q, m) as paths q, m[0], ..., m[n-1]
+ * from its root, like InstMatchTrie does for the instantiations of a single
+ * quantified formula. It is used for detecting duplicate instantiations,
+ * where it typically holds a very large number of entries.
+ *
+ * Rather than allocating a map per trie node, the trie nodes are stored in
+ * a single array, where each node stores its key, its parent, its first
+ * child and its next sibling. The edges are found by an open addressing hash
+ * table from (parent, key id) to the child, whose slots only store the ids
+ * of the children.
  *
- * This is a context-dependent version of the above class.
+ * If a context is given, the entries added in a context are removed when it
+ * is popped. Since the nodes are stored in the order they are added, this
+ * amounts to removing the most recent nodes, as done for the equality
+ * engine.
  */
-class CDInstMatchTrie
+class FlatInstMatchTrie
 {
  public:
-  CDInstMatchTrie(context::Context* c) : d_valid(c, false) {}
-  ~CDInstMatchTrie();
-
-  /** exists inst match
-   *
-   * This method considers the entry given by m, starting at the given index.
-   * The domain of m is the bound variables of quantified formula q.
-   * It returns true if (the suffix) of m exists in this trie.
-   * It additionally takes a context c, for which the entry is valid in.
-   */
-  bool existsInstMatch(context::Context* context,
-                       Node q,
-                       const std::vector<Node>& m,
-                       unsigned index = 0);
-  /** add inst match
-   *
-   * This method adds (the suffix of) m starting at the given index to this
-   * trie, and returns true if and only if m did not already occur in this trie.
-   * The domain of m is the bound variables of quantified formula q.
-   * It additionally takes a context c, for which the entry is valid in.
+  /**
+   * Constructor, where c is the context in which the entries are valid, or
+   * nullptr if entries are never removed.
    */
-  bool addInstMatch(context::Context* context,
-                    Node q,
-                    const std::vector<Node>& m,
-                    unsigned index = 0,
-                    bool onlyExist = false);
+  FlatInstMatchTrie(context::Context* c = nullptr);
+  ~FlatInstMatchTrie();
+  /** returns true if the instantiation m of q exists in this trie */
+  bool existsInstMatch(Node q, const std::vector<Node>& m);
   /**
-   * Adds the instantiations for q into insts.
+   * Adds the instantiation m of q to this trie, and returns true if and only
+   * if it did not already occur in this trie.
    */
+  bool addInstMatch(Node q, const std::vector<Node>& m);
+  /** Adds the quantified formulas that have instantiations into qs. */
+  void getQuantifiedFormulas(std::vector<Node>& qs) const;
+  /** Adds the instantiations for q into insts. */
   void getInstantiations(Node q, std::vector<std::vector<Node>>& insts) const;
-
-  /** print this class */
+  /** print the instantiations of q */
   void print(std::ostream& out, Node q) const;
+  /** The number of nodes of this trie, excluding the root */
+  size_t size() const { return d_nodes.size() - 1; }
 
  private:
-  /** Helper for getInstantiations.*/
-  void getInstantiations(Node q,
+  /**
+   * The context-dependent number of nodes, which notifies the trie when a
+   * context is popped.
+   */
+  class CDSize : public context::ContextNotifyObj
+  {
+   public:
+    CDSize(context::Context* c, FlatInstMatchTrie& t, size_t size)
+        : context::ContextNotifyObj(c), d_size(c, size), d_trie(t)
+    {
+    }
+    /** The number of nodes */
+    context::CDO<size_t> d_size;
+
+   protected:
+    void contextNotifyPop() override { d_trie.backtrack(); }
+
+   private:
+    FlatInstMatchTrie& d_trie;
+  };
+  /** A node of the trie, where ids are indices into d_nodes */
+  struct TrieNode
+  {
+    TrieNode(TNode key, uint32_t parent, uint32_t nextSibling)
+        : d_key(key), d_parent(parent), d_firstChild(0), d_next(nextSibling)
+    {
+    }
+    /** The key of the edge from the parent to this node */
+    Node d_key;
+    /** The parent */
+    uint32_t d_parent;
+    /** The first child, or 0 if none */
+    uint32_t d_firstChild;
+    /** The next sibling, or 0 if none */
+    uint32_t d_next;
+  };
+  /** Get the child of parent with the given key, or 0 if none */
+  uint32_t findChild(uint32_t parent, TNode key) const;
+  /** Add a child of parent with the given key, and return its id */
+  uint32_t addChild(uint32_t parent, TNode key);
+  /** The home slot of the edge from parent with the given key */
+  size_t slot(uint32_t parent, TNode key) const;
+  /** Double the number of slots */
+  void grow();
+  /** Remove the nodes that were added in popped contexts */
+  void backtrack();
+  /** Get the children of id, sorted by their keys */
+  void getChildren(uint32_t id, std::vector<uint32_t>& children) const;
+  /** Helper for getInstantiations */
+  void getInstantiations(uint32_t id,
+                         size_t depth,
                          std::vector<std::vector<Node>>& insts,
                          std::vector<Node>& terms) const;
-  /** helper for print
-   * terms accumulates the path we are on in the trie.
-   */
-  void print(std::ostream& out, Node q, std::vector<TNode>& terms) const;
-  /** the data */
-  std::map<Node, CDInstMatchTrie*> d_data;
-  /** is valid */
-  context::CDO<bool> d_valid;
+  /** The nodes, where the root has id 0 */
+  std::vector<TrieNode> d_nodes;
+  /** The slots of the edge table, storing child ids, or 0 if empty */
+  std::vector<uint32_t> d_slots;
+  /** 64 minus the logarithm of the number of slots */
+  uint32_t d_shift;
+  /** The context-dependent number of nodes, if a context is given */
+  std::unique_ptr<CDSize> d_cdSize;
 };
 
 /** inst match trie ordered
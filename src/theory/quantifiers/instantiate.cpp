@@ -52,21 +52,14 @@ Instantiate::Instantiate(Env& env,
       d_qreg(qr),
       d_treg(tr),
       d_insts(userContext()),
-      d_c_inst_match_trie_dom(userContext()),
+      d_instTrie(options().base.incrementalSolving ? userContext() : nullptr),
       d_pfInst(isProofEnabled()
                    ? new CDProof(env, userContext(), "Instantiate::pfInst")
                    : nullptr)
 {
 }
 
-Instantiate::~Instantiate()
-{
-  for (std::pair<const Node, CDInstMatchTrie*>& t : d_c_inst_match_trie)
-  {
-    delete t.second;
-  }
-  d_c_inst_match_trie.clear();
-}
+Instantiate::~Instantiate() {}
 
 bool Instantiate::reset(Theory::Effort e)
 {
@@ -531,23 +524,7 @@ void Instantiate::recordInstantiation(Node q,
 
 bool Instantiate::existsInstantiation(Node q, const std::vector<Node>& terms)
 {
-  if (options().base.incrementalSolving)
-  {
-    std::map<Node, CDInstMatchTrie*>::iterator it = d_c_inst_match_trie.find(q);
-    if (it != d_c_inst_match_trie.end())
-    {
-      return it->second->existsInstMatch(userContext(), q, terms);
-    }
-  }
-  else
-  {
-    std::map<Node, InstMatchTrie>::iterator it = d_inst_match_trie.find(q);
-    if (it != d_inst_match_trie.end())
-    {
-      return it->second.existsInstMatch(q, terms);
-    }
-  }
-  return false;
+  return d_instTrie.existsInstMatch(q, terms);
 }
 
 Node Instantiate::getInstantiation(Node q,
@@ -619,20 +596,8 @@ Node Instantiate::getInstantiation(Node q,
 bool Instantiate::recordInstantiationInternal(Node q,
                                               const std::vector<Node>& terms)
 {
-  if (options().base.incrementalSolving)
-  {
-    Trace("inst-add-debug")
-        << "Adding into context-dependent inst trie" << std::endl;
-    const auto res = d_c_inst_match_trie.insert({q, nullptr});
-    if (res.second)
-    {
-      res.first->second = new CDInstMatchTrie(userContext());
-    }
-    d_c_inst_match_trie_dom.insert(q);
-    return res.first->second->addInstMatch(userContext(), q, terms);
-  }
   Trace("inst-add-debug") << "Adding into inst trie" << std::endl;
-  return d_inst_match_trie[q].addInstMatch(q, terms);
+  return d_instTrie.addInstMatch(q, terms);
 }
 
 void Instantiate::getInstantiatedQuantifiedFormulas(std::vector<Node>& qs) const
@@ -648,42 +613,17 @@ void Instantiate::getInstantiatedQuantifiedFormulas(std::vector<Node>& qs) const
 void Instantiate::getInstantiationTermVectors(
     Node q, std::vector<std::vector<Node> >& tvecs)
 {
-  if (options().base.incrementalSolving)
-  {
-    std::map<Node, CDInstMatchTrie*>::const_iterator it =
-        d_c_inst_match_trie.find(q);
-    if (it != d_c_inst_match_trie.end())
-    {
-      it->second->getInstantiations(q, tvecs);
-    }
-  }
-  else
-  {
-    std::map<Node, InstMatchTrie>::const_iterator it =
-        d_inst_match_trie.find(q);
-    if (it != d_inst_match_trie.end())
-    {
-      it->second.getInstantiations(q, tvecs);
-    }
-  }
+  d_instTrie.getInstantiations(q, tvecs);
 }
 
 void Instantiate::getInstantiationTermVectors(
     std::map<Node, std::vector<std::vector<Node> > >& insts)
 {
-  if (options().base.incrementalSolving)
-  {
-    for (const auto& t : d_c_inst_match_trie)
-    {
-      getInstantiationTermVectors(t.first, insts[t.first]);
-    }
-  }
-  else
+  std::vector<Node> qs;
+  d_instTrie.getQuantifiedFormulas(qs);
+  for (const Node& q : qs)
   {
-    for (const auto& t : d_inst_match_trie)
-    {
-      getInstantiationTermVectors(t.first, insts[t.first]);
-    }
+    getInstantiationTermVectors(q, insts[q]);
   }
 }
 
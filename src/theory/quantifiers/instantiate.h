@@ -81,10 +81,9 @@ class InstLemmaList
 
 /** Instantiate
  *
- * This class is used for generating instantiation lemmas.  It maintains an
- * instantiation trie, which is represented by a different data structure
- * depending on whether incremental solving is enabled (see d_inst_match_trie
- * and d_c_inst_match_trie).
+ * This class is used for generating instantiation lemmas.  It maintains a
+ * trie of all instantiations (see d_instTrie), which is user-context
+ * dependent if incremental solving is enabled.
  *
  * Below, we say an instantiation lemma for q = forall x. F under substitution
  * { x -> t } is the formula:
@@ -341,16 +340,10 @@ class Instantiate : public QuantifiersUtil
 
   /** list of all instantiations produced for each quantifier
    *
-   * We store context (dependent, independent) versions. If incremental solving
-   * is disabled, we use d_inst_match_trie for performance reasons.
+   * This trie is user-context-dependent if incremental solving is enabled,
+   * and context-independent otherwise.
    */
-  std::map<Node, InstMatchTrie> d_inst_match_trie;
-  std::map<Node, CDInstMatchTrie*> d_c_inst_match_trie;
-  /**
-   * The list of quantified formulas for which the domain of d_c_inst_match_trie
-   * is valid.
-   */
-  context::CDHashSet<Node> d_c_inst_match_trie_dom;
+  FlatInstMatchTrie d_instTrie;
   /**
    * A CDProof storing instantiation steps.
    */
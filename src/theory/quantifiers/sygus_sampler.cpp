@@ -54,6 +54,7 @@ void SygusSampler::initialize(TypeNode tn,
   d_ftn = TypeNode::null();
   d_type_vars.clear();
   d_vars.clear();
+  d_evalProgram.reset();
   d_rvalue_cindices.clear();
   d_rvalue_null_cindices.clear();
   d_rstring_alphabet.clear();
@@ -104,6 +105,7 @@ void SygusSampler::initializeSygus(TypeNode ftn, unsigned nsamples)
   Trace("sygus-sample") << "Register sampler for " << ftn << std::endl;
 
   d_vars.clear();
+  d_evalProgram.reset();
   d_type_vars.clear();
   d_var_index.clear();
   d_type_vars.clear();
@@ -454,8 +456,14 @@ Node SygusSampler::evaluate(Node n, unsigned index)
   Assert(index < d_samples.size());
   // do beta-reductions in n first
   n = d_env.getRewriter()->rewrite(n);
-  // use efficient rewrite for substitution + rewrite
-  Node ev = d_env.evaluate(n, d_vars, d_samples[index], true);
+  // use efficient rewrite for substitution + rewrite, compiling n if it is
+  // not the term we evaluated last
+  if (d_evalProgram == nullptr || n != d_evalProgramTerm)
+  {
+    d_evalProgram.reset(new EvalProgram(*d_env.getEvaluator(true), n, d_vars));
+    d_evalProgramTerm = n;
+  }
+  Node ev = d_evalProgram->eval(d_samples[index]);
   Assert(!ev.isNull());
   Trace("sygus-sample-ev") << "Evaluate ( " << n << ", " << index << " ) -> ";
   Trace("sygus-sample-ev") << ev << std::endl;
@@ -19,8 +19,10 @@
 #define CVC5__THEORY__QUANTIFIERS__SYGUS_SAMPLER_H
 
 #include <map>
+#include <memory>
 
 #include "smt/env_obj.h"
+#include "theory/evaluator.h"
 #include "theory/quantifiers/lazy_trie.h"
 #include "theory/quantifiers/term_enumeration.h"
 
@@ -199,6 +201,13 @@ class SygusSampler : protected EnvObj, public LazyTrieEvaluator
   std::map<TypeNode, std::map<Node, Node> > d_builtin_to_sygus;
   /** all variables we are sampling values for */
   std::vector<Node> d_vars;
+  /**
+   * The program for the term that was last evaluated. Terms are typically
+   * evaluated on all sample points in a row, hence we compile them once.
+   */
+  std::unique_ptr<EvalProgram> d_evalProgram;
+  /** The term compiled into d_evalProgram */
+  Node d_evalProgramTerm;
   /** type variables
    *
    * We group variables according to "type ids". Two variables have the same
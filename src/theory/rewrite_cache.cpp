@@ -0,0 +1,82 @@
+/******************************************************************************
+ * Top contributors (to current version):
+ *   agent
+ *
+ * This file is part of the cvc5 project.
+ *
+ * Copyright (c) 2009-2023 by the authors listed in the file AUTHORS
+ * in the top-level source directory and their institutional affiliations.
+ * All rights reserved.  See the file COPYING in the top-level source
+ * directory for licensing information.
+ * ****************************************************************************
+ *
+ * A bounded cache for the results of the rewriter.
+ */
+
+#include "theory/rewrite_cache.h"
+
+#include "util/statistics_registry.h"
+
+namespace cvc5::internal {
+namespace theory {
+
+RewriteCache::RewriteCache(StatisticsRegistry& sr, size_t limit)
+    : d_limit(limit),
+      d_hits(sr.registerInt("theory::Rewriter::cacheHits")),
+      d_misses(sr.registerInt("theory::Rewriter::cacheMisses")),
+      d_evictions(sr.registerInt("theory::Rewriter::cacheEvictions"))
+{
+  Assert(d_limit > 0);
+}
+
+RewriteCache::Key RewriteCache::mkKey(TheoryId tid, bool isPre, TNode n)
+{
+  return Key(n, (static_cast<uint32_t>(tid) << 1) | (isPre ? 1 : 0));
+}
+
+Node RewriteCache::get(TheoryId tid, bool isPre, TNode n)
+{
+  auto it = d_map.find(mkKey(tid, isPre, n));
+  if (it == d_map.end())
+  {
+    ++d_misses;
+    return Node::null();
+  }
+  ++d_hits;
+  // mark as most recently used
+  d_entries.splice(d_entries.begin(), d_entries, it->second);
+  return it->second->second;
+}
+
+void RewriteCache::set(TheoryId tid, bool isPre, TNode n, TNode ret)
+{
+  Assert(!ret.isNull());
+  Key key = mkKey(tid, isPre, n);
+  auto it = d_map.find(key);
+  if (it != d_map.end())
+  {
+    it->second->second = ret;
+    d_entries.splice(d_entries.begin(), d_entries, it->second);
+    return;
+  }
+  if (d_map.size() >= d_limit)
+  {
+    // evict the least recently used entry
+    d_map.erase(d_entries.back().first);
+    d_entries.pop_back();
+    ++d_evictions;
+  }
+  d_entries.emplace_front(key, ret);
+  d_map[key] = d_entries.begin();
+}
+
+size_t RewriteCache::size() const { return d_map.size(); }
+
+void RewriteCache::clear()
+{
+  d_map.clear();
+  d_entries.clear();
+}
+
+}  // namespace theory
+}  // namespace cvc5::internal
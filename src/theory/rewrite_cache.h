@@ -0,0 +1,93 @@
+/******************************************************************************
+ * Top contributors (to current version):
+ *   agent
+ *
+ * This file is part of the cvc5 project.
+ *
+ * Copyright (c) 2009-2023 by the authors listed in the file AUTHORS
+ * in the top-level source directory and their institutional affiliations.
+ * All rights reserved.  See the file COPYING in the top-level source
+ * directory for licensing information.
+ * ****************************************************************************
+ *
+ * A bounded cache for the results of the rewriter.
+ */
+
+#include "cvc5_private.h"
+
+#ifndef CVC5__THEORY__REWRITE_CACHE_H
+#define CVC5__THEORY__REWRITE_CACHE_H
+
+#include <list>
+#include <unordered_map>
+#include <utility>
+
+#include "expr/node.h"
+#include "theory/theory_id.h"
+#include "util/hash.h"
+#include "util/statistics_stats.h"
+
+namespace cvc5::internal {
+
+class StatisticsRegistry;
+
+namespace theory {
+
+/**
+ * A cache for the results of the pre- and post-rewrites of the rewriter that
+ * holds at most a fixed number of entries, evicting the least recently used
+ * entry once it is full.
+ *
+ * By default, the rewriter caches its results in node attributes, which live
+ * as long as the rewritten node. This cache is used instead if a limit is set
+ * via option --rewrite-cache-limit, which bounds the memory used for caching
+ * at the price of rewriting evicted nodes again. Since the cache holds
+ * references to the nodes of its entries, it also keeps at most that many
+ * nodes alive.
+ */
+class RewriteCache
+{
+ public:
+  /**
+   * @param sr The statistics registry for registering the cache statistics
+   * @param limit The maximal number of entries, which must be positive
+   */
+  RewriteCache(StatisticsRegistry& sr, size_t limit);
+  /**
+   * Get the cached result of the pre-rewrite (if isPre is true) or
+   * post-rewrite of n by the rewriter of theory tid, or null if there is none.
+   */
+  Node get(TheoryId tid, bool isPre, TNode n);
+  /** Set the result of the pre- or post-rewrite of n to ret */
+  void set(TheoryId tid, bool isPre, TNode n, TNode ret);
+  /** Get the number of entries */
+  size_t size() const;
+  /** Remove all entries */
+  void clear();
+
+ private:
+  /** The key of an entry, the node and the theory and kind of rewrite */
+  using Key = std::pair<Node, uint32_t>;
+  using KeyHashFunction = PairHashFunction<Node, uint32_t, std::hash<Node>>;
+  /** The entries, ordered from the most to the least recently used */
+  using EntryList = std::list<std::pair<Key, Node>>;
+  /** Make the key for the given arguments */
+  static Key mkKey(TheoryId tid, bool isPre, TNode n);
+  /** The maximal number of entries */
+  size_t d_limit;
+  /** The entries */
+  EntryList d_entries;
+  /** Maps keys to their entry */
+  std::unordered_map<Key, EntryList::iterator, KeyHashFunction> d_map;
+  /** Number of lookups that returned an entry */
+  IntStat d_hits;
+  /** Number of lookups that did not return an entry */
+  IntStat d_misses;
+  /** Number of entries evicted */
+  IntStat d_evictions;
+};
+
+}  // namespace theory
+}  // namespace cvc5::internal
+
+#endif /* CVC5__THEORY__REWRITE_CACHE_H */
@@ -18,6 +18,7 @@
 #pragma once
 
 #include "expr/node.h"
+#include "theory/rewrite_cache.h"
 #include "theory/theory_rewriter.h"
 
 namespace cvc5::internal {
@@ -149,6 +150,12 @@ class Rewriter {
   /** The resource manager, for tracking resource usage */
   ResourceManager* d_resourceManager;
 
+  /**
+   * The bounded cache, if option --rewrite-cache-limit is set. Otherwise
+   * the results are cached in node attributes.
+   */
+  std::unique_ptr<RewriteCache> d_cache;
+
   /** Theory rewriters used by this rewriter instance */
   TheoryRewriter* d_theoryRewriters[theory::THEORY_LAST];
 
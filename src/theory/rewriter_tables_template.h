@@ -34,6 +34,10 @@ namespace theory {
 
 Node Rewriter::getPreRewriteCache(theory::TheoryId theoryId, TNode node)
 {
+  if (d_cache != nullptr)
+  {
+    return d_cache->get(theoryId, true, node);
+  }
   switch (theoryId)
   {
     // clang-format off
@@ -45,6 +49,10 @@ ${pre_rewrite_get_cache}
 
 Node Rewriter::getPostRewriteCache(theory::TheoryId theoryId, TNode node)
 {
+  if (d_cache != nullptr)
+  {
+    return d_cache->get(theoryId, false, node);
+  }
   switch (theoryId)
   {
     // clang-format off
@@ -58,6 +66,11 @@ void Rewriter::setPreRewriteCache(theory::TheoryId theoryId,
                                   TNode node,
                                   TNode cache)
 {
+  if (d_cache != nullptr)
+  {
+    d_cache->set(theoryId, true, node, cache);
+    return;
+  }
   switch (theoryId)
   {
     // clang-format off
@@ -71,6 +84,11 @@ void Rewriter::setPostRewriteCache(theory::TheoryId theoryId,
                                    TNode node,
                                    TNode cache)
 {
+  if (d_cache != nullptr)
+  {
+    d_cache->set(theoryId, false, node, cache);
+    return;
+  }
   switch (theoryId)
   {
     // clang-format off
@@ -18,6 +18,7 @@
 
 #include "proof/unsat_core.h"
 #include "smt/env.h"
+#include "util/resource_manager.h"
 
 namespace cvc5::internal {
 namespace theory {
@@ -29,7 +30,8 @@ SubsolverSetupInfo::SubsolverSetupInfo(const Options& opts,
     : d_opts(opts),
       d_logicInfo(logicInfo),
       d_sepLocType(sepLocType),
-      d_sepDataType(sepDataType)
+      d_sepDataType(sepDataType),
+      d_parentResourceManager(nullptr)
 {
 }
 
@@ -37,7 +39,8 @@ SubsolverSetupInfo::SubsolverSetupInfo(const Env& env)
     : d_opts(env.getOptions()),
       d_logicInfo(env.getLogicInfo()),
       d_sepLocType(env.getSepLocType()),
-      d_sepDataType(env.getSepDataType())
+      d_sepDataType(env.getSepDataType()),
+      d_parentResourceManager(env.getResourceManager())
 {
 }
 
@@ -45,7 +48,8 @@ SubsolverSetupInfo::SubsolverSetupInfo(const Env& env, const Options& opts)
     : d_opts(opts),
       d_logicInfo(env.getLogicInfo()),
       d_sepLocType(env.getSepLocType()),
-      d_sepDataType(env.getSepDataType())
+      d_sepDataType(env.getSepDataType()),
+      d_parentResourceManager(env.getResourceManager())
 {
 }
 
@@ -74,6 +78,12 @@ void initializeSubsolver(std::unique_ptr<SolverEngine>& smte,
   smte.reset(new SolverEngine(&info.d_opts));
   smte->setIsInternalSubsolver();
   smte->setLogic(info.d_logicInfo);
+  // the resources spent by the subsolver count towards the per-resource
+  // budgets of the current solver
+  if (info.d_parentResourceManager != nullptr)
+  {
+    smte->getResourceManager()->setParent(info.d_parentResourceManager);
+  }
   // set the options
   if (needsTimeout)
   {
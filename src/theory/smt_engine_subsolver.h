@@ -47,6 +47,11 @@ struct SubsolverSetupInfo
   /** The separation logic location and data types */
   TypeNode d_sepLocType;
   TypeNode d_sepDataType;
+  /**
+   * The resource manager of the solver creating the subsolver, which is the
+   * parent of the resource manager of the subsolver, if it is not null.
+   */
+  ResourceManager* d_parentResourceManager;
 };
 
 /**
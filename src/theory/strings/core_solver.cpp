@@ -549,7 +549,7 @@ void CoreSolver::checkNormalFormsEqProp()
   d_normal_form.clear();
   // map from normal form terms (the concatenation of the terms in the normal
   // form) to the equivalence that had that normal form
-  std::map<Node, Node> nf_to_eqc;
+  ScratchMap<Node, Node> nf_to_eqc(d_termReg.getScratchArena());
   for (const Node& eqc : d_strings_eqc)
   {
     Assert(d_pinfers.empty());
@@ -572,7 +572,7 @@ void CoreSolver::checkNormalFormsEqProp()
     }
     NormalForm& nfe = getNormalForm(eqc);
     Node nf_term = d_termReg.mkNConcat(nfe.d_nf, stype);
-    std::map<Node, Node>::iterator itn = nf_to_eqc.find(nf_term);
+    ScratchMap<Node, Node>::iterator itn = nf_to_eqc.find(nf_term);
     if (itn != nf_to_eqc.end())
     {
       NormalForm& nfe_eq = getNormalForm(itn->second);
@@ -626,7 +626,7 @@ void CoreSolver::normalizeEquivalenceClass(Node eqc,
     // Normal forms for the relevant terms in the equivalence class of eqc
     std::vector<NormalForm> normal_forms;
     // map each term to its index in the above vector
-    std::map<Node, unsigned> term_to_nf_index;
+    ScratchMap<Node, unsigned> term_to_nf_index(d_termReg.getScratchArena());
     // get the normal forms
     getNormalForms(eqc, normal_forms, term_to_nf_index, stype);
     if (d_im.hasProcessed())
@@ -646,7 +646,7 @@ void CoreSolver::normalizeEquivalenceClass(Node eqc,
     //construct the normal form
     Assert(!normal_forms.empty());
     unsigned nf_index = 0;
-    std::map<Node, unsigned>::iterator it = term_to_nf_index.find(eqc);
+    ScratchMap<Node, unsigned>::iterator it = term_to_nf_index.find(eqc);
     // we prefer taking the normal form whose base is the equivalence
     // class representative, since this leads to shorter explanations in
     // some cases.
@@ -842,7 +842,7 @@ Node CoreSolver::getDecomposeConclusion(Node x,
 
 void CoreSolver::getNormalForms(Node eqc,
                                 std::vector<NormalForm>& normal_forms,
-                                std::map<Node, unsigned>& term_to_nf_index,
+                                ScratchMap<Node, unsigned>& term_to_nf_index,
                                 TypeNode stype)
 {
   Node emp = Word::mkEmptyWord(stype);
@@ -1057,8 +1057,8 @@ void CoreSolver::processNEqc(Node eqc,
   // conflicts
   Node c = d_bsolver.getConstantEqc(eqc);
   // compute normal forms that are effectively unique
-  std::unordered_map<Node, size_t> nfCache;
-  std::vector<size_t> nfIndices;
+  ScratchUnorderedMap<Node, size_t> nfCache(d_termReg.getScratchArena());
+  ScratchVector<size_t> nfIndices(d_termReg.getScratchArena());
   bool hasConstIndex = false;
   for (size_t i = 0, nnforms = normal_forms.size(); i < nnforms; i++)
   {
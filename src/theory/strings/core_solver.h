@@ -363,7 +363,7 @@ class CoreSolver : protected EnvObj
    */
   void getNormalForms(Node eqc,
                       std::vector<NormalForm>& normal_forms,
-                      std::map<Node, unsigned>& term_to_nf_index,
+                      ScratchMap<Node, unsigned>& term_to_nf_index,
                       TypeNode stype);
   /** process normalize equivalence class
    *
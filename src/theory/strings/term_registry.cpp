@@ -665,7 +665,11 @@ void TermRegistry::notifyStartFullEffortCheck()
   d_theory.computeRelevantTerms(d_relevantTerms);
 }
 
-void TermRegistry::notifyEndFullEffortCheck() { d_inFullEffortCheck = false; }
+void TermRegistry::notifyEndFullEffortCheck()
+{
+  d_inFullEffortCheck = false;
+  d_scratch.reset();
+}
 
 const std::set<Node>& TermRegistry::getRelevantTermSet() const
 {
@@ -674,6 +678,8 @@ const std::set<Node>& TermRegistry::getRelevantTermSet() const
   return d_relevantTerms;
 }
 
+ScratchArena& TermRegistry::getScratchArena() { return d_scratch; }
+
 Node TermRegistry::mkNConcat(Node n1, Node n2) const
 {
   return rewrite(NodeManager::currentNM()->mkNode(STRING_CONCAT, n1, n2));
@@ -30,6 +30,7 @@
 #include "theory/strings/skolem_cache.h"
 #include "theory/strings/solver_state.h"
 #include "theory/uf/equality_engine.h"
+#include "util/scratch_arena.h"
 
 namespace cvc5::internal {
 namespace theory {
@@ -239,7 +240,8 @@ class TermRegistry : protected EnvObj
    */
   void notifyStartFullEffortCheck();
   /**
-   * Called at the end of full effort check by TheoryStrings.
+   * Called at the end of full effort check by TheoryStrings. This resets the
+   * scratch arena.
    */
   void notifyEndFullEffortCheck();
   /**
@@ -251,6 +253,13 @@ class TermRegistry : protected EnvObj
    * for the theory of strings.
    */
   const std::set<Node>& getRelevantTermSet() const;
+  /**
+   * Get the scratch arena, which the solvers of the theory of strings use
+   * for the temporary containers of a check. It is reset at the end of each
+   * full effort check, hence no data allocated in it may be kept beyond a
+   * check.
+   */
+  ScratchArena& getScratchArena();
 
  private:
   /** Reference to theory of strings, for computing relevant terms */
@@ -311,6 +320,8 @@ class TermRegistry : protected EnvObj
   bool d_inFullEffortCheck;
   /** Set of terms that appear in the current assertions */
   std::set<Node> d_relevantTerms;
+  /** The scratch arena */
+  ScratchArena d_scratch;
   /** Register type
    *
    * Ensures the theory solver is setup to handle string-like type tn. In
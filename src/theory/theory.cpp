@@ -66,6 +66,8 @@ Theory::Theory(TheoryId id,
                                                      + "checkTime")),
       d_computeCareGraphTime(statisticsRegistry().registerTimer(
           getStatsPrefix(id) + name + "computeCareGraphTime")),
+      d_propagateTime(statisticsRegistry().registerTimer(
+          getStatsPrefix(id) + name + "propagateTime")),
       d_sharedTerms(d_env.getContext()),
       d_out(&out),
       d_valuation(valuation),
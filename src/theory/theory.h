@@ -113,6 +113,8 @@ class Theory : protected EnvObj
   TimerStat d_checkTime;
   /** time spent in theory combination */
   TimerStat d_computeCareGraphTime;
+  /** time spent in propagate, measured by the theory engine */
+  TimerStat d_propagateTime;
 
   /** Add (t1, t2) to the care graph */
   void addCarePair(TNode t1, TNode t2);
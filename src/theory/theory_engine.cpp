@@ -570,11 +570,13 @@ void TheoryEngine::propagate(Theory::Effort effort)
 #ifdef CVC5_FOR_EACH_THEORY_STATEMENT
 #undef CVC5_FOR_EACH_THEORY_STATEMENT
 #endif
-#define CVC5_FOR_EACH_THEORY_STATEMENT(THEORY)   \
-  if (theory::TheoryTraits<THEORY>::hasPropagate \
-      && isTheoryEnabled(THEORY))    \
-  {                                              \
-    theoryOf(THEORY)->propagate(effort);         \
+#define CVC5_FOR_EACH_THEORY_STATEMENT(THEORY)                      \
+  if (theory::TheoryTraits<THEORY>::hasPropagate                    \
+      && isTheoryEnabled(THEORY))                                   \
+  {                                                                 \
+    TimerStat::CodeTimer propagateTimer(                            \
+        theoryOf(THEORY)->d_propagateTime);                         \
+    theoryOf(THEORY)->propagate(effort);                            \
   }
 
   // Reset the interrupt flag
@@ -914,7 +916,7 @@ bool TheoryEngine::markPropagation(TNode assertion, TNode originalAssertion, the
   Trace("theory::assertToTheory") << "TheoryEngine::markPropagation(): marking [" << d_propagationMapTimestamp << "] " << assertion << ", " << toTheoryId << " from " << originalAssertion << ", " << fromTheoryId << endl;
 
   // Mark the propagation
-  d_propagationMap[toAssert] = toExplain;
+  d_propagationMap.insert(toAssert, toExplain);
   d_propagationMapTimestamp = d_propagationMapTimestamp + 1;
 
   return true;
@@ -23,6 +23,7 @@
 
 #include "base/check.h"
 #include "context/cdhashmap.h"
+#include "context/cdtrail_hashmap.h"
 #include "expr/node.h"
 #include "options/theory_options.h"
 #include "proof/trust_node.h"
@@ -420,9 +421,10 @@ class TheoryEngine : protected EnvObj
   void checkTheoryAssertionsWithModel(bool hardFailure);
 
  private:
-  typedef context::
-      CDHashMap<NodeTheoryPair, NodeTheoryPair, NodeTheoryPairHashFunction>
-          PropagationMap;
+  typedef context::CDTrailHashMap<NodeTheoryPair,
+                                  NodeTheoryPair,
+                                  NodeTheoryPairHashFunction>
+      PropagationMap;
 
   /**
    * Called by the theories to notify of a conflict.
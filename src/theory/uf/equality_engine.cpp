@@ -202,8 +202,8 @@ EqualityNodeId EqualityEngine::newApplicationNode(TNode original, EqualityNodeId
   EqualityNodeId funId = newNode(original);
   FunctionApplication funOriginal(type, t1, t2);
   // The function application we're creating
-  EqualityNodeId t1ClassId = getEqualityNode(t1).getFind();
-  EqualityNodeId t2ClassId = getEqualityNode(t2).getFind();
+  EqualityNodeId t1ClassId = getFind(t1);
+  EqualityNodeId t2ClassId = getFind(t2);
   FunctionApplication funNormalized(type, t1ClassId, t2ClassId);
 
   Trace("equality") << d_name << "::eq::newApplicationNode: funOriginal: ("
@@ -215,8 +215,9 @@ EqualityNodeId EqualityEngine::newApplicationNode(TNode original, EqualityNodeId
   d_applications[funId] = FunctionApplicationPair(funOriginal, funNormalized);
 
   // Add the lookup data, if it's not already there
-  ApplicationIdsMap::iterator find = d_applicationLookup.find(funNormalized);
-  if (find == d_applicationLookup.end()) {
+  EqualityNodeId lookupId = d_applicationLookup.find(funNormalized);
+  if (lookupId == null_id)
+  {
     Trace("equality") << d_name << "::eq::newApplicationNode(" << original
                       << ", " << t1 << ", " << t2
                       << "): no lookup, setting up funNorm: (" << type << " "
@@ -227,8 +228,8 @@ EqualityNodeId EqualityEngine::newApplicationNode(TNode original, EqualityNodeId
   } else {
     // If it's there, we need to merge these two
     Trace("equality") << d_name << "::eq::newApplicationNode(" << original << ", " << t1 << ", " << t2 << "): lookup exists, adding to queue" << std::endl;
-    Trace("equality") << d_name << "::eq::newApplicationNode(" << original << ", " << t1 << ", " << t2 << "): lookup = " << d_nodes[find->second] << std::endl;
-    enqueue(MergeCandidate(funId, find->second, MERGED_THROUGH_CONGRUENCE, TNode::null()));
+    Trace("equality") << d_name << "::eq::newApplicationNode(" << original << ", " << t1 << ", " << t2 << "): lookup = " << d_nodes[lookupId] << std::endl;
+    enqueue(MergeCandidate(funId, lookupId, MERGED_THROUGH_CONGRUENCE, TNode::null()));
   }
 
   // Add to the use lists
@@ -251,7 +252,7 @@ EqualityNodeId EqualityEngine::newNode(TNode node) {
 
   // Register the new id of the term
   EqualityNodeId newId = d_nodes.size();
-  d_nodeIds[node] = newId;
+  d_nodeIds.insert(node, newId);
   // Add the node to it's position
   d_nodes.push_back(node);
   // Note if this is an application or not
@@ -272,6 +273,8 @@ EqualityNodeId EqualityEngine::newNode(TNode node) {
   d_isInternal.push_back(true);
   // Add the equality node to the nodes
   d_equalityNodes.push_back(EqualityNode(newId));
+  // The node is its own representative
+  d_findIds.push_back(newId);
 
   // Increase the counters
   d_nodesCount = d_nodesCount + 1;
@@ -429,13 +432,12 @@ void EqualityEngine::addTermInternal(TNode t, bool isOperator) {
   Trace("equality") << d_name << "::eq::addTermInternal(" << t << ") => " << result << std::endl;
 }
 
-bool EqualityEngine::hasTerm(TNode t) const {
-  return d_nodeIds.find(t) != d_nodeIds.end();
-}
+bool EqualityEngine::hasTerm(TNode t) const { return d_nodeIds.contains(t); }
 
 EqualityNodeId EqualityEngine::getNodeId(TNode node) const {
-  Assert(hasTerm(node)) << node;
-  return (*d_nodeIds.find(node)).second;
+  EqualityNodeId id = d_nodeIds.find(node);
+  Assert(id != null_id) << node;
+  return id;
 }
 
 EqualityNode& EqualityEngine::getEqualityNode(TNode t) {
@@ -528,8 +530,8 @@ bool EqualityEngine::assertEquality(TNode eq,
     // If both have constant representatives, we don't notify anyone
     EqualityNodeId a = getNodeId(eq[0]);
     EqualityNodeId b = getNodeId(eq[1]);
-    EqualityNodeId aClassId = getEqualityNode(a).getFind();
-    EqualityNodeId bClassId = getEqualityNode(b).getFind();
+    EqualityNodeId aClassId = getFind(a);
+    EqualityNodeId bClassId = getFind(b);
     if (d_isConstant[aClassId] && d_isConstant[bClassId]) {
       return true;
     }
@@ -589,32 +591,31 @@ bool EqualityEngine::assertEquality(TNode eq,
 TNode EqualityEngine::getRepresentative(TNode t) const {
   Trace("equality::internal") << d_name << "::eq::getRepresentative(" << t << ")" << std::endl;
   Assert(hasTerm(t));
-  EqualityNodeId representativeId = getEqualityNode(t).getFind();
+  EqualityNodeId representativeId = getFind(t);
   Assert(!d_isInternal[representativeId]);
   Trace("equality::internal") << d_name << "::eq::getRepresentative(" << t << ") => " << d_nodes[representativeId] << std::endl;
   return d_nodes[representativeId];
 }
 
-bool EqualityEngine::merge(EqualityNode& class1, EqualityNode& class2, std::vector<TriggerId>& triggersFired) {
-
-  Trace("equality") << d_name << "::eq::merge(" << class1.getFind() << "," << class2.getFind() << ")" << std::endl;
+bool EqualityEngine::merge(EqualityNodeId class1Id,
+                           EqualityNodeId class2Id,
+                           std::vector<TriggerId>& triggersFired)
+{
+  Trace("equality") << d_name << "::eq::merge(" << class1Id << "," << class2Id << ")" << std::endl;
 
   Assert(triggersFired.empty());
+  Assert(getFind(class1Id) == class1Id);
+  Assert(getFind(class2Id) == class2Id);
 
   ++d_stats.d_mergesCount;
 
-  EqualityNodeId class1Id = class1.getFind();
-  EqualityNodeId class2Id = class2.getFind();
-
   Node n1 = d_nodes[class1Id];
   Node n2 = d_nodes[class2Id];
-  EqualityNode cc1 = getEqualityNode(n1);
-  EqualityNode cc2 = getEqualityNode(n2);
   bool doNotify = false;
   // Determine if we should notify the owner of this class of this merge.
   // The second part of this check is needed due to the internal implementation
   // of this class. It ensures that we are merging terms and not operators.
-  if (class1Id == cc1.getFind() && class2Id == cc2.getFind())
+  if (class1Id == getFind(n1) && class2Id == getFind(n2))
   {
     doNotify = true;
   }
@@ -655,15 +656,15 @@ bool EqualityEngine::merge(EqualityNode& class1, EqualityNode& class2, std::vect
   }
 
   // Update class2 representative information
-  Trace("equality") << d_name << "::eq::merge(" << class1.getFind() << "," << class2.getFind() << "): updating class " << class2Id << std::endl;
+  Trace("equality") << d_name << "::eq::merge(" << class1Id << "," << class2Id << "): updating class " << class2Id << std::endl;
   EqualityNodeId currentId = class2Id;
   do {
     // Get the current node
     EqualityNode& currentNode = getEqualityNode(currentId);
 
     // Update it's find to class1 id
-    Trace("equality") << d_name << "::eq::merge(" << class1.getFind() << "," << class2.getFind() << "): " << currentId << "->" << class1Id << std::endl;
-    currentNode.setFind(class1Id);
+    Trace("equality") << d_name << "::eq::merge(" << class1Id << "," << class2Id << "): " << currentId << "->" << class1Id << std::endl;
+    d_findIds[currentId] = class1Id;
 
     // Go through the triggers and inform if necessary
     TriggerId currentTrigger = d_nodeTriggers[currentId];
@@ -695,11 +696,11 @@ bool EqualityEngine::merge(EqualityNode& class1, EqualityNode& class2, std::vect
   // Update class2 table lookup and information if not a boolean
   // since booleans can't be in an application
   if (!d_isEquality[class2Id]) {
-    Trace("equality") << d_name << "::eq::merge(" << class1.getFind() << "," << class2.getFind() << "): updating lookups of " << class2Id << std::endl;
+    Trace("equality") << d_name << "::eq::merge(" << class1Id << "," << class2Id << "): updating lookups of " << class2Id << std::endl;
     do {
       // Get the current node
       EqualityNode& currentNode = getEqualityNode(currentId);
-      Trace("equality") << d_name << "::eq::merge(" << class1.getFind() << "," << class2.getFind() << "): updating lookups of node " << currentId << std::endl;
+      Trace("equality") << d_name << "::eq::merge(" << class1Id << "," << class2Id << "): updating lookups of node " << currentId << std::endl;
 
       // Go through the uselist and check for congruences
       UseListNodeId currentUseId = currentNode.getUseList();
@@ -708,7 +709,7 @@ bool EqualityEngine::merge(EqualityNode& class1, EqualityNode& class2, std::vect
         UseListNode& useNode = d_useListNodes[currentUseId];
         // Get the function application
         EqualityNodeId funId = useNode.getApplicationId();
-        Trace("equality") << d_name << "::eq::merge(" << class1.getFind() << "," << class2.getFind() << "): " << d_nodes[currentId] << " in " << d_nodes[funId] << std::endl;
+        Trace("equality") << d_name << "::eq::merge(" << class1Id << "," << class2Id << "): " << d_nodes[currentId] << " in " << d_nodes[funId] << std::endl;
         const FunctionApplication& fun =
             d_applications[useNode.getApplicationId()].d_normalized;
         // If it's interpreted and we can interpret
@@ -719,14 +720,17 @@ bool EqualityEngine::merge(EqualityNode& class1, EqualityNode& class2, std::vect
           subtermEvaluates(getNodeId(term));
         }
         // Check if there is an application with find arguments
-        EqualityNodeId aNormalized = getEqualityNode(fun.d_a).getFind();
-        EqualityNodeId bNormalized = getEqualityNode(fun.d_b).getFind();
+        EqualityNodeId aNormalized = getFind(fun.d_a);
+        EqualityNodeId bNormalized = getFind(fun.d_b);
         FunctionApplication funNormalized(fun.d_type, aNormalized, bNormalized);
-        ApplicationIdsMap::iterator find = d_applicationLookup.find(funNormalized);
-        if (find != d_applicationLookup.end()) {
+        EqualityNodeId lookupId = d_applicationLookup.find(funNormalized);
+        if (lookupId != null_id)
+        {
           // Applications fun and the funNormalized can be merged due to congruence
-          if (getEqualityNode(funId).getFind() != getEqualityNode(find->second).getFind()) {
-            enqueue(MergeCandidate(funId, find->second, MERGED_THROUGH_CONGRUENCE, TNode::null()));
+          if (getFind(funId) != getFind(lookupId))
+          {
+            enqueue(MergeCandidate(
+                funId, lookupId, MERGED_THROUGH_CONGRUENCE, TNode::null()));
           }
         } else {
           // There is no representative, so we can add one, we remove this when backtracking
@@ -743,7 +747,7 @@ bool EqualityEngine::merge(EqualityNode& class1, EqualityNode& class2, std::vect
   }
 
   // Now merge the lists
-  class1.merge<true>(class2);
+  d_equalityNodes[class1Id].merge<true>(d_equalityNodes[class2Id]);
 
   // notify the theory
   if (doNotify) {
@@ -831,22 +835,23 @@ bool EqualityEngine::merge(EqualityNode& class1, EqualityNode& class2, std::vect
   return true;
 }
 
-void EqualityEngine::undoMerge(EqualityNode& class1, EqualityNode& class2, EqualityNodeId class2Id) {
-
-  Trace("equality") << d_name << "::eq::undoMerge(" << class1.getFind() << "," << class2Id << ")" << std::endl;
+void EqualityEngine::undoMerge(EqualityNodeId class1Id,
+                               EqualityNodeId class2Id)
+{
+  Trace("equality") << d_name << "::eq::undoMerge(" << class1Id << "," << class2Id << ")" << std::endl;
 
   // Now unmerge the lists (same as merge)
-  class1.merge<false>(class2);
+  d_equalityNodes[class1Id].merge<false>(d_equalityNodes[class2Id]);
 
   // Update class2 representative information
   EqualityNodeId currentId = class2Id;
-  Trace("equality") << d_name << "::eq::undoMerge(" << class1.getFind() << "," << class2Id << "): undoing representative info" << std::endl;
+  Trace("equality") << d_name << "::eq::undoMerge(" << class1Id << "," << class2Id << "): undoing representative info" << std::endl;
   do {
     // Get the current node
     EqualityNode& currentNode = getEqualityNode(currentId);
 
-    // Update it's find to class1 id
-    currentNode.setFind(class2Id);
+    // Update it's find to class2 id
+    d_findIds[currentId] = class2Id;
 
     // Go through the trigger list (if any) and undo the class
     TriggerId currentTrigger = d_nodeTriggers[currentId];
@@ -883,8 +888,7 @@ void EqualityEngine::backtrack() {
       // Undo the merge
       if (eq.d_lhs != null_id)
       {
-        undoMerge(
-            d_equalityNodes[eq.d_lhs], d_equalityNodes[eq.d_rhs], eq.d_rhs);
+        undoMerge(eq.d_lhs, eq.d_rhs);
       }
     }
 
@@ -900,6 +904,30 @@ void EqualityEngine::backtrack() {
     }
 
     d_equalityEdges.resize(2 * d_assertedEqualitiesCount);
+
+    // Forget the explanations that use the removed edges
+    for (size_t i = d_assertedEqualitiesCount,
+                i_end = d_explanationMemoLevels.size();
+         i < i_end;
+         ++i)
+    {
+      for (const std::pair<EqualityPair, bool>& key :
+           d_explanationMemoLevels[i])
+      {
+        if (key.second)
+        {
+          d_proofExplanationMemo.erase(key.first);
+        }
+        else
+        {
+          d_explanationMemo.erase(key.first);
+        }
+      }
+    }
+    if (d_explanationMemoLevels.size() > d_assertedEqualitiesCount)
+    {
+      d_explanationMemoLevels.resize(d_assertedEqualitiesCount);
+    }
   }
 
   if (d_triggerTermSetUpdates.size() > d_triggerTermSetUpdatesSize) {
@@ -963,6 +991,7 @@ void EqualityEngine::backtrack() {
     d_isInternal.resize(d_nodesCount);
     d_equalityGraph.resize(d_nodesCount);
     d_equalityNodes.resize(d_nodesCount);
+    d_findIds.resize(d_nodesCount);
   }
 
   if (d_deducedDisequalities.size() > d_deducedDisequalitiesSize) {
@@ -1336,7 +1365,7 @@ Node EqualityEngine::mkExplainLit(TNode lit) const
   return ret;
 }
 
-void EqualityEngine::getExplanation(
+size_t EqualityEngine::getExplanation(
     EqualityNodeId t1Id,
     EqualityNodeId t2Id,
     std::vector<TNode>& equalities,
@@ -1350,6 +1379,7 @@ void EqualityEngine::getExplanation(
   // determine if we have already computed the explanation.
   std::pair<EqualityNodeId, EqualityNodeId> cacheKey;
   std::map<std::pair<EqualityNodeId, EqualityNodeId>, EqProof*>::iterator it;
+  ExplanationMemo& memo = eqp ? d_proofExplanationMemo : d_explanationMemo;
   if (!eqp)
   {
     // If proofs are disabled, we order the ids, since explaining t1 = t2 is the
@@ -1358,7 +1388,8 @@ void EqualityEngine::getExplanation(
     it = cache.find(cacheKey);
     if (it != cache.end())
     {
-      return;
+      ExplanationMemo::const_iterator mit = memo.find(cacheKey);
+      return mit == memo.end() ? 0 : mit->second.d_level;
     }
   }
   else
@@ -1386,20 +1417,77 @@ void EqualityEngine::getExplanation(
         Assert(eqp->d_id == MERGED_THROUGH_REFLEXIVITY);
         eqp->d_node = d_nodes[t1Id].eqNode(d_nodes[t1Id]);
       }
-      return;
+      ExplanationMemo::const_iterator mit = memo.find(cacheKey);
+      return mit == memo.end() ? 0 : mit->second.d_level;
+    }
+  }
+
+  // determine if we have explained this equality in a previous call
+  ExplanationMemo::const_iterator mit = memo.find(cacheKey);
+  if (mit != memo.end())
+  {
+    const ExplanationMemoEntry& entry = mit->second;
+    Trace("eq-exp") << d_name << "::eq::getExplanation(): memoized, "
+                    << entry.d_steps.size() << " steps" << std::endl;
+    cache[cacheKey] = entry.d_proof.get();
+    // replay the steps, which adds the same equalities as computing the
+    // explanation again, and uses the memoized sub-explanations
+    for (const ExplanationStep& step : entry.d_steps)
+    {
+      if (step.d_reason.isNull())
+      {
+        if (step.d_a == step.d_b)
+        {
+          // trivial, and we must not cache the temporary proof below for it
+          continue;
+        }
+        std::shared_ptr<EqProof> eqpc =
+            eqp ? std::make_shared<EqProof>() : nullptr;
+        EqualityPair stepKey =
+            eqp ? EqualityPair(step.d_a, step.d_b)
+                : EqualityPair(std::minmax(step.d_a, step.d_b));
+        // The steps were explained when this explanation was computed, and
+        // are memoized at a level that is at most its level. Hence they are
+        // replayed as well, and the cache does not refer to eqpc, which is
+        // temporary.
+        Assert(cache.find(stepKey) != cache.end()
+               || memo.find(stepKey) != memo.end());
+        getExplanation(step.d_a, step.d_b, equalities, cache, eqpc.get());
+        if (eqp)
+        {
+          // should the step have been explained anew nevertheless, the cache
+          // refers to eqpc, hence we let it refer to the memoized proof
+          std::map<EqualityPair, EqProof*>::iterator cit = cache.find(stepKey);
+          if (cit != cache.end() && cit->second == eqpc.get())
+          {
+            ExplanationMemo::const_iterator sit = memo.find(stepKey);
+            Assert(sit != memo.end());
+            cit->second = sit->second.d_proof.get();
+          }
+        }
+      }
+      else
+      {
+        equalities.push_back(step.d_reason);
+      }
+    }
+    if (eqp)
+    {
+      *eqp = *entry.d_proof;
     }
+    return entry.d_level;
   }
   cache[cacheKey] = eqp;
 
   // We can only explain the nodes that got merged
 #ifdef CVC5_ASSERTIONS
-  bool canExplain = getEqualityNode(t1Id).getFind() == getEqualityNode(t2Id).getFind()
+  bool canExplain = getFind(t1Id) == getFind(t2Id)
                   || (d_done && isConstant(t1Id) && isConstant(t2Id));
 
   if (!canExplain) {
     warning() << "Can't explain equality:" << std::endl;
-    warning() << d_nodes[t1Id] << " with find " << d_nodes[getEqualityNode(t1Id).getFind()] << std::endl;
-    warning() << d_nodes[t2Id] << " with find " << d_nodes[getEqualityNode(t2Id).getFind()] << std::endl;
+    warning() << d_nodes[t1Id] << " with find " << d_nodes[getFind(t1Id)] << std::endl;
+    warning() << d_nodes[t2Id] << " with find " << d_nodes[getFind(t2Id)] << std::endl;
   }
   Assert(canExplain);
 #endif
@@ -1425,7 +1513,7 @@ void EqualityEngine::getExplanation(
         eqp->d_node = d_nodes[t1Id].eqNode(d_nodes[t1Id]);
       }
     }
-    return;
+    return 0;
   }
 
   // Queue for the BFS containing nodes
@@ -1472,6 +1560,9 @@ void EqualityEngine::getExplanation(
           Trace("equality") << d_name << "::eq::getExplanation(): path found: " << std::endl;
 
           std::vector<std::shared_ptr<EqProof>> eqp_trans;
+          // the steps and level of the explanation, for memoizing it
+          std::vector<ExplanationStep> steps;
+          size_t level = 0;
 
           // Reconstruct the path
           do {
@@ -1481,6 +1572,7 @@ void EqualityEngine::getExplanation(
             MergeReasonType reasonType = static_cast<MergeReasonType>(
                 d_equalityEdges[currentEdge].getReasonType());
             Node reason = d_equalityEdges[currentEdge].getReason();
+            level = std::max(level, size_t(currentEdge >> 1) + 1);
 
             Trace("equality")
                 << d_name
@@ -1523,11 +1615,23 @@ void EqualityEngine::getExplanation(
               Trace("equality") << "Explaining left hand side equalities" << std::endl;
               std::shared_ptr<EqProof> eqpc1 =
                   eqpc ? std::make_shared<EqProof>() : nullptr;
-              getExplanation(f1.d_a, f2.d_a, equalities, cache, eqpc1.get());
+              steps.emplace_back(f1.d_a, f2.d_a);
+              level = std::max(level,
+                               getExplanation(f1.d_a,
+                                              f2.d_a,
+                                              equalities,
+                                              cache,
+                                              eqpc1.get()));
               Trace("equality") << "Explaining right hand side equalities" << std::endl;
               std::shared_ptr<EqProof> eqpc2 =
                   eqpc ? std::make_shared<EqProof>() : nullptr;
-              getExplanation(f1.d_b, f2.d_b, equalities, cache, eqpc2.get());
+              steps.emplace_back(f1.d_b, f2.d_b);
+              level = std::max(level,
+                               getExplanation(f1.d_b,
+                                              f2.d_b,
+                                              equalities,
+                                              cache,
+                                              eqpc2.get()));
               if (eqpc)
               {
                 eqpc->d_children.push_back(eqpc1);
@@ -1564,7 +1668,13 @@ void EqualityEngine::getExplanation(
               Trace("equality") << push;
               std::shared_ptr<EqProof> eqpc1 =
                   eqpc ? std::make_shared<EqProof>() : nullptr;
-              getExplanation(eq.d_a, eq.d_b, equalities, cache, eqpc1.get());
+              steps.emplace_back(eq.d_a, eq.d_b);
+              level = std::max(level,
+                               getExplanation(eq.d_a,
+                                              eq.d_b,
+                                              equalities,
+                                              cache,
+                                              eqpc1.get()));
               if( eqpc ){
                 eqpc->d_children.push_back( eqpc1 );
               }
@@ -1607,11 +1717,12 @@ void EqualityEngine::getExplanation(
                 Assert(isConstant(childId));
                 std::shared_ptr<EqProof> eqpcc =
                     eqpc ? std::make_shared<EqProof>() : nullptr;
-                getExplanation(childId,
-                               getEqualityNode(childId).getFind(),
-                               equalities,
-                               cache,
-                               eqpcc.get());
+                EqualityNodeId findId = getFind(childId);
+                steps.emplace_back(childId, findId);
+                level = std::max(
+                    level,
+                    getExplanation(
+                        childId, findId, equalities, cache, eqpcc.get()));
                 if( eqpc ) {
                   eqpc->d_children.push_back( eqpcc );
                   if (TraceIsOn("pf::ee"))
@@ -1660,6 +1771,7 @@ void EqualityEngine::getExplanation(
                 eqpc->d_id = reasonType;
               }
               equalities.push_back(reason);
+              steps.emplace_back(TNode(reason));
               break;
             }
             }
@@ -1702,8 +1814,23 @@ void EqualityEngine::getExplanation(
             }
           }
 
+          // Memoize the explanation until we backtrack below its level
+          ExplanationMemoEntry& entry = memo[cacheKey];
+          entry.d_steps = std::move(steps);
+          if (eqp)
+          {
+            entry.d_proof = std::make_shared<EqProof>(*eqp);
+          }
+          entry.d_level = level;
+          if (d_explanationMemoLevels.size() < level)
+          {
+            d_explanationMemoLevels.resize(level);
+          }
+          d_explanationMemoLevels[level - 1].emplace_back(cacheKey,
+                                                          eqp != nullptr);
+
           // Done
-          return;
+          return level;
         }
 
         // Push to the visitation queue if it's not the backward edge
@@ -1808,13 +1935,13 @@ void EqualityEngine::addTriggerEqualityInternal(TNode t1, TNode t2, TNode trigge
 
   // Get the information about t1
   EqualityNodeId t1Id = getNodeId(t1);
-  EqualityNodeId t1classId = getEqualityNode(t1Id).getFind();
+  EqualityNodeId t1classId = getFind(t1Id);
   // We will attach it to the class representative, since then we know how to backtrack it
   TriggerId t1TriggerId = d_nodeTriggers[t1classId];
 
   // Get the information about t2
   EqualityNodeId t2Id = getNodeId(t2);
-  EqualityNodeId t2classId = getEqualityNode(t2Id).getFind();
+  EqualityNodeId t2classId = getFind(t2Id);
   // We will attach it to the class representative, since then we know how to backtrack it
   TriggerId t2TriggerId = d_nodeTriggers[t2classId];
 
@@ -1917,8 +2044,8 @@ void EqualityEngine::propagate() {
     d_propagationQueue.pop_front();
 
     // Get the representatives
-    EqualityNodeId t1classId = getEqualityNode(current.d_t1Id).getFind();
-    EqualityNodeId t2classId = getEqualityNode(current.d_t2Id).getFind();
+    EqualityNodeId t1classId = getFind(current.d_t1Id);
+    EqualityNodeId t2classId = getFind(current.d_t2Id);
 
     // If already the same, we're done
     if (t1classId == t2classId) {
@@ -1932,8 +2059,8 @@ void EqualityEngine::propagate() {
     EqualityNode& node1 = getEqualityNode(t1classId);
     EqualityNode& node2 = getEqualityNode(t2classId);
 
-    Assert(node1.getFind() == t1classId);
-    Assert(node2.getFind() == t2classId);
+    Assert(getFind(t1classId) == t1classId);
+    Assert(getFind(t2classId) == t2classId);
 
     // Add the actual equality to the equality graph
     addGraphEdge(
@@ -1987,7 +2114,7 @@ void EqualityEngine::propagate() {
                         << d_nodes[current.d_t2Id] << std::endl;
       d_assertedEqualities.push_back(Equality(t2classId, t1classId));
       d_assertedEqualitiesCount = d_assertedEqualitiesCount + 1;
-      if (!merge(node2, node1, triggers)) {
+      if (!merge(t2classId, t1classId, triggers)) {
         d_done = true;
       }
     } else {
@@ -1996,7 +2123,7 @@ void EqualityEngine::propagate() {
                         << d_nodes[current.d_t1Id] << std::endl;
       d_assertedEqualities.push_back(Equality(t1classId, t2classId));
       d_assertedEqualitiesCount = d_assertedEqualitiesCount + 1;
-    if (!merge(node1, node2, triggers)) {
+    if (!merge(t1classId, t2classId, triggers)) {
         d_done = true;
       }
     }
@@ -2068,7 +2195,7 @@ void EqualityEngine::debugPrintGraph() const
   for (EqualityNodeId nodeId = 0; nodeId < d_nodes.size(); ++nodeId)
   {
     Trace("equality::internal") << d_nodes[nodeId] << " " << nodeId << "("
-                                << getEqualityNode(nodeId).getFind() << "):";
+                                << getFind(nodeId) << "):";
 
     EqualityEdgeId edgeId = d_equalityGraph[nodeId];
     while (edgeId != null_edge)
@@ -2114,7 +2241,7 @@ bool EqualityEngine::areEqual(TNode t1, TNode t2) const {
   Assert(hasTerm(t1));
   Assert(hasTerm(t2));
 
-  bool result = getEqualityNode(t1).getFind() == getEqualityNode(t2).getFind();
+  bool result = getFind(t1) == getFind(t2);
   Trace("equality") << (result ? "\t(YES)" : "\t(NO)") << std::endl;
   return result;
 }
@@ -2138,8 +2265,8 @@ bool EqualityEngine::areDisequal(TNode t1, TNode t2, bool ensureProof) const
   }
 
   // Get equivalence classes
-  EqualityNodeId t1ClassId = getEqualityNode(t1Id).getFind();
-  EqualityNodeId t2ClassId = getEqualityNode(t2Id).getFind();
+  EqualityNodeId t1ClassId = getFind(t1Id);
+  EqualityNodeId t2ClassId = getFind(t2Id);
 
   // We are semantically const, for remembering stuff
   EqualityEngine* nonConst = const_cast<EqualityEngine*>(this);
@@ -2157,15 +2284,16 @@ bool EqualityEngine::areDisequal(TNode t1, TNode t2, bool ensureProof) const
 
   // Create the equality
   FunctionApplication eqNormalized(APP_EQUALITY, t1ClassId, t2ClassId);
-  ApplicationIdsMap::const_iterator find = d_applicationLookup.find(eqNormalized);
-  if (find != d_applicationLookup.end()) {
-    if (getEqualityNode(find->second).getFind() == getEqualityNode(d_falseId).getFind()) {
+  EqualityNodeId lookupId = d_applicationLookup.find(eqNormalized);
+  if (lookupId != null_id)
+  {
+    if (getFind(lookupId) == getFind(d_falseId)) {
       if (ensureProof) {
         const FunctionApplication original =
-            d_applications[find->second].d_original;
+            d_applications[lookupId].d_original;
         nonConst->d_deducedDisequalityReasons.push_back(
             EqualityPair(t1Id, original.d_a));
-        nonConst->d_deducedDisequalityReasons.push_back(EqualityPair(find->second, d_falseId));
+        nonConst->d_deducedDisequalityReasons.push_back(EqualityPair(lookupId, d_falseId));
         nonConst->d_deducedDisequalityReasons.push_back(
             EqualityPair(t2Id, original.d_b));
         nonConst->storePropagatedDisequality(THEORY_LAST, t1Id, t2Id);
@@ -2177,15 +2305,16 @@ bool EqualityEngine::areDisequal(TNode t1, TNode t2, bool ensureProof) const
 
   // Check the symmetric disequality
   std::swap(eqNormalized.d_a, eqNormalized.d_b);
-  find = d_applicationLookup.find(eqNormalized);
-  if (find != d_applicationLookup.end()) {
-    if (getEqualityNode(find->second).getFind() == getEqualityNode(d_falseId).getFind()) {
+  lookupId = d_applicationLookup.find(eqNormalized);
+  if (lookupId != null_id)
+  {
+    if (getFind(lookupId) == getFind(d_falseId)) {
       if (ensureProof) {
         const FunctionApplication original =
-            d_applications[find->second].d_original;
+            d_applications[lookupId].d_original;
         nonConst->d_deducedDisequalityReasons.push_back(
             EqualityPair(t2Id, original.d_a));
-        nonConst->d_deducedDisequalityReasons.push_back(EqualityPair(find->second, d_falseId));
+        nonConst->d_deducedDisequalityReasons.push_back(EqualityPair(lookupId, d_falseId));
         nonConst->d_deducedDisequalityReasons.push_back(
             EqualityPair(t1Id, original.d_b));
         nonConst->storePropagatedDisequality(THEORY_LAST, t1Id, t2Id);
@@ -2203,7 +2332,7 @@ bool EqualityEngine::areDisequal(TNode t1, TNode t2, bool ensureProof) const
 size_t EqualityEngine::getSize(TNode t) {
   // Add the term
   addTermInternal(t);
-  return getEqualityNode(getEqualityNode(t).getFind()).getSize();
+  return getEqualityNode(getFind(t)).getSize();
 }
 
 std::string EqualityEngine::identify() const { return d_name; }
@@ -2229,8 +2358,7 @@ void EqualityEngine::addTriggerTerm(TNode t, TheoryId tag)
 
   // Get the node id
   EqualityNodeId eqNodeId = getNodeId(t);
-  EqualityNode& eqNode = getEqualityNode(eqNodeId);
-  EqualityNodeId classId = eqNode.getFind();
+  EqualityNodeId classId = getFind(eqNodeId);
 
   // Possibly existing set of triggers
   TriggerTermSetRef triggerSetRef = d_nodeIndividualTrigger[classId];
@@ -2301,7 +2429,7 @@ void EqualityEngine::addTriggerTerm(TNode t, TheoryId tag)
 
 bool EqualityEngine::isTriggerTerm(TNode t, TheoryId tag) const {
   if (!hasTerm(t)) return false;
-  EqualityNodeId classId = getEqualityNode(t).getFind();
+  EqualityNodeId classId = getFind(t);
   TriggerTermSetRef triggerSetRef = d_nodeIndividualTrigger[classId];
   return triggerSetRef != +null_set_id && getTriggerTermSet(triggerSetRef).hasTrigger(tag);
 }
@@ -2309,7 +2437,7 @@ bool EqualityEngine::isTriggerTerm(TNode t, TheoryId tag) const {
 
 TNode EqualityEngine::getTriggerTermRepresentative(TNode t, TheoryId tag) const {
   Assert(isTriggerTerm(t, tag));
-  EqualityNodeId classId = getEqualityNode(t).getFind();
+  EqualityNodeId classId = getFind(t);
   const TriggerTermSet& triggerSet = getTriggerTermSet(d_nodeIndividualTrigger[classId]);
   unsigned i = 0;
   TheoryIdSet tags = triggerSet.d_tags;
@@ -2321,8 +2449,7 @@ TNode EqualityEngine::getTriggerTermRepresentative(TNode t, TheoryId tag) const
 }
 
 void EqualityEngine::storeApplicationLookup(FunctionApplication& funNormalized, EqualityNodeId funId) {
-  Assert(d_applicationLookup.find(funNormalized) == d_applicationLookup.end());
-  d_applicationLookup[funNormalized] = funId;
+  d_applicationLookup.insert(funNormalized, funId);
   d_applicationLookups.push_back(funNormalized);
   d_applicationLookupsCount = d_applicationLookupsCount + 1;
   Trace("equality::backtrack") << "d_applicationLookupsCount = " << d_applicationLookupsCount << std::endl;
@@ -2432,8 +2559,8 @@ void EqualityEngine::storePropagatedDisequality(TheoryId tag, EqualityNodeId lhs
     for (unsigned i = ref.d_mergesStart; i < ref.d_mergesEnd; ++i)
     {
       Assert(
-          getEqualityNode(d_deducedDisequalityReasons[i].first).getFind()
-          == getEqualityNode(d_deducedDisequalityReasons[i].second).getFind());
+          getFind(d_deducedDisequalityReasons[i].first)
+          == getFind(d_deducedDisequalityReasons[i].second));
     }
 #endif
     if (TraceIsOn("equality::disequality")) {
@@ -2499,7 +2626,7 @@ void EqualityEngine::getDisequalities(bool allowConstants,
       const FunctionApplication& fun =
           d_applications[useListNode.getApplicationId()].d_original;
       // If it's an equality asserted to false, we do the work
-      if (fun.isEquality() && getEqualityNode(funId).getFind() == getEqualityNode(d_false).getFind()) {
+      if (fun.isEquality() && getFind(funId) == getFind(d_false)) {
         // Get the other equality member
         bool lhs = false;
         EqualityNodeId toCompare = fun.d_b;
@@ -2508,7 +2635,7 @@ void EqualityEngine::getDisequalities(bool allowConstants,
           lhs = true;
         }
         // Representative of the other member
-        EqualityNodeId toCompareRep = getEqualityNode(toCompare).getFind();
+        EqualityNodeId toCompareRep = getFind(toCompare);
         if (toCompareRep == classId) {
           // We're in conflict, so we will send it out from merge
           out.clear();
@@ -2573,7 +2700,7 @@ bool EqualityEngine::propagateTriggerTermDisequalities(
     // Figure out who we are comparing to in the original equality
     EqualityNodeId toCompare = disequalityInfo.d_lhs ? fun.d_a : fun.d_b;
     EqualityNodeId myCompare = disequalityInfo.d_lhs ? fun.d_b : fun.d_a;
-    if (getEqualityNode(toCompare).getFind() == getEqualityNode(myCompare).getFind()) {
+    if (getFind(toCompare) == getFind(myCompare)) {
       // We're propagating a != a, which means we're inconsistent, just bail and let it go into
       // a regular conflict
       return !d_done;
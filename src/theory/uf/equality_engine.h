@@ -22,6 +22,7 @@
 #define CVC5__THEORY__UF__EQUALITY_ENGINE_H
 
 #include <deque>
+#include <memory>
 #include <queue>
 #include <unordered_map>
 #include <vector>
@@ -32,6 +33,7 @@
 #include "expr/node.h"
 #include "smt/env_obj.h"
 #include "theory/theory_id.h"
+#include "theory/uf/equality_engine_id_table.h"
 #include "theory/uf/equality_engine_iterator.h"
 #include "theory/uf/equality_engine_notify.h"
 #include "theory/uf/equality_engine_types.h"
@@ -306,10 +308,11 @@ class EqualityEngine : public context::ContextNotifyObj, protected EnvObj
   KindMap d_congruenceKindsExtOperators;
 
   /** Map from nodes to their ids */
-  std::unordered_map<TNode, EqualityNodeId> d_nodeIds;
+  EqualityIdTable<TNode, std::hash<TNode>> d_nodeIds;
 
   /** Map from function applications to their ids */
-  typedef std::unordered_map<FunctionApplication, EqualityNodeId, FunctionApplicationHashFunction> ApplicationIdsMap;
+  typedef EqualityIdTable<FunctionApplication, FunctionApplicationHashFunction>
+      ApplicationIdsMap;
 
   /**
    * A map from a pair (a', b') to a function application f(a, b), where a' and b' are the current representatives
@@ -345,6 +348,13 @@ class EqualityEngine : public context::ContextNotifyObj, protected EnvObj
   /** Map from ids to the equality nodes */
   std::vector<EqualityNode> d_equalityNodes;
 
+  /**
+   * Map from ids to the ids of their representatives. These are kept apart
+   * from the equality nodes, since finding representatives is by far the
+   * most frequent operation, e.g., when normalizing function applications.
+   */
+  std::vector<EqualityNodeId> d_findIds;
+
   /** Number of asserted equalities we have so far */
   context::CDO<DefaultSizeType> d_assertedEqualitiesCount;
 
@@ -444,14 +454,26 @@ class EqualityEngine : public context::ContextNotifyObj, protected EnvObj
   /** Returns the id of the node */
   EqualityNodeId getNodeId(TNode node) const;
 
+  /** Returns the id of the representative of the given node */
+  EqualityNodeId getFind(EqualityNodeId nodeId) const
+  {
+    Assert(nodeId < d_findIds.size());
+    return d_findIds[nodeId];
+  }
+
+  /** Returns the id of the representative of the given node */
+  EqualityNodeId getFind(TNode node) const { return getFind(getNodeId(node)); }
+
   /**
-   * Merge the class2 into class1
+   * Merge the class2 into class1, where both are representatives
    * @return true if ok, false if to break out
    */
-  bool merge(EqualityNode& class1, EqualityNode& class2, std::vector<TriggerId>& triggers);
+  bool merge(EqualityNodeId class1Id,
+             EqualityNodeId class2Id,
+             std::vector<TriggerId>& triggers);
 
   /** Undo the merge of class2 into class1 */
-  void undoMerge(EqualityNode& class1, EqualityNode& class2, EqualityNodeId class2Id);
+  void undoMerge(EqualityNodeId class1Id, EqualityNodeId class2Id);
 
   /** Backtrack the information if necessary */
   void backtrack();
@@ -537,7 +559,7 @@ class EqualityEngine : public context::ContextNotifyObj, protected EnvObj
    * Returns true if it's a constant
    */
   bool isConstant(EqualityNodeId id) const {
-    return d_isConstant[getEqualityNode(id).getFind()];
+    return d_isConstant[getFind(id)];
   }
 
   /**
@@ -605,9 +627,13 @@ class EqualityEngine : public context::ContextNotifyObj, protected EnvObj
    * children such that it is a proof of t1 = t2.
    *
    * We cache results of this call in cache, where cache[t1Id][t2Id] stores
-   * a proof of t1 = t2.
+   * a proof of t1 = t2. Explanations are also memoized across calls in
+   * d_explanationMemo and d_proofExplanationMemo, see below.
+   *
+   * Returns the level of the explanation, i.e. one plus the index of the
+   * most recent asserted equality it depends on, or zero if t1Id = t2Id.
    */
-  void getExplanation(
+  size_t getExplanation(
       EqualityEdgeId t1Id,
       EqualityNodeId t2Id,
       std::vector<TNode>& equalities,
@@ -619,6 +645,63 @@ class EqualityEngine : public context::ContextNotifyObj, protected EnvObj
    */
   void debugPrintGraph() const;
 
+  /**
+   * A step of a memoized explanation, which is either an asserted reason or,
+   * if d_reason is null, the explanation of the equality of d_a and d_b.
+   */
+  struct ExplanationStep
+  {
+    ExplanationStep(TNode reason)
+        : d_reason(reason), d_a(null_id), d_b(null_id)
+    {
+    }
+    ExplanationStep(EqualityNodeId a, EqualityNodeId b) : d_a(a), d_b(b) {}
+    TNode d_reason;
+    EqualityNodeId d_a;
+    EqualityNodeId d_b;
+  };
+
+  /** A memoized explanation of an equality */
+  struct ExplanationMemoEntry
+  {
+    /** The steps, in the order in which getExplanation took them */
+    std::vector<ExplanationStep> d_steps;
+    /** The proof of the equality, if it was explained with proofs */
+    std::shared_ptr<EqProof> d_proof;
+    /** The level of the explanation, as returned by getExplanation */
+    size_t d_level;
+  };
+
+  typedef std::unordered_map<EqualityPair,
+                             ExplanationMemoEntry,
+                             EqualityPairHashFunction>
+      ExplanationMemo;
+
+  /**
+   * Explanations computed by getExplanation without proofs, keyed by the
+   * ordered pair of ids. The path between two nodes of the proof forest does
+   * not change as long as none of its edges is removed, hence an explanation
+   * remains valid until we backtrack below its level. This lets theories
+   * that request the same explanations many times, e.g. arrays and strings,
+   * skip the search of the equality graph. Sub-explanations are stored as
+   * steps rather than expanded, so that replaying an explanation produces
+   * the same assumptions as computing it again.
+   */
+  mutable ExplanationMemo d_explanationMemo;
+  /**
+   * Explanations computed by getExplanation with proofs. As with the cache
+   * of getExplanation, these are keyed by the pair of ids as given, since
+   * proofs are sensitive to the order of the ids.
+   */
+  mutable ExplanationMemo d_proofExplanationMemo;
+  /**
+   * The keys of the memoized explanations of each level minus one, with
+   * whether they are in d_proofExplanationMemo, for removing them on
+   * backtracking.
+   */
+  mutable std::vector<std::vector<std::pair<EqualityPair, bool>>>
+      d_explanationMemoLevels;
+
   /** The true node */
   Node d_true;
   /** True node id */
@@ -0,0 +1,176 @@
+/******************************************************************************
+ * Top contributors (to current version):
+ *   agent
+ *
+ * This file is part of the cvc5 project.
+ *
+ * Copyright (c) 2009-2023 by the authors listed in the file AUTHORS
+ * in the top-level source directory and their institutional affiliations.
+ * All rights reserved.  See the file COPYING in the top-level source
+ * directory for licensing information.
+ * ****************************************************************************
+ *
+ * Flat hash table from keys to equality node ids.
+ */
+
+#include "cvc5_private.h"
+
+#ifndef CVC5__THEORY__UF__EQUALITY_ENGINE_ID_TABLE_H
+#define CVC5__THEORY__UF__EQUALITY_ENGINE_ID_TABLE_H
+
+#include <cstdint>
+#include <vector>
+
+#include "base/check.h"
+#include "expr/node.h"
+#include "theory/uf/equality_engine_types.h"
+
+namespace cvc5::internal {
+namespace theory {
+namespace eq {
+
+/**
+ * A hash table from keys to equality node ids, used by the equality engine
+ * for looking up the ids of terms and of normalized function applications.
+ *
+ * The table uses open addressing with linear probing and stores the keys
+ * and ids inline in a single array, so that a lookup usually touches a
+ * single cache line. Slots are empty if their id is null_id. Erasing an
+ * entry shifts the following entries of its cluster back, hence the table
+ * has no tombstones and does not degrade when entries are erased and
+ * inserted again on backtracking.
+ *
+ * Key must be default constructible and cheap to copy, Hash computes a hash
+ * of a key, which is mixed further by the table.
+ */
+template <class Key, class Hash>
+class EqualityIdTable
+{
+ public:
+  EqualityIdTable() : d_size(0), d_shift(64 - s_initialLogCapacity)
+  {
+    d_entries.resize(size_t(1) << s_initialLogCapacity);
+  }
+
+  /** Get the id of k, or null_id if k is not in the table */
+  EqualityNodeId find(const Key& k) const
+  {
+    size_t mask = d_entries.size() - 1;
+    for (size_t i = slot(k);; i = (i + 1) & mask)
+    {
+      const Entry& e = d_entries[i];
+      if (e.d_id == null_id || e.d_key == k)
+      {
+        return e.d_id;
+      }
+    }
+  }
+
+  /** Does the table contain k? */
+  bool contains(const Key& k) const { return find(k) != null_id; }
+
+  /** Insert k with the given id, where k must not be in the table */
+  void insert(const Key& k, EqualityNodeId id)
+  {
+    Assert(id != null_id);
+    Assert(!contains(k));
+    // keep the load factor at most 1/2
+    if (2 * (d_size + 1) > d_entries.size())
+    {
+      grow();
+    }
+    insertInternal(k, id);
+    d_size++;
+  }
+
+  /** Erase k, which must be in the table */
+  void erase(const Key& k)
+  {
+    size_t mask = d_entries.size() - 1;
+    size_t i = slot(k);
+    while (!(d_entries[i].d_key == k))
+    {
+      Assert(d_entries[i].d_id != null_id);
+      i = (i + 1) & mask;
+    }
+    // shift back the entries after i whose home slot is not in (i, j]
+    for (size_t j = (i + 1) & mask; d_entries[j].d_id != null_id;
+         j = (j + 1) & mask)
+    {
+      size_t home = slot(d_entries[j].d_key);
+      if (((j - home) & mask) >= ((j - i) & mask))
+      {
+        d_entries[i] = d_entries[j];
+        i = j;
+      }
+    }
+    d_entries[i] = Entry();
+    d_size--;
+  }
+
+  /** The number of entries */
+  size_t size() const { return d_size; }
+
+ private:
+  /** The initial capacity is 2^s_initialLogCapacity */
+  static constexpr uint32_t s_initialLogCapacity = 6;
+
+  /** An entry of the table */
+  struct Entry
+  {
+    Entry() : d_key(), d_id(null_id) {}
+    Entry(const Key& k, EqualityNodeId id) : d_key(k), d_id(id) {}
+    Key d_key;
+    EqualityNodeId d_id;
+  };
+
+  /** The home slot of k, using Fibonacci hashing */
+  size_t slot(const Key& k) const
+  {
+    return static_cast<size_t>(
+        (static_cast<uint64_t>(d_hash(k)) * UINT64_C(0x9e3779b97f4a7c15))
+        >> d_shift);
+  }
+
+  /** Insert k in the first free slot of its cluster */
+  void insertInternal(const Key& k, EqualityNodeId id)
+  {
+    size_t mask = d_entries.size() - 1;
+    size_t i = slot(k);
+    while (d_entries[i].d_id != null_id)
+    {
+      i = (i + 1) & mask;
+    }
+    d_entries[i] = Entry(k, id);
+  }
+
+  /** Double the capacity and rehash all entries */
+  void grow()
+  {
+    std::vector<Entry> old(d_entries.size() * 2);
+    old.swap(d_entries);
+    d_shift--;
+    for (const Entry& e : old)
+    {
+      if (e.d_id != null_id)
+      {
+        insertInternal(e.d_key, e.d_id);
+      }
+    }
+  }
+
+  /** The slots, whose number is a power of two */
+  std::vector<Entry> d_entries;
+  /** The number of entries */
+  size_t d_size;
+  /** 64 minus the logarithm of the capacity */
+  uint32_t d_shift;
+  /** The hash function */
+  Hash d_hash;
+};
+
+}  // namespace eq
+}  // namespace theory
+}  // namespace cvc5::internal
+
+#endif /* CVC5__THEORY__UF__EQUALITY_ENGINE_ID_TABLE_H */
@@ -173,6 +173,8 @@ public:
  * function applications it appears in and the list of asserted
  * disequalities it belongs to. In order to get these lists one must
  * traverse the entire class and pick up all the individual lists.
+ * The representatives of the nodes are stored separately by the equality
+ * engine.
  */
 class EqualityNode {
 
@@ -181,9 +183,6 @@ private:
   /** The size of this equivalence class (if it's a representative) */
   DefaultSizeType d_size;
 
-  /** The id (in the eq-manager) of the representative equality node */
-  EqualityNodeId d_findId;
-
   /** The next equality node in this class */
   EqualityNodeId d_nextId;
 
@@ -197,7 +196,6 @@ public:
    */
   EqualityNode(EqualityNodeId nodeId = null_id)
   : d_size(1)
-  , d_findId(nodeId)
   , d_nextId(nodeId)
   , d_useList(null_uselist_id)
   {}
@@ -237,16 +235,6 @@ public:
     }
   }
 
-  /**
-   * Returns the class representative.
-   */
-  EqualityNodeId getFind() const { return d_findId; }
-
-  /**
-   * Set the class representative.
-   */
-  void setFind(EqualityNodeId findId) { d_findId = findId; }
-
   /**
    * Note that this node is used in a function application funId, or
    * a negatively asserted equality (dis-equality) with funId.
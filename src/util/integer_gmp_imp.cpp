@@ -15,11 +15,13 @@
 
 #include <cmath>
 #include <limits>
+#include <numeric>
 #include <sstream>
 #include <string>
 
 #include "base/check.h"
 #include "base/cvc5config.h"
+#include "util/gmp_util.h"
 #include "util/integer.h"
 #include "util/rational.h"
 
@@ -31,152 +33,281 @@ using namespace std;
 
 namespace cvc5::internal {
 
-Integer::Integer(const char* s, unsigned base)
-  : d_value(s, base)
-{}
+namespace {
 
-Integer::Integer(const std::string& s, unsigned base)
-  : d_value(s, base)
-{}
+/** Returns the absolute value of the inline value v as an unsigned long. */
+unsigned long absUnsigned(signed long int v)
+{
+  return v < 0 ? static_cast<unsigned long>(-v) : static_cast<unsigned long>(v);
+}
+
+}  // namespace
+
+Integer::Integer(const char* s, unsigned base) : d_small(0)
+{
+  setMpz(mpz_class(s, base));
+}
+
+Integer::Integer(const std::string& s, unsigned base) : d_small(0)
+{
+  setMpz(mpz_class(s, base));
+}
 
 #ifdef CVC5_NEED_INT64_T_OVERLOADS
-Integer::Integer(int64_t z)
+Integer::Integer(int64_t z) : d_small(0)
 {
   if (std::numeric_limits<signed long int>::min() <= z
       && z <= std::numeric_limits<signed long int>::max())
   {
-    d_value = static_cast<signed long int>(z);
+    setSignedLong(static_cast<signed long int>(z));
   }
   else
   {
-    d_value = std::to_string(z);
+    setMpz(mpz_class(std::to_string(z)));
   }
 }
-Integer::Integer(uint64_t z)
+Integer::Integer(uint64_t z) : d_small(0)
 {
   if (std::numeric_limits<unsigned long int>::min() <= z
       && z <= std::numeric_limits<unsigned long int>::max())
   {
-    d_value = static_cast<unsigned long int>(z);
+    setUnsignedLong(static_cast<unsigned long int>(z));
   }
   else
   {
-    d_value = std::to_string(z);
+    setMpz(mpz_class(std::to_string(z)));
   }
 }
 #endif /* CVC5_NEED_INT64_T_OVERLOADS */
 
+void Integer::setMpz(const mpz_class& val)
+{
+  if (mpz_fits_slong_p(val.get_mpz_t()) != 0)
+  {
+    signed long int z = val.get_si();
+    if (z >= s_minSmall)
+    {
+      d_small = z;
+      d_big.reset();
+      return;
+    }
+  }
+  if (d_big == nullptr)
+  {
+    d_big = std::make_unique<mpz_class>(val);
+  }
+  else
+  {
+    *d_big = val;
+  }
+}
+
+mpz_class Integer::getValue() const
+{
+  mpz_class tmp;
+  return get_mpz(tmp);
+}
+
 Integer& Integer::operator=(const Integer& x)
 {
   if (this == &x) return *this;
-  d_value = x.d_value;
+  if (x.isSmall())
+  {
+    d_small = x.d_small;
+    d_big.reset();
+  }
+  else
+  {
+    setMpz(*x.d_big);
+  }
   return *this;
 }
 
 bool Integer::operator==(const Integer& y) const
 {
-  return d_value == y.d_value;
+  if (isSmall() || y.isSmall())
+  {
+    // the representation is unique, hence mixed values are distinct
+    return isSmall() && y.isSmall() && d_small == y.d_small;
+  }
+  return *d_big == *y.d_big;
 }
 
-Integer Integer::operator-() const { return Integer(-(d_value)); }
-
-bool Integer::operator!=(const Integer& y) const
+Integer Integer::operator-() const
 {
-  return d_value != y.d_value;
+  if (isSmall())
+  {
+    return Integer(-d_small);
+  }
+  return Integer(-(*d_big));
 }
 
-bool Integer::operator<(const Integer& y) const { return d_value < y.d_value; }
+bool Integer::operator!=(const Integer& y) const { return !(*this == y); }
 
-bool Integer::operator<=(const Integer& y) const
+bool Integer::operator<(const Integer& y) const
 {
-  return d_value <= y.d_value;
+  if (isSmall() && y.isSmall())
+  {
+    return d_small < y.d_small;
+  }
+  mpz_class tx, ty;
+  return get_mpz(tx) < y.get_mpz(ty);
 }
 
-bool Integer::operator>(const Integer& y) const { return d_value > y.d_value; }
+bool Integer::operator<=(const Integer& y) const { return !(y < *this); }
 
-bool Integer::operator>=(const Integer& y) const
-{
-  return d_value >= y.d_value;
-}
+bool Integer::operator>(const Integer& y) const { return y < *this; }
+
+bool Integer::operator>=(const Integer& y) const { return !(*this < y); }
 
 Integer Integer::operator+(const Integer& y) const
 {
-  return Integer(d_value + y.d_value);
+  Integer res(*this);
+  res += y;
+  return res;
 }
 
 Integer& Integer::operator+=(const Integer& y)
 {
-  d_value += y.d_value;
+  signed long int res;
+  if (isSmall() && y.isSmall()
+      && !__builtin_add_overflow(d_small, y.d_small, &res))
+  {
+    setSignedLong(res);
+    return *this;
+  }
+  mpz_class tx, ty;
+  setMpz(get_mpz(tx) + y.get_mpz(ty));
   return *this;
 }
 
 Integer Integer::operator-(const Integer& y) const
 {
-  return Integer(d_value - y.d_value);
+  Integer res(*this);
+  res -= y;
+  return res;
 }
 
 Integer& Integer::operator-=(const Integer& y)
 {
-  d_value -= y.d_value;
+  signed long int res;
+  if (isSmall() && y.isSmall()
+      && !__builtin_sub_overflow(d_small, y.d_small, &res))
+  {
+    setSignedLong(res);
+    return *this;
+  }
+  mpz_class tx, ty;
+  setMpz(get_mpz(tx) - y.get_mpz(ty));
   return *this;
 }
 
 Integer Integer::operator*(const Integer& y) const
 {
-  return Integer(d_value * y.d_value);
+  Integer res(*this);
+  res *= y;
+  return res;
 }
 
 Integer& Integer::operator*=(const Integer& y)
 {
-  d_value *= y.d_value;
+  signed long int res;
+  if (isSmall() && y.isSmall()
+      && !__builtin_mul_overflow(d_small, y.d_small, &res))
+  {
+    setSignedLong(res);
+    return *this;
+  }
+  mpz_class tx, ty;
+  setMpz(get_mpz(tx) * y.get_mpz(ty));
   return *this;
 }
 
 Integer Integer::bitwiseOr(const Integer& y) const
 {
-  mpz_class result;
-  mpz_ior(result.get_mpz_t(), d_value.get_mpz_t(), y.d_value.get_mpz_t());
+  // GMP uses two's complement semantics for bit-wise operations, hence we
+  // can use machine operations on inline values
+  if (isSmall() && y.isSmall())
+  {
+    return Integer(d_small | y.d_small);
+  }
+  mpz_class result, tx, ty;
+  mpz_ior(result.get_mpz_t(),
+          get_mpz(tx).get_mpz_t(),
+          y.get_mpz(ty).get_mpz_t());
   return Integer(result);
 }
 
 Integer Integer::bitwiseAnd(const Integer& y) const
 {
-  mpz_class result;
-  mpz_and(result.get_mpz_t(), d_value.get_mpz_t(), y.d_value.get_mpz_t());
+  if (isSmall() && y.isSmall())
+  {
+    return Integer(d_small & y.d_small);
+  }
+  mpz_class result, tx, ty;
+  mpz_and(result.get_mpz_t(),
+          get_mpz(tx).get_mpz_t(),
+          y.get_mpz(ty).get_mpz_t());
   return Integer(result);
 }
 
 Integer Integer::bitwiseXor(const Integer& y) const
 {
-  mpz_class result;
-  mpz_xor(result.get_mpz_t(), d_value.get_mpz_t(), y.d_value.get_mpz_t());
+  if (isSmall() && y.isSmall())
+  {
+    return Integer(d_small ^ y.d_small);
+  }
+  mpz_class result, tx, ty;
+  mpz_xor(result.get_mpz_t(),
+          get_mpz(tx).get_mpz_t(),
+          y.get_mpz(ty).get_mpz_t());
   return Integer(result);
 }
 
 Integer Integer::bitwiseNot() const
 {
+  if (isSmall())
+  {
+    return Integer(~d_small);
+  }
   mpz_class result;
-  mpz_com(result.get_mpz_t(), d_value.get_mpz_t());
+  mpz_com(result.get_mpz_t(), d_big->get_mpz_t());
   return Integer(result);
 }
 
 Integer Integer::multiplyByPow2(uint32_t pow) const
 {
-  mpz_class result;
-  mpz_mul_2exp(result.get_mpz_t(), d_value.get_mpz_t(), pow);
+  if (isSmall()
+      && pow < static_cast<uint32_t>(std::numeric_limits<signed long>::digits)
+      && absUnsigned(d_small) <= (static_cast<unsigned long>(s_maxSmall) >> pow))
+  {
+    return Integer(d_small * (1L << pow));
+  }
+  mpz_class result, tmp;
+  mpz_mul_2exp(result.get_mpz_t(), get_mpz(tmp).get_mpz_t(), pow);
   return Integer(result);
 }
 
 void Integer::setBit(uint32_t i, bool value)
 {
+  if (isSmall()
+      && i + 1 < static_cast<uint32_t>(std::numeric_limits<unsigned long>::digits))
+  {
+    signed long int mask = 1L << i;
+    setSignedLong(value ? (d_small | mask) : (d_small & ~mask));
+    return;
+  }
+  mpz_class tmp;
+  mpz_class val = get_mpz(tmp);
   if (value)
   {
-    mpz_setbit(d_value.get_mpz_t(), i);
+    mpz_setbit(val.get_mpz_t(), i);
   }
   else
   {
-    mpz_clrbit(d_value.get_mpz_t(), i);
+    mpz_clrbit(val.get_mpz_t(), i);
   }
+  setMpz(val);
 }
 
 bool Integer::isBitSet(uint32_t i) const
@@ -188,7 +319,8 @@ Integer Integer::oneExtend(uint32_t size, uint32_t amount) const
 {
   // check that the size is accurate
   Assert((*this) < Integer(1).multiplyByPow2(size));
-  mpz_class res = d_value;
+  mpz_class tmp;
+  mpz_class res = get_mpz(tmp);
 
   for (unsigned i = size; i < size + amount; ++i)
   {
@@ -200,16 +332,24 @@ Integer Integer::oneExtend(uint32_t size, uint32_t amount) const
 
 uint32_t Integer::toUnsignedInt() const
 {
-  return mpz_get_ui(d_value.get_mpz_t());
+  if (isSmall())
+  {
+    return static_cast<uint32_t>(absUnsigned(d_small));
+  }
+  return mpz_get_ui(d_big->get_mpz_t());
 }
 
 Integer Integer::extractBitRange(uint32_t bitCount, uint32_t low) const
 {
   // bitCount = high-low+1
   uint32_t high = low + bitCount - 1;
+  if (isSmall())
+  {
+    return modByPow2(high + 1).divByPow2(low);
+  }
   //- Function: void mpz_fdiv_r_2exp (mpz_t r, mpz_t n, mp_bitcnt_t b)
   mpz_class rem, div;
-  mpz_fdiv_r_2exp(rem.get_mpz_t(), d_value.get_mpz_t(), high + 1);
+  mpz_fdiv_r_2exp(rem.get_mpz_t(), d_big->get_mpz_t(), high + 1);
   mpz_fdiv_q_2exp(div.get_mpz_t(), rem.get_mpz_t(), low);
 
   return Integer(div);
@@ -217,16 +357,16 @@ Integer Integer::extractBitRange(uint32_t bitCount, uint32_t low) const
 
 Integer Integer::floorDivideQuotient(const Integer& y) const
 {
-  mpz_class q;
-  mpz_fdiv_q(q.get_mpz_t(), d_value.get_mpz_t(), y.d_value.get_mpz_t());
-  return Integer(q);
+  Integer q, r;
+  floorQR(q, r, *this, y);
+  return q;
 }
 
 Integer Integer::floorDivideRemainder(const Integer& y) const
 {
-  mpz_class r;
-  mpz_fdiv_r(r.get_mpz_t(), d_value.get_mpz_t(), y.d_value.get_mpz_t());
-  return Integer(r);
+  Integer q, r;
+  floorQR(q, r, *this, y);
+  return r;
 }
 
 void Integer::floorQR(Integer& q,
@@ -234,23 +374,59 @@ void Integer::floorQR(Integer& q,
                       const Integer& x,
                       const Integer& y)
 {
-  mpz_fdiv_qr(q.d_value.get_mpz_t(),
-              r.d_value.get_mpz_t(),
-              x.d_value.get_mpz_t(),
-              y.d_value.get_mpz_t());
+  if (x.isSmall() && y.isSmall() && y.d_small != 0)
+  {
+    // neither can overflow, since the minimal long is not stored inline
+    signed long int qs = x.d_small / y.d_small;
+    signed long int rs = x.d_small % y.d_small;
+    if (rs != 0 && ((rs < 0) != (y.d_small < 0)))
+    {
+      qs -= 1;
+      rs += y.d_small;
+    }
+    q.setSignedLong(qs);
+    r.setSignedLong(rs);
+    return;
+  }
+  mpz_class qv, rv, tx, ty;
+  mpz_fdiv_qr(qv.get_mpz_t(),
+              rv.get_mpz_t(),
+              x.get_mpz(tx).get_mpz_t(),
+              y.get_mpz(ty).get_mpz_t());
+  q.setMpz(qv);
+  r.setMpz(rv);
 }
 
 Integer Integer::ceilingDivideQuotient(const Integer& y) const
 {
-  mpz_class q;
-  mpz_cdiv_q(q.get_mpz_t(), d_value.get_mpz_t(), y.d_value.get_mpz_t());
+  if (isSmall() && y.isSmall() && y.d_small != 0)
+  {
+    signed long int qs = d_small / y.d_small;
+    signed long int rs = d_small % y.d_small;
+    if (rs != 0 && ((rs > 0) == (y.d_small > 0)))
+    {
+      qs += 1;
+    }
+    return Integer(qs);
+  }
+  mpz_class q, tx, ty;
+  mpz_cdiv_q(q.get_mpz_t(), get_mpz(tx).get_mpz_t(), y.get_mpz(ty).get_mpz_t());
   return Integer(q);
 }
 
 Integer Integer::ceilingDivideRemainder(const Integer& y) const
 {
-  mpz_class r;
-  mpz_cdiv_r(r.get_mpz_t(), d_value.get_mpz_t(), y.d_value.get_mpz_t());
+  if (isSmall() && y.isSmall() && y.d_small != 0)
+  {
+    signed long int rs = d_small % y.d_small;
+    if (rs != 0 && ((rs > 0) == (y.d_small > 0)))
+    {
+      rs -= y.d_small;
+    }
+    return Integer(rs);
+  }
+  mpz_class r, tx, ty;
+  mpz_cdiv_r(r.get_mpz_t(), get_mpz(tx).get_mpz_t(), y.get_mpz(ty).get_mpz_t());
   return Integer(r);
 }
 
@@ -305,82 +481,149 @@ Integer Integer::euclidianDivideRemainder(const Integer& y) const
 Integer Integer::exactQuotient(const Integer& y) const
 {
   Assert(y.divides(*this));
-  mpz_class q;
-  mpz_divexact(q.get_mpz_t(), d_value.get_mpz_t(), y.d_value.get_mpz_t());
+  if (isSmall() && y.isSmall())
+  {
+    return Integer(d_small / y.d_small);
+  }
+  mpz_class q, tx, ty;
+  mpz_divexact(
+      q.get_mpz_t(), get_mpz(tx).get_mpz_t(), y.get_mpz(ty).get_mpz_t());
   return Integer(q);
 }
 
 Integer Integer::modByPow2(uint32_t exp) const
 {
-  mpz_class res;
-  mpz_fdiv_r_2exp(res.get_mpz_t(), d_value.get_mpz_t(), exp);
+  if (isSmall()
+      && exp < static_cast<uint32_t>(std::numeric_limits<signed long>::digits))
+  {
+    // in two's complement, masking computes the floor remainder
+    return Integer(d_small & ((1L << exp) - 1));
+  }
+  mpz_class res, tmp;
+  mpz_fdiv_r_2exp(res.get_mpz_t(), get_mpz(tmp).get_mpz_t(), exp);
   return Integer(res);
 }
 
 Integer Integer::divByPow2(uint32_t exp) const
 {
+  if (isSmall())
+  {
+    // the arithmetic right shift computes the floor quotient
+    if (exp < static_cast<uint32_t>(std::numeric_limits<signed long>::digits))
+    {
+      return Integer(d_small >> exp);
+    }
+    return Integer(d_small < 0 ? -1 : 0);
+  }
   mpz_class res;
-  mpz_fdiv_q_2exp(res.get_mpz_t(), d_value.get_mpz_t(), exp);
+  mpz_fdiv_q_2exp(res.get_mpz_t(), d_big->get_mpz_t(), exp);
   return Integer(res);
 }
 
-int Integer::sgn() const { return mpz_sgn(d_value.get_mpz_t()); }
+int Integer::sgn() const
+{
+  if (isSmall())
+  {
+    return d_small < 0 ? -1 : (d_small > 0 ? 1 : 0);
+  }
+  return mpz_sgn(d_big->get_mpz_t());
+}
 
 bool Integer::strictlyPositive() const { return sgn() > 0; }
 
 bool Integer::strictlyNegative() const { return sgn() < 0; }
 
-bool Integer::isZero() const { return sgn() == 0; }
+bool Integer::isZero() const { return isSmall() && d_small == 0; }
 
-bool Integer::isOne() const { return mpz_cmp_si(d_value.get_mpz_t(), 1) == 0; }
+bool Integer::isOne() const { return isSmall() && d_small == 1; }
 
-bool Integer::isNegativeOne() const
-{
-  return mpz_cmp_si(d_value.get_mpz_t(), -1) == 0;
-}
+bool Integer::isNegativeOne() const { return isSmall() && d_small == -1; }
 
 Integer Integer::pow(uint32_t exp) const
 {
-  mpz_class result;
-  mpz_pow_ui(result.get_mpz_t(), d_value.get_mpz_t(), exp);
+  if (isSmall())
+  {
+    // square and multiply, giving up on the first overflow
+    signed long int res = 1;
+    signed long int base = d_small;
+    uint32_t e = exp;
+    bool overflow = false;
+    while (e > 0 && !overflow)
+    {
+      if ((e & 1) != 0)
+      {
+        overflow = __builtin_mul_overflow(res, base, &res);
+      }
+      e >>= 1;
+      if (e > 0 && !overflow)
+      {
+        overflow = __builtin_mul_overflow(base, base, &base);
+      }
+    }
+    if (!overflow)
+    {
+      return Integer(res);
+    }
+  }
+  mpz_class result, tmp;
+  mpz_pow_ui(result.get_mpz_t(), get_mpz(tmp).get_mpz_t(), exp);
   return Integer(result);
 }
 
 Integer Integer::gcd(const Integer& y) const
 {
-  mpz_class result;
-  mpz_gcd(result.get_mpz_t(), d_value.get_mpz_t(), y.d_value.get_mpz_t());
+  if (isSmall() && y.isSmall())
+  {
+    return Integer(std::gcd(d_small, y.d_small));
+  }
+  mpz_class result, tx, ty;
+  mpz_gcd(result.get_mpz_t(), get_mpz(tx).get_mpz_t(), y.get_mpz(ty).get_mpz_t());
   return Integer(result);
 }
 
 Integer Integer::lcm(const Integer& y) const
 {
-  mpz_class result;
-  mpz_lcm(result.get_mpz_t(), d_value.get_mpz_t(), y.d_value.get_mpz_t());
+  if (isSmall() && y.isSmall())
+  {
+    if (d_small == 0 || y.d_small == 0)
+    {
+      return Integer(0);
+    }
+    signed long int res;
+    signed long int a = d_small < 0 ? -d_small : d_small;
+    signed long int b = y.d_small < 0 ? -y.d_small : y.d_small;
+    if (!__builtin_mul_overflow(a / std::gcd(a, b), b, &res))
+    {
+      return Integer(res);
+    }
+  }
+  mpz_class result, tx, ty;
+  mpz_lcm(result.get_mpz_t(), get_mpz(tx).get_mpz_t(), y.get_mpz(ty).get_mpz_t());
   return Integer(result);
 }
 
 Integer Integer::modAdd(const Integer& y, const Integer& m) const
 {
-  mpz_class res;
-  mpz_add(res.get_mpz_t(), d_value.get_mpz_t(), y.d_value.get_mpz_t());
-  mpz_mod(res.get_mpz_t(), res.get_mpz_t(), m.d_value.get_mpz_t());
+  mpz_class res, tx, ty, tm;
+  mpz_add(res.get_mpz_t(), get_mpz(tx).get_mpz_t(), y.get_mpz(ty).get_mpz_t());
+  mpz_mod(res.get_mpz_t(), res.get_mpz_t(), m.get_mpz(tm).get_mpz_t());
   return Integer(res);
 }
 
 Integer Integer::modMultiply(const Integer& y, const Integer& m) const
 {
-  mpz_class res;
-  mpz_mul(res.get_mpz_t(), d_value.get_mpz_t(), y.d_value.get_mpz_t());
-  mpz_mod(res.get_mpz_t(), res.get_mpz_t(), m.d_value.get_mpz_t());
+  mpz_class res, tx, ty, tm;
+  mpz_mul(res.get_mpz_t(), get_mpz(tx).get_mpz_t(), y.get_mpz(ty).get_mpz_t());
+  mpz_mod(res.get_mpz_t(), res.get_mpz_t(), m.get_mpz(tm).get_mpz_t());
   return Integer(res);
 }
 
 Integer Integer::modInverse(const Integer& m) const
 {
   Assert(m > 0) << "m must be greater than zero";
-  mpz_class res;
-  if (mpz_invert(res.get_mpz_t(), d_value.get_mpz_t(), m.d_value.get_mpz_t())
+  mpz_class res, tx, tm;
+  if (mpz_invert(
+          res.get_mpz_t(), get_mpz(tx).get_mpz_t(), m.get_mpz(tm).get_mpz_t())
       == 0)
   {
     return Integer(-1);
@@ -390,54 +633,79 @@ Integer Integer::modInverse(const Integer& m) const
 
 bool Integer::divides(const Integer& y) const
 {
-  int res = mpz_divisible_p(y.d_value.get_mpz_t(), d_value.get_mpz_t());
+  if (isSmall() && y.isSmall())
+  {
+    // as in GMP, zero only divides zero
+    return d_small == 0 ? y.d_small == 0 : y.d_small % d_small == 0;
+  }
+  mpz_class tx, ty;
+  int res =
+      mpz_divisible_p(y.get_mpz(ty).get_mpz_t(), get_mpz(tx).get_mpz_t());
   return res != 0;
 }
 
-Integer Integer::abs() const { return d_value >= 0 ? *this : -*this; }
+Integer Integer::abs() const { return sgn() >= 0 ? *this : -*this; }
 
-std::string Integer::toString(int base) const { return d_value.get_str(base); }
+std::string Integer::toString(int base) const
+{
+  if (isSmall() && base == 10)
+  {
+    return std::to_string(d_small);
+  }
+  mpz_class tmp;
+  return get_mpz(tmp).get_str(base);
+}
 
-bool Integer::fitsSignedInt() const { return d_value.fits_sint_p(); }
+bool Integer::fitsSignedInt() const
+{
+  return isSmall() && d_small >= std::numeric_limits<int>::min()
+         && d_small <= std::numeric_limits<int>::max();
+}
 
-bool Integer::fitsUnsignedInt() const { return d_value.fits_uint_p(); }
+bool Integer::fitsUnsignedInt() const
+{
+  return isSmall() && d_small >= 0
+         && static_cast<unsigned long>(d_small)
+                <= std::numeric_limits<unsigned int>::max();
+}
 
 signed int Integer::getSignedInt() const
 {
   // ensure there isn't overflow
-  Assert(d_value <= std::numeric_limits<int>::max())
-      << "Overflow detected in Integer::getSignedInt().";
-  Assert(d_value >= std::numeric_limits<int>::min())
-      << "Overflow detected in Integer::getSignedInt().";
   Assert(fitsSignedInt()) << "Overflow detected in Integer::getSignedInt().";
-  return (signed int)d_value.get_si();
+  return static_cast<signed int>(d_small);
 }
 
 unsigned int Integer::getUnsignedInt() const
 {
   // ensure there isn't overflow
-  Assert(d_value <= std::numeric_limits<unsigned int>::max())
-      << "Overflow detected in Integer::getUnsignedInt()";
-  Assert(d_value >= std::numeric_limits<unsigned int>::min())
-      << "Overflow detected in Integer::getUnsignedInt()";
   Assert(fitsUnsignedInt()) << "Overflow detected in Integer::getUnsignedInt()";
-  return (unsigned int)d_value.get_ui();
+  return static_cast<unsigned int>(d_small);
 }
 
 long Integer::getLong() const
 {
-  // ensure there it fits
-  Assert(mpz_fits_slong_p(d_value.get_mpz_t()) != 0)
+  if (isSmall())
+  {
+    return d_small;
+  }
+  // ensure there it fits, which is only the case for the minimal long
+  Assert(mpz_fits_slong_p(d_big->get_mpz_t()) != 0)
       << "Overflow detected in Integer::getLong().";
-  return d_value.get_si();
+  return d_big->get_si();
 }
 
 unsigned long Integer::getUnsignedLong() const
 {
+  if (isSmall())
+  {
+    Assert(d_small >= 0) << "Overflow detected in Integer::getUnsignedLong().";
+    return static_cast<unsigned long>(d_small);
+  }
   // ensure that it fits
-  Assert(mpz_fits_ulong_p(d_value.get_mpz_t()) != 0)
+  Assert(mpz_fits_ulong_p(d_big->get_mpz_t()) != 0)
       << "Overflow detected in Integer::getUnsignedLong().";
-  return d_value.get_ui();
+  return d_big->get_ui();
 }
 
 int64_t Integer::getSigned64() const
@@ -448,7 +716,7 @@ int64_t Integer::getSigned64() const
   }
   else
   {
-    if (mpz_fits_slong_p(d_value.get_mpz_t()) != 0)
+    if (isSmall() || mpz_fits_slong_p(d_big->get_mpz_t()) != 0)
     {
       return getLong();
     }
@@ -471,7 +739,7 @@ uint64_t Integer::getUnsigned64() const
   }
   else
   {
-    if (mpz_fits_ulong_p(d_value.get_mpz_t()) != 0)
+    if (isSmall() || mpz_fits_ulong_p(d_big->get_mpz_t()) != 0)
     {
       return getUnsignedLong();
     }
@@ -488,40 +756,68 @@ uint64_t Integer::getUnsigned64() const
   return 0;
 }
 
-size_t Integer::hash() const { return gmpz_hash(d_value.get_mpz_t()); }
+size_t Integer::hash() const
+{
+  if (isSmall())
+  {
+    // same as gmpz_hash, which hashes the (single) limb of the magnitude
+    return static_cast<size_t>(absUnsigned(d_small));
+  }
+  return gmpz_hash(d_big->get_mpz_t());
+}
 
 bool Integer::testBit(unsigned n) const
 {
-  return mpz_tstbit(d_value.get_mpz_t(), n);
+  if (isSmall())
+  {
+    if (n >= static_cast<unsigned>(std::numeric_limits<signed long>::digits))
+    {
+      return d_small < 0;
+    }
+    return ((d_small >> n) & 1) != 0;
+  }
+  return mpz_tstbit(d_big->get_mpz_t(), n);
 }
 
 unsigned Integer::isPow2() const
 {
-  if (d_value <= 0) return 0;
+  if (isSmall())
+  {
+    if (d_small <= 0 || (d_small & (d_small - 1)) != 0)
+    {
+      return 0;
+    }
+    // return the index of the one plus 1
+    return __builtin_ctzl(static_cast<unsigned long>(d_small)) + 1;
+  }
+  if (sgn() <= 0) return 0;
   // check that the number of ones in the binary representation is 1
-  if (mpz_popcount(d_value.get_mpz_t()) == 1)
+  if (mpz_popcount(d_big->get_mpz_t()) == 1)
   {
     // return the index of the first one plus 1
-    return mpz_scan1(d_value.get_mpz_t(), 0) + 1;
+    return mpz_scan1(d_big->get_mpz_t(), 0) + 1;
   }
   return 0;
 }
 
 size_t Integer::length() const
 {
-  if (sgn() == 0)
+  if (isSmall())
   {
-    return 1;
-  }
-  else
-  {
-    return mpz_sizeinbase(d_value.get_mpz_t(), 2);
+    if (d_small == 0)
+    {
+      return 1;
+    }
+    return std::numeric_limits<unsigned long>::digits
+           - __builtin_clzl(absUnsigned(d_small));
   }
+  return mpz_sizeinbase(d_big->get_mpz_t(), 2);
 }
 
 bool Integer::isProbablePrime() const
 {
-  return mpz_probab_prime_p(d_value.get_mpz_t(), 30) > 0;
+  mpz_class tmp;
+  return mpz_probab_prime_p(get_mpz(tmp).get_mpz_t(), 30) > 0;
 }
 
 void Integer::extendedGcd(
@@ -529,11 +825,15 @@ void Integer::extendedGcd(
 {
   // see the documentation for:
   // mpz_gcdext (mpz_t g, mpz_t s, mpz_t t, mpz_t a, mpz_t b);
-  mpz_gcdext(g.d_value.get_mpz_t(),
-             s.d_value.get_mpz_t(),
-             t.d_value.get_mpz_t(),
-             a.d_value.get_mpz_t(),
-             b.d_value.get_mpz_t());
+  mpz_class gv, sv, tv, ta, tb;
+  mpz_gcdext(gv.get_mpz_t(),
+             sv.get_mpz_t(),
+             tv.get_mpz_t(),
+             a.get_mpz(ta).get_mpz_t(),
+             b.get_mpz(tb).get_mpz_t());
+  g.setMpz(gv);
+  s.setMpz(sv);
+  t.setMpz(tv);
 }
 
 const Integer& Integer::min(const Integer& a, const Integer& b)
@@ -11,6 +11,11 @@
  * ****************************************************************************
  *
  * A multiprecision integer constant; wraps a GMP multiprecision integer.
+ *
+ * Values that fit into a machine word are stored inline, and arithmetic on
+ * them is performed with overflow-checked machine arithmetic. Only values
+ * that do not fit, and results of operations that overflow, are stored as GMP
+ * integers.
  */
 
 #include "cvc5_public.h"
@@ -21,6 +26,8 @@
 #include <gmpxx.h>
 
 #include <iosfwd>
+#include <limits>
+#include <memory>
 #include <string>
 
 namespace cvc5::internal {
@@ -35,10 +42,10 @@ class Integer
   /**
    * Constructs an Integer by copying a GMP C++ primitive.
    */
-  Integer(const mpz_class& val) : d_value(val) {}
+  Integer(const mpz_class& val) : d_small(0) { setMpz(val); }
 
   /** Constructs a rational with the value 0. */
-  Integer() : d_value(0) {}
+  Integer() : d_small(0) {}
 
   /**
    * Constructs a Integer from a C string.
@@ -49,12 +56,18 @@ class Integer
   explicit Integer(const char* s, unsigned base = 10);
   explicit Integer(const std::string& s, unsigned base = 10);
 
-  Integer(const Integer& q) : d_value(q.d_value) {}
+  Integer(const Integer& q)
+      : d_small(q.d_small),
+        d_big(q.d_big == nullptr ? nullptr
+                                 : std::make_unique<mpz_class>(*q.d_big))
+  {
+  }
+  Integer(Integer&& q) = default;
 
-  Integer(signed int z) : d_value(z) {}
-  Integer(unsigned int z) : d_value(z) {}
-  Integer(signed long int z) : d_value(z) {}
-  Integer(unsigned long int z) : d_value(z) {}
+  Integer(signed int z) : d_small(0) { setSignedLong(z); }
+  Integer(unsigned int z) : d_small(0) { setUnsignedLong(z); }
+  Integer(signed long int z) : d_small(0) { setSignedLong(z); }
+  Integer(unsigned long int z) : d_small(0) { setUnsignedLong(z); }
 
 #ifdef CVC5_NEED_INT64_T_OVERLOADS
   Integer(int64_t z);
@@ -64,11 +77,13 @@ class Integer
   /** Destructor. */
   ~Integer() {}
 
-  /** Returns a copy of d_value to enable public access of GMP data. */
-  const mpz_class& getValue() const { return d_value; }
+  /** Returns a copy of the value as a GMP integer. */
+  mpz_class getValue() const;
 
   /** Overload copy assignment operator. */
   Integer& operator=(const Integer& x);
+  /** Overload move assignment operator. */
+  Integer& operator=(Integer&& x) = default;
 
   /** Overload equality comparison operator. */
   bool operator==(const Integer& y) const;
@@ -320,16 +335,68 @@ class Integer
 
  private:
   /**
-   * Gets a reference to the gmp data that backs up the integer.
-   * Only accessible to friend classes.
+   * The smallest value stored inline. We exclude the minimal signed long,
+   * such that negating and taking the absolute value of an inline value never
+   * overflows.
    */
-  const mpz_class& get_mpz() const { return d_value; }
-
+  static constexpr signed long int s_minSmall =
+      -std::numeric_limits<signed long int>::max();
+  /** The largest value stored inline. */
+  static constexpr signed long int s_maxSmall =
+      std::numeric_limits<signed long int>::max();
+
+  /** Is the value stored inline (in d_small)? */
+  bool isSmall() const { return d_big == nullptr; }
+  /** Set the value to z. */
+  void setSignedLong(signed long int z)
+  {
+    if (z >= s_minSmall)
+    {
+      d_small = z;
+      d_big.reset();
+    }
+    else
+    {
+      d_big = std::make_unique<mpz_class>(z);
+    }
+  }
+  /** Set the value to z. */
+  void setUnsignedLong(unsigned long int z)
+  {
+    if (z <= static_cast<unsigned long int>(s_maxSmall))
+    {
+      d_small = static_cast<signed long int>(z);
+      d_big.reset();
+    }
+    else
+    {
+      d_big = std::make_unique<mpz_class>(z);
+    }
+  }
+  /** Set the value to val, which is stored inline if it fits. */
+  void setMpz(const mpz_class& val);
+  /**
+   * Gets a reference to a GMP integer with the value of this Integer. For
+   * values stored inline, this is tmp, which is set to the value.
+   */
+  const mpz_class& get_mpz(mpz_class& tmp) const
+  {
+    if (d_big != nullptr)
+    {
+      return *d_big;
+    }
+    tmp = d_small;
+    return tmp;
+  }
+
+  /** The value of this Integer, if d_big is null. */
+  signed long int d_small;
   /**
-   * The value of the rational is stored in a C++ GMP integer class.
-   * Using this instead of mpz_t allows for easier destruction.
+   * The value of this Integer, if it does not fit into d_small. Values that
+   * fit into d_small are never stored here, hence the representation of each
+   * value is unique.
    */
-  mpz_class d_value;
+  std::unique_ptr<mpz_class> d_big;
 }; /* class Integer */
 
 struct IntegerHashFunction
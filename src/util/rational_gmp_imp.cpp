@@ -13,6 +13,8 @@
  * A multi-precision rational constant.
  */
 #include <cmath>
+#include <limits>
+#include <numeric>
 #include <sstream>
 #include <string>
 
@@ -24,9 +26,368 @@
 #endif /* CVC5_GMP_IMP */
 
 #include "base/check.h"
+#include "util/gmp_util.h"
 
 namespace cvc5::internal {
 
+namespace {
+
+/**
+ * The smallest value stored inline. We exclude the minimal signed long, such
+ * that negating an inline numerator or denominator never overflows.
+ */
+constexpr signed long int s_minSmall =
+    -std::numeric_limits<signed long int>::max();
+/** The largest value stored inline. */
+constexpr signed long int s_maxSmall =
+    std::numeric_limits<signed long int>::max();
+
+}  // namespace
+
+Rational::Rational(const char* s, unsigned base) : d_num(0), d_den(1)
+{
+  mpq_class val(s, base);
+  val.canonicalize();
+  setMpq(val);
+}
+
+Rational::Rational(const std::string& s, unsigned base) : d_num(0), d_den(1)
+{
+  mpq_class val(s, base);
+  val.canonicalize();
+  setMpq(val);
+}
+
+Rational::Rational(const Integer& n, const Integer& d) : d_num(0), d_den(1)
+{
+  if (n.isSmall() && d.isSmall())
+  {
+    setCanonical(n.d_small, d.d_small);
+    return;
+  }
+  mpz_class tn, td;
+  mpq_class val(n.get_mpz(tn), d.get_mpz(td));
+  val.canonicalize();
+  setMpq(val);
+}
+
+Rational::Rational(const Integer& n) : d_num(0), d_den(1)
+{
+  if (n.isSmall())
+  {
+    d_num = n.d_small;
+    return;
+  }
+  d_big = std::make_unique<mpq_class>(*n.d_big);
+}
+
+void Rational::setCanonical(signed long int n, signed long int d)
+{
+  Assert(d != 0) << "Division by zero in Rational";
+  if (n >= s_minSmall && d >= s_minSmall)
+  {
+    if (d < 0)
+    {
+      n = -n;
+      d = -d;
+    }
+    signed long int g = std::gcd(n, d);
+    d_num = n / g;
+    d_den = d / g;
+    d_big.reset();
+    return;
+  }
+  mpq_class val(n, d);
+  val.canonicalize();
+  setMpq(val);
+}
+
+void Rational::setUnsigned(unsigned long int n, unsigned long int d)
+{
+  if (n <= static_cast<unsigned long int>(s_maxSmall)
+      && d <= static_cast<unsigned long int>(s_maxSmall))
+  {
+    setCanonical(static_cast<signed long int>(n),
+                 static_cast<signed long int>(d));
+    return;
+  }
+  mpq_class val(n, d);
+  val.canonicalize();
+  setMpq(val);
+}
+
+void Rational::setMpq(const mpq_class& val)
+{
+  if (mpz_fits_slong_p(val.get_num_mpz_t()) != 0
+      && mpz_fits_slong_p(val.get_den_mpz_t()) != 0)
+  {
+    signed long int n = mpz_get_si(val.get_num_mpz_t());
+    signed long int d = mpz_get_si(val.get_den_mpz_t());
+    if (n >= s_minSmall && d >= s_minSmall)
+    {
+      d_num = n;
+      d_den = d;
+      d_big.reset();
+      return;
+    }
+  }
+  if (d_big == nullptr)
+  {
+    d_big = std::make_unique<mpq_class>(val);
+  }
+  else
+  {
+    *d_big = val;
+  }
+}
+
+const mpq_class& Rational::get_mpq(mpq_class& tmp) const
+{
+  if (d_big != nullptr)
+  {
+    return *d_big;
+  }
+  mpq_set_si(tmp.get_mpq_t(), d_num, static_cast<unsigned long>(d_den));
+  return tmp;
+}
+
+mpq_class Rational::getValue() const
+{
+  mpq_class tmp;
+  return get_mpq(tmp);
+}
+
+double Rational::getDouble() const
+{
+  // integers of at most 53 bits are exactly representable, otherwise we
+  // use GMP which truncates
+  if (isSmall() && d_den == 1 && d_num <= (1L << 53) && d_num >= -(1L << 53))
+  {
+    return static_cast<double>(d_num);
+  }
+  mpq_class tmp;
+  return get_mpq(tmp).get_d();
+}
+
+Rational Rational::inverse() const
+{
+  if (isSmall() && d_num != 0)
+  {
+    Rational res;
+    res.d_num = d_num < 0 ? -d_den : d_den;
+    res.d_den = d_num < 0 ? -d_num : d_num;
+    return res;
+  }
+  return Rational(getDenominator(), getNumerator());
+}
+
+int Rational::cmp(const Rational& x) const
+{
+  if (isSmall() && x.isSmall())
+  {
+    if (d_den == x.d_den)
+    {
+      return d_num < x.d_num ? -1 : (d_num > x.d_num ? 1 : 0);
+    }
+    signed long int l, r;
+    if (!__builtin_mul_overflow(d_num, x.d_den, &l)
+        && !__builtin_mul_overflow(x.d_num, d_den, &r))
+    {
+      return l < r ? -1 : (l > r ? 1 : 0);
+    }
+  }
+  // Don't use mpq_class's cmp() function.
+  // The name ends up conflicting with this function.
+  mpq_class tx, ty;
+  return mpq_cmp(get_mpq(tx).get_mpq_t(), x.get_mpq(ty).get_mpq_t());
+}
+
+Integer Rational::floor() const
+{
+  if (isSmall())
+  {
+    signed long int q = d_num / d_den;
+    if (d_num % d_den < 0)
+    {
+      q -= 1;
+    }
+    return Integer(q);
+  }
+  mpz_class q;
+  mpz_fdiv_q(q.get_mpz_t(), d_big->get_num_mpz_t(), d_big->get_den_mpz_t());
+  return Integer(q);
+}
+
+Integer Rational::ceiling() const
+{
+  if (isSmall())
+  {
+    signed long int q = d_num / d_den;
+    if (d_num % d_den > 0)
+    {
+      q += 1;
+    }
+    return Integer(q);
+  }
+  mpz_class q;
+  mpz_cdiv_q(q.get_mpz_t(), d_big->get_num_mpz_t(), d_big->get_den_mpz_t());
+  return Integer(q);
+}
+
+Rational& Rational::operator=(const Rational& x)
+{
+  if (this == &x) return *this;
+  if (x.isSmall())
+  {
+    d_num = x.d_num;
+    d_den = x.d_den;
+    d_big.reset();
+  }
+  else
+  {
+    setMpq(*x.d_big);
+  }
+  return *this;
+}
+
+Rational Rational::operator-() const
+{
+  if (isSmall())
+  {
+    Rational res(*this);
+    res.d_num = -d_num;
+    return res;
+  }
+  return Rational(mpq_class(-(*d_big)));
+}
+
+Rational& Rational::operator+=(const Rational& y)
+{
+  if (isSmall() && y.isSmall())
+  {
+    signed long int n, d, t1, t2;
+    if (d_den == 1 && y.d_den == 1)
+    {
+      if (!__builtin_add_overflow(d_num, y.d_num, &n))
+      {
+        setCanonical(n, 1);
+        return *this;
+      }
+    }
+    else
+    {
+      signed long int g = std::gcd(d_den, y.d_den);
+      if (!__builtin_mul_overflow(d_num, y.d_den / g, &t1)
+          && !__builtin_mul_overflow(y.d_num, d_den / g, &t2)
+          && !__builtin_add_overflow(t1, t2, &n)
+          && !__builtin_mul_overflow(d_den, y.d_den / g, &d))
+      {
+        setCanonical(n, d);
+        return *this;
+      }
+    }
+  }
+  mpq_class tx, ty;
+  setMpq(get_mpq(tx) + y.get_mpq(ty));
+  return *this;
+}
+
+Rational& Rational::operator-=(const Rational& y)
+{
+  if (isSmall() && y.isSmall())
+  {
+    signed long int n, d, t1, t2;
+    if (d_den == 1 && y.d_den == 1)
+    {
+      if (!__builtin_sub_overflow(d_num, y.d_num, &n))
+      {
+        setCanonical(n, 1);
+        return *this;
+      }
+    }
+    else
+    {
+      signed long int g = std::gcd(d_den, y.d_den);
+      if (!__builtin_mul_overflow(d_num, y.d_den / g, &t1)
+          && !__builtin_mul_overflow(y.d_num, d_den / g, &t2)
+          && !__builtin_sub_overflow(t1, t2, &n)
+          && !__builtin_mul_overflow(d_den, y.d_den / g, &d))
+      {
+        setCanonical(n, d);
+        return *this;
+      }
+    }
+  }
+  mpq_class tx, ty;
+  setMpq(get_mpq(tx) - y.get_mpq(ty));
+  return *this;
+}
+
+Rational& Rational::operator*=(const Rational& y)
+{
+  if (isSmall() && y.isSmall())
+  {
+    // cancel common factors first, then the result is canonical
+    signed long int g1 = std::gcd(d_num, y.d_den);
+    signed long int g2 = std::gcd(y.d_num, d_den);
+    signed long int n, d;
+    if (!__builtin_mul_overflow(d_num / g1, y.d_num / g2, &n)
+        && !__builtin_mul_overflow(d_den / g2, y.d_den / g1, &d)
+        && n >= s_minSmall)
+    {
+      d_num = n;
+      d_den = d;
+      return *this;
+    }
+  }
+  mpq_class tx, ty;
+  setMpq(get_mpq(tx) * y.get_mpq(ty));
+  return *this;
+}
+
+Rational& Rational::operator/=(const Rational& y)
+{
+  if (y.isSmall() && !y.isZero())
+  {
+    return (*this) *= y.inverse();
+  }
+  mpq_class tx, ty;
+  setMpq(get_mpq(tx) / y.get_mpq(ty));
+  return *this;
+}
+
+std::string Rational::toString(int base) const
+{
+  if (isSmall() && base == 10)
+  {
+    std::string res = std::to_string(d_num);
+    if (d_den != 1)
+    {
+      res += "/" + std::to_string(d_den);
+    }
+    return res;
+  }
+  mpq_class tmp;
+  return get_mpq(tmp).get_str(base);
+}
+
+size_t Rational::hash() const
+{
+  if (isSmall())
+  {
+    // same as for GMP rationals, whose numerator and denominator are single
+    // limbs here
+    size_t numeratorHash = static_cast<size_t>(
+        d_num < 0 ? -static_cast<unsigned long>(d_num) : d_num);
+    size_t denominatorHash = static_cast<size_t>(d_den);
+    return numeratorHash xor denominatorHash;
+  }
+  size_t numeratorHash = gmpz_hash(d_big->get_num_mpz_t());
+  size_t denominatorHash = gmpz_hash(d_big->get_den_mpz_t());
+
+  return numeratorHash xor denominatorHash;
+}
+
 std::ostream& operator<<(std::ostream& os, const Rational& q){
   return os << q.toString();
 }
@@ -89,9 +450,9 @@ std::optional<Rational> Rational::fromDouble(double d)
 {
   using namespace std;
   if(isfinite(d)){
-    Rational q;
-    mpq_set_d(q.d_value.get_mpq_t(), d);
-    return q;
+    mpq_class q;
+    mpq_set_d(q.get_mpq_t(), d);
+    return Rational(q);
   }
   return std::optional<Rational>();
 }
@@ -11,6 +11,11 @@
  * ****************************************************************************
  *
  * Multiprecision rational constants; wraps a GMP multiprecision rational.
+ *
+ * Rationals whose numerator and denominator fit into a machine word are
+ * stored inline, and arithmetic on them is performed with overflow-checked
+ * machine arithmetic. Only other values, and results of operations that
+ * overflow, are stored as GMP rationals.
  */
 
 #include "cvc5_public.h"
@@ -20,6 +25,7 @@
 
 #include <gmp.h>
 
+#include <memory>
 #include <optional>
 #include <string>
 
@@ -52,7 +58,7 @@ class Rational
    * Assumes that the value is in canonical form, and thus does not
    * have to call canonicalize() on the value.
    */
-  Rational(const mpq_class& val) : d_value(val) {}
+  Rational(const mpq_class& val) : d_num(0), d_den(1) { setMpq(val); }
 
   /**
    * Creates a rational from a decimal string (e.g., <code>"1.5"</code>).
@@ -63,7 +69,7 @@ class Rational
   static Rational fromDecimal(const std::string& dec);
 
   /** Constructs a rational with the value 0/1. */
-  Rational() : d_value(0) { d_value.canonicalize(); }
+  Rational() : d_num(0), d_den(1) {}
 
   /**
    * Constructs a Rational from a C string in a given base (defaults to 10).
@@ -72,96 +78,97 @@ class Rational
    * For more information about what is a valid rational string,
    * see GMP's documentation for mpq_set_str().
    */
-  explicit Rational(const char* s, unsigned base = 10) : d_value(s, base)
-  {
-    d_value.canonicalize();
-  }
-  Rational(const std::string& s, unsigned base = 10) : d_value(s, base)
-  {
-    d_value.canonicalize();
-  }
+  explicit Rational(const char* s, unsigned base = 10);
+  Rational(const std::string& s, unsigned base = 10);
 
   /**
    * Creates a Rational from another Rational, q, by performing a deep copy.
    */
-  Rational(const Rational& q) : d_value(q.d_value) { d_value.canonicalize(); }
+  Rational(const Rational& q)
+      : d_num(q.d_num),
+        d_den(q.d_den),
+        d_big(q.d_big == nullptr ? nullptr
+                                 : std::make_unique<mpq_class>(*q.d_big))
+  {
+  }
+  Rational(Rational&& q) = default;
 
   /**
    * Constructs a canonical Rational from a numerator.
    */
-  Rational(signed int n) : d_value(n, 1) { d_value.canonicalize(); }
-  Rational(unsigned int n) : d_value(n, 1) { d_value.canonicalize(); }
-  Rational(signed long int n) : d_value(n, 1) { d_value.canonicalize(); }
-  Rational(unsigned long int n) : d_value(n, 1) { d_value.canonicalize(); }
+  Rational(signed int n) : d_num(0), d_den(1) { setCanonical(n, 1); }
+  Rational(unsigned int n) : d_num(0), d_den(1) { setUnsigned(n, 1); }
+  Rational(signed long int n) : d_num(0), d_den(1) { setCanonical(n, 1); }
+  Rational(unsigned long int n) : d_num(0), d_den(1) { setUnsigned(n, 1); }
 
 #ifdef CVC5_NEED_INT64_T_OVERLOADS
-  Rational(int64_t n) : d_value(static_cast<long>(n), 1)
+  Rational(int64_t n) : d_num(0), d_den(1)
   {
-    d_value.canonicalize();
+    setCanonical(static_cast<long>(n), 1);
   }
-  Rational(uint64_t n) : d_value(static_cast<unsigned long>(n), 1)
+  Rational(uint64_t n) : d_num(0), d_den(1)
   {
-    d_value.canonicalize();
+    setUnsigned(static_cast<unsigned long>(n), 1);
   }
 #endif /* CVC5_NEED_INT64_T_OVERLOADS */
 
   /**
    * Constructs a canonical Rational from a numerator and denominator.
    */
-  Rational(signed int n, signed int d) : d_value(n, d)
+  Rational(signed int n, signed int d) : d_num(0), d_den(1)
   {
-    d_value.canonicalize();
+    setCanonical(n, d);
   }
-  Rational(unsigned int n, unsigned int d) : d_value(n, d)
+  Rational(unsigned int n, unsigned int d) : d_num(0), d_den(1)
   {
-    d_value.canonicalize();
+    setUnsigned(n, d);
   }
-  Rational(signed long int n, signed long int d) : d_value(n, d)
+  Rational(signed long int n, signed long int d) : d_num(0), d_den(1)
   {
-    d_value.canonicalize();
+    setCanonical(n, d);
   }
-  Rational(unsigned long int n, unsigned long int d) : d_value(n, d)
+  Rational(unsigned long int n, unsigned long int d) : d_num(0), d_den(1)
   {
-    d_value.canonicalize();
+    setUnsigned(n, d);
   }
 
 #ifdef CVC5_NEED_INT64_T_OVERLOADS
-  Rational(int64_t n, int64_t d)
-      : d_value(static_cast<long>(n), static_cast<long>(d))
+  Rational(int64_t n, int64_t d) : d_num(0), d_den(1)
   {
-    d_value.canonicalize();
+    setCanonical(static_cast<long>(n), static_cast<long>(d));
   }
-  Rational(uint64_t n, uint64_t d)
-      : d_value(static_cast<unsigned long>(n), static_cast<unsigned long>(d))
+  Rational(uint64_t n, uint64_t d) : d_num(0), d_den(1)
   {
-    d_value.canonicalize();
+    setUnsigned(static_cast<unsigned long>(n), static_cast<unsigned long>(d));
   }
 #endif /* CVC5_NEED_INT64_T_OVERLOADS */
 
-  Rational(const Integer& n, const Integer& d)
-      : d_value(n.get_mpz(), d.get_mpz())
-  {
-    d_value.canonicalize();
-  }
-  Rational(const Integer& n) : d_value(n.get_mpz()) { d_value.canonicalize(); }
+  Rational(const Integer& n, const Integer& d);
+  Rational(const Integer& n);
   ~Rational() {}
 
   /**
-   * Returns a copy of d_value to enable public access of GMP data.
+   * Returns a copy of the value as a GMP rational.
    */
-  const mpq_class& getValue() const { return d_value; }
+  mpq_class getValue() const;
 
   /**
    * Returns the value of numerator of the Rational.
    * Note that this makes a deep copy of the numerator.
    */
-  Integer getNumerator() const { return Integer(d_value.get_num()); }
+  Integer getNumerator() const
+  {
+    return isSmall() ? Integer(d_num) : Integer(d_big->get_num());
+  }
 
   /**
    * Returns the value of denominator of the Rational.
    * Note that this makes a deep copy of the denominator.
    */
-  Integer getDenominator() const { return Integer(d_value.get_den()); }
+  Integer getDenominator() const
+  {
+    return isSmall() ? Integer(d_den) : Integer(d_big->get_den());
+  }
 
   static std::optional<Rational> fromDouble(double d);
 
@@ -170,30 +177,26 @@ class Rational
    * approximate: truncation may occur, overflow may result in
    * infinity, and underflow may result in zero.
    */
-  double getDouble() const { return d_value.get_d(); }
+  double getDouble() const;
 
-  Rational inverse() const
-  {
-    return Rational(getDenominator(), getNumerator());
-  }
+  Rational inverse() const;
 
-  int cmp(const Rational& x) const
+  int cmp(const Rational& x) const;
+
+  int sgn() const
   {
-    // Don't use mpq_class's cmp() function.
-    // The name ends up conflicting with this function.
-    return mpq_cmp(d_value.get_mpq_t(), x.d_value.get_mpq_t());
+    if (isSmall())
+    {
+      return d_num < 0 ? -1 : (d_num > 0 ? 1 : 0);
+    }
+    return mpq_sgn(d_big->get_mpq_t());
   }
 
-  int sgn() const { return mpq_sgn(d_value.get_mpq_t()); }
+  bool isZero() const { return isSmall() && d_num == 0; }
 
-  bool isZero() const { return sgn() == 0; }
+  bool isOne() const { return isSmall() && d_num == 1 && d_den == 1; }
 
-  bool isOne() const { return mpq_cmp_si(d_value.get_mpq_t(), 1, 1) == 0; }
-
-  bool isNegativeOne() const
-  {
-    return mpq_cmp_si(d_value.get_mpq_t(), -1, 1) == 0;
-  }
+  bool isNegativeOne() const { return isSmall() && d_num == -1 && d_den == 1; }
 
   Rational abs() const
   {
@@ -207,100 +210,85 @@ class Rational
     }
   }
 
-  Integer floor() const
-  {
-    mpz_class q;
-    mpz_fdiv_q(q.get_mpz_t(), d_value.get_num_mpz_t(), d_value.get_den_mpz_t());
-    return Integer(q);
-  }
+  Integer floor() const;
 
-  Integer ceiling() const
-  {
-    mpz_class q;
-    mpz_cdiv_q(q.get_mpz_t(), d_value.get_num_mpz_t(), d_value.get_den_mpz_t());
-    return Integer(q);
-  }
+  Integer ceiling() const;
 
   Rational floor_frac() const { return (*this) - Rational(floor()); }
 
-  Rational& operator=(const Rational& x)
-  {
-    if (this == &x) return *this;
-    d_value = x.d_value;
-    return *this;
-  }
+  Rational& operator=(const Rational& x);
+  Rational& operator=(Rational&& x) = default;
 
-  Rational operator-() const { return Rational(-(d_value)); }
+  Rational operator-() const;
 
-  bool operator==(const Rational& y) const { return d_value == y.d_value; }
+  bool operator==(const Rational& y) const
+  {
+    if (isSmall() || y.isSmall())
+    {
+      // the representation is unique, hence mixed values are distinct
+      return isSmall() && y.isSmall() && d_num == y.d_num && d_den == y.d_den;
+    }
+    return *d_big == *y.d_big;
+  }
 
-  bool operator!=(const Rational& y) const { return d_value != y.d_value; }
+  bool operator!=(const Rational& y) const { return !(*this == y); }
 
-  bool operator<(const Rational& y) const { return d_value < y.d_value; }
+  bool operator<(const Rational& y) const { return cmp(y) < 0; }
 
-  bool operator<=(const Rational& y) const { return d_value <= y.d_value; }
+  bool operator<=(const Rational& y) const { return cmp(y) <= 0; }
 
-  bool operator>(const Rational& y) const { return d_value > y.d_value; }
+  bool operator>(const Rational& y) const { return cmp(y) > 0; }
 
-  bool operator>=(const Rational& y) const { return d_value >= y.d_value; }
+  bool operator>=(const Rational& y) const { return cmp(y) >= 0; }
 
   Rational operator+(const Rational& y) const
   {
-    return Rational(d_value + y.d_value);
+    Rational res(*this);
+    res += y;
+    return res;
   }
   Rational operator-(const Rational& y) const
   {
-    return Rational(d_value - y.d_value);
+    Rational res(*this);
+    res -= y;
+    return res;
   }
 
   Rational operator*(const Rational& y) const
   {
-    return Rational(d_value * y.d_value);
+    Rational res(*this);
+    res *= y;
+    return res;
   }
   Rational operator/(const Rational& y) const
   {
-    return Rational(d_value / y.d_value);
+    Rational res(*this);
+    res /= y;
+    return res;
   }
 
-  Rational& operator+=(const Rational& y)
-  {
-    d_value += y.d_value;
-    return (*this);
-  }
-  Rational& operator-=(const Rational& y)
-  {
-    d_value -= y.d_value;
-    return (*this);
-  }
-
-  Rational& operator*=(const Rational& y)
-  {
-    d_value *= y.d_value;
-    return (*this);
-  }
+  Rational& operator+=(const Rational& y);
+  Rational& operator-=(const Rational& y);
+  Rational& operator*=(const Rational& y);
+  Rational& operator/=(const Rational& y);
 
-  Rational& operator/=(const Rational& y)
+  bool isIntegral() const
   {
-    d_value /= y.d_value;
-    return (*this);
+    if (isSmall())
+    {
+      return d_den == 1;
+    }
+    return mpz_cmp_ui(d_big->get_den_mpz_t(), 1) == 0;
   }
 
-  bool isIntegral() const { return mpz_cmp_ui(d_value.get_den_mpz_t(), 1) == 0; }
-
   /** Returns a string representing the rational in the given base. */
-  std::string toString(int base = 10) const { return d_value.get_str(base); }
+  std::string toString(int base = 10) const;
 
   /**
    * Computes the hash of the rational from hashes of the numerator and the
    * denominator.
    */
-  size_t hash() const
-  {
-    size_t numeratorHash = gmpz_hash(d_value.get_num_mpz_t());
-    size_t denominatorHash = gmpz_hash(d_value.get_den_mpz_t());
-
-    return numeratorHash xor denominatorHash;
-  }
+  size_t hash() const;
 
   uint32_t complexity() const
   {
@@ -313,11 +301,35 @@ class Rational
   int absCmp(const Rational& q) const;
 
  private:
+  /** Is the value stored inline (in d_num and d_den)? */
+  bool isSmall() const { return d_big == nullptr; }
+  /**
+   * Set the value to n/d, where d is non-zero. This normalizes the sign and
+   * divides by the greatest common divisor of n and d.
+   */
+  void setCanonical(signed long int n, signed long int d);
+  /** As above, for unsigned numerator and denominator. */
+  void setUnsigned(unsigned long int n, unsigned long int d);
+  /** Set the value to val, which must be canonical. */
+  void setMpq(const mpq_class& val);
+  /**
+   * Gets a reference to a GMP rational with the value of this Rational. For
+   * values stored inline, this is tmp, which is set to the value.
+   */
+  const mpq_class& get_mpq(mpq_class& tmp) const;
+
+  /** The numerator, if d_big is null */
+  signed long int d_num;
+  /**
+   * The denominator, if d_big is null. It is positive, and coprime to d_num.
+   */
+  signed long int d_den;
   /**
-   * Stores the value of the rational is stored in a C++ GMP rational class.
-   * Using this instead of mpq_t allows for easier destruction.
+   * The value of the rational, if its numerator or denominator do not fit
+   * into d_num and d_den. Values that fit are never stored here, hence the
+   * representation of each value is unique.
    */
-  mpq_class d_value;
+  std::unique_ptr<mpq_class> d_big;
 
 }; /* class Rational */
 
@@ -26,6 +26,7 @@
 #include "options/option_exception.h"
 #include "options/options.h"
 #include "util/statistics_registry.h"
+#include "util/statistics_reporter.h"
 
 using namespace std;
 
@@ -103,6 +104,7 @@ struct ResourceManager::Statistics
   IntStat d_spendResourceCalls;
   HistogramStat<theory::InferenceId> d_inferenceIdSteps;
   HistogramStat<Resource> d_resourceSteps;
+  ValueStat<std::string> d_exhaustedLimit;
   Statistics(StatisticsRegistry& stats);
 };
 
@@ -113,7 +115,9 @@ ResourceManager::Statistics::Statistics(StatisticsRegistry& stats)
       d_inferenceIdSteps(stats.registerHistogram<theory::InferenceId>(
           "resource::steps::inference-id")),
       d_resourceSteps(
-          stats.registerHistogram<Resource>("resource::steps::resource"))
+          stats.registerHistogram<Resource>("resource::steps::resource")),
+      d_exhaustedLimit(
+          stats.registerValue<std::string>("resource::exhaustedLimit"))
 {
 }
 
@@ -152,18 +156,23 @@ bool setWeight(const std::string& name, uint64_t weight, Weights& weights)
 ResourceManager::ResourceManager(StatisticsRegistry& stats,
                                  const Options& options)
     : d_options(options),
+      d_statisticsRegistry(stats),
       d_enabled(true),
       d_perCallTimer(),
       d_cumulativeTimeUsed(0),
       d_cumulativeResourceUsed(0),
       d_thisCallResourceUsed(0),
       d_thisCallResourceBudget(0),
+      d_exhaustedResource(Resource::Unknown),
+      d_parent(nullptr),
       d_statistics(new ResourceManager::Statistics(stats))
 {
   d_statistics->d_resourceUnitsUsed.set(d_cumulativeResourceUsed);
 
   d_infidWeights.fill(1);
   d_resourceWeights.fill(1);
+  d_resourceBudgets.fill(0);
+  d_thisCallResourceSteps.fill(0);
   for (const auto& opt : d_options.base.resourceWeightHolder)
   {
     std::string name;
@@ -199,6 +208,37 @@ uint64_t ResourceManager::getResourceRemaining() const
   return d_options.base.cumulativeResourceLimit - d_cumulativeResourceUsed;
 }
 
+std::string ResourceManager::getExhaustedLimit() const
+{
+  if (!d_enabled)
+  {
+    return "";
+  }
+  if (d_exhaustedResource != Resource::Unknown)
+  {
+    return toString(d_exhaustedResource);
+  }
+  if (d_options.base.perCallResourceLimit > 0
+      && d_thisCallResourceUsed >= d_options.base.perCallResourceLimit)
+  {
+    return "rlimit-per";
+  }
+  if (d_options.base.cumulativeResourceLimit > 0
+      && d_cumulativeResourceUsed >= d_options.base.cumulativeResourceLimit)
+  {
+    return "rlimit";
+  }
+  if (outOfTime())
+  {
+    return "tlimit-per";
+  }
+  if (d_parent != nullptr)
+  {
+    return d_parent->getExhaustedLimit();
+  }
+  return "";
+}
+
 void ResourceManager::spendResource(uint64_t amount)
 {
   ++d_statistics->d_spendResourceCalls;
@@ -206,6 +246,10 @@ void ResourceManager::spendResource(uint64_t amount)
 
   Trace("limit") << "ResourceManager::spendResource()" << std::endl;
   d_thisCallResourceUsed += amount;
+  if (d_statisticsReporter != nullptr)
+  {
+    d_statisticsReporter->check();
+  }
   if (out())
   {
     Trace("limit") << "ResourceManager::spendResource: interrupt!" << std::endl;
@@ -216,6 +260,7 @@ void ResourceManager::spendResource(uint64_t amount)
       Trace("limit") << "ResourceManager::spendResource: elapsed time"
                      << d_perCallTimer.elapsed() << std::endl;
     }
+    d_statistics->d_exhaustedLimit.set(getExhaustedLimit());
 
     for (Listener* l : d_listeners)
     {
@@ -229,9 +274,26 @@ void ResourceManager::spendResource(Resource r)
   std::size_t i = static_cast<std::size_t>(r);
   Assert(d_resourceWeights.size() > i);
   d_statistics->d_resourceSteps << r;
+  countStep(i);
   spendResource(d_resourceWeights[i]);
 }
 
+void ResourceManager::countStep(std::size_t i)
+{
+  if (d_resourceBudgets[i] > 0
+      && ++d_thisCallResourceSteps[i] >= d_resourceBudgets[i]
+      && d_exhaustedResource == Resource::Unknown)
+  {
+    Trace("limit") << "ResourceManager::countStep: budget of "
+                   << static_cast<Resource>(i) << " exhausted" << std::endl;
+    d_exhaustedResource = static_cast<Resource>(i);
+  }
+  if (d_parent != nullptr)
+  {
+    d_parent->countStep(i);
+  }
+}
+
 void ResourceManager::spendResource(theory::InferenceId iid)
 {
   std::size_t i = static_cast<std::size_t>(iid);
@@ -247,6 +309,20 @@ void ResourceManager::beginCall()
   // begin call
   d_perCallTimer.set(d_options.base.perCallMillisecondLimit);
   d_thisCallResourceUsed = 0;
+  d_thisCallResourceSteps.fill(0);
+  d_exhaustedResource = Resource::Unknown;
+  readResourceBudgets();
+  // the options may have been set after construction, hence we create the
+  // reporter on the first call
+  if (d_statisticsReporter == nullptr && d_options.base.statisticsInterval > 0)
+  {
+    d_statisticsReporter = std::make_unique<StatisticsReporter>(
+        d_statisticsRegistry,
+        d_options.base.statisticsInterval,
+        [this](const std::string& line) {
+          *d_options.base.statisticsStream << line << std::endl;
+        });
+  }
 
   if (d_options.base.cumulativeResourceLimit > 0)
   {
@@ -264,6 +340,23 @@ void ResourceManager::beginCall()
   }
 }
 
+void ResourceManager::readResourceBudgets()
+{
+  // the budgets are read here instead of in the constructor, since the
+  // options may be set after the resource manager is constructed
+  d_resourceBudgets.fill(0);
+  for (const auto& opt : d_options.base.resourceBudgetHolder)
+  {
+    std::string name;
+    uint64_t budget;
+    if (!parseOption(opt, name, budget)
+        || !setWeight<Resource>(name, budget, d_resourceBudgets))
+    {
+      throw OptionException("Did not recognize resource budget " + opt);
+    }
+  }
+}
+
 void ResourceManager::refresh()
 {
   d_cumulativeTimeUsed += d_perCallTimer.elapsed();
@@ -275,7 +368,9 @@ bool ResourceManager::limitOn() const
 {
   return (d_options.base.cumulativeResourceLimit > 0)
          || (d_options.base.perCallMillisecondLimit > 0)
-         || (d_options.base.perCallResourceLimit > 0);
+         || (d_options.base.perCallResourceLimit > 0)
+         || !d_options.base.resourceBudgetHolder.empty()
+         || d_parent != nullptr;
 }
 
 bool ResourceManager::outOfResources() const
@@ -284,6 +379,14 @@ bool ResourceManager::outOfResources() const
   {
     return false;
   }
+  if (d_exhaustedResource != Resource::Unknown)
+  {
+    return true;
+  }
+  if (d_parent != nullptr && d_parent->outOfResources())
+  {
+    return true;
+  }
   if (d_options.base.perCallResourceLimit > 0)
   {
     // Check if per-call resources are exhausted
@@ -25,6 +25,7 @@
 #include <array>
 #include <chrono>
 #include <memory>
+#include <string>
 #include <vector>
 
 #include "theory/inference_id.h"
@@ -34,6 +35,7 @@ namespace cvc5::internal {
 class Listener;
 class Options;
 class StatisticsRegistry;
+class StatisticsReporter;
 
 /**
  * This class implements a easy to use wall clock timer based on std::chrono.
@@ -107,6 +109,16 @@ constexpr std::size_t ResourceMax = static_cast<std::size_t>(Resource::Unknown);
  * This class manages resource limits (cumulative or per call) and (per call)
  * time limits. The available resources are listed in Resource and their individual
  * costs are configured via command line options.
+ *
+ * Additionally, the number of steps of each resource may be limited per call
+ * (option --rlimit-resource), e.g. to bound the number of quantifier steps
+ * while allowing any number of SAT conflicts. These budgets count steps
+ * instead of weighted resource units.
+ *
+ * The resource manager of a subsolver may have a parent (see setParent). The
+ * steps spent by the subsolver count towards the per-resource budgets of the
+ * parent for its current call, and the subsolver is out of resources if its
+ * parent is.
  */
 class ResourceManager
 {
@@ -145,6 +157,13 @@ class ResourceManager
   uint64_t getRemainingTime() const;
   /** Retrieves the remaining number of cumulative resources. */
   uint64_t getResourceRemaining() const;
+  /**
+   * Returns the name of a limit that is exhausted, which is the name of the
+   * resource for a per-resource budget, or the name of the option for the
+   * other limits ("rlimit", "rlimit-per" or "tlimit-per"). Returns the empty
+   * string if no limit is exhausted.
+   */
+  std::string getExhaustedLimit() const;
 
   /**
    * Spends a given resource. Calls the listener to interrupt the solver if
@@ -175,8 +194,16 @@ class ResourceManager
    */
   void registerListener(Listener* listener);
 
+  /**
+   * Sets the resource manager of the solver that created the subsolver that
+   * owns this resource manager.
+   */
+  void setParent(ResourceManager* parent) { d_parent = parent; }
+
  private:
   const Options& d_options;
+  /** The statistics registry, which is reported by d_statisticsReporter */
+  const StatisticsRegistry& d_statisticsRegistry;
 
   /**
    * If the resource manager is not enabled, then the checks whether we are out
@@ -205,15 +232,39 @@ class ResourceManager
   std::vector<Listener*> d_listeners;
 
   void spendResource(uint64_t amount);
+  /**
+   * Count a step of the resource with index i towards its budget for this
+   * call, and towards the budgets of the parents.
+   */
+  void countStep(std::size_t i);
+  /** Read the per-resource budgets from the options */
+  void readResourceBudgets();
 
   /** Weights for InferenceId resources */
   std::array<uint64_t, resman_detail::InferenceIdMax + 1> d_infidWeights;
   /** Weights for Resource resources */
   std::array<uint64_t, resman_detail::ResourceMax + 1> d_resourceWeights;
+  /** Per-call budgets for the number of steps of resources, 0 if unlimited */
+  std::array<uint64_t, resman_detail::ResourceMax + 1> d_resourceBudgets;
+  /** The number of steps of resources during this call */
+  std::array<uint64_t, resman_detail::ResourceMax + 1> d_thisCallResourceSteps;
+  /**
+   * The first resource whose budget was exhausted during this call, or
+   * Resource::Unknown.
+   */
+  Resource d_exhaustedResource;
+  /** The resource manager of the parent solver, if this is a subsolver */
+  ResourceManager* d_parent;
 
   struct Statistics;
   /** The statistics object */
   std::unique_ptr<Statistics> d_statistics;
+
+  /**
+   * Reports the statistics periodically while resources are spent, if option
+   * statisticsInterval is set.
+   */
+  std::unique_ptr<StatisticsReporter> d_statisticsReporter;
 }; /* class ResourceManager */
 
 }  // namespace cvc5::internal
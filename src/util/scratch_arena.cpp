@@ -0,0 +1,110 @@
+/******************************************************************************
+ * Top contributors (to current version):
+ *   agent
+ *
+ * This file is part of the cvc5 project.
+ *
+ * Copyright (c) 2009-2023 by the authors listed in the file AUTHORS
+ * in the top-level source directory and their institutional affiliations.
+ * All rights reserved.  See the file COPYING in the top-level source
+ * directory for licensing information.
+ * ****************************************************************************
+ *
+ * Resettable region allocator for temporary data, and STL allocators using it.
+ */
+
+#include "util/scratch_arena.h"
+
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+
+#include "base/check.h"
+
+namespace cvc5::internal {
+
+ScratchArena::ScratchArena()
+    : d_chunk(0), d_cur(nullptr), d_end(nullptr), d_bytes(0)
+{
+}
+
+ScratchArena::~ScratchArena()
+{
+  reset();
+  for (char* c : d_chunks)
+  {
+    std::free(c);
+  }
+}
+
+void* ScratchArena::allocate(size_t size, size_t align)
+{
+  Assert(align > 0 && (align & (align - 1)) == 0);
+  d_bytes += size;
+  if (size + align > CHUNK_SIZE)
+  {
+    // too large for a chunk, allocated separately, note that malloc returns
+    // memory that is suitably aligned for any fundamental type
+    Assert(align <= alignof(std::max_align_t));
+    void* p = std::malloc(size);
+    if (p == nullptr)
+    {
+      throw std::bad_alloc();
+    }
+    d_large.push_back(p);
+    return p;
+  }
+  for (;;)
+  {
+    if (d_cur != nullptr)
+    {
+      uintptr_t p = reinterpret_cast<uintptr_t>(d_cur);
+      uintptr_t mask = static_cast<uintptr_t>(align) - 1;
+      char* start = d_cur + (((p + mask) & ~mask) - p);
+      if (start + size <= d_end)
+      {
+        d_cur = start + size;
+        return start;
+      }
+    }
+    nextChunk();
+  }
+}
+
+void ScratchArena::nextChunk()
+{
+  if (d_cur != nullptr)
+  {
+    d_chunk++;
+  }
+  if (d_chunk == d_chunks.size())
+  {
+    char* c = static_cast<char*>(std::malloc(CHUNK_SIZE));
+    if (c == nullptr)
+    {
+      throw std::bad_alloc();
+    }
+    d_chunks.push_back(c);
+  }
+  d_cur = d_chunks[d_chunk];
+  d_end = d_cur + CHUNK_SIZE;
+}
+
+void ScratchArena::reset()
+{
+  for (void* p : d_large)
+  {
+    std::free(p);
+  }
+  d_large.clear();
+  d_chunk = 0;
+  d_cur = nullptr;
+  d_end = nullptr;
+  d_bytes = 0;
+}
+
+size_t ScratchArena::getBytesAllocated() const { return d_bytes; }
+
+size_t ScratchArena::getNumChunks() const { return d_chunks.size(); }
+
+}  // namespace cvc5::internal
@@ -0,0 +1,151 @@
+/******************************************************************************
+ * Top contributors (to current version):
+ *   agent
+ *
+ * This file is part of the cvc5 project.
+ *
+ * Copyright (c) 2009-2023 by the authors listed in the file AUTHORS
+ * in the top-level source directory and their institutional affiliations.
+ * All rights reserved.  See the file COPYING in the top-level source
+ * directory for licensing information.
+ * ****************************************************************************
+ *
+ * Resettable region allocator for temporary data, and STL allocators using it.
+ */
+
+#include "cvc5_private.h"
+
+#ifndef CVC5__UTIL__SCRATCH_ARENA_H
+#define CVC5__UTIL__SCRATCH_ARENA_H
+
+#include <cstddef>
+#include <functional>
+#include <map>
+#include <set>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace cvc5::internal {
+
+/**
+ * A region allocator for temporary data, e.g. the local maps and vectors of
+ * one full effort check of a theory solver.
+ *
+ * Memory is allocated by bumping a pointer into large chunks. Deallocation is
+ * a no-op, all memory is released at once by reset(), which keeps the chunks
+ * for the allocations after the reset. Hence, after the first few calls, the
+ * allocations of a check do not touch the global heap at all.
+ *
+ * It is the responsibility of the user to ensure that no data allocated in
+ * this arena is used after a call to reset(). Typically, containers using
+ * this arena are local variables of methods that are called during a check,
+ * and the arena is reset at the end of the check.
+ */
+class ScratchArena
+{
+ public:
+  /** The size of the chunks */
+  static constexpr size_t CHUNK_SIZE = static_cast<size_t>(1) << 16;
+
+  ScratchArena();
+  ~ScratchArena();
+  ScratchArena(const ScratchArena&) = delete;
+  ScratchArena& operator=(const ScratchArena&) = delete;
+
+  /** Allocate size bytes with the given alignment */
+  void* allocate(size_t size, size_t align = alignof(std::max_align_t));
+  /**
+   * Release all memory allocated since the last reset. Allocations larger
+   * than a chunk are freed, the chunks are kept.
+   */
+  void reset();
+  /** Get the number of bytes allocated since the last reset */
+  size_t getBytesAllocated() const;
+  /** Get the number of chunks owned by this arena */
+  size_t getNumChunks() const;
+
+ private:
+  /** Make the next chunk the current one, allocating it if necessary */
+  void nextChunk();
+  /** The chunks */
+  std::vector<char*> d_chunks;
+  /** The index of the current chunk in d_chunks */
+  size_t d_chunk;
+  /** The unused part of the current chunk */
+  char* d_cur;
+  /** The end of the current chunk */
+  char* d_end;
+  /** The allocations that did not fit into a chunk */
+  std::vector<void*> d_large;
+  /** The number of bytes allocated since the last reset */
+  size_t d_bytes;
+};
+
+/**
+ * An STL allocator that allocates from a scratch arena. Deallocation does
+ * nothing, the memory is released when the arena is reset.
+ */
+template <class T>
+class ScratchAllocator
+{
+ public:
+  using value_type = T;
+
+  ScratchAllocator(ScratchArena& arena) : d_arena(&arena) {}
+  template <class U>
+  ScratchAllocator(const ScratchAllocator<U>& alloc) : d_arena(alloc.getArena())
+  {
+  }
+
+  ScratchArena* getArena() const { return d_arena; }
+  T* allocate(size_t n)
+  {
+    return static_cast<T*>(d_arena->allocate(n * sizeof(T), alignof(T)));
+  }
+  void deallocate(T* p, size_t n) { /* released on reset */ }
+
+ private:
+  /** The arena */
+  ScratchArena* d_arena;
+};
+
+template <class T, class U>
+inline bool operator==(const ScratchAllocator<T>& a1,
+                       const ScratchAllocator<U>& a2)
+{
+  return a1.getArena() == a2.getArena();
+}
+
+template <class T, class U>
+inline bool operator!=(const ScratchAllocator<T>& a1,
+                       const ScratchAllocator<U>& a2)
+{
+  return a1.getArena() != a2.getArena();
+}
+
+/** STL containers allocated in a scratch arena */
+template <class T>
+using ScratchVector = std::vector<T, ScratchAllocator<T>>;
+template <class K, class V, class Compare = std::less<K>>
+using ScratchMap =
+    std::map<K, V, Compare, ScratchAllocator<std::pair<const K, V>>>;
+template <class K, class Compare = std::less<K>>
+using ScratchSet = std::set<K, Compare, ScratchAllocator<K>>;
+template <class K,
+          class V,
+          class Hash = std::hash<K>,
+          class Equal = std::equal_to<K>>
+using ScratchUnorderedMap =
+    std::unordered_map<K,
+                       V,
+                       Hash,
+                       Equal,
+                       ScratchAllocator<std::pair<const K, V>>>;
+template <class K, class Hash = std::hash<K>, class Equal = std::equal_to<K>>
+using ScratchUnorderedSet =
+    std::unordered_set<K, Hash, Equal, ScratchAllocator<K>>;
+
+}  // namespace cvc5::internal
+
+#endif /* CVC5__UTIL__SCRATCH_ARENA_H */
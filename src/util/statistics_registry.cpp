@@ -45,21 +45,34 @@ TimerStat StatisticsRegistry::registerTimer(const std::string& name,
 {
   return registerStat<TimerStat>(name, internal);
 }
+MemoryStat StatisticsRegistry::registerMemory(const std::string& name,
+                                              bool internal)
+{
+  return MemoryStat(registerInt(name + "::liveBytes", internal),
+                    registerInt(name + "::peakBytes", internal));
+}
 
 void StatisticsRegistry::storeSnapshot()
 {
   if constexpr (configuration::isStatisticsBuild())
   {
-    d_lastSnapshot = std::make_unique<Snapshot>();
+    d_lastSnapshot = std::make_unique<Snapshot>(getSnapshot());
+  }
+}
+
+StatisticsRegistry::Snapshot StatisticsRegistry::getSnapshot() const
+{
+  Snapshot res;
+  if constexpr (configuration::isStatisticsBuild())
+  {
     for (const auto& s : d_stats)
     {
       if (!options().base.statisticsInternal && s.second->d_internal) continue;
       if (!options().base.statisticsAll && s.second->isDefault()) continue;
-      d_lastSnapshot->emplace(
-          s.first,
-          s.second->getViewer());
+      res.emplace(s.first, s.second->getViewer());
     }
   }
+  return res;
 }
 
 StatisticBaseValue* StatisticsRegistry::get(const std::string& name) const
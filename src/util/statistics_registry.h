@@ -42,6 +42,9 @@
  * This allows a more efficient implementation as std::vector<std::uint64_t>
  * instead of a std::map<T, uint64_t>.
  *
+ * MemoryStat is a pair of IntStats for the live and peak memory usage of a
+ * component.
+ *
  * TimerStat uses std::chrono to collect timing information. It is
  * implemented as BackedStat<std::chrono::duration> and provides methods
  * start() and stop(), accumulating times it was activated. It provides
@@ -177,6 +180,12 @@ class StatisticsRegistry : protected EnvObj
   /** Register a new timer statistic for `name` */
   TimerStat registerTimer(const std::string& name, bool internal = true);
 
+  /**
+   * Register a new memory statistic for `name`, which consists of the integer
+   * statistics `<name>::liveBytes` and `<name>::peakBytes`.
+   */
+  MemoryStat registerMemory(const std::string& name, bool internal = true);
+
   /** Register a new value statistic for `name`. */
   template <typename T>
   ValueStat<T> registerValue(const std::string& name, bool internal = true)
@@ -205,6 +214,12 @@ class StatisticsRegistry : protected EnvObj
    */
   void storeSnapshot();
 
+  /**
+   * Returns the current state of all statistics that would be printed by
+   * print(), without storing it.
+   */
+  Snapshot getSnapshot() const;
+
   /**
    * Obtain a single statistic by name. Returns nullptr if no statistic has
    * been registered for this name.
@@ -0,0 +1,207 @@
+/******************************************************************************
+ * Top contributors (to current version):
+ *   agent
+ *
+ * This file is part of the cvc5 project.
+ *
+ * Copyright (c) 2009-2023 by the authors listed in the file AUTHORS
+ * in the top-level source directory and their institutional affiliations.
+ * All rights reserved.  See the file COPYING in the top-level source
+ * directory for licensing information.
+ * ****************************************************************************
+ *
+ * Periodic reporting of statistics.
+ */
+
+#include "util/statistics_reporter.h"
+
+#include <iomanip>
+#include <sstream>
+
+#include "util/statistics_value.h"
+
+namespace cvc5::internal {
+
+namespace {
+
+/** Print s as a JSON string */
+void printJsonString(std::ostream& os, const std::string& s)
+{
+  os << '"';
+  for (char c : s)
+  {
+    switch (c)
+    {
+      case '"': os << "\\\""; break;
+      case '\\': os << "\\\\"; break;
+      case '\n': os << "\\n"; break;
+      case '\t': os << "\\t"; break;
+      default:
+        if (static_cast<unsigned char>(c) < 0x20)
+        {
+          os << "\\u" << std::hex << std::setw(4) << std::setfill('0')
+             << static_cast<int>(c) << std::dec << std::setfill(' ');
+        }
+        else
+        {
+          os << c;
+        }
+    }
+  }
+  os << '"';
+}
+
+/**
+ * Print the value of a numeric statistic, its change since old and its
+ * change per second, where interval is the number of seconds since old.
+ */
+template <typename T>
+void printJsonNumber(std::ostream& os, T value, T old, double interval)
+{
+  os << "{\"value\":" << value << ",\"delta\":" << (value - old);
+  if (interval > 0)
+  {
+    std::streamsize precision = os.precision();
+    os << ",\"rate\":" << std::fixed << std::setprecision(3)
+       << static_cast<double>(value - old) / interval;
+    os.unsetf(std::ios_base::floatfield);
+    os.precision(precision);
+  }
+  os << "}";
+}
+
+/**
+ * Print the value of a statistic, where old is its value at the previous
+ * report, or nullptr if it was not reported yet.
+ */
+void printJsonDiff(std::ostream& os,
+                   const StatExportData& value,
+                   const StatExportData* old,
+                   double interval)
+{
+  if (const int64_t* vi = std::get_if<int64_t>(&value))
+  {
+    const int64_t* oi = old == nullptr ? nullptr : std::get_if<int64_t>(old);
+    printJsonNumber<int64_t>(os, *vi, oi == nullptr ? 0 : *oi, interval);
+  }
+  else if (const double* vd = std::get_if<double>(&value))
+  {
+    const double* od = old == nullptr ? nullptr : std::get_if<double>(old);
+    printJsonNumber<double>(os, *vd, od == nullptr ? 0 : *od, interval);
+  }
+  else if (const std::string* vs = std::get_if<std::string>(&value))
+  {
+    os << "{\"value\":";
+    printJsonString(os, *vs);
+    os << "}";
+  }
+  else
+  {
+    using Histogram = std::map<std::string, uint64_t>;
+    const Histogram& h = std::get<Histogram>(value);
+    const Histogram* o = old == nullptr ? nullptr : std::get_if<Histogram>(old);
+    os << "{";
+    bool first = true;
+    for (const std::pair<const std::string, uint64_t>& e : h)
+    {
+      int64_t ov = 0;
+      if (o != nullptr)
+      {
+        Histogram::const_iterator it = o->find(e.first);
+        if (it != o->end())
+        {
+          if (it->second == e.second)
+          {
+            continue;
+          }
+          ov = static_cast<int64_t>(it->second);
+        }
+      }
+      os << (first ? "" : ",");
+      first = false;
+      printJsonString(os, e.first);
+      os << ":";
+      printJsonNumber<int64_t>(
+          os, static_cast<int64_t>(e.second), ov, interval);
+    }
+    os << "}";
+  }
+}
+
+}  // namespace
+
+StatisticsReporter::StatisticsReporter(const StatisticsRegistry& reg,
+                                       uint64_t intervalMillis,
+                                       Callback cb)
+    : d_registry(reg),
+      d_interval(std::chrono::milliseconds(intervalMillis)),
+      d_callback(std::move(cb)),
+      d_calls(0),
+      d_start(clock::now()),
+      d_last(d_start)
+{
+}
+
+void StatisticsReporter::checkTime()
+{
+  if (clock::now() - d_last >= d_interval)
+  {
+    report();
+  }
+}
+
+void StatisticsReporter::report()
+{
+  clock::time_point now = clock::now();
+  double time = std::chrono::duration<double>(now - d_start).count();
+  double interval = std::chrono::duration<double>(now - d_last).count();
+  StatisticsRegistry::Snapshot snapshot = d_registry.getSnapshot();
+  std::stringstream ss;
+  ss << std::fixed << std::setprecision(3) << "{\"time\":" << time
+     << ",\"interval\":" << interval << ",\"stats\":{";
+  ss.unsetf(std::ios_base::floatfield);
+  ss << std::setprecision(6);
+  bool first = true;
+  for (const std::pair<const std::string, StatExportData>& s : snapshot)
+  {
+    StatisticsRegistry::Snapshot::const_iterator it =
+        d_lastSnapshot.find(s.first);
+    if (it != d_lastSnapshot.end() && it->second == s.second)
+    {
+      continue;
+    }
+    ss << (first ? "" : ",");
+    first = false;
+    printJsonString(ss, s.first);
+    ss << ":";
+    printJsonDiff(ss,
+                  s.second,
+                  it == d_lastSnapshot.end() ? nullptr : &it->second,
+                  interval);
+  }
+  // statistics that were reset to their default value are no longer in the
+  // snapshot, unless all statistics are printed
+  for (const std::pair<const std::string, StatExportData>& s : d_lastSnapshot)
+  {
+    if (snapshot.find(s.first) != snapshot.end())
+    {
+      continue;
+    }
+    StatisticBaseValue* sbv = d_registry.get(s.first);
+    if (sbv == nullptr)
+    {
+      continue;
+    }
+    ss << (first ? "" : ",");
+    first = false;
+    printJsonString(ss, s.first);
+    ss << ":";
+    printJsonDiff(ss, sbv->getViewer(), &s.second, interval);
+  }
+  ss << "}}";
+  d_lastSnapshot = std::move(snapshot);
+  d_last = now;
+  d_callback(ss.str());
+}
+
+}  // namespace cvc5::internal
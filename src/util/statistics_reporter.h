@@ -0,0 +1,106 @@
+/******************************************************************************
+ * Top contributors (to current version):
+ *   agent
+ *
+ * This file is part of the cvc5 project.
+ *
+ * Copyright (c) 2009-2023 by the authors listed in the file AUTHORS
+ * in the top-level source directory and their institutional affiliations.
+ * All rights reserved.  See the file COPYING in the top-level source
+ * directory for licensing information.
+ * ****************************************************************************
+ *
+ * Periodic reporting of statistics.
+ */
+
+#include "cvc5_private.h"
+
+#ifndef CVC5__UTIL__STATISTICS_REPORTER_H
+#define CVC5__UTIL__STATISTICS_REPORTER_H
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <string>
+
+#include "util/statistics_registry.h"
+
+namespace cvc5::internal {
+
+/**
+ * Reports the changes of the statistics of a registry at a regular interval,
+ * which allows to monitor the progress of long running queries.
+ *
+ * Each report is a single line holding a JSON object of the form
+ *
+ *   {"time":12.003,"interval":1.000,"stats":{"sat::conflicts":
+ *     {"value":5120,"delta":310,"rate":309.8}, ...}}
+ *
+ * where time is the number of seconds since the reporter was created and
+ * interval the number of seconds since the previous report. The reported
+ * statistics are those that changed since the previous report, where the
+ * statistics are filtered as for StatisticsRegistry::print. Integer and
+ * floating point statistics have their value, the change since the previous
+ * report and the change per second. Histograms are reported per entry that
+ * changed, and other statistics (e.g. timers) only have their value.
+ *
+ * The statistics are not synchronized, hence this class does not use a
+ * thread of its own. Instead, the solver calls check() frequently (see
+ * ResourceManager::spendResource), which reports if the interval has passed.
+ * Consequently, there is no report while the solver does not spend resources.
+ */
+class StatisticsReporter
+{
+ public:
+  /** The type of the callback that receives each report */
+  using Callback = std::function<void(const std::string&)>;
+
+  /**
+   * Reports the statistics of reg to the callback cb every intervalMillis
+   * milliseconds.
+   */
+  StatisticsReporter(const StatisticsRegistry& reg,
+                     uint64_t intervalMillis,
+                     Callback cb);
+
+  /**
+   * Report if the interval has passed since the previous report. Only looks
+   * at the clock every s_checkPeriod calls, hence this is cheap enough to be
+   * called for every resource spent.
+   */
+  void check()
+  {
+    if (++d_calls % s_checkPeriod == 0)
+    {
+      checkTime();
+    }
+  }
+
+  /** Report now, regardless of the interval */
+  void report();
+
+ private:
+  using clock = std::chrono::steady_clock;
+  /** The number of calls to check() per look at the clock */
+  static constexpr uint64_t s_checkPeriod = 64;
+  /** Report if the interval has passed since the previous report */
+  void checkTime();
+  /** The statistics that are reported */
+  const StatisticsRegistry& d_registry;
+  /** The interval */
+  clock::duration d_interval;
+  /** The callback that receives the reports */
+  Callback d_callback;
+  /** The number of calls to check() */
+  uint64_t d_calls;
+  /** The time at which this reporter was created */
+  clock::time_point d_start;
+  /** The time of the previous report */
+  clock::time_point d_last;
+  /** The statistics at the time of the previous report */
+  StatisticsRegistry::Snapshot d_lastSnapshot;
+};
+
+}  // namespace cvc5::internal
+
+#endif /* CVC5__UTIL__STATISTICS_REPORTER_H */
@@ -88,6 +88,15 @@ void IntStat::minAssign(int64_t val)
   }
 }
 
+void MemoryStat::set(int64_t bytes)
+{
+  if constexpr (configuration::isStatisticsBuild())
+  {
+    d_live = bytes;
+    d_peak.maxAssign(bytes);
+  }
+}
+
 void TimerStat::start()
 {
   if constexpr (configuration::isStatisticsBuild())
@@ -347,6 +347,29 @@ class IntStat : public ValueStat<int64_t>
   IntStat(stat_type* data) : ValueStat(data) {}
 };
 
+/**
+ * Collects the memory usage of some component in bytes, as a pair of integer
+ * statistics `<name>::liveBytes` and `<name>::peakBytes` (see
+ * `StatisticsRegistry::registerMemory`). The live bytes are set to a sampled
+ * value, and the peak bytes are the maximum of the live bytes seen so far.
+ */
+class MemoryStat
+{
+ public:
+  /** Allow access to private constructor */
+  friend class StatisticsRegistry;
+  /** Set the live bytes to `bytes` */
+  void set(int64_t bytes);
+
+ private:
+  /** Construct from the statistics for the live and peak bytes */
+  MemoryStat(IntStat live, IntStat peak) : d_live(live), d_peak(peak) {}
+  /** The live bytes */
+  IntStat d_live;
+  /** The peak bytes */
+  IntStat d_peak;
+};
+
 }  // namespace cvc5::internal
 
 #endif
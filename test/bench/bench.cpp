@@ -0,0 +1,343 @@
+/******************************************************************************
+ * Top contributors (to current version):
+ *   agent
+ *
+ * This file is part of the cvc5 project.
+ *
+ * Copyright (c) 2009-2023 by the authors listed in the file AUTHORS
+ * in the top-level source directory and their institutional affiliations.
+ * All rights reserved.  See the file COPYING in the top-level source
+ * directory for licensing information.
+ * ****************************************************************************
+ *
+ * Runner of the micro benchmarks.
+ *
+ * Each benchmark is first calibrated, i.e., run with an increasing number of
+ * iterations until one run takes at least the minimum time. It is then run
+ * the given number of repetitions with this number of iterations, and the
+ * median and minimum time per iteration over the repetitions are reported.
+ *
+ * Usage: cvc5-bench [--filter=<substring>] [--min-time=<seconds>]
+ *                   [--repetitions=<n>] [--json=<file>] [--list]
+ */
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "bench.h"
+#include "base/configuration.h"
+
+namespace cvc5::internal {
+namespace bench {
+
+State::State(uint64_t iterations)
+    : d_iterations(iterations),
+      d_remaining(iterations),
+      d_running(false),
+      d_elapsed(Clock::duration::zero())
+{
+}
+
+bool State::keepRunning()
+{
+  if (d_remaining == d_iterations && !d_running)
+  {
+    // first call
+    resumeTiming();
+  }
+  if (d_remaining > 0)
+  {
+    d_remaining--;
+    return true;
+  }
+  pauseTiming();
+  return false;
+}
+
+void State::pauseTiming()
+{
+  if (d_running)
+  {
+    d_elapsed += Clock::now() - d_start;
+    d_running = false;
+  }
+}
+
+void State::resumeTiming()
+{
+  if (!d_running)
+  {
+    d_start = Clock::now();
+    d_running = true;
+  }
+}
+
+void State::setCounter(const std::string& name, double value)
+{
+  d_counters[name] = value;
+}
+
+uint64_t State::getIterations() const { return d_iterations; }
+
+double State::getElapsedNs() const
+{
+  return static_cast<double>(
+      std::chrono::duration_cast<std::chrono::nanoseconds>(d_elapsed).count());
+}
+
+const std::map<std::string, double>& State::getCounters() const
+{
+  return d_counters;
+}
+
+namespace {
+
+/** The registered benchmarks */
+std::vector<std::pair<std::string, BenchmarkFunction>>& getBenchmarks()
+{
+  static std::vector<std::pair<std::string, BenchmarkFunction>> benchmarks;
+  return benchmarks;
+}
+
+/** The result of running a benchmark */
+struct Result
+{
+  std::string d_name;
+  uint64_t d_iterations;
+  double d_nsPerIter;
+  double d_nsPerIterMin;
+  std::map<std::string, double> d_counters;
+};
+
+/** Run fun for the given number of iterations */
+State runOnce(BenchmarkFunction fun, uint64_t iterations)
+{
+  State state(iterations);
+  fun(state);
+  return state;
+}
+
+Result runBenchmark(const std::string& name,
+                    BenchmarkFunction fun,
+                    double minTime,
+                    size_t repetitions)
+{
+  double minNs = minTime * 1e9;
+  uint64_t iterations = 1;
+  for (;;)
+  {
+    State state = runOnce(fun, iterations);
+    double ns = state.getElapsedNs();
+    if (ns >= minNs || iterations >= (static_cast<uint64_t>(1) << 40))
+    {
+      break;
+    }
+    // aim slightly above the minimum time, growing by at most 10x per step
+    double factor = ns > 0 ? 1.4 * minNs / ns : 10.0;
+    factor = std::min(std::max(factor, 2.0), 10.0);
+    iterations = static_cast<uint64_t>(iterations * factor);
+  }
+  std::vector<double> times;
+  Result res;
+  res.d_name = name;
+  res.d_iterations = iterations;
+  for (size_t i = 0; i < repetitions; i++)
+  {
+    State state = runOnce(fun, iterations);
+    times.push_back(state.getElapsedNs() / iterations);
+    res.d_counters = state.getCounters();
+  }
+  std::sort(times.begin(), times.end());
+  res.d_nsPerIter = times[times.size() / 2];
+  res.d_nsPerIterMin = times[0];
+  return res;
+}
+
+/** Escape s for use in a JSON string */
+std::string jsonEscape(const std::string& s)
+{
+  std::stringstream ss;
+  for (char c : s)
+  {
+    if (c == '"' || c == '\\')
+    {
+      ss << '\\' << c;
+    }
+    else if (static_cast<unsigned char>(c) < 0x20)
+    {
+      ss << "\\u" << std::hex << std::setw(4) << std::setfill('0')
+         << static_cast<int>(c) << std::dec;
+    }
+    else
+    {
+      ss << c;
+    }
+  }
+  return ss.str();
+}
+
+void printJson(std::ostream& out, const std::vector<Result>& results)
+{
+  out << "{" << std::endl;
+  out << "  \"context\": {" << std::endl;
+  out << "    \"version\": \"" << jsonEscape(Configuration::getVersionString())
+      << "\"," << std::endl;
+  out << "    \"git\": \"" << jsonEscape(Configuration::getGitInfo()) << "\","
+      << std::endl;
+  out << "    \"debug\": " << (Configuration::isDebugBuild() ? "true" : "false")
+      << "," << std::endl;
+  out << "    \"assertions\": "
+      << (Configuration::isAssertionBuild() ? "true" : "false") << std::endl;
+  out << "  }," << std::endl;
+  out << "  \"benchmarks\": [" << std::endl;
+  out << std::setprecision(6) << std::fixed;
+  for (size_t i = 0, nres = results.size(); i < nres; i++)
+  {
+    const Result& r = results[i];
+    out << "    {" << std::endl;
+    out << "      \"name\": \"" << jsonEscape(r.d_name) << "\"," << std::endl;
+    out << "      \"iterations\": " << r.d_iterations << "," << std::endl;
+    out << "      \"ns_per_iter\": " << r.d_nsPerIter << "," << std::endl;
+    out << "      \"ns_per_iter_min\": " << r.d_nsPerIterMin << ","
+        << std::endl;
+    out << "      \"counters\": {";
+    bool first = true;
+    for (const std::pair<const std::string, double>& c : r.d_counters)
+    {
+      out << (first ? "" : ",") << std::endl;
+      out << "        \"" << jsonEscape(c.first) << "\": " << c.second;
+      first = false;
+    }
+    out << (first ? "" : "\n      ") << "}" << std::endl;
+    out << "    }" << (i + 1 < nres ? "," : "") << std::endl;
+  }
+  out << "  ]" << std::endl;
+  out << "}" << std::endl;
+}
+
+void printResult(std::ostream& out, const Result& r)
+{
+  std::stringstream ss;
+  ss << std::left << std::setw(40) << r.d_name << std::right << std::fixed
+     << std::setprecision(1) << std::setw(16) << r.d_nsPerIter << " ns"
+     << std::setw(16) << r.d_nsPerIterMin << " ns " << std::setw(12)
+     << r.d_iterations;
+  for (const std::pair<const std::string, double>& c : r.d_counters)
+  {
+    ss << "  " << c.first << "=" << c.second;
+  }
+  out << ss.str() << std::endl;
+}
+
+/** Get the value of option opt if arg is of the form --opt=value */
+bool getOption(const char* arg, const char* opt, std::string& value)
+{
+  size_t len = std::strlen(opt);
+  if (std::strncmp(arg, "--", 2) == 0 && std::strncmp(arg + 2, opt, len) == 0
+      && arg[len + 2] == '=')
+  {
+    value = arg + len + 3;
+    return true;
+  }
+  return false;
+}
+
+}  // namespace
+
+bool registerBenchmark(const char* name, BenchmarkFunction fun)
+{
+  getBenchmarks().emplace_back(name, fun);
+  return true;
+}
+
+int runMain(int argc, char* argv[])
+{
+  std::string filter;
+  std::string json;
+  double minTime = 0.5;
+  size_t repetitions = 3;
+  bool list = false;
+  for (int i = 1; i < argc; i++)
+  {
+    std::string value;
+    if (getOption(argv[i], "filter", value))
+    {
+      filter = value;
+    }
+    else if (getOption(argv[i], "json", value))
+    {
+      json = value;
+    }
+    else if (getOption(argv[i], "min-time", value))
+    {
+      minTime = std::atof(value.c_str());
+    }
+    else if (getOption(argv[i], "repetitions", value))
+    {
+      repetitions = std::max(std::atoi(value.c_str()), 1);
+    }
+    else if (std::strcmp(argv[i], "--list") == 0)
+    {
+      list = true;
+    }
+    else
+    {
+      std::cerr << "usage: " << argv[0]
+                << " [--filter=<substring>] [--min-time=<seconds>]"
+                   " [--repetitions=<n>] [--json=<file>] [--list]"
+                << std::endl;
+      return 1;
+    }
+  }
+  std::vector<std::pair<std::string, BenchmarkFunction>> benchmarks =
+      getBenchmarks();
+  std::sort(benchmarks.begin(), benchmarks.end());
+  if (Configuration::isAssertionBuild())
+  {
+    std::cerr << "warning: assertions are enabled, timings are not "
+                 "representative"
+              << std::endl;
+  }
+  std::vector<Result> results;
+  for (const std::pair<std::string, BenchmarkFunction>& b : benchmarks)
+  {
+    if (b.first.find(filter) == std::string::npos)
+    {
+      continue;
+    }
+    if (list)
+    {
+      std::cout << b.first << std::endl;
+      continue;
+    }
+    results.push_back(runBenchmark(b.first, b.second, minTime, repetitions));
+    printResult(std::cout, results.back());
+  }
+  if (!json.empty())
+  {
+    std::ofstream out(json);
+    if (!out)
+    {
+      std::cerr << "cannot open " << json << std::endl;
+      return 1;
+    }
+    printJson(out, results);
+  }
+  return 0;
+}
+
+}  // namespace bench
+}  // namespace cvc5::internal
+
+int main(int argc, char* argv[])
+{
+  return cvc5::internal::bench::runMain(argc, argv);
+}
@@ -0,0 +1,122 @@
+/******************************************************************************
+ * Top contributors (to current version):
+ *   agent
+ *
+ * This file is part of the cvc5 project.
+ *
+ * Copyright (c) 2009-2023 by the authors listed in the file AUTHORS
+ * in the top-level source directory and their institutional affiliations.
+ * All rights reserved.  See the file COPYING in the top-level source
+ * directory for licensing information.
+ * ****************************************************************************
+ *
+ * Common header for micro benchmarks.
+ */
+
+#ifndef CVC5__TEST__BENCH__BENCH_H
+#define CVC5__TEST__BENCH__BENCH_H
+
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace cvc5::internal {
+namespace bench {
+
+/**
+ * The state of one run of a benchmark, which determines how many iterations
+ * are run and measures the time they take. A benchmark function has the form
+ *
+ *   CVC5_BENCHMARK(expr, my_benchmark)
+ *   {
+ *     // setup, which is not timed
+ *     while (state.keepRunning())
+ *     {
+ *       // the code to measure
+ *     }
+ *   }
+ *
+ * Work inside the loop that should not be measured can be excluded by
+ * pauseTiming() and resumeTiming().
+ */
+class State
+{
+ public:
+  State(uint64_t iterations);
+  /**
+   * Returns true if another iteration should be run. The timer is started by
+   * the first call and stopped by the call that returns false.
+   */
+  bool keepRunning();
+  /** Stop the timer until resumeTiming() is called */
+  void pauseTiming();
+  /** Restart the timer after pauseTiming() */
+  void resumeTiming();
+  /**
+   * Set a user-defined counter, e.g. the value of a statistic, which is
+   * reported together with the timing.
+   */
+  void setCounter(const std::string& name, double value);
+  /** Get the number of iterations of this run */
+  uint64_t getIterations() const;
+  /** Get the measured time in nanoseconds */
+  double getElapsedNs() const;
+  /** Get the counters */
+  const std::map<std::string, double>& getCounters() const;
+
+ private:
+  using Clock = std::chrono::steady_clock;
+  /** The number of iterations */
+  uint64_t d_iterations;
+  /** The number of iterations that remain to be run */
+  uint64_t d_remaining;
+  /** Whether the timer is running */
+  bool d_running;
+  /** When the timer was last started */
+  Clock::time_point d_start;
+  /** The time measured so far */
+  Clock::duration d_elapsed;
+  /** The counters */
+  std::map<std::string, double> d_counters;
+};
+
+/** The type of benchmark functions */
+using BenchmarkFunction = void (*)(State&);
+
+/**
+ * Register a benchmark, returns true. This is called via CVC5_BENCHMARK
+ * during static initialization.
+ */
+bool registerBenchmark(const char* name, BenchmarkFunction fun);
+
+/**
+ * Prevent the compiler from optimizing away the computation of a value that
+ * is otherwise unused in a benchmark.
+ */
+template <class T>
+inline void doNotOptimize(const T& value)
+{
+  asm volatile("" : : "r,m"(value) : "memory");
+}
+
+}  // namespace bench
+}  // namespace cvc5::internal
+
+/**
+ * Define and register the benchmark with the given name in the given group,
+ * which is reported as "<group>/<name>". The body of the benchmark follows
+ * the macro and has access to the bench::State as variable state.
+ */
+#define CVC5_BENCHMARK(group, name)                                     \
+  static void cvc5_bench_##group##_##name(                              \
+      ::cvc5::internal::bench::State& state);                           \
+  [[maybe_unused]] static const bool                                    \
+      cvc5_bench_registered_##group##_##name =                          \
+          ::cvc5::internal::bench::registerBenchmark(                   \
+              #group "/" #name, cvc5_bench_##group##_##name);           \
+  static void cvc5_bench_##group##_##name(                              \
+      [[maybe_unused]] ::cvc5::internal::bench::State& state)
+
+#endif
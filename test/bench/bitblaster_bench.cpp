@@ -0,0 +1,92 @@
+/******************************************************************************
+ * Top contributors (to current version):
+ *   agent
+ *
+ * This file is part of the cvc5 project.
+ *
+ * Copyright (c) 2009-2023 by the authors listed in the file AUTHORS
+ * in the top-level source directory and their institutional affiliations.
+ * All rights reserved.  See the file COPYING in the top-level source
+ * directory for licensing information.
+ * ****************************************************************************
+ *
+ * Micro benchmarks of bit-blasting.
+ */
+
+#include <vector>
+
+#include "bench.h"
+#include "expr/node.h"
+#include "expr/node_manager.h"
+#include "expr/skolem_manager.h"
+#include "smt/solver_engine.h"
+#include "theory/bv/bitblast/node_bitblaster.h"
+#include "theory/theory_state.h"
+#include "theory/valuation.h"
+
+namespace cvc5::internal {
+namespace bench {
+
+using namespace theory;
+
+namespace {
+
+/**
+ * Bit-blast an atom built by mkAtom from fresh variables of the given width,
+ * so that no term is in the cache of the bit-blaster.
+ */
+template <class MkAtom>
+void bitblastFresh(State& state, uint32_t width, MkAtom mkAtom)
+{
+  SolverEngine slv;
+  slv.finishInit();
+  NodeManager* nm = NodeManager::currentNM();
+  SkolemManager* sm = nm->getSkolemManager();
+  TheoryState ts(slv.getEnv(), Valuation(nullptr));
+  bv::NodeBitblaster bb(slv.getEnv(), &ts);
+  TypeNode t = nm->mkBitVectorType(width);
+  while (state.keepRunning())
+  {
+    state.pauseTiming();
+    Node x = sm->mkDummySkolem("x", t);
+    Node y = sm->mkDummySkolem("y", t);
+    Node z = sm->mkDummySkolem("z", t);
+    Node atom = mkAtom(nm, x, y, z);
+    state.resumeTiming();
+    bb.bbAtom(atom);
+  }
+}
+
+}  // namespace
+
+CVC5_BENCHMARK(bitblaster, add_32)
+{
+  bitblastFresh(state, 32, [](NodeManager* nm, Node x, Node y, Node z) {
+    return nm->mkNode(kind::BITVECTOR_ADD, x, y).eqNode(z);
+  });
+}
+
+CVC5_BENCHMARK(bitblaster, mult_32)
+{
+  bitblastFresh(state, 32, [](NodeManager* nm, Node x, Node y, Node z) {
+    return nm->mkNode(kind::BITVECTOR_MULT, x, y).eqNode(z);
+  });
+}
+
+CVC5_BENCHMARK(bitblaster, udiv_16)
+{
+  bitblastFresh(state, 16, [](NodeManager* nm, Node x, Node y, Node z) {
+    return nm->mkNode(kind::BITVECTOR_UDIV, x, y).eqNode(z);
+  });
+}
+
+CVC5_BENCHMARK(bitblaster, ult_64)
+{
+  bitblastFresh(state, 64, [](NodeManager* nm, Node x, Node y, Node z) {
+    return nm->mkNode(
+        kind::BITVECTOR_ULT, nm->mkNode(kind::BITVECTOR_SUB, x, z), y);
+  });
+}
+
+}  // namespace bench
+}  // namespace cvc5::internal
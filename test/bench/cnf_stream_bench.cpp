@@ -0,0 +1,133 @@
+/******************************************************************************
+ * Top contributors (to current version):
+ *   agent
+ *
+ * This file is part of the cvc5 project.
+ *
+ * Copyright (c) 2009-2023 by the authors listed in the file AUTHORS
+ * in the top-level source directory and their institutional affiliations.
+ * All rights reserved.  See the file COPYING in the top-level source
+ * directory for licensing information.
+ * ****************************************************************************
+ *
+ * Micro benchmarks of the conversion to CNF.
+ */
+
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "bench.h"
+#include "context/context.h"
+#include "expr/node.h"
+#include "expr/node_manager.h"
+#include "expr/skolem_manager.h"
+#include "prop/cnf_stream.h"
+#include "prop/registrar.h"
+#include "prop/sat_solver.h"
+#include "smt/solver_engine.h"
+
+namespace cvc5::internal {
+namespace bench {
+
+using namespace prop;
+
+namespace {
+
+/** A SAT solver that only counts its variables and clauses */
+class CountingSatSolver : public SatSolver
+{
+ public:
+  CountingSatSolver() : d_nextVar(0), d_numClauses(0) {}
+
+  SatVariable newVar(bool theoryAtom, bool canErase) override
+  {
+    return d_nextVar++;
+  }
+  SatVariable trueVar() override { return d_nextVar++; }
+  SatVariable falseVar() override { return d_nextVar++; }
+  ClauseId addClause(SatClause& c, bool lemma) override
+  {
+    d_numClauses++;
+    return ClauseIdUndef;
+  }
+  ClauseId addXorClause(SatClause& clause, bool rhs, bool removable) override
+  {
+    d_numClauses++;
+    return ClauseIdUndef;
+  }
+  bool nativeXor() override { return false; }
+  unsigned getAssertionLevel() const override { return 0; }
+  void interrupt() override {}
+  SatValue solve() override { return SAT_VALUE_UNKNOWN; }
+  SatValue solve(long unsigned int& resource) override
+  {
+    return SAT_VALUE_UNKNOWN;
+  }
+  SatValue value(SatLiteral l) override { return SAT_VALUE_UNKNOWN; }
+  SatValue modelValue(SatLiteral l) override { return SAT_VALUE_UNKNOWN; }
+  bool ok() const override { return true; }
+
+  /** The number of clauses added */
+  uint64_t getNumClauses() const { return d_numClauses; }
+
+ private:
+  SatVariable d_nextVar;
+  uint64_t d_numClauses;
+};
+
+}  // namespace
+
+/**
+ * Convert random Boolean formulas over a fixed set of atoms, each of which
+ * has a fresh subformula so that it is not cached.
+ */
+CVC5_BENCHMARK(cnf_stream, convert_and_assert)
+{
+  SolverEngine slv;
+  slv.finishInit();
+  NodeManager* nm = NodeManager::currentNM();
+  SkolemManager* sm = nm->getSkolemManager();
+  CountingSatSolver sat;
+  NullRegistrar registrar;
+  context::Context context;
+  CnfStream cnf(slv.getEnv(), &sat, &registrar, &context);
+  std::mt19937 rng(42);
+  std::vector<Node> atoms;
+  for (size_t i = 0; i < 64; i++)
+  {
+    atoms.push_back(sm->mkDummySkolem("p", nm->booleanType()));
+  }
+  Kind kinds[] = {kind::AND, kind::OR, kind::XOR, kind::IMPLIES, kind::EQUAL};
+  uint64_t numFormulas = 0;
+  while (state.keepRunning())
+  {
+    state.pauseTiming();
+    std::vector<Node> nodes{sm->mkDummySkolem("p", nm->booleanType())};
+    for (size_t i = 0; i < 128; i++)
+    {
+      Node a = nodes[rng() % nodes.size()];
+      Node b = atoms[rng() % atoms.size()];
+      if (rng() % 4 == 0)
+      {
+        Node c = nodes[rng() % nodes.size()];
+        nodes.push_back(nm->mkNode(kind::ITE, b, a, c));
+      }
+      else
+      {
+        nodes.push_back(nm->mkNode(kinds[rng() % 5], a, b));
+      }
+    }
+    Node n = nm->mkNode(kind::AND, nodes);
+    state.resumeTiming();
+    cnf.convertAndAssert(n, false, false);
+    numFormulas++;
+  }
+  state.setCounter("clauses_per_formula",
+                   numFormulas == 0 ? 0.0
+                                    : static_cast<double>(sat.getNumClauses())
+                                          / numFormulas);
+}
+
+}  // namespace bench
+}  // namespace cvc5::internal
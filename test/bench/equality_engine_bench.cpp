@@ -0,0 +1,125 @@
+/******************************************************************************
+ * Top contributors (to current version):
+ *   agent
+ *
+ * This file is part of the cvc5 project.
+ *
+ * Copyright (c) 2009-2023 by the authors listed in the file AUTHORS
+ * in the top-level source directory and their institutional affiliations.
+ * All rights reserved.  See the file COPYING in the top-level source
+ * directory for licensing information.
+ * ****************************************************************************
+ *
+ * Micro benchmarks of the equality engine.
+ */
+
+#include <algorithm>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "bench.h"
+#include "context/context.h"
+#include "expr/node.h"
+#include "expr/node_manager.h"
+#include "expr/skolem_manager.h"
+#include "smt/env.h"
+#include "smt/solver_engine.h"
+#include "theory/uf/equality_engine.h"
+
+namespace cvc5::internal {
+namespace bench {
+
+using namespace theory::eq;
+
+namespace {
+
+/** The number of constants of the benchmarks */
+constexpr size_t s_numConsts = 256;
+
+/**
+ * An equality engine over s_numConsts constants x_i, together with the
+ * applications f(x_i) of a unary function, whose equalities are asserted in a
+ * random order within a context level.
+ */
+class EqualityEngineBench
+{
+ public:
+  EqualityEngineBench() : d_nm(NodeManager::currentNM()), d_rng(42)
+  {
+    d_slv.finishInit();
+    d_ee.reset(new EqualityEngine(d_slv.getEnv(), &d_context, "bench", false));
+    d_ee->addFunctionKind(kind::APPLY_UF);
+    TypeNode u = d_nm->mkSort("U");
+    SkolemManager* sm = d_nm->getSkolemManager();
+    Node f = sm->mkDummySkolem("f", d_nm->mkFunctionType(u, u));
+    for (size_t i = 0; i < s_numConsts; i++)
+    {
+      Node x = sm->mkDummySkolem("x", u);
+      d_consts.push_back(x);
+      d_apps.push_back(d_nm->mkNode(kind::APPLY_UF, f, x));
+      d_ee->addTerm(d_apps.back());
+    }
+    for (size_t i = 0; i < s_numConsts; i++)
+    {
+      d_eqs.push_back(d_consts[i].eqNode(d_consts[(i + 1) % s_numConsts]));
+    }
+  }
+
+  /** Assert the equalities in a random order */
+  void assertEqualities()
+  {
+    std::shuffle(d_eqs.begin(), d_eqs.end(), d_rng);
+    for (const Node& eq : d_eqs)
+    {
+      d_ee->assertEquality(eq, true, eq);
+    }
+  }
+
+  NodeManager* d_nm;
+  std::mt19937 d_rng;
+  SolverEngine d_slv;
+  context::Context d_context;
+  std::unique_ptr<EqualityEngine> d_ee;
+  std::vector<Node> d_consts;
+  std::vector<Node> d_apps;
+  std::vector<Node> d_eqs;
+};
+
+}  // namespace
+
+/**
+ * Merge all constants, including the congruence closure of the applications,
+ * and backtrack.
+ */
+CVC5_BENCHMARK(equality_engine, merge)
+{
+  EqualityEngineBench b;
+  while (state.keepRunning())
+  {
+    b.d_context.push();
+    b.assertEqualities();
+    b.d_context.pop();
+  }
+}
+
+/** Explain the equality of random pairs of applications */
+CVC5_BENCHMARK(equality_engine, explain)
+{
+  EqualityEngineBench b;
+  b.d_context.push();
+  b.assertEqualities();
+  std::vector<TNode> assumptions;
+  while (state.keepRunning())
+  {
+    TNode t1 = b.d_apps[b.d_rng() % s_numConsts];
+    TNode t2 = b.d_apps[b.d_rng() % s_numConsts];
+    assumptions.clear();
+    b.d_ee->explainEquality(t1, t2, true, assumptions);
+    doNotOptimize(assumptions.size());
+  }
+  b.d_context.pop();
+}
+
+}  // namespace bench
+}  // namespace cvc5::internal
@@ -0,0 +1,145 @@
+/******************************************************************************
+ * Top contributors (to current version):
+ *   agent
+ *
+ * This file is part of the cvc5 project.
+ *
+ * Copyright (c) 2009-2023 by the authors listed in the file AUTHORS
+ * in the top-level source directory and their institutional affiliations.
+ * All rights reserved.  See the file COPYING in the top-level source
+ * directory for licensing information.
+ * ****************************************************************************
+ *
+ * Micro benchmarks of the construction of nodes and of attribute accesses.
+ */
+
+#include <vector>
+
+#include "bench.h"
+#include "expr/attribute.h"
+#include "expr/node.h"
+#include "expr/node_manager.h"
+#include "util/rational.h"
+
+namespace cvc5::internal {
+namespace bench {
+
+/** Construct nodes that already exist, i.e., lookups in the node pool */
+CVC5_BENCHMARK(node_manager, mk_node_existing)
+{
+  NodeManager* nm = NodeManager::currentNM();
+  std::vector<Node> vars;
+  for (size_t i = 0; i < 64; i++)
+  {
+    vars.push_back(nm->mkBoundVar(nm->integerType()));
+  }
+  std::vector<Node> keep;
+  for (size_t i = 0; i < 64; i++)
+  {
+    keep.push_back(nm->mkNode(kind::ADD, vars[i], vars[(i * 7 + 3) % 64]));
+  }
+  size_t i = 0;
+  while (state.keepRunning())
+  {
+    Node n = nm->mkNode(kind::ADD, vars[i % 64], vars[(i * 7 + 3) % 64]);
+    doNotOptimize(n);
+    i++;
+  }
+}
+
+/**
+ * Construct nodes that do not exist yet, which are immediately garbage, i.e.,
+ * insertions into the node pool and their reclamation.
+ */
+CVC5_BENCHMARK(node_manager, mk_node_new)
+{
+  NodeManager* nm = NodeManager::currentNM();
+  Node x = nm->mkBoundVar(nm->integerType());
+  Node y = nm->mkBoundVar(nm->integerType());
+  int64_t i = 0;
+  while (state.keepRunning())
+  {
+    Node c = nm->mkConstInt(Rational(i));
+    Node n = nm->mkNode(kind::ADD, x, nm->mkNode(kind::MULT, c, y));
+    doNotOptimize(n);
+    i++;
+  }
+}
+
+/** Construct nodes with many children */
+CVC5_BENCHMARK(node_manager, mk_node_nary)
+{
+  NodeManager* nm = NodeManager::currentNM();
+  std::vector<Node> vars;
+  for (size_t i = 0; i < 32; i++)
+  {
+    vars.push_back(nm->mkBoundVar(nm->booleanType()));
+  }
+  while (state.keepRunning())
+  {
+    // a new node, since the first child is new
+    vars[0] = nm->mkBoundVar(nm->booleanType());
+    Node n = nm->mkNode(kind::AND, vars);
+    doNotOptimize(n);
+  }
+}
+
+/** Construct bound variables */
+CVC5_BENCHMARK(node_manager, mk_bound_var)
+{
+  NodeManager* nm = NodeManager::currentNM();
+  TypeNode t = nm->integerType();
+  while (state.keepRunning())
+  {
+    Node v = nm->mkBoundVar(t);
+    doNotOptimize(v);
+  }
+}
+
+struct BenchAttributeId
+{
+};
+/** An attribute for the benchmarks below */
+using BenchAttribute = expr::Attribute<BenchAttributeId, uint64_t>;
+
+/**
+ * Get attributes of nodes of the node manager of this thread, which is not
+ * shared, hence the accesses are not locked.
+ */
+CVC5_BENCHMARK(node_manager, get_attribute)
+{
+  NodeManager* nm = NodeManager::currentNM();
+  std::vector<Node> vars;
+  for (size_t i = 0; i < 1024; i++)
+  {
+    vars.push_back(nm->mkBoundVar(nm->integerType()));
+    vars.back().setAttribute(BenchAttribute(), i);
+  }
+  size_t i = 0;
+  while (state.keepRunning())
+  {
+    uint64_t v = vars[i % 1024].getAttribute(BenchAttribute());
+    doNotOptimize(v);
+    i++;
+  }
+}
+
+/** Set attributes of nodes of the node manager of this thread */
+CVC5_BENCHMARK(node_manager, set_attribute)
+{
+  NodeManager* nm = NodeManager::currentNM();
+  std::vector<Node> vars;
+  for (size_t i = 0; i < 1024; i++)
+  {
+    vars.push_back(nm->mkBoundVar(nm->integerType()));
+  }
+  size_t i = 0;
+  while (state.keepRunning())
+  {
+    vars[i % 1024].setAttribute(BenchAttribute(), i);
+    i++;
+  }
+}
+
+}  // namespace bench
+}  // namespace cvc5::internal
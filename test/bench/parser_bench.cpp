@@ -0,0 +1,98 @@
+/******************************************************************************
+ * Top contributors (to current version):
+ *   agent
+ *
+ * This file is part of the cvc5 project.
+ *
+ * Copyright (c) 2009-2023 by the authors listed in the file AUTHORS
+ * in the top-level source directory and their institutional affiliations.
+ * All rights reserved.  See the file COPYING in the top-level source
+ * directory for licensing information.
+ * ****************************************************************************
+ *
+ * Micro benchmarks of the SMT-LIB parser.
+ */
+
+#include <cvc5/cvc5.h>
+
+#include <memory>
+#include <random>
+#include <sstream>
+#include <string>
+
+#include "bench.h"
+#include "parser/api/cpp/command.h"
+#include "parser/api/cpp/input_parser.h"
+#include "parser/api/cpp/symbol_manager.h"
+
+namespace cvc5::internal {
+namespace bench {
+
+namespace {
+
+/**
+ * Make an SMT-LIB problem with the given number of declarations and
+ * assertions of nested linear integer terms.
+ */
+std::string mkProblem(size_t numVars, size_t numAsserts)
+{
+  std::mt19937 rng(42);
+  std::stringstream ss;
+  ss << "(set-logic QF_LIA)" << std::endl;
+  for (size_t i = 0; i < numVars; i++)
+  {
+    ss << "(declare-fun x" << i << " () Int)" << std::endl;
+  }
+  for (size_t i = 0; i < numAsserts; i++)
+  {
+    ss << "(assert (let ((s (+";
+    for (size_t j = 0; j < 8; j++)
+    {
+      ss << " (* " << (rng() % 100) << " x" << (rng() % numVars) << ")";
+    }
+    ss << "))) (or (<= s " << (rng() % 1000) << ") (>= (- s x"
+       << (rng() % numVars) << ") " << (rng() % 1000) << "))))" << std::endl;
+  }
+  return ss.str();
+}
+
+}  // namespace
+
+/**
+ * Parse and execute the commands of a problem, which declares the symbols
+ * and asserts the formulas without checking satisfiability.
+ */
+CVC5_BENCHMARK(parser, smt2_commands)
+{
+  std::string problem = mkProblem(200, 1000);
+  uint64_t numCommands = 0;
+  while (state.keepRunning())
+  {
+    state.pauseTiming();
+    std::unique_ptr<cvc5::Solver> solver(new cvc5::Solver());
+    std::unique_ptr<cvc5::parser::SymbolManager> sm(
+        new cvc5::parser::SymbolManager(solver.get()));
+    std::istringstream input(problem);
+    state.resumeTiming();
+    {
+      cvc5::parser::InputParser ip(solver.get(), sm.get());
+      ip.setStreamInput("LANG_SMTLIB_V2_6", input, "bench");
+      std::unique_ptr<cvc5::parser::Command> cmd;
+      while ((cmd = ip.nextCommand()) != nullptr)
+      {
+        cmd->invoke(solver.get(), sm.get());
+        numCommands++;
+      }
+    }
+    state.pauseTiming();
+    sm.reset();
+    solver.reset();
+    state.resumeTiming();
+  }
+  state.setCounter("bytes", static_cast<double>(problem.size()));
+  state.setCounter("commands",
+                   static_cast<double>(numCommands) / state.getIterations());
+}
+
+}  // namespace bench
+}  // namespace cvc5::internal
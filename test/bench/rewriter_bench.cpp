@@ -0,0 +1,142 @@
+/******************************************************************************
+ * Top contributors (to current version):
+ *   agent
+ *
+ * This file is part of the cvc5 project.
+ *
+ * Copyright (c) 2009-2023 by the authors listed in the file AUTHORS
+ * in the top-level source directory and their institutional affiliations.
+ * All rights reserved.  See the file COPYING in the top-level source
+ * directory for licensing information.
+ * ****************************************************************************
+ *
+ * Micro benchmarks of the rewriter.
+ */
+
+#include <random>
+#include <vector>
+
+#include "bench.h"
+#include "expr/node.h"
+#include "expr/node_manager.h"
+#include "expr/skolem_manager.h"
+#include "smt/env.h"
+#include "smt/solver_engine.h"
+#include "theory/rewriter.h"
+#include "util/rational.h"
+
+namespace cvc5::internal {
+namespace bench {
+
+namespace {
+
+/**
+ * Make a random linear sum over vars of the given length, with the constant
+ * id as the first summand, so that the terms of different ids are different.
+ */
+Node mkSum(NodeManager* nm,
+           const std::vector<Node>& vars,
+           size_t len,
+           int64_t id,
+           std::mt19937& rng)
+{
+  std::vector<Node> children;
+  children.push_back(nm->mkConstInt(Rational(id)));
+  for (size_t i = 0; i < len; i++)
+  {
+    Node c = nm->mkConstInt(Rational(static_cast<int64_t>(rng() % 9) - 4));
+    Node v = vars[rng() % vars.size()];
+    children.push_back(nm->mkNode(kind::MULT, c, v));
+  }
+  return nm->mkNode(kind::ADD, children);
+}
+
+}  // namespace
+
+/** Rewrite linear integer inequalities that were not rewritten before */
+CVC5_BENCHMARK(rewriter, arith_linear)
+{
+  SolverEngine slv;
+  slv.finishInit();
+  NodeManager* nm = NodeManager::currentNM();
+  SkolemManager* sm = nm->getSkolemManager();
+  theory::Rewriter* rr = slv.getEnv().getRewriter();
+  std::mt19937 rng(42);
+  std::vector<Node> vars;
+  for (size_t i = 0; i < 16; i++)
+  {
+    vars.push_back(sm->mkDummySkolem("x", nm->integerType()));
+  }
+  int64_t id = 0;
+  while (state.keepRunning())
+  {
+    state.pauseTiming();
+    Node lhs = mkSum(nm, vars, 12, id++, rng);
+    Node rhs = mkSum(nm, vars, 4, 0, rng);
+    Node n = nm->mkNode(kind::LEQ, lhs, rhs);
+    state.resumeTiming();
+    Node r = rr->rewrite(n);
+    doNotOptimize(r);
+  }
+}
+
+/** Rewrite Boolean formulas that were not rewritten before */
+CVC5_BENCHMARK(rewriter, bool_nested)
+{
+  SolverEngine slv;
+  slv.finishInit();
+  NodeManager* nm = NodeManager::currentNM();
+  SkolemManager* sm = nm->getSkolemManager();
+  theory::Rewriter* rr = slv.getEnv().getRewriter();
+  std::mt19937 rng(42);
+  std::vector<Node> atoms;
+  for (size_t i = 0; i < 16; i++)
+  {
+    atoms.push_back(sm->mkDummySkolem("p", nm->booleanType()));
+  }
+  Kind kinds[] = {kind::AND, kind::OR, kind::XOR, kind::IMPLIES};
+  while (state.keepRunning())
+  {
+    state.pauseTiming();
+    // a fresh atom ensures the formula was not rewritten before
+    std::vector<Node> nodes{sm->mkDummySkolem("p", nm->booleanType())};
+    for (size_t i = 0; i < 64; i++)
+    {
+      Node a = nodes[rng() % nodes.size()];
+      Node b = rng() % 2 == 0 ? atoms[rng() % atoms.size()]
+                              : nodes[rng() % nodes.size()];
+      nodes.push_back(nm->mkNode(kinds[rng() % 4], a, b.notNode()));
+    }
+    Node n = nodes.back();
+    state.resumeTiming();
+    Node r = rr->rewrite(n);
+    doNotOptimize(r);
+  }
+}
+
+/** Rewrite a term whose rewritten form is cached */
+CVC5_BENCHMARK(rewriter, cached)
+{
+  SolverEngine slv;
+  slv.finishInit();
+  NodeManager* nm = NodeManager::currentNM();
+  SkolemManager* sm = nm->getSkolemManager();
+  theory::Rewriter* rr = slv.getEnv().getRewriter();
+  std::mt19937 rng(42);
+  std::vector<Node> vars;
+  for (size_t i = 0; i < 16; i++)
+  {
+    vars.push_back(sm->mkDummySkolem("x", nm->integerType()));
+  }
+  Node n = nm->mkNode(
+      kind::LEQ, mkSum(nm, vars, 12, 0, rng), mkSum(nm, vars, 4, 0, rng));
+  rr->rewrite(n);
+  while (state.keepRunning())
+  {
+    Node r = rr->rewrite(n);
+    doNotOptimize(r);
+  }
+}
+
+}  // namespace bench
+}  // namespace cvc5::internal
@@ -0,0 +1,218 @@
+#!/usr/bin/env python3
+###############################################################################
+# Top contributors (to current version):
+#   agent
+#
+# This file is part of the cvc5 project.
+#
+# Copyright (c) 2009-2023 by the authors listed in the file AUTHORS
+# in the top-level source directory and their institutional affiliations.
+# All rights reserved.  See the file COPYING in the top-level source
+# directory for licensing information.
+# #############################################################################
+##
+"""
+Runs the performance benchmarks and compares their results across commits.
+
+  run_bench.py micro --output <json> <cvc5-bench> [args...]
+    Runs the micro benchmarks, where args are passed to cvc5-bench (e.g.
+    --filter=rewriter).
+
+  run_bench.py regress --output <json> <cvc5> [--list <file>]
+    Runs the cvc5 binary on the regression benchmarks listed in <file>
+    (regress_benchmarks.txt by default) and records the wall clock time, the
+    result and the numeric statistics of each benchmark.
+
+  run_bench.py compare <old json> <new json> [--threshold <percent>]
+    Compares two result files of the same kind and reports the benchmarks
+    whose time changed by more than the threshold. The exit code is 1 if some
+    benchmark got slower or changed its result.
+"""
+
+import argparse
+import json
+import os
+import re
+import shlex
+import statistics
+import subprocess
+import sys
+import time
+
+SCRIPT_DIR = os.path.dirname(os.path.abspath(__file__))
+REGRESS_DIR = os.path.join(SCRIPT_DIR, os.pardir, 'regress', 'cli')
+DEFAULT_LIST = os.path.join(SCRIPT_DIR, 'regress_benchmarks.txt')
+
+STAT_REGEX = re.compile(r'^([^\s=]+) = (-?[0-9.]+)(ms)?$')
+
+
+def get_git_info():
+    """Returns the current commit of the source tree, if available."""
+    try:
+        return subprocess.check_output(
+            ['git', 'rev-parse', 'HEAD'],
+            cwd=SCRIPT_DIR,
+            stderr=subprocess.DEVNULL).decode().strip()
+    except (OSError, subprocess.CalledProcessError):
+        return ''
+
+
+def parse_stats(output):
+    """Returns the numeric statistics printed by --stats in output."""
+    stats = {}
+    for line in output.splitlines():
+        m = STAT_REGEX.match(line.strip())
+        if m:
+            stats[m.group(1)] = float(m.group(2))
+    return stats
+
+
+def read_benchmark_list(filename):
+    """
+    Returns the pairs of benchmark and options of the list in filename, where
+    each line is a benchmark relative to test/regress/cli followed by options,
+    and comments start with #.
+    """
+    benchmarks = []
+    with open(filename) as f:
+        for line in f:
+            line = line.split('#', 1)[0].strip()
+            if line:
+                parts = shlex.split(line)
+                benchmarks.append((parts[0], parts[1:]))
+    return benchmarks
+
+
+def run_micro(args, rest):
+    cmd = [args.binary, '--json=' + args.output] + rest
+    print(' '.join(cmd))
+    return subprocess.call(cmd)
+
+
+def run_regress(args):
+    results = []
+    for benchmark, options in read_benchmark_list(args.list):
+        path = os.path.join(REGRESS_DIR, benchmark)
+        cmd = [args.binary, '--stats', '--stats-internal'] + options + [path]
+        times = []
+        result = 'timeout'
+        stats = {}
+        for _ in range(args.repetitions):
+            start = time.monotonic()
+            try:
+                proc = subprocess.run(cmd,
+                                      stdout=subprocess.PIPE,
+                                      stderr=subprocess.PIPE,
+                                      timeout=args.timeout)
+            except subprocess.TimeoutExpired:
+                times.append(args.timeout * 1000.0)
+                break
+            times.append((time.monotonic() - start) * 1000.0)
+            out = proc.stdout.decode(errors='replace').split()
+            result = out[0] if out else 'error'
+            stats = parse_stats(proc.stderr.decode(errors='replace'))
+        entry = {
+            'name': benchmark,
+            'options': options,
+            'result': result,
+            'time_ms': statistics.median(times),
+            'time_ms_min': min(times),
+            'stats': stats,
+        }
+        results.append(entry)
+        print('{:<70} {:>10} {:>12.1f} ms'.format(benchmark, result,
+                                                   entry['time_ms']))
+    data = {
+        'context': {
+            'binary': os.path.abspath(args.binary),
+            'git': get_git_info(),
+        },
+        'benchmarks': results,
+    }
+    with open(args.output, 'w') as f:
+        json.dump(data, f, indent=2)
+    return 0
+
+
+def get_time(entry):
+    """Returns the time of a micro or regression benchmark entry."""
+    return entry['ns_per_iter'] if 'ns_per_iter' in entry else entry['time_ms']
+
+
+def compare(args):
+    with open(args.old) as f:
+        old = {b['name']: b for b in json.load(f)['benchmarks']}
+    with open(args.new) as f:
+        new = {b['name']: b for b in json.load(f)['benchmarks']}
+    threshold = args.threshold / 100.0
+    failed = False
+    for name in sorted(set(old) | set(new)):
+        if name not in old or name not in new:
+            print('{:<70} only in {}'.format(
+                name, args.old if name in old else args.new))
+            continue
+        o, n = old[name], new[name]
+        told, tnew = get_time(o), get_time(n)
+        change = (tnew - told) / told if told > 0 else 0.0
+        status = ''
+        if change > threshold:
+            status = 'SLOWER'
+            failed = True
+        elif change < -threshold:
+            status = 'faster'
+        if o.get('result') != n.get('result'):
+            status += ' RESULT {} -> {}'.format(o.get('result'),
+                                                n.get('result'))
+            failed = True
+        print('{:<70} {:>14.1f} {:>14.1f} {:>+8.1f}% {}'.format(
+            name, told, tnew, 100.0 * change, status))
+        if args.stats:
+            so, sn = o.get('stats', o.get('counters', {})), n.get(
+                'stats', n.get('counters', {}))
+            for stat in sorted(set(so) & set(sn)):
+                vo, vn = so[stat], sn[stat]
+                if vo != vn and (vo == 0 or abs(vn - vo) / abs(vo) > threshold):
+                    print('    {:<66} {:>14} {:>14}'.format(stat, vo, vn))
+    return 1 if failed else 0
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description='Runs and compares the performance benchmarks of cvc5.')
+    subparsers = parser.add_subparsers(dest='command', required=True)
+
+    micro = subparsers.add_parser('micro', help='run the micro benchmarks')
+    micro.add_argument('--output', required=True)
+    micro.add_argument('binary', help='the cvc5-bench binary')
+
+    regress = subparsers.add_parser('regress',
+                                    help='run the regression benchmarks')
+    regress.add_argument('--output', required=True)
+    regress.add_argument('--list', default=DEFAULT_LIST)
+    regress.add_argument('--repetitions', type=int, default=3)
+    regress.add_argument('--timeout', type=float, default=600.0)
+    regress.add_argument('binary', help='the cvc5 binary')
+
+    cmp = subparsers.add_parser('compare', help='compare two result files')
+    cmp.add_argument('old')
+    cmp.add_argument('new')
+    cmp.add_argument('--threshold',
+                     type=float,
+                     default=10.0,
+                     help='relative change in percent that is reported')
+    cmp.add_argument('--stats',
+                     action='store_true',
+                     help='also report statistics that changed')
+
+    args, rest = parser.parse_known_args()
+    if args.command == 'micro':
+        return run_micro(args, rest)
+    if rest:
+        parser.error('unrecognized arguments: ' + ' '.join(rest))
+    if args.command == 'regress':
+        return run_regress(args)
+    return compare(args)
+
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -0,0 +1,97 @@
+/******************************************************************************
+ * Top contributors (to current version):
+ *   agent
+ *
+ * This file is part of the cvc5 project.
+ *
+ * Copyright (c) 2009-2023 by the authors listed in the file AUTHORS
+ * in the top-level source directory and their institutional affiliations.
+ * All rights reserved.  See the file COPYING in the top-level source
+ * directory for licensing information.
+ * ****************************************************************************
+ *
+ * Micro benchmarks of the simplex solver of linear real arithmetic.
+ */
+
+#include <cvc5/cvc5.h>
+
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "bench.h"
+
+namespace cvc5::internal {
+namespace bench {
+
+namespace {
+
+/**
+ * Assert random linear constraints over numVars variables bounded by
+ * [-100, 100], which are satisfied by the origin shifted by a random point,
+ * hence the problem is satisfiable and requires pivots to find a model.
+ */
+void assertProblem(cvc5::Solver& solver,
+                   size_t numVars,
+                   size_t numConstraints,
+                   std::mt19937& rng)
+{
+  cvc5::Sort real = solver.getRealSort();
+  std::vector<cvc5::Term> vars;
+  std::vector<int64_t> point;
+  for (size_t i = 0; i < numVars; i++)
+  {
+    vars.push_back(solver.mkConst(real));
+    point.push_back(static_cast<int64_t>(rng() % 21) - 10);
+    solver.assertFormula(solver.mkTerm(
+        cvc5::Kind::LEQ, {solver.mkReal(-100), vars.back()}));
+    solver.assertFormula(solver.mkTerm(
+        cvc5::Kind::LEQ, {vars.back(), solver.mkReal(100)}));
+  }
+  for (size_t i = 0; i < numConstraints; i++)
+  {
+    std::vector<cvc5::Term> summands;
+    int64_t value = 0;
+    for (size_t j = 0; j < 6; j++)
+    {
+      size_t v = rng() % numVars;
+      int64_t c = static_cast<int64_t>(rng() % 19) - 9;
+      value += c * point[v];
+      summands.push_back(
+          solver.mkTerm(cvc5::Kind::MULT, {solver.mkReal(c), vars[v]}));
+    }
+    // the point satisfies the constraint, possibly tightly
+    int64_t slack = static_cast<int64_t>(rng() % 3);
+    cvc5::Term sum = solver.mkTerm(cvc5::Kind::ADD, summands);
+    solver.assertFormula(solver.mkTerm(
+        cvc5::Kind::GEQ, {sum, solver.mkReal(value - slack)}));
+  }
+}
+
+}  // namespace
+
+/** Check the satisfiability of a fixed random feasible QF_LRA problem */
+CVC5_BENCHMARK(simplex, feasible_lra)
+{
+  int64_t pivots = 0;
+  while (state.keepRunning())
+  {
+    state.pauseTiming();
+    // the same problem in each iteration
+    std::mt19937 rng(42);
+    std::unique_ptr<cvc5::Solver> solver(new cvc5::Solver());
+    solver->setLogic("QF_LRA");
+    assertProblem(*solver, 60, 120, rng);
+    state.resumeTiming();
+    solver->checkSat();
+    state.pauseTiming();
+    pivots += solver->getStatistics().get("theory::arith::pivots").getInt();
+    solver.reset();
+    state.resumeTiming();
+  }
+  state.setCounter("pivots",
+                   static_cast<double>(pivots) / state.getIterations());
+}
+
+}  // namespace bench
+}  // namespace cvc5::internal
@@ -1,4 +1,5 @@
 ; COMMAND-LINE: --decision=justification
+; COMMAND-LINE: --decision=justification --jh-watch
 ; EXPECT: sat
 (set-option :incremental false)
 (set-info :status sat)
@@ -0,0 +1,8 @@
+; DISABLE-TESTER: dump
+; REQUIRES: no-cadical-propagator
+; COMMAND-LINE: --sat-solver=cadical
+; ERROR-SCRUBBER: grep -o "IPASIR-UP"
+; EXPECT-ERROR: IPASIR-UP
+; EXIT: 1
+(set-logic QF_UF)
+(check-sat)
@@ -0,0 +1,19 @@
+; DISABLE-TESTER: unsat-core
+; DISABLE-TESTER: proof
+; DISABLE-TESTER: lfsc
+; DISABLE-TESTER: dump
+; COMMAND-LINE: --compute-partitions=4 --partition-solve-jobs=2
+; EXPECT: sat
+(set-logic QF_UF)
+(declare-sort U 0)
+(declare-fun a () U)
+(declare-fun b () U)
+(declare-fun c () U)
+(declare-fun x () U)
+(declare-fun y () U)
+(declare-fun z () U)
+(assert (or (= x a) (= x b) (= x c)))
+(assert (or (= y a) (= y b) (= y c)))
+(assert (or (= z a) (= z b) (= z c)))
+(assert (distinct x y z))
+(check-sat)
@@ -0,0 +1,18 @@
+; DISABLE-TESTER: unsat-core
+; DISABLE-TESTER: proof
+; DISABLE-TESTER: lfsc
+; DISABLE-TESTER: dump
+; COMMAND-LINE: --compute-partitions=2 --partition-solve-jobs=2
+; EXPECT: unsat
+(set-logic QF_UF)
+(declare-sort U 0)
+(declare-fun a () U)
+(declare-fun b () U)
+(declare-fun x () U)
+(declare-fun y () U)
+(declare-fun z () U)
+(assert (or (= x a) (= x b)))
+(assert (or (= y a) (= y b)))
+(assert (or (= z a) (= z b)))
+(assert (distinct x y z))
+(check-sat)
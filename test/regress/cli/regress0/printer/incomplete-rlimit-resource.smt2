@@ -0,0 +1,11 @@
+; COMMAND-LINE: -o incomplete --rlimit-resource=QuantifierStep=1
+; EXPECT: (incomplete RESOURCEOUT QuantifierStep)
+; EXPECT: unknown
+; EXPECT: (:reason-unknown resourceout)
+(set-logic ALL)
+(declare-fun f (Int) Int)
+(declare-fun a () Int)
+(assert (forall ((x Int)) (> (f x) (f (+ x 1)))))
+(assert (= (f a) 0))
+(check-sat)
+(get-info :reason-unknown)
@@ -0,0 +1,13 @@
+; COMMAND-LINE: --trigger-delta
+; EXPECT: unsat
+(set-logic UF)
+(declare-sort U 0)
+(declare-fun f (U) U)
+(declare-fun g (U U) U)
+(declare-fun P (U) Bool)
+(declare-fun a () U)
+(declare-fun b () U)
+(assert (forall ((x U)) (! (P (f x)) :pattern ((f x)))))
+(assert (forall ((x U) (y U)) (! (= (g x y) (f (g y x))) :pattern ((g x y)))))
+(assert (or (not (P (f a))) (not (P (f (g a b))))))
+(check-sat)
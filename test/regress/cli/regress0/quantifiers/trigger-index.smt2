@@ -0,0 +1,15 @@
+; COMMAND-LINE: --trigger-index
+; COMMAND-LINE: --trigger-index --trigger-index-threads=2
+; EXPECT: unsat
+(set-logic UF)
+(declare-sort U 0)
+(declare-fun f (U U) U)
+(declare-fun P (U) Bool)
+(declare-fun a () U)
+(declare-fun b () U)
+(declare-fun c () U)
+(assert (forall ((x U)) (! (P (f x a)) :pattern ((f x a)))))
+(assert (forall ((x U)) (! (not (= (f x x) c)) :pattern ((f x x)))))
+(assert (forall ((x U) (y U)) (! (= (f x y) (f y x)) :pattern ((f x y)))))
+(assert (or (= (f b b) c) (not (P (f c a)))))
+(check-sat)
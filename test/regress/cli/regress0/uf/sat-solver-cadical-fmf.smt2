@@ -0,0 +1,14 @@
+; REQUIRES: cadical-propagator
+; COMMAND-LINE: --sat-solver=cadical --finite-model-find
+; EXPECT: sat
+; Finite model finding introduces the literals of its cardinality bounds
+; during search, which CaDiCaL must decide before the model is accepted.
+(set-logic UF)
+(declare-sort U 0)
+(declare-fun f (U) U)
+(declare-fun P (U) Bool)
+(declare-fun a () U)
+(assert (forall ((x U)) (not (= (f x) x))))
+(assert (forall ((x U)) (=> (P x) (not (P (f x))))))
+(assert (P a))
+(check-sat)
@@ -0,0 +1,18 @@
+; REQUIRES: cadical-propagator
+; COMMAND-LINE: --sat-solver=cadical
+; EXPECT: sat
+; EXPECT: unsat
+(set-logic QF_UF)
+(set-option :incremental true)
+(declare-sort U 0)
+(declare-fun f (U) U)
+(declare-fun a () U)
+(declare-fun b () U)
+(declare-fun c () U)
+(assert (or (= a b) (= a c)))
+(assert (not (= (f a) (f b))))
+(check-sat)
+(push 1)
+(assert (not (= (f a) (f c))))
+(check-sat)
+(pop 1)
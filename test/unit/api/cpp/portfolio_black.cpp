@@ -0,0 +1,198 @@
+/******************************************************************************
+ * Top contributors (to current version):
+ *   agent
+ *
+ * This file is part of the cvc5 project.
+ *
+ * Copyright (c) 2009-2023 by the authors listed in the file AUTHORS
+ * in the top-level source directory and their institutional affiliations.
+ * All rights reserved.  See the file COPYING in the top-level source
+ * directory for licensing information.
+ * ****************************************************************************
+ *
+ * Black box testing of the Portfolio class
+ */
+
+#include "test_api.h"
+
+namespace cvc5::internal {
+
+namespace test {
+
+class TestApiBlackPortfolio : public TestApi
+{
+ protected:
+  /** Pigeonhole problem with n+1 pigeons and n holes, which is unsat. */
+  static void setupPigeonhole(cvc5::Solver& slv, size_t n)
+  {
+    slv.setLogic("QF_UF");
+    Sort b = slv.getBooleanSort();
+    std::vector<std::vector<Term>> p(n + 1);
+    for (size_t i = 0; i <= n; i++)
+    {
+      for (size_t j = 0; j < n; j++)
+      {
+        p[i].push_back(slv.mkConst(
+            b, "p_" + std::to_string(i) + "_" + std::to_string(j)));
+      }
+      slv.assertFormula(slv.mkTerm(Kind::OR, p[i]));
+    }
+    for (size_t j = 0; j < n; j++)
+    {
+      for (size_t i = 0; i <= n; i++)
+      {
+        for (size_t k = i + 1; k <= n; k++)
+        {
+          slv.assertFormula(slv.mkTerm(
+              Kind::OR, {p[i][j].notTerm(), p[k][j].notTerm()}));
+        }
+      }
+    }
+  }
+};
+
+TEST_F(TestApiBlackPortfolio, constructor)
+{
+  std::vector<cvc5::Portfolio::Configuration> configs;
+  ASSERT_THROW(cvc5::Portfolio p(configs), CVC5ApiException);
+  configs.emplace_back();
+  ASSERT_NO_THROW(cvc5::Portfolio p(configs));
+}
+
+TEST_F(TestApiBlackPortfolio, checkSatSat)
+{
+  cvc5::Portfolio portfolio(std::vector<cvc5::Portfolio::Configuration>{
+      {}, {{"decision", "internal"}}, {{"random-seed", "3"}}});
+  ASSERT_THROW(portfolio.getWinner(), CVC5ApiException);
+  std::string value;
+  cvc5::Result res = portfolio.checkSat(
+      [](cvc5::Solver& slv) {
+        slv.setOption("produce-models", "true");
+        slv.setLogic("QF_LIA");
+        Sort i = slv.getIntegerSort();
+        Term x = slv.mkConst(i, "x");
+        slv.assertFormula(slv.mkTerm(Kind::GT, {x, slv.mkInteger(5)}));
+        slv.assertFormula(slv.mkTerm(Kind::LT, {x, slv.mkInteger(7)}));
+      },
+      [&value](cvc5::Solver& slv, const cvc5::Result& r) {
+        EXPECT_TRUE(r.isSat());
+        Term x = slv.getAssertions()[0][0];
+        value = slv.getValue(x).toString();
+      });
+  ASSERT_TRUE(res.isSat());
+  ASSERT_EQ(value, "6");
+  ASSERT_LT(portfolio.getWinner(), 3);
+}
+
+TEST_F(TestApiBlackPortfolio, checkSatUnsat)
+{
+  cvc5::Portfolio portfolio(std::vector<cvc5::Portfolio::Configuration>{
+      {}, {{"decision", "internal"}}, {{"random-seed", "7"}}});
+  cvc5::Result res = portfolio.checkSat(
+      [](cvc5::Solver& slv) { setupPigeonhole(slv, 6); });
+  ASSERT_TRUE(res.isUnsat());
+  ASSERT_LT(portfolio.getWinner(), 3);
+}
+
+TEST_F(TestApiBlackPortfolio, checkSatNoSharing)
+{
+  cvc5::Portfolio portfolio(std::vector<cvc5::Portfolio::Configuration>{
+      {{"learned-share-length", "0"}}, {{"learned-share-length", "0"}}});
+  cvc5::Result res = portfolio.checkSat(
+      [](cvc5::Solver& slv) { setupPigeonhole(slv, 4); });
+  ASSERT_TRUE(res.isUnsat());
+}
+
+TEST_F(TestApiBlackPortfolio, checkSatCapacity)
+{
+  // an exchange that is full drops further clauses, which must not affect
+  // the result
+  cvc5::Portfolio portfolio(std::vector<cvc5::Portfolio::Configuration>{
+      {{"learned-share-capacity", "1"}}, {{"learned-share-capacity", "0"}}});
+  cvc5::Result res = portfolio.checkSat(
+      [](cvc5::Solver& slv) { setupPigeonhole(slv, 4); });
+  ASSERT_TRUE(res.isUnsat());
+  cvc5::Portfolio invalid(std::vector<cvc5::Portfolio::Configuration>{
+      {{"learned-share-capacity", "-1"}}});
+  ASSERT_THROW(invalid.checkSat([](cvc5::Solver& slv) {}),
+               CVC5ApiOptionException);
+}
+
+TEST_F(TestApiBlackPortfolio, checkSatMixedConfigurations)
+{
+  // Coloring of a cycle of 5 nodes with 3 colors, which is sat. Symmetry
+  // breaking, which is on by default for QF_UF, would add assertions that are
+  // not entailed, e.g. fixing the color of a node, and finite model finding
+  // adds lemmas that are not entailed. Neither must cut models from the
+  // solvers of the other configurations.
+  cvc5::Portfolio portfolio(std::vector<cvc5::Portfolio::Configuration>{
+      {},
+      {{"finite-model-find", "true"}},
+      {{"decision", "internal"}},
+      {{"simplification", "none"}},
+      {{"random-seed", "5"}}});
+  bool modelChecked = false;
+  cvc5::Result res = portfolio.checkSat(
+      [](cvc5::Solver& slv) {
+        slv.setOption("produce-models", "true");
+        slv.setLogic("QF_UF");
+        Sort u = slv.mkUninterpretedSort("U");
+        std::vector<Term> colors;
+        for (const std::string c : {"r", "g", "b"})
+        {
+          colors.push_back(slv.mkConst(u, c));
+        }
+        slv.assertFormula(slv.mkTerm(Kind::DISTINCT, colors));
+        std::vector<Term> nodes;
+        for (size_t i = 0; i < 5; i++)
+        {
+          nodes.push_back(slv.mkConst(u, "n" + std::to_string(i)));
+          std::vector<Term> choices;
+          for (const Term& c : colors)
+          {
+            choices.push_back(slv.mkTerm(Kind::EQUAL, {nodes[i], c}));
+          }
+          slv.assertFormula(slv.mkTerm(Kind::OR, choices));
+        }
+        for (size_t i = 0; i < 5; i++)
+        {
+          slv.assertFormula(
+              slv.mkTerm(Kind::DISTINCT, {nodes[i], nodes[(i + 1) % 5]}));
+        }
+      },
+      [&modelChecked](cvc5::Solver& slv, const cvc5::Result& r) {
+        EXPECT_TRUE(r.isSat());
+        EXPECT_EQ(slv.getOption("symmetry-breaker"), "false");
+        for (const Term& a : slv.getAssertions())
+        {
+          EXPECT_TRUE(slv.getValue(a).getBooleanValue());
+        }
+        modelChecked = true;
+      });
+  ASSERT_TRUE(res.isSat());
+  ASSERT_TRUE(modelChecked);
+  // the same configurations on an unsat problem
+  res = portfolio.checkSat([](cvc5::Solver& slv) { setupPigeonhole(slv, 5); });
+  ASSERT_TRUE(res.isUnsat());
+}
+
+TEST_F(TestApiBlackPortfolio, checkSatSymmetryBreaker)
+{
+  // preprocessing that does not preserve equivalence cannot be enabled
+  cvc5::Portfolio portfolio(std::vector<cvc5::Portfolio::Configuration>{
+      {{"symmetry-breaker", "true"}}});
+  ASSERT_THROW(portfolio.checkSat(
+                   [](cvc5::Solver& slv) { setupPigeonhole(slv, 2); }),
+               CVC5ApiOptionException);
+}
+
+TEST_F(TestApiBlackPortfolio, checkSatException)
+{
+  cvc5::Portfolio portfolio(std::vector<cvc5::Portfolio::Configuration>{
+      {{"no-such-option", "true"}}});
+  ASSERT_THROW(portfolio.checkSat([](cvc5::Solver& slv) {}),
+               CVC5ApiException);
+}
+
+}  // namespace test
+}  // namespace cvc5::internal
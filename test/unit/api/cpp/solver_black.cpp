@@ -1424,6 +1424,220 @@ TEST_F(TestApiBlackSolver, getAssertions)
   ASSERT_EQ(d_solver.getAssertions(), asserts);
 }
 
+namespace {
+
+/** The bytes with the given values */
+std::string bytes(std::initializer_list<int> values)
+{
+  std::string res;
+  for (int v : values)
+  {
+    res += static_cast<char>(v);
+  }
+  return res;
+}
+
+/** A short string in the binary format, i.e., its length and characters */
+std::string binaryString(const std::string& s)
+{
+  return static_cast<char>(s.size()) + s;
+}
+
+/**
+ * A binary input that starts with the declarations of the given kinds,
+ * followed by the given records.
+ */
+std::string binaryInput(const std::vector<std::string>& kinds,
+                        const std::string& records)
+{
+  // the magic string and the version
+  std::string res = "cvc5bin\n" + bytes({1});
+  for (const std::string& k : kinds)
+  {
+    res += bytes({1}) + binaryString(k);
+  }
+  return res + records;
+}
+
+}  // namespace
+
+TEST_F(TestApiBlackSolver, writeBinary)
+{
+  Sort bv8 = d_solver.mkBitVectorSort(8);
+  Term b = d_solver.mkConst(bv8, "b");
+  Term t = d_solver.mkTerm(Kind::BITVECTOR_ADD, {b, d_solver.mkBitVector(8, 3)});
+  std::stringstream ss;
+  ASSERT_NO_THROW(d_solver.writeBinary(ss, {t, b}));
+  ASSERT_EQ(ss.str().substr(0, 8), "cvc5bin\n");
+  ASSERT_THROW(d_solver.writeBinary(ss, {Term()}), CVC5ApiException);
+  // empty sets are not supported
+  Term empty = d_solver.mkEmptySet(d_solver.mkSetSort(bv8));
+  std::stringstream ss2;
+  ASSERT_THROW(d_solver.writeBinary(ss2, {empty}), CVC5ApiException);
+}
+
+TEST_F(TestApiBlackSolver, readBinary)
+{
+  Sort fp = d_solver.mkFloatingPointSort(5, 11);
+  Term x = d_solver.mkConst(fp, "x");
+  Term rm = d_solver.mkRoundingMode(RoundingMode::ROUND_TOWARD_ZERO);
+  std::vector<Term> terms = {
+      d_solver.mkTerm(Kind::FLOATINGPOINT_ADD,
+                      {rm, x, d_solver.mkFloatingPointPosInf(5, 11)}),
+      d_solver.mkTerm(d_solver.mkOp(Kind::INT_TO_BITVECTOR, {4}),
+                      {d_solver.mkInteger(-5)}),
+      d_solver.mkTerm(Kind::EQUAL, {x, x}),
+      d_solver.mkTrue()};
+  std::stringstream ss;
+  d_solver.writeBinary(ss, terms);
+  std::vector<Term> read = d_solver.readBinary(ss);
+  ASSERT_EQ(read.size(), terms.size());
+  for (size_t i = 0, n = terms.size(); i < n; i++)
+  {
+    ASSERT_EQ(read[i].toString(), terms[i].toString());
+    ASSERT_EQ(read[i].getSort().toString(), terms[i].getSort().toString());
+  }
+  // constants are not fresh
+  ASSERT_EQ(read[3], d_solver.mkTrue());
+  // a hand-written input
+  std::stringstream in(binaryInput({"CONST_BOOLEAN"},
+                                   bytes({5, 0, 0, 12, 1, 0})));
+  ASSERT_EQ(d_solver.readBinary(in), std::vector<Term>{d_solver.mkFalse()});
+  std::stringstream empty;
+  ASSERT_THROW(d_solver.readBinary(empty), CVC5ApiException);
+}
+
+TEST_F(TestApiBlackSolver, readBinaryMalformed)
+{
+  std::vector<std::string> inputs = {
+      // not a binary input
+      "(assert true)",
+      // unsupported version
+      "cvc5bin\n" + bytes({2}),
+      // unknown kind
+      binaryInput({"NO_SUCH_KIND"}, ""),
+      // reference to an undefined kind
+      binaryInput({}, bytes({5, 0, 1, 12, 1})),
+      // a bit-vector of width zero
+      binaryInput({"CONST_BITVECTOR"},
+                  bytes({5, 0, 0}) + binaryString("0") + bytes({12, 1})),
+      // a bit-vector value that does not fit its width
+      binaryInput({"CONST_BITVECTOR"},
+                  bytes({5, 0, 2}) + binaryString("ff") + bytes({12, 1})),
+      // invalid integers
+      binaryInput({"CONST_INTEGER"},
+                  bytes({5, 0}) + binaryString("-") + binaryString("1")),
+      binaryInput({"CONST_INTEGER"},
+                  bytes({5, 0}) + binaryString("1-2") + binaryString("1")),
+      binaryInput({"CONST_INTEGER"},
+                  bytes({5, 0}) + binaryString("1") + binaryString("2")),
+      binaryInput({"CONST_RATIONAL"},
+                  bytes({5, 0}) + binaryString("1") + binaryString("-2")),
+      // a floating-point size that is too small
+      binaryInput({"CONST_FLOATINGPOINT"},
+                  bytes({5, 0, 1, 1}) + binaryString("0")),
+      // a divisibility predicate by zero
+      binaryInput({"DIVISIBLE_OP"}, bytes({5, 0}) + binaryString("0")),
+      // a constant of a kind that is not a constant kind
+      binaryInput({"ADD"}, bytes({5, 0, 1})),
+      // a variable of a kind that is not a variable kind
+      binaryInput({"TYPE_CONSTANT", "ADD"},
+                  bytes({2, 0}) + binaryString("Boolean type") + bytes({6, 1})
+                      + binaryString("x") + bytes({1})),
+      // a type of a kind that is not a type kind
+      binaryInput({"TYPE_CONSTANT", "ADD"},
+                  bytes({2, 0}) + binaryString("Boolean type")
+                      + bytes({4, 1, 2, 1, 1})),
+      // a reference to a term where a type is expected
+      binaryInput({"CONST_BOOLEAN", "VARIABLE"},
+                  bytes({5, 0, 1, 6, 1}) + binaryString("x") + bytes({1})),
+      // too many children
+      binaryInput({"CONST_BOOLEAN", "NOT"},
+                  bytes({5, 0, 1, 7, 1, 2, 1, 1, 12, 1})),
+      // too few children
+      binaryInput({"ADD"}, bytes({7, 0, 0, 12, 1})),
+      // an ill-typed term
+      binaryInput({"CONST_BOOLEAN", "ADD"},
+                  bytes({5, 0, 1, 7, 1, 2, 1, 1, 12, 1})),
+      // an operator of the wrong kind
+      binaryInput({"CONST_BOOLEAN", "BITVECTOR_EXTRACT"},
+                  bytes({5, 0, 1, 7, 1, 1, 1, 1, 12, 1})),
+      // a reference to the term that is being defined
+      binaryInput({"CONST_BOOLEAN", "NOT"}, bytes({5, 0, 1, 7, 1, 1, 0})),
+  };
+  for (const std::string& input : inputs)
+  {
+    std::stringstream in(input);
+    ASSERT_THROW(d_solver.readBinary(in), CVC5ApiException);
+  }
+}
+
+TEST_F(TestApiBlackSolver, readBinaryFuzz)
+{
+  Sort u = d_solver.mkUninterpretedSort("u");
+  Sort bv8 = d_solver.mkBitVectorSort(8);
+  Term f = d_solver.mkConst(d_solver.mkFunctionSort({u}, bv8), "f");
+  Term x = d_solver.mkConst(u, "x");
+  Term y = d_solver.mkVar(d_solver.getIntegerSort(), "y");
+  Term fx = d_solver.mkTerm(Kind::APPLY_UF, {f, x});
+  std::vector<Term> terms = {
+      d_solver.mkTerm(d_solver.mkOp(Kind::BITVECTOR_EXTRACT, {5, 2}),
+                      {d_solver.mkTerm(Kind::BITVECTOR_ADD,
+                                       {fx, d_solver.mkBitVector(8, 200)})}),
+      d_solver.mkTerm(
+          Kind::FORALL,
+          {d_solver.mkTerm(Kind::VARIABLE_LIST, {y}),
+           d_solver.mkTerm(Kind::LEQ, {y, d_solver.mkInteger("-123")})}),
+      d_solver.mkTerm(Kind::STRING_LENGTH, {d_solver.mkString("ab")})};
+  std::stringstream ss;
+  d_solver.writeBinary(ss, terms);
+  std::string data = ss.str();
+  // every truncation and every change of a byte is either read or rejected
+  std::vector<std::string> inputs;
+  for (size_t i = 0, size = data.size(); i < size; i++)
+  {
+    inputs.push_back(data.substr(0, i));
+    for (int mask : {0x01, 0x02, 0x10, 0x80, 0xff})
+    {
+      inputs.push_back(data);
+      inputs.back()[i] = static_cast<char>(data[i] ^ mask);
+    }
+  }
+  for (const std::string& input : inputs)
+  {
+    std::stringstream in(input);
+    try
+    {
+      d_solver.readBinary(in);
+    }
+    catch (const CVC5ApiException&)
+    {
+    }
+  }
+}
+
+TEST_F(TestApiBlackSolver, writeBinaryProblem)
+{
+  d_solver.setLogic("QF_UFBV");
+  Sort u = d_solver.mkUninterpretedSort("u");
+  Sort bv8 = d_solver.mkBitVectorSort(8);
+  Term f = d_solver.mkConst(d_solver.mkFunctionSort({u}, bv8), "f");
+  Term x = d_solver.mkConst(u, "x");
+  Term fx = d_solver.mkTerm(Kind::APPLY_UF, {f, x});
+  d_solver.assertFormula(
+      d_solver.mkTerm(Kind::BITVECTOR_ULT, {fx, d_solver.mkBitVector(8, 1)}));
+  std::stringstream ss;
+  ASSERT_NO_THROW(d_solver.writeBinaryProblem(ss));
+  // a problem has no records of terms without a particular role
+  ASSERT_TRUE(d_solver.readBinary(ss).empty());
+  // empty sets are not supported
+  Term s = d_solver.mkConst(d_solver.mkSetSort(bv8), "s");
+  d_solver.assertFormula(d_solver.mkTerm(
+      Kind::EQUAL, {s, d_solver.mkEmptySet(d_solver.mkSetSort(bv8))}));
+  std::stringstream ss2;
+  ASSERT_THROW(d_solver.writeBinaryProblem(ss2), CVC5ApiException);
+}
+
 TEST_F(TestApiBlackSolver, getInfo)
 {
   ASSERT_NO_THROW(d_solver.getInfo("name"));
@@ -0,0 +1,163 @@
+/******************************************************************************
+ * Top contributors (to current version):
+ *   agent
+ *
+ * This file is part of the cvc5 project.
+ *
+ * Copyright (c) 2009-2023 by the authors listed in the file AUTHORS
+ * in the top-level source directory and their institutional affiliations.
+ * All rights reserved.  See the file COPYING in the top-level source
+ * directory for licensing information.
+ * ****************************************************************************
+ *
+ * Black box testing of the TermManager class
+ */
+
+#include <thread>
+
+#include "test_api.h"
+
+namespace cvc5::internal {
+
+namespace test {
+
+class TestApiBlackTermManager : public TestApi
+{
+};
+
+TEST_F(TestApiBlackTermManager, scope)
+{
+  cvc5::TermManager tm;
+  Term x;
+  {
+    cvc5::TermManager::Scope scope(tm);
+    cvc5::Solver slv;
+    x = slv.mkConst(slv.getIntegerSort(), "x");
+    // a solver created in another scope for the same term manager accepts x
+    cvc5::TermManager::Scope inner(tm);
+    cvc5::Solver slv2;
+    ASSERT_NO_THROW(
+        slv2.assertFormula(slv2.mkTerm(Kind::GT, {x, slv2.mkInteger(0)})));
+  }
+  // the solver of this thread's own term manager does not
+  ASSERT_THROW(d_solver.assertFormula(
+                   d_solver.mkTerm(Kind::GT, {x, d_solver.mkInteger(0)})),
+               CVC5ApiException);
+  x = Term();
+}
+
+TEST_F(TestApiBlackTermManager, threads)
+{
+  cvc5::TermManager tm;
+  std::vector<Term> xs;
+  Term background;
+  {
+    cvc5::TermManager::Scope scope(tm);
+    cvc5::Solver slv;
+    Sort isort = slv.getIntegerSort();
+    std::vector<Term> conj;
+    for (size_t i = 0; i < 10; i++)
+    {
+      xs.push_back(slv.mkConst(isort, "x" + std::to_string(i)));
+      conj.push_back(slv.mkTerm(Kind::GEQ, {xs[i], slv.mkInteger(0)}));
+    }
+    background = slv.mkTerm(Kind::AND, conj);
+  }
+  size_t numThreads = 4;
+  std::vector<std::thread> threads;
+  std::vector<cvc5::Result> results(numThreads);
+  std::vector<Term> sums(numThreads);
+  for (size_t t = 0; t < numThreads; t++)
+  {
+    threads.emplace_back([&, t]() {
+      cvc5::TermManager::Scope scope(tm);
+      cvc5::Solver slv;
+      slv.setLogic("QF_LIA");
+      slv.assertFormula(background);
+      sums[t] = slv.mkTerm(Kind::ADD, xs);
+      // sat for even t, unsat for odd t
+      slv.assertFormula(slv.mkTerm(
+          t % 2 == 0 ? Kind::GEQ : Kind::LT, {sums[t], slv.mkInteger(0)}));
+      results[t] = slv.checkSat();
+    });
+  }
+  for (std::thread& th : threads)
+  {
+    th.join();
+  }
+  cvc5::TermManager::Scope scope(tm);
+  for (size_t t = 0; t < numThreads; t++)
+  {
+    ASSERT_EQ(results[t].isSat(), t % 2 == 0);
+    ASSERT_EQ(results[t].isUnsat(), t % 2 == 1);
+    // terms built in different threads are hash-consed
+    ASSERT_EQ(sums[t], sums[0]);
+  }
+  // release all terms of the term manager before it is destroyed
+  xs.clear();
+  background = Term();
+  sums.clear();
+}
+
+TEST_F(TestApiBlackTermManager, triggerIndexThreads)
+{
+  // the trigger index only computes matches in parallel for a term manager
+  // that is shared by threads
+  cvc5::TermManager tm;
+  cvc5::TermManager::Scope scope(tm);
+  std::vector<std::string> insts;
+  std::vector<cvc5::Result> results;
+  for (const std::string threads : {"1", "2"})
+  {
+    cvc5::Solver slv;
+    slv.setLogic("UF");
+    slv.setOption("trigger-index", "true");
+    slv.setOption("trigger-index-threads", threads);
+    Sort u = slv.mkUninterpretedSort("U");
+    Term f = slv.mkConst(slv.mkFunctionSort({u, u}, u), "f");
+    Term p = slv.mkConst(slv.mkFunctionSort({u}, slv.getBooleanSort()), "P");
+    Term a = slv.mkConst(u, "a");
+    Term b = slv.mkConst(u, "b");
+    Term c = slv.mkConst(u, "c");
+    Term x = slv.mkVar(u, "x");
+    Term y = slv.mkVar(u, "y");
+    // forall x. P(f(x, a)), with pattern f(x, a)
+    Term fxa = slv.mkTerm(Kind::APPLY_UF, {f, x, a});
+    slv.assertFormula(slv.mkTerm(
+        Kind::FORALL,
+        {slv.mkTerm(Kind::VARIABLE_LIST, {x}),
+         slv.mkTerm(Kind::APPLY_UF, {p, fxa}),
+         slv.mkTerm(Kind::INST_PATTERN_LIST,
+                    {slv.mkTerm(Kind::INST_PATTERN, {fxa})})}));
+    // forall x. f(x, x) != c, with pattern f(x, x)
+    Term fxx = slv.mkTerm(Kind::APPLY_UF, {f, x, x});
+    slv.assertFormula(slv.mkTerm(
+        Kind::FORALL,
+        {slv.mkTerm(Kind::VARIABLE_LIST, {x}),
+         slv.mkTerm(Kind::DISTINCT, {fxx, c}),
+         slv.mkTerm(Kind::INST_PATTERN_LIST,
+                    {slv.mkTerm(Kind::INST_PATTERN, {fxx})})}));
+    // forall x y. f(x, y) = f(y, x), with pattern f(x, y)
+    Term fxy = slv.mkTerm(Kind::APPLY_UF, {f, x, y});
+    slv.assertFormula(slv.mkTerm(
+        Kind::FORALL,
+        {slv.mkTerm(Kind::VARIABLE_LIST, {x, y}),
+         slv.mkTerm(Kind::EQUAL, {fxy, slv.mkTerm(Kind::APPLY_UF, {f, y, x})}),
+         slv.mkTerm(Kind::INST_PATTERN_LIST,
+                    {slv.mkTerm(Kind::INST_PATTERN, {fxy})})}));
+    Term fbb = slv.mkTerm(Kind::APPLY_UF, {f, b, b});
+    Term fca = slv.mkTerm(Kind::APPLY_UF, {f, c, a});
+    slv.assertFormula(slv.mkTerm(
+        Kind::OR,
+        {slv.mkTerm(Kind::EQUAL, {fbb, c}),
+         slv.mkTerm(Kind::NOT, {slv.mkTerm(Kind::APPLY_UF, {p, fca})})}));
+    results.push_back(slv.checkSat());
+    insts.push_back(slv.getInstantiations());
+  }
+  ASSERT_TRUE(results[0].isUnsat());
+  ASSERT_TRUE(results[1].isUnsat());
+  ASSERT_FALSE(insts[0].empty());
+  ASSERT_EQ(insts[0], insts[1]);
+}
+}  // namespace test
+}  // namespace cvc5::internal
@@ -0,0 +1,124 @@
+/******************************************************************************
+ * Top contributors (to current version):
+ *   agent
+ *
+ * This file is part of the cvc5 project.
+ *
+ * Copyright (c) 2009-2023 by the authors listed in the file AUTHORS
+ * in the top-level source directory and their institutional affiliations.
+ * All rights reserved.  See the file COPYING in the top-level source
+ * directory for licensing information.
+ * ****************************************************************************
+ *
+ * Black box testing of cvc5::context::CDTrailHashMap<>.
+ */
+
+#include <map>
+#include <random>
+
+#include "context/cdhashmap.h"
+#include "context/cdtrail_hashmap.h"
+#include "test_context.h"
+
+namespace cvc5::internal {
+namespace test {
+
+using cvc5::context::CDHashMap;
+using cvc5::context::CDTrailHashMap;
+
+class TestContextBlackCDTrailHashMap : public TestContext
+{
+ protected:
+  /** Returns the elements in a CDTrailHashMap. */
+  static std::map<int32_t, int32_t> get_elements(
+      const CDTrailHashMap<int32_t, int32_t>& map)
+  {
+    return std::map<int32_t, int32_t>{map.begin(), map.end()};
+  }
+};
+
+TEST_F(TestContextBlackCDTrailHashMap, simple_sequence)
+{
+  CDTrailHashMap<int32_t, int32_t> map(d_context.get());
+  ASSERT_TRUE(map.empty());
+
+  map.insert(3, 4);
+  ASSERT_EQ(get_elements(map), (std::map<int32_t, int32_t>{{3, 4}}));
+
+  d_context->push();
+  ASSERT_TRUE(map.insert(5, 6));
+  ASSERT_FALSE(map.insert(3, 7));
+  ASSERT_EQ(get_elements(map),
+            (std::map<int32_t, int32_t>{{3, 7}, {5, 6}}));
+
+  d_context->push();
+  ASSERT_FALSE(map.insert(3, 8));
+  ASSERT_FALSE(map.insert(5, 9));
+  ASSERT_TRUE(map.insert(1, 2));
+  ASSERT_EQ(map[3], 8);
+  ASSERT_EQ(map.size(), 3);
+  d_context->pop();
+
+  ASSERT_EQ(get_elements(map),
+            (std::map<int32_t, int32_t>{{3, 7}, {5, 6}}));
+  ASSERT_EQ(map.find(1), map.end());
+  d_context->pop();
+
+  ASSERT_EQ(get_elements(map), (std::map<int32_t, int32_t>{{3, 4}}));
+  ASSERT_EQ(map.count(5), 0);
+}
+
+TEST_F(TestContextBlackCDTrailHashMap, insertion_order)
+{
+  CDTrailHashMap<int32_t, int32_t> map(d_context.get());
+  for (int32_t i = 100; i > 0; i--)
+  {
+    map.insert(i, -i);
+  }
+  int32_t expected = 100;
+  for (const std::pair<int32_t, int32_t>& p : map)
+  {
+    ASSERT_EQ(p.first, expected);
+    ASSERT_EQ(p.second, -expected);
+    expected--;
+  }
+}
+
+TEST_F(TestContextBlackCDTrailHashMap, compare_cdhashmap)
+{
+  // performs random inserts, pushes and pops on a CDTrailHashMap and a
+  // CDHashMap, which must have the same elements
+  CDTrailHashMap<int32_t, int32_t> map(d_context.get());
+  CDHashMap<int32_t, int32_t> expected(d_context.get());
+  std::mt19937 rng(7);
+  std::uniform_int_distribution<int32_t> key(0, 300);
+  std::uniform_int_distribution<int32_t> action(0, 9);
+  for (uint32_t i = 0; i < 20000; i++)
+  {
+    int32_t a = action(rng);
+    if (a == 0 && d_context->getLevel() < 30)
+    {
+      d_context->push();
+    }
+    else if (a == 1 && d_context->getLevel() > 0)
+    {
+      d_context->pop();
+      ASSERT_EQ(map.size(), expected.size());
+      for (const auto& p : expected)
+      {
+        ASSERT_EQ(map[p.first], p.second);
+      }
+    }
+    else
+    {
+      int32_t k = key(rng);
+      ASSERT_EQ(map.insert(k, static_cast<int32_t>(i)),
+                expected.insert(k, static_cast<int32_t>(i)));
+    }
+  }
+  d_context->popto(0);
+  ASSERT_EQ(map.size(), expected.size());
+}
+
+}  // namespace test
+}  // namespace cvc5::internal
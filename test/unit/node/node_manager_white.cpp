@@ -14,6 +14,7 @@
  */
 
 #include <string>
+#include <thread>
 
 #include "expr/node_manager.h"
 #include "test_node.h"
@@ -80,5 +81,105 @@ TEST_F(TestNodeWhiteNodeManager, topological_sort)
     ASSERT_EQ(NodeManager::TopologicalSort(roots), result);
   }
 }
+
+TEST_F(TestNodeWhiteNodeManager, reclaim_zombies)
+{
+  TypeNode intType = d_nodeManager->integerType();
+  Node x = d_nodeManager->mkVar("x", intType);
+  size_t poolSize = d_nodeManager->d_nodeValuePool.size();
+  std::vector<Node> terms;
+  std::vector<uint64_t> ids;
+  for (size_t i = 0; i < 20000; i++)
+  {
+    Node c = d_nodeManager->mkConstInt(Rational(i));
+    terms.push_back(d_nodeManager->mkNode(kind::ADD, x, c));
+    ids.push_back(terms.back().getId());
+  }
+  // the terms are hash-consed
+  for (size_t i = 0; i < 20000; i++)
+  {
+    Node c = d_nodeManager->mkConstInt(Rational(i));
+    ASSERT_EQ(d_nodeManager->mkNode(kind::ADD, x, c).getId(), ids[i]);
+  }
+  size_t numSlabs = d_nodeManager->d_nodeValueArena.getNumSlabs();
+  terms.clear();
+  // reclaiming the terms zombifies their children
+  while (!d_nodeManager->d_zombies.empty())
+  {
+    d_nodeManager->reclaimZombies();
+  }
+  ASSERT_EQ(d_nodeManager->d_nodeValuePool.size(), poolSize);
+  // the memory of the reclaimed terms is reused
+  for (size_t i = 0; i < 20000; i++)
+  {
+    Node c = d_nodeManager->mkConstInt(Rational(i));
+    terms.push_back(d_nodeManager->mkNode(kind::ADD, x, c));
+  }
+  ASSERT_EQ(d_nodeManager->d_nodeValueArena.getNumSlabs(), numSlabs);
+}
+
+TEST_F(TestNodeWhiteNodeManager, reclaim_zombies_shared)
+{
+  NodeManager nm(true);
+  NodeManagerScope scope(&nm);
+  TypeNode intType = nm.integerType();
+  Node x = nm.mkVar("x", intType);
+  size_t poolSize = nm.d_nodeValuePool.size();
+  // several threads create and release the same terms
+  std::vector<std::thread> workers;
+  for (size_t t = 0; t < 4; t++)
+  {
+    workers.emplace_back([&nm, &x]() {
+      NodeManagerScope wscope(&nm);
+      for (size_t r = 0; r < 5; r++)
+      {
+        std::vector<Node> terms;
+        for (size_t i = 0; i < 2000; i++)
+        {
+          Node c = nm.mkConstInt(Rational(i));
+          terms.push_back(nm.mkNode(kind::ADD, x, c));
+        }
+      }
+    });
+  }
+  for (std::thread& w : workers)
+  {
+    w.join();
+  }
+  ASSERT_TRUE(nm.d_maxedOut.empty());
+  while (!nm.d_zombies.empty())
+  {
+    nm.reclaimZombies();
+  }
+  // the node values of the shared node manager are reclaimed
+  ASSERT_EQ(nm.d_nodeValuePool.size(), poolSize);
+}
+
+TEST_F(TestNodeWhiteNodeManager, memory_usage)
+{
+  TypeNode boolType = d_nodeManager->booleanType();
+  std::vector<Node> vars;
+  for (size_t i = 0; i < 20; i++)
+  {
+    vars.push_back(d_nodeManager->mkVar("x" + std::to_string(i), boolType));
+  }
+  while (!d_nodeManager->d_zombies.empty())
+  {
+    d_nodeManager->reclaimZombies();
+  }
+  size_t usage = d_nodeManager->getMemoryUsage();
+  {
+    // too many children for the arena, hence allocated by the node builder
+    ASSERT_FALSE(NodeValueArena::isArenaAllocated(vars.size()));
+    Node n = d_nodeManager->mkNode(kind::AND, vars);
+    ASSERT_EQ(d_nodeManager->getMemoryUsage(),
+              usage + sizeof(NodeValue) + sizeof(NodeValue*) * vars.size());
+  }
+  while (!d_nodeManager->d_zombies.empty())
+  {
+    d_nodeManager->reclaimZombies();
+  }
+  ASSERT_EQ(d_nodeManager->getMemoryUsage(), usage);
+}
 }  // namespace test
 }  // namespace cvc5::internal
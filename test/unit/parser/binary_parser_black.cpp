@@ -0,0 +1,142 @@
+/******************************************************************************
+ * Top contributors (to current version):
+ *   agent
+ *
+ * This file is part of the cvc5 project.
+ *
+ * Copyright (c) 2009-2023 by the authors listed in the file AUTHORS
+ * in the top-level source directory and their institutional affiliations.
+ * All rights reserved.  See the file COPYING in the top-level source
+ * directory for licensing information.
+ * ****************************************************************************
+ *
+ * Black box testing of the binary format of cvc5.
+ */
+
+#include <cvc5/cvc5.h>
+
+#include <sstream>
+
+#include "parser/api/cpp/command.h"
+#include "parser/api/cpp/input_parser.h"
+#include "parser/api/cpp/symbol_manager.h"
+#include "parser/parser_exception.h"
+#include "test.h"
+
+using namespace cvc5::parser;
+
+namespace cvc5::internal {
+namespace test {
+
+class TestParserBlackBinaryParser : public TestInternal
+{
+ protected:
+  void SetUp() override
+  {
+    TestInternal::SetUp();
+    d_solver.reset(new cvc5::Solver());
+  }
+
+  void TearDown() override { d_solver.reset(nullptr); }
+
+  /** Parse and invoke all commands of the binary input in a fresh solver */
+  std::vector<std::string> parseProblem(std::istream& in, cvc5::Solver& slv)
+  {
+    SymbolManager sm(&slv);
+    InputParser parser(&slv, &sm);
+    parser.setStreamInput("LANG_BINARY", in, "test");
+    std::vector<std::string> names;
+    std::unique_ptr<Command> cmd;
+    std::stringstream out;
+    while ((cmd = parser.nextCommand()) != nullptr)
+    {
+      names.push_back(cmd->getCommandName());
+      cmd->invoke(&slv, &sm, out);
+    }
+    return names;
+  }
+
+  std::unique_ptr<cvc5::Solver> d_solver;
+};
+
+TEST_F(TestParserBlackBinaryParser, terms)
+{
+  cvc5::Solver& slv = *d_solver;
+  Sort u = slv.mkUninterpretedSort("u");
+  Sort bv8 = slv.mkBitVectorSort(8);
+  Term f = slv.mkConst(slv.mkFunctionSort({u}, slv.getIntegerSort()), "f");
+  Term x = slv.mkConst(u, "x");
+  Term y = slv.mkVar(u, "y");
+  Term fx = slv.mkTerm(Kind::APPLY_UF, {f, x});
+  Term fy = slv.mkTerm(Kind::APPLY_UF, {f, y});
+  Term b = slv.mkConst(bv8, "b");
+  std::vector<Term> terms = {
+      slv.mkTerm(Kind::GT, {fx, slv.mkInteger("123456789012345678901234")}),
+      slv.mkTerm(Kind::FORALL,
+                 {slv.mkTerm(Kind::VARIABLE_LIST, {y}),
+                  slv.mkTerm(Kind::LEQ, {fy, slv.mkInteger(-3)})}),
+      slv.mkTerm(slv.mkOp(Kind::BITVECTOR_EXTRACT, {5, 2}),
+                 {slv.mkTerm(Kind::BITVECTOR_ADD,
+                             {b, slv.mkBitVector(8, 200)})}),
+      slv.mkTerm(Kind::STRING_CONCAT,
+                 {slv.mkString("a\\u{1f}b", true), slv.mkString("c")}),
+      slv.mkReal(-7, 3),
+      fx};
+  std::stringstream ss;
+  slv.writeBinary(ss, terms);
+  std::vector<Term> read = slv.readBinary(ss);
+  ASSERT_EQ(read.size(), terms.size());
+  for (size_t i = 0, n = terms.size(); i < n; i++)
+  {
+    // the symbols are fresh, but have the same names
+    ASSERT_NE(read[i], terms[i]);
+    ASSERT_EQ(read[i].toString(), terms[i].toString());
+  }
+  // shared symbols remain shared
+  ASSERT_EQ(read[0][0], read[5]);
+}
+
+TEST_F(TestParserBlackBinaryParser, problem)
+{
+  cvc5::Solver& slv = *d_solver;
+  slv.setLogic("QF_UFLIA");
+  Sort u = slv.mkUninterpretedSort("u");
+  Term f = slv.mkConst(slv.mkFunctionSort({u}, slv.getIntegerSort()), "f");
+  Term x = slv.mkConst(u, "x");
+  Term fx = slv.mkTerm(Kind::APPLY_UF, {f, x});
+  slv.assertFormula(slv.mkTerm(Kind::GT, {fx, slv.mkInteger(0)}));
+  slv.assertFormula(slv.mkTerm(Kind::LT, {fx, slv.mkInteger(2)}));
+  std::stringstream ss;
+  slv.writeBinaryProblem(ss);
+
+  cvc5::Solver slv2;
+  std::vector<std::string> names = parseProblem(ss, slv2);
+  ASSERT_EQ(names.size(), 7);
+  ASSERT_EQ(names[0], "set-logic");
+  ASSERT_EQ(names[1], "declare-sort");
+  ASSERT_EQ(names[6], "check-sat");
+  std::vector<Term> asserts = slv2.getAssertions();
+  ASSERT_EQ(asserts.size(), 2);
+  ASSERT_EQ(asserts[0].toString(), "(> (f x) 0)");
+  ASSERT_EQ(asserts[1].toString(), "(< (f x) 2)");
+  ASSERT_TRUE(slv2.checkSat().isSat());
+}
+
+TEST_F(TestParserBlackBinaryParser, malformed)
+{
+  std::stringstream ss;
+  d_solver->writeBinary(ss, {d_solver->mkTrue()});
+  std::string data = ss.str();
+  // not a binary input
+  std::stringstream notBinary("(assert true)");
+  ASSERT_THROW(d_solver->readBinary(notBinary), CVC5ApiException);
+  // truncated input
+  std::stringstream truncated(data.substr(0, data.size() - 2));
+  ASSERT_THROW(d_solver->readBinary(truncated), CVC5ApiException);
+  cvc5::Solver slv2;
+  std::stringstream truncated2(data.substr(0, data.size() - 2));
+  ASSERT_THROW(parseProblem(truncated2, slv2), ParserException);
+}
+
+}  // namespace test
+}  // namespace cvc5::internal
@@ -0,0 +1,157 @@
+/******************************************************************************
+ * Top contributors (to current version):
+ *   agent
+ *
+ * This file is part of the cvc5 project.
+ *
+ * Copyright (c) 2009-2023 by the authors listed in the file AUTHORS
+ * in the top-level source directory and their institutional affiliations.
+ * All rights reserved.  See the file COPYING in the top-level source
+ * directory for licensing information.
+ * ****************************************************************************
+ *
+ * Black box testing of the flex lexer on the different kinds of inputs.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "parser/flex_input.h"
+#include "parser/parser_exception.h"
+#include "parser/smt2/smt2_lexer_new.h"
+#include "test.h"
+
+using namespace cvc5::parser;
+
+namespace cvc5::internal {
+namespace test {
+
+class TestParserBlackFlexLexer : public TestInternal
+{
+ protected:
+  /** Get the tokens of input, together with their text */
+  std::vector<std::pair<Token, std::string>> lex(FlexInput* input,
+                                                 bool pipelined = false)
+  {
+    Smt2LexerNew lex(false, false, pipelined);
+    lex.initialize(input, "test");
+    std::vector<std::pair<Token, std::string>> tokens;
+    Token tok;
+    do
+    {
+      tok = lex.nextToken();
+      std::string text(lex.tokenView());
+      EXPECT_EQ(text, lex.tokenStr());
+      tokens.emplace_back(tok, text);
+    } while (tok != Token::EOF_TOK
+             && tok != Token::UNTERMINATED_QUOTED_SYMBOL);
+    return tokens;
+  }
+
+  /** Check that all kinds of input yield the same tokens for s */
+  void checkInputs(const std::string& s,
+                   const std::vector<std::pair<Token, std::string>>& expected)
+  {
+    char* filename = strdup("/tmp/testinput.XXXXXX");
+    int32_t fd = mkstemp(filename);
+    ASSERT_NE(fd, -1);
+    close(fd);
+    std::fstream fs(filename, std::fstream::out);
+    fs << s;
+    fs.close();
+
+    ASSERT_EQ(lex(FlexInput::mkFileInput(filename).get()), expected);
+    std::ifstream ifs(filename);
+    ASSERT_EQ(lex(FlexInput::mkStreamInput(ifs).get()), expected);
+    ASSERT_EQ(lex(FlexInput::mkStringInput(s).get()), expected);
+
+    remove(filename);
+    free(filename);
+  }
+};
+
+TEST_F(TestParserBlackFlexLexer, tokens)
+{
+  checkInputs("(assert (! (= x #b01) :named a1)) ; comment\n"
+              "(check-sat) |quoted\nsymbol| \"str\"\"ing\" 1.5 let",
+              {{Token::LPAREN_TOK, "("},
+               {Token::SYMBOL, "assert"},
+               {Token::LPAREN_TOK, "("},
+               {Token::ATTRIBUTE_TOK, "!"},
+               {Token::LPAREN_TOK, "("},
+               {Token::SYMBOL, "="},
+               {Token::SYMBOL, "x"},
+               {Token::BINARY_LITERAL, "#b01"},
+               {Token::RPAREN_TOK, ")"},
+               {Token::KEYWORD, ":named"},
+               {Token::SYMBOL, "a1"},
+               {Token::RPAREN_TOK, ")"},
+               {Token::RPAREN_TOK, ")"},
+               {Token::LPAREN_TOK, "("},
+               {Token::SYMBOL, "check-sat"},
+               {Token::RPAREN_TOK, ")"},
+               {Token::QUOTED_SYMBOL, "|quoted\nsymbol|"},
+               {Token::STRING_LITERAL, "\"str\"\"ing\""},
+               {Token::DECIMAL_LITERAL, "1.5"},
+               {Token::LET_TOK, "let"},
+               {Token::EOF_TOK, ""}});
+}
+
+TEST_F(TestParserBlackFlexLexer, empty)
+{
+  checkInputs("", {{Token::EOF_TOK, ""}});
+  checkInputs(" ; comment", {{Token::EOF_TOK, ""}});
+}
+
+TEST_F(TestParserBlackFlexLexer, unterminated)
+{
+  checkInputs("x |abc",
+              {{Token::SYMBOL, "x"},
+               {Token::UNTERMINATED_QUOTED_SYMBOL, "|abc"}});
+}
+
+TEST_F(TestParserBlackFlexLexer, pipelined)
+{
+  // large enough to be lexed in a separate thread
+  std::stringstream ss;
+  for (size_t i = 0; i < 20000; i++)
+  {
+    ss << "(assert (! (= x" << i << " #b01) :named a" << i << "))\n";
+  }
+  ss << "|abc";
+  std::unique_ptr<FlexInput> input = FlexInput::mkStringInput(ss.str());
+  std::vector<std::pair<Token, std::string>> expected = lex(input.get());
+  ASSERT_EQ(expected.size(), 20000 * 13 + 1);
+  ASSERT_EQ(lex(input.get(), true), expected);
+
+  // errors of the lexing thread are raised when reaching their position
+  std::string s = ss.str();
+  s.replace(s.size() - 4, 4, "#z");
+  input = FlexInput::mkStringInput(s);
+  Smt2LexerNew plex(false, false, true);
+  plex.initialize(input.get(), "test");
+  for (size_t i = 0, n = expected.size() - 1; i < n; i++)
+  {
+    ASSERT_EQ(plex.nextToken(), expected[i].first);
+    ASSERT_EQ(plex.tokenView(), expected[i].second);
+  }
+  try
+  {
+    plex.nextToken();
+    FAIL();
+  }
+  catch (ParserException& e)
+  {
+    ASSERT_EQ(e.getLine(), 20001);
+  }
+}
+
+}  // namespace test
+}  // namespace cvc5::internal
@@ -61,5 +61,22 @@ TEST_F(TestPrinterBlackSmt2, regexp_loop)
                             d_nodeManager->mkConst(String("x"))));
   checkToString(n, "((_ re.loop 1 3) (str.to_re \"x\"))");
 }
+
+TEST_F(TestPrinterBlackSmt2, letify)
+{
+  Node x = d_nodeManager->mkBoundVar("x", d_nodeManager->integerType());
+  Node y = d_nodeManager->mkBoundVar("y", d_nodeManager->integerType());
+  Node t = d_nodeManager->mkNode(ADD, x, y);
+  Node u = d_nodeManager->mkNode(MULT, t, t);
+  Node n = d_nodeManager->mkNode(EQUAL, d_nodeManager->mkNode(ADD, u, u), t);
+  std::stringstream ss;
+  options::ioutils::applyNodeDepth(ss, -1);
+  options::ioutils::applyDagThresh(ss, 1);
+  options::ioutils::applyOutputLanguage(ss, Language::LANG_SMTLIB_V2_6);
+  ss << n;
+  ASSERT_EQ(ss.str(),
+            "(let ((_let_1 (+ x y))) (let ((_let_2 (* _let_1 _let_1))) (= (+ "
+            "_let_2 _let_2) _let_1)))");
+}
 }  // namespace test
 }  // namespace cvc5::internal
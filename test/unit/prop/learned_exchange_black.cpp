@@ -0,0 +1,113 @@
+/******************************************************************************
+ * Top contributors (to current version):
+ *   agent
+ *
+ * This file is part of the cvc5 project.
+ *
+ * Copyright (c) 2009-2023 by the authors listed in the file AUTHORS
+ * in the top-level source directory and their institutional affiliations.
+ * All rights reserved.  See the file COPYING in the top-level source
+ * directory for licensing information.
+ * ****************************************************************************
+ *
+ * Black box testing of cvc5::prop::LearnedExchange.
+ */
+
+#include <thread>
+
+#include "prop/learned_exchange.h"
+#include "test.h"
+
+namespace cvc5::internal {
+
+using namespace prop;
+
+namespace test {
+
+class TestPropBlackLearnedExchange : public TestInternal
+{
+};
+
+TEST_F(TestPropBlackLearnedExchange, publish_fetch)
+{
+  LearnedExchange exchange(2);
+  size_t s0 = exchange.registerSolver();
+  size_t s1 = exchange.registerSolver();
+  ASSERT_NE(s0, s1);
+  size_t c0 = 0;
+  size_t c1 = 0;
+  std::vector<const SharedClause*> clauses;
+  ASSERT_TRUE(exchange.publish(s0, {{"a", true}, {"b", false}}));
+  // a solver does not fetch its own clauses
+  exchange.fetch(s0, c0, clauses);
+  ASSERT_TRUE(clauses.empty());
+  ASSERT_EQ(c0, 1);
+  exchange.fetch(s1, c1, clauses);
+  ASSERT_EQ(clauses.size(), 1);
+  ASSERT_EQ(clauses[0]->d_source, s0);
+  ASSERT_EQ(clauses[0]->d_lits.size(), 2);
+  ASSERT_EQ(clauses[0]->d_lits[1].first, "b");
+  ASSERT_FALSE(clauses[0]->d_lits[1].second);
+  // nothing new
+  clauses.clear();
+  exchange.fetch(s1, c1, clauses);
+  ASSERT_TRUE(clauses.empty());
+  // full after the second clause
+  ASSERT_TRUE(exchange.publish(s1, {{"c", true}}));
+  ASSERT_FALSE(exchange.publish(s1, {{"d", true}}));
+  ASSERT_EQ(exchange.size(), 2);
+  exchange.fetch(s0, c0, clauses);
+  ASSERT_EQ(clauses.size(), 1);
+  ASSERT_EQ(clauses[0]->d_lits[0].first, "c");
+}
+
+TEST_F(TestPropBlackLearnedExchange, stop)
+{
+  LearnedExchange exchange(1);
+  ASSERT_FALSE(exchange.isStopRequested());
+  exchange.requestStop();
+  ASSERT_TRUE(exchange.isStopRequested());
+}
+
+TEST_F(TestPropBlackLearnedExchange, concurrent)
+{
+  const size_t nthreads = 4;
+  const size_t nclauses = 1000;
+  LearnedExchange exchange(nthreads * nclauses);
+  std::vector<size_t> received(nthreads, 0);
+  std::vector<std::thread> threads;
+  for (size_t t = 0; t < nthreads; t++)
+  {
+    threads.emplace_back([&exchange, &received, t]() {
+      size_t id = exchange.registerSolver();
+      size_t cursor = 0;
+      std::vector<const SharedClause*> clauses;
+      for (size_t i = 0; i < nclauses; i++)
+      {
+        exchange.publish(id, {{std::to_string(i), true}});
+        exchange.fetch(id, cursor, clauses);
+      }
+      // wait until all clauses are published
+      while (exchange.size() < nthreads * nclauses)
+      {
+        std::this_thread::yield();
+      }
+      while (cursor < nthreads * nclauses)
+      {
+        exchange.fetch(id, cursor, clauses);
+      }
+      received[t] = clauses.size();
+    });
+  }
+  for (std::thread& t : threads)
+  {
+    t.join();
+  }
+  for (size_t t = 0; t < nthreads; t++)
+  {
+    ASSERT_EQ(received[t], (nthreads - 1) * nclauses);
+  }
+}
+
+}  // namespace test
+}  // namespace cvc5::internal
@@ -160,5 +160,58 @@ TEST_F(TestTheoryWhiteEvaluator, code)
     ASSERT_EQ(r, d_nodeManager->mkConstInt(Rational(-1)));
   }
 }
+
+TEST_F(TestTheoryWhiteEvaluator, program)
+{
+  TypeNode intType = d_nodeManager->integerType();
+  Node x = d_nodeManager->mkVar("x", intType);
+  Node y = d_nodeManager->mkVar("y", intType);
+  Node two = d_nodeManager->mkConstInt(Rational(2));
+
+  // (ite (>= x y) (div (+ x y) (- x y)) (* x 2)), which divides by zero if
+  // x = y, and hence falls back to the evaluator
+  Node sum = d_nodeManager->mkNode(kind::ADD, x, y);
+  Node diff = d_nodeManager->mkNode(kind::SUB, x, y);
+  Node t = d_nodeManager->mkNode(
+      kind::ITE,
+      d_nodeManager->mkNode(kind::GEQ, x, y),
+      d_nodeManager->mkNode(kind::INTS_DIVISION, sum, diff),
+      d_nodeManager->mkNode(kind::MULT, x, two));
+
+  std::vector<Node> args = {x, y};
+  std::vector<std::vector<Node>> points;
+  for (int64_t i = -3; i <= 3; i++)
+  {
+    for (int64_t j = -3; j <= 3; j++)
+    {
+      points.push_back({d_nodeManager->mkConstInt(Rational(i)),
+                        d_nodeManager->mkConstInt(Rational(j))});
+    }
+  }
+
+  Rewriter* rr = d_slvEngine->getEnv().getRewriter();
+  Evaluator eval(rr);
+  EvalProgram prog(eval, t, args);
+  ASSERT_TRUE(prog.isCompiled());
+  std::vector<Node> batch = prog.evalBatch(points);
+  ASSERT_EQ(batch.size(), points.size());
+  for (size_t i = 0, npoints = points.size(); i < npoints; i++)
+  {
+    Node expected = eval.eval(t, args, points[i]);
+    ASSERT_EQ(prog.eval(points[i]), expected);
+    ASSERT_EQ(batch[i], expected);
+  }
+
+  // terms with applications of uninterpreted functions are not compiled
+  Node z = d_nodeManager->mkBoundVar(intType);
+  Node lambda = d_nodeManager->mkNode(
+      kind::LAMBDA,
+      d_nodeManager->mkNode(kind::BOUND_VAR_LIST, z),
+      d_nodeManager->mkNode(kind::ADD, z, two));
+  Node app = d_nodeManager->mkNode(kind::APPLY_UF, lambda, x);
+  EvalProgram progApp(eval, app, args);
+  ASSERT_FALSE(progApp.isCompiled());
+  ASSERT_EQ(progApp.eval(points[0]), eval.eval(app, args, points[0]));
+}
 }  // namespace test
 }  // namespace cvc5::internal
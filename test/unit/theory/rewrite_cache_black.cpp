@@ -0,0 +1,77 @@
+/******************************************************************************
+ * Top contributors (to current version):
+ *   agent
+ *
+ * This file is part of the cvc5 project.
+ *
+ * Copyright (c) 2009-2023 by the authors listed in the file AUTHORS
+ * in the top-level source directory and their institutional affiliations.
+ * All rights reserved.  See the file COPYING in the top-level source
+ * directory for licensing information.
+ * ****************************************************************************
+ *
+ * Black box testing of the bounded rewrite cache.
+ */
+
+#include "expr/node.h"
+#include "test_smt.h"
+#include "theory/rewrite_cache.h"
+#include "theory/rewriter.h"
+#include "util/rational.h"
+
+using namespace cvc5::internal::kind;
+using namespace cvc5::internal::theory;
+
+namespace cvc5::internal {
+namespace test {
+
+class TestTheoryBlackRewriteCache : public TestSmtNoFinishInit
+{
+};
+
+TEST_F(TestTheoryBlackRewriteCache, lru)
+{
+  RewriteCache cache(d_slvEngine->getEnv().getStatisticsRegistry(), 2);
+  TypeNode intType = d_nodeManager->integerType();
+  Node a = d_nodeManager->mkBoundVar("a", intType);
+  Node b = d_nodeManager->mkBoundVar("b", intType);
+  Node c = d_nodeManager->mkBoundVar("c", intType);
+  cache.set(THEORY_ARITH, true, a, b);
+  cache.set(THEORY_ARITH, false, a, c);
+  ASSERT_EQ(cache.size(), 2);
+  // pre- and post-rewrites are distinct
+  ASSERT_EQ(cache.get(THEORY_ARITH, true, a), b);
+  ASSERT_EQ(cache.get(THEORY_ARITH, false, a), c);
+  ASSERT_TRUE(cache.get(THEORY_UF, false, a).isNull());
+  // the pre-rewrite of a is now the least recently used entry
+  cache.set(THEORY_ARITH, false, b, b);
+  ASSERT_EQ(cache.size(), 2);
+  ASSERT_TRUE(cache.get(THEORY_ARITH, true, a).isNull());
+  ASSERT_EQ(cache.get(THEORY_ARITH, false, a), c);
+  ASSERT_EQ(cache.get(THEORY_ARITH, false, b), b);
+  cache.clear();
+  ASSERT_EQ(cache.size(), 0);
+  ASSERT_TRUE(cache.get(THEORY_ARITH, false, b).isNull());
+}
+
+TEST_F(TestTheoryBlackRewriteCache, rewrite)
+{
+  d_slvEngine->setOption("rewrite-cache-limit", "3");
+  d_slvEngine->finishInit();
+  Rewriter* rr = d_slvEngine->getEnv().getRewriter();
+  TypeNode intType = d_nodeManager->integerType();
+  Node x = d_nodeManager->mkBoundVar("x", intType);
+  Node one = d_nodeManager->mkConstInt(Rational(1));
+  Node t = x;
+  for (size_t i = 0; i < 10; i++)
+  {
+    t = d_nodeManager->mkNode(ADD, t, one);
+  }
+  Node expected =
+      d_nodeManager->mkNode(ADD, x, d_nodeManager->mkConstInt(Rational(10)));
+  // the result does not depend on evictions
+  ASSERT_EQ(rr->rewrite(t), rr->rewrite(expected));
+  ASSERT_EQ(rr->rewrite(t), rr->rewrite(expected));
+}
+}  // namespace test
+}  // namespace cvc5::internal
@@ -0,0 +1,130 @@
+/******************************************************************************
+ * Top contributors (to current version):
+ *   agent
+ *
+ * This file is part of the cvc5 project.
+ *
+ * Copyright (c) 2009-2023 by the authors listed in the file AUTHORS
+ * in the top-level source directory and their institutional affiliations.
+ * All rights reserved.  See the file COPYING in the top-level source
+ * directory for licensing information.
+ * ****************************************************************************
+ *
+ * Black box testing of the flat instantiation trie.
+ */
+
+#include <algorithm>
+
+#include "context/context.h"
+#include "expr/node.h"
+#include "test_smt.h"
+#include "theory/quantifiers/inst_match_trie.h"
+
+using namespace cvc5::internal::kind;
+using namespace cvc5::internal::theory::quantifiers;
+
+namespace cvc5::internal {
+namespace test {
+
+class TestTheoryBlackQuantifiersInstMatchTrie : public TestSmt
+{
+ protected:
+  void SetUp() override
+  {
+    TestSmt::SetUp();
+    TypeNode u = d_nodeManager->mkSort("u");
+    Node x = d_nodeManager->mkBoundVar("x", u);
+    Node y = d_nodeManager->mkBoundVar("y", u);
+    Node z = d_nodeManager->mkBoundVar("z", u);
+    Node p = d_skolemManager->mkDummySkolem(
+        "p", d_nodeManager->mkPredicateType({u, u}));
+    Node body = d_nodeManager->mkNode(APPLY_UF, p, x, y);
+    d_q1 = d_nodeManager->mkNode(
+        FORALL, d_nodeManager->mkNode(BOUND_VAR_LIST, x, y), body);
+    d_q2 = d_nodeManager->mkNode(
+        FORALL,
+        d_nodeManager->mkNode(BOUND_VAR_LIST, z),
+        d_nodeManager->mkNode(APPLY_UF, p, z, z));
+    for (size_t i = 0; i < 8; i++)
+    {
+      d_terms.push_back(d_skolemManager->mkDummySkolem("a", u));
+    }
+  }
+
+  Node d_q1;
+  Node d_q2;
+  std::vector<Node> d_terms;
+};
+
+TEST_F(TestTheoryBlackQuantifiersInstMatchTrie, addExists)
+{
+  FlatInstMatchTrie trie;
+  std::vector<Node> m1 = {d_terms[0], d_terms[1]};
+  std::vector<Node> m2 = {d_terms[0], d_terms[2]};
+  std::vector<Node> m3 = {d_terms[0]};
+  ASSERT_FALSE(trie.existsInstMatch(d_q1, m1));
+  ASSERT_TRUE(trie.addInstMatch(d_q1, m1));
+  ASSERT_FALSE(trie.addInstMatch(d_q1, m1));
+  ASSERT_TRUE(trie.existsInstMatch(d_q1, m1));
+  ASSERT_FALSE(trie.existsInstMatch(d_q1, m2));
+  ASSERT_TRUE(trie.addInstMatch(d_q1, m2));
+  // instantiations of different quantified formulas are distinct
+  ASSERT_FALSE(trie.existsInstMatch(d_q2, m3));
+  ASSERT_TRUE(trie.addInstMatch(d_q2, m3));
+  std::vector<Node> qs;
+  trie.getQuantifiedFormulas(qs);
+  ASSERT_EQ(qs.size(), 2);
+  std::vector<std::vector<Node>> insts;
+  trie.getInstantiations(d_q1, insts);
+  ASSERT_EQ(insts.size(), 2);
+  ASSERT_TRUE(std::find(insts.begin(), insts.end(), m1) != insts.end());
+  ASSERT_TRUE(std::find(insts.begin(), insts.end(), m2) != insts.end());
+}
+
+TEST_F(TestTheoryBlackQuantifiersInstMatchTrie, backtrack)
+{
+  context::Context ctx;
+  FlatInstMatchTrie trie(&ctx);
+  std::vector<Node> m1 = {d_terms[0], d_terms[1]};
+  ASSERT_TRUE(trie.addInstMatch(d_q1, m1));
+  size_t size = trie.size();
+  for (size_t round = 0; round < 2; round++)
+  {
+    ctx.push();
+    // add many instantiations, which grows the edge table of initially 64
+    // slots several times, such that the entries are removed from a table
+    // that was resized after they were added
+    for (const Node& a : d_terms)
+    {
+      for (const Node& b : d_terms)
+      {
+        trie.addInstMatch(d_q1, {a, b});
+        trie.addInstMatch(d_q2, {b});
+      }
+    }
+    ASSERT_GT(trie.size(), 64);
+    for (const Node& a : d_terms)
+    {
+      for (const Node& b : d_terms)
+      {
+        ASSERT_TRUE(trie.existsInstMatch(d_q1, {a, b}));
+      }
+    }
+    ctx.pop();
+    ASSERT_EQ(trie.size(), size);
+    ASSERT_TRUE(trie.existsInstMatch(d_q1, m1));
+    for (const Node& a : d_terms)
+    {
+      for (const Node& b : d_terms)
+      {
+        ASSERT_EQ(trie.existsInstMatch(d_q1, {a, b}),
+                  a == m1[0] && b == m1[1]);
+      }
+      ASSERT_FALSE(trie.existsInstMatch(d_q2, {a}));
+    }
+  }
+  ASSERT_TRUE(trie.addInstMatch(d_q1, {d_terms[3], d_terms[2]}));
+}
+
+}  // namespace test
+}  // namespace cvc5::internal
@@ -0,0 +1,190 @@
+/******************************************************************************
+ * Top contributors (to current version):
+ *   agent
+ *
+ * This file is part of the cvc5 project.
+ *
+ * Copyright (c) 2009-2023 by the authors listed in the file AUTHORS
+ * in the top-level source directory and their institutional affiliations.
+ * All rights reserved.  See the file COPYING in the top-level source
+ * directory for licensing information.
+ * ****************************************************************************
+ *
+ * Black box testing of the explanations of the equality engine.
+ */
+
+#include <set>
+#include <vector>
+
+#include "context/context.h"
+#include "expr/skolem_manager.h"
+#include "test_env.h"
+#include "theory/uf/eq_proof.h"
+#include "theory/uf/equality_engine.h"
+
+using namespace cvc5::internal::theory::eq;
+
+namespace cvc5::internal {
+namespace test {
+
+class TestTheoryBlackEqualityEngine : public TestEnv
+{
+ protected:
+  void SetUp() override
+  {
+    TestEnv::SetUp();
+    SkolemManager* sm = d_nodeManager->getSkolemManager();
+    TypeNode u = d_nodeManager->mkSort("U");
+    d_a = sm->mkDummySkolem("a", u);
+    d_b = sm->mkDummySkolem("b", u);
+    d_c = sm->mkDummySkolem("c", u);
+    d_d = sm->mkDummySkolem("d", u);
+    Node f = sm->mkDummySkolem("f", d_nodeManager->mkFunctionType(u, u));
+    d_fa = d_nodeManager->mkNode(kind::APPLY_UF, f, d_a);
+    d_fc = d_nodeManager->mkNode(kind::APPLY_UF, f, d_c);
+    d_context = d_env->getContext();
+    d_ee.reset(new EqualityEngine(*d_env, d_context, "test", false));
+    d_ee->addFunctionKind(kind::APPLY_UF);
+    d_ee->addTerm(d_fa);
+    d_ee->addTerm(d_fc);
+  }
+
+  void TearDown() override
+  {
+    d_ee.reset();
+    d_asserted.clear();
+    TestEnv::TearDown();
+  }
+
+  /** Get x = y, oriented by the ids of x and y */
+  static Node eq(Node x, Node y) { return x < y ? x.eqNode(y) : y.eqNode(x); }
+
+  /** Assert x = y, which is its own reason */
+  void assertEq(Node x, Node y)
+  {
+    d_asserted.push_back(eq(x, y));
+    d_ee->assertEquality(d_asserted.back(), true, d_asserted.back());
+  }
+
+  /** Explain x = y, and store its proof in eqp if it is not null */
+  std::set<Node> explain(Node x, Node y, EqProof* eqp = nullptr)
+  {
+    std::vector<TNode> assumptions;
+    d_ee->explainEquality(x, y, true, assumptions, eqp);
+    return std::set<Node>(assumptions.begin(), assumptions.end());
+  }
+
+  /** Get the assumptions of the proof p, oriented as by eq() */
+  static std::set<Node> getAssumptions(const EqProof& p)
+  {
+    std::set<Node> res;
+    std::vector<const EqProof*> visit{&p};
+    while (!visit.empty())
+    {
+      const EqProof* cur = visit.back();
+      visit.pop_back();
+      if (cur->d_id == MERGED_THROUGH_EQUALITY)
+      {
+        res.insert(eq(cur->d_node[0], cur->d_node[1]));
+      }
+      for (const std::shared_ptr<EqProof>& c : cur->d_children)
+      {
+        visit.push_back(c.get());
+      }
+    }
+    return res;
+  }
+
+  /**
+   * Explain a = c and f(a) = f(c) several times, where the explanations after
+   * the first one are memoized, and check that they are the given
+   * assumptions, also for the proofs if withProofs is true.
+   */
+  void checkExplanations(const std::set<Node>& expected, bool withProofs)
+  {
+    for (size_t i = 0; i < 3; i++)
+    {
+      for (const std::pair<Node, Node>& p :
+           {std::make_pair(d_a, d_c), std::make_pair(d_fa, d_fc)})
+      {
+        EqProof eqp;
+        ASSERT_EQ(explain(p.first, p.second, withProofs ? &eqp : nullptr),
+                  expected);
+        if (withProofs)
+        {
+          ASSERT_EQ(getAssumptions(eqp), expected);
+          if (p.first == d_a)
+          {
+            ASSERT_EQ(eq(eqp.d_node[0], eqp.d_node[1]), eq(d_a, d_c));
+          }
+        }
+      }
+    }
+  }
+
+  /**
+   * Merge a and c in two ways, where we backtrack below the level of the
+   * memoized explanations in between.
+   */
+  void checkBacktrack(bool withProofs)
+  {
+    d_context->push();
+    assertEq(d_a, d_b);
+    d_context->push();
+    assertEq(d_b, d_c);
+    ASSERT_TRUE(d_ee->areEqual(d_fa, d_fc));
+    checkExplanations({eq(d_a, d_b), eq(d_b, d_c)}, withProofs);
+    // backtrack past b = c, which the memoized explanations depend on
+    d_context->pop();
+    ASSERT_FALSE(d_ee->areEqual(d_a, d_c));
+    ASSERT_FALSE(d_ee->areEqual(d_fa, d_fc));
+    assertEq(d_a, d_d);
+    assertEq(d_d, d_c);
+    checkExplanations({eq(d_a, d_d), eq(d_d, d_c)}, withProofs);
+    // backtrack past all equalities, and merge a and c directly
+    d_context->pop();
+    assertEq(d_c, d_a);
+    checkExplanations({eq(d_a, d_c)}, withProofs);
+  }
+
+  Node d_a;
+  Node d_b;
+  Node d_c;
+  Node d_d;
+  Node d_fa;
+  Node d_fc;
+  std::vector<Node> d_asserted;
+  context::Context* d_context;
+  std::unique_ptr<EqualityEngine> d_ee;
+};
+
+TEST_F(TestTheoryBlackEqualityEngine, memoizedExplanations)
+{
+  checkBacktrack(false);
+}
+
+TEST_F(TestTheoryBlackEqualityEngine, memoizedProofs)
+{
+  checkBacktrack(true);
+}
+
+TEST_F(TestTheoryBlackEqualityEngine, memoizedWithAndWithoutProofs)
+{
+  // explanations with and without proofs are memoized separately
+  d_context->push();
+  assertEq(d_a, d_b);
+  assertEq(d_b, d_c);
+  checkExplanations({eq(d_a, d_b), eq(d_b, d_c)}, false);
+  checkExplanations({eq(d_a, d_b), eq(d_b, d_c)}, true);
+  checkExplanations({eq(d_a, d_b), eq(d_b, d_c)}, false);
+  d_context->pop();
+  d_context->push();
+  assertEq(d_c, d_d);
+  assertEq(d_d, d_a);
+  checkExplanations({eq(d_c, d_d), eq(d_d, d_a)}, true);
+  checkExplanations({eq(d_c, d_d), eq(d_d, d_a)}, false);
+  d_context->pop();
+}
+
+}  // namespace test
+}  // namespace cvc5::internal
@@ -0,0 +1,96 @@
+/******************************************************************************
+ * Top contributors (to current version):
+ *   agent
+ *
+ * This file is part of the cvc5 project.
+ *
+ * Copyright (c) 2009-2023 by the authors listed in the file AUTHORS
+ * in the top-level source directory and their institutional affiliations.
+ * All rights reserved.  See the file COPYING in the top-level source
+ * directory for licensing information.
+ * ****************************************************************************
+ *
+ * Black box testing of the flat id table of the equality engine.
+ */
+
+#include <random>
+#include <unordered_map>
+#include <vector>
+
+#include "test.h"
+#include "theory/uf/equality_engine_id_table.h"
+
+using namespace cvc5::internal::theory::eq;
+
+namespace cvc5::internal {
+namespace test {
+
+class TestTheoryBlackEqualityIdTable : public TestInternal
+{
+};
+
+TEST_F(TestTheoryBlackEqualityIdTable, insertErase)
+{
+  EqualityIdTable<FunctionApplication, FunctionApplicationHashFunction> table;
+  FunctionApplication f(APP_UNINTERPRETED, 1, 2);
+  FunctionApplication g(APP_EQUALITY, 1, 2);
+  ASSERT_EQ(table.find(f), null_id);
+  table.insert(f, 7);
+  ASSERT_EQ(table.find(f), 7);
+  // applications of different types are distinct
+  ASSERT_FALSE(table.contains(g));
+  table.insert(g, 8);
+  ASSERT_EQ(table.size(), 2);
+  table.erase(f);
+  ASSERT_FALSE(table.contains(f));
+  ASSERT_EQ(table.find(g), 8);
+  ASSERT_EQ(table.size(), 1);
+}
+
+TEST_F(TestTheoryBlackEqualityIdTable, backtrack)
+{
+  // inserts in order and erases in reverse order, as on backtracking, and
+  // compares against a standard map
+  EqualityIdTable<FunctionApplication, FunctionApplicationHashFunction> table;
+  std::unordered_map<FunctionApplication,
+                     EqualityNodeId,
+                     FunctionApplicationHashFunction>
+      expected;
+  std::vector<FunctionApplication> trail;
+  std::mt19937 rng(42);
+  std::uniform_int_distribution<EqualityNodeId> arg(0, 200);
+  for (uint32_t round = 0; round < 20; round++)
+  {
+    for (uint32_t i = 0; i < 1000; i++)
+    {
+      FunctionApplication app(APP_UNINTERPRETED, arg(rng), arg(rng));
+      if (expected.find(app) == expected.end())
+      {
+        EqualityNodeId id = static_cast<EqualityNodeId>(trail.size());
+        table.insert(app, id);
+        expected[app] = id;
+        trail.push_back(app);
+      }
+    }
+    size_t keep = trail.size() / 2;
+    while (trail.size() > keep)
+    {
+      table.erase(trail.back());
+      expected.erase(trail.back());
+      trail.pop_back();
+    }
+    ASSERT_EQ(table.size(), expected.size());
+    for (EqualityNodeId a = 0; a <= 200; a++)
+    {
+      for (EqualityNodeId b = 0; b <= 200; b += 7)
+      {
+        FunctionApplication app(APP_UNINTERPRETED, a, b);
+        auto it = expected.find(app);
+        ASSERT_EQ(table.find(app), it == expected.end() ? null_id : it->second);
+      }
+    }
+  }
+}
+
+}  // namespace test
+}  // namespace cvc5::internal
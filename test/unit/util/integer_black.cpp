@@ -613,5 +613,33 @@ TEST_F(TestUtilBlackInteger, modInverse)
     }
   }
 }
+
+TEST_F(TestUtilBlackInteger, smallOverflow)
+{
+  // values at the boundary of the inline representation
+  Integer max(std::numeric_limits<signed long>::max());
+  Integer min(std::numeric_limits<signed long>::min());
+  Integer one(1);
+  ASSERT_EQ(max + one, Integer("9223372036854775808"));
+  ASSERT_EQ(max + one - one, max);
+  ASSERT_EQ(min - one, Integer("-9223372036854775809"));
+  ASSERT_EQ(min + one + min - min - one, min);
+  ASSERT_EQ(-min, Integer("9223372036854775808"));
+  ASSERT_EQ(max * max, Integer("85070591730234615847396907784232501249"));
+  ASSERT_EQ((max * max).floorDivideQuotient(max), max);
+  ASSERT_EQ(min.abs() - one, max);
+  ASSERT_EQ(min.floorDivideQuotient(Integer(-1)), -min);
+  ASSERT_EQ(min.getLong(), std::numeric_limits<signed long>::min());
+  // equal values have equal hashes, independent of how they were computed
+  ASSERT_EQ((max + one - one).hash(), max.hash());
+  ASSERT_EQ((min - one + one).hash(), min.hash());
+  ASSERT_EQ(Integer(7).multiplyByPow2(70).divByPow2(70), Integer(7));
+  ASSERT_EQ(Integer(0).multiplyByPow2(63), Integer(0));
+  ASSERT_EQ(Integer(1).multiplyByPow2(62), Integer("4611686018427387904"));
+  ASSERT_EQ(Integer(1).multiplyByPow2(63), Integer("9223372036854775808"));
+  ASSERT_EQ(Integer(-1).multiplyByPow2(63), min);
+  ASSERT_EQ(Integer(-7).divByPow2(1), Integer(-4));
+  ASSERT_EQ(Integer(-7).modByPow2(2), Integer(1));
+}
 }  // namespace test
 }  // namespace cvc5::internal
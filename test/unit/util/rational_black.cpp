@@ -15,6 +15,8 @@
 
 #include <sstream>
 
+#include <limits>
+
 #include "test.h"
 #include "util/rational.h"
 
@@ -42,5 +44,29 @@ TEST_F(TestUtilBlackRational, fromDecimal)
   ASSERT_THROW(Rational::fromDecimal("1.2/3");, std::invalid_argument);
   ASSERT_THROW(Rational::fromDecimal("Hello, world!");, std::invalid_argument);
 }
+
+TEST_F(TestUtilBlackRational, smallOverflow)
+{
+  // values at the boundary of the inline representation
+  Rational max(std::numeric_limits<signed long>::max());
+  Rational min(std::numeric_limits<signed long>::min());
+  Rational half(1, 2);
+  ASSERT_EQ(max + max - max, max);
+  ASSERT_EQ(min * Rational(-1), -min);
+  ASSERT_EQ(-min, Rational("9223372036854775808"));
+  ASSERT_EQ((max / Rational(2)) * Rational(2), max);
+  ASSERT_EQ(max / max, Rational(1));
+  ASSERT_EQ(Rational(max.getNumerator(), Integer(3)).getDenominator(),
+            Integer(3));
+  ASSERT_EQ((half * max).floor(), Integer("4611686018427387903"));
+  ASSERT_EQ((half * max).ceiling(), Integer("4611686018427387904"));
+  ASSERT_EQ(Rational(-3, 2).floor(), Integer(-2));
+  ASSERT_EQ(Rational(-3, 2).ceiling(), Integer(-1));
+  ASSERT_LT(Rational(1, 3), Rational(1, 2));
+  ASSERT_LT(max / Rational(3), min.abs() / Rational(3));
+  ASSERT_EQ(Rational(2, -4), Rational(-1, 2));
+  ASSERT_EQ((max + max - max).hash(), max.hash());
+  ASSERT_EQ(Rational(6, 4).toString(), "3/2");
+}
 }  // namespace test
 }  // namespace cvc5::internal
@@ -0,0 +1,77 @@
+/******************************************************************************
+ * Top contributors (to current version):
+ *   agent
+ *
+ * This file is part of the cvc5 project.
+ *
+ * Copyright (c) 2009-2023 by the authors listed in the file AUTHORS
+ * in the top-level source directory and their institutional affiliations.
+ * All rights reserved.  See the file COPYING in the top-level source
+ * directory for licensing information.
+ * ****************************************************************************
+ *
+ * Black box testing of cvc5::internal::ScratchArena.
+ */
+
+#include <cstdint>
+#include <string>
+
+#include "test.h"
+#include "util/scratch_arena.h"
+
+namespace cvc5::internal {
+namespace test {
+
+class TestUtilBlackScratchArena : public TestInternal
+{
+};
+
+TEST_F(TestUtilBlackScratchArena, alignment)
+{
+  ScratchArena arena;
+  for (size_t align : {1, 2, 4, 8, 16})
+  {
+    // misalign the current position
+    arena.allocate(1, 1);
+    void* p = arena.allocate(24, align);
+    ASSERT_EQ(reinterpret_cast<uintptr_t>(p) % align, 0);
+  }
+  // a large allocation
+  char* p = static_cast<char*>(arena.allocate(4 * ScratchArena::CHUNK_SIZE));
+  p[4 * ScratchArena::CHUNK_SIZE - 1] = 'a';
+  ASSERT_EQ(arena.getNumChunks(), 1);
+}
+
+TEST_F(TestUtilBlackScratchArena, reset)
+{
+  ScratchArena arena;
+  for (size_t i = 0; i < 5; i++)
+  {
+    {
+      ScratchMap<size_t, std::string> m(arena);
+      ScratchUnorderedMap<size_t, size_t> um(arena);
+      ScratchVector<size_t> v(arena);
+      for (size_t j = 0; j < 10000; j++)
+      {
+        m[j] = std::to_string(j);
+        um[j] = j * j;
+        v.push_back(j);
+      }
+      for (size_t j = 0; j < 10000; j++)
+      {
+        ASSERT_EQ(m[j], std::to_string(j));
+        ASSERT_EQ(um[j], j * j);
+        ASSERT_EQ(v[j], j);
+      }
+      ASSERT_GT(arena.getBytesAllocated(), 0);
+    }
+    size_t numChunks = arena.getNumChunks();
+    arena.reset();
+    ASSERT_EQ(arena.getBytesAllocated(), 0);
+    // the chunks are reused after the reset
+    ASSERT_EQ(arena.getNumChunks(), numChunks);
+  }
+}
+
+}  // namespace test
+}  // namespace cvc5::internal
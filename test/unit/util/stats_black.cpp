@@ -19,11 +19,13 @@
 #include <sstream>
 #include <string>
 #include <thread>
+#include <vector>
 
 #include "lib/clock_gettime.h"
 #include "proof/proof_rule.h"
 #include "test_env.h"
 #include "util/statistics_registry.h"
+#include "util/statistics_reporter.h"
 #include "util/statistics_stats.h"
 
 namespace cvc5::internal {
@@ -85,6 +87,12 @@ TEST_F(TestUtilBlackStats, stats)
   ValueStat<double> valD3 = reg.registerValue("backedDoubleNoDec", 2.0);
   valD3.set(17);
 
+  MemoryStat mem = reg.registerMemory("mem");
+  mem.set(100);
+  mem.set(150);
+  mem.set(30);
+  mem.set(60);
+
   ASSERT_EQ(reg.get("avg"), std::string("1.5"));
   ASSERT_EQ(reg.get("hist-int"), std::string("{ 14: 1, 15: 2, 16: 2 }"));
   ASSERT_EQ(reg.get("hist-pfrule"), std::string("{ ASSUME: 2, SCOPE: 1 }"));
@@ -95,6 +103,56 @@ TEST_F(TestUtilBlackStats, stats)
   ASSERT_EQ(reg.get("backedDouble"), std::string("3.5"));
   ASSERT_EQ(reg.get("backedNegDouble"), std::string("-3.5"));
   ASSERT_EQ(reg.get("backedDoubleNoDec"), std::string("17"));
+  ASSERT_EQ(reg.get("mem::liveBytes"), std::string("60"));
+  ASSERT_EQ(reg.get("mem::peakBytes"), std::string("150"));
+#endif
+}
+
+TEST_F(TestUtilBlackStats, reporter)
+{
+#ifdef CVC5_STATISTICS_ON
+  StatisticsRegistry reg(*d_env.get(), false);
+  std::vector<std::string> lines;
+  StatisticsReporter reporter(
+      reg, 1000, [&lines](const std::string& line) { lines.push_back(line); });
+
+  // the reporter prints public statistics only by default
+  IntStat intstat = reg.registerInt("int", false);
+  HistogramStat<int64_t> histInt =
+      reg.registerHistogram<int64_t>("hist-int", false);
+  ValueStat<std::string> valStr = reg.registerValue<std::string>("str", false);
+  IntStat internal = reg.registerInt("internal");
+  internal = 1;
+  intstat = 5;
+  histInt << 1 << 2;
+  valStr.set("a\"b");
+  reporter.report();
+  intstat += 3;
+  histInt << 2;
+  reporter.report();
+  reporter.report();
+
+  ASSERT_EQ(lines.size(), 3);
+  for (const std::string& line : lines)
+  {
+    ASSERT_EQ(line.find("{\"time\":"), 0);
+    ASSERT_EQ(line.find('\n'), std::string::npos);
+  }
+  ASSERT_NE(lines[0].find("\"int\":{\"value\":5,\"delta\":5"),
+            std::string::npos);
+  ASSERT_NE(lines[0].find("\"1\":{\"value\":1,\"delta\":1"),
+            std::string::npos);
+  ASSERT_EQ(lines[0].find("\"internal\":"), std::string::npos);
+  ASSERT_NE(lines[0].find("\"str\":{\"value\":\"a\\\"b\"}"),
+            std::string::npos);
+  // only the changed statistics are reported
+  ASSERT_NE(lines[1].find("\"int\":{\"value\":8,\"delta\":3"),
+            std::string::npos);
+  ASSERT_NE(lines[1].find("\"2\":{\"value\":2,\"delta\":1"),
+            std::string::npos);
+  ASSERT_EQ(lines[1].find("\"1\":"), std::string::npos);
+  ASSERT_EQ(lines[1].find("\"str\":"), std::string::npos);
+  ASSERT_NE(lines[2].find("\"stats\":{}}"), std::string::npos);
 #endif
 }
 }  // namespace test